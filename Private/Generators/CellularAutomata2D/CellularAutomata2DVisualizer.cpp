@@ -69,19 +69,12 @@ void ACellularAutomata2DVisualizer::OnConstruction(const FTransform& Transform)
 	FCellularAutomataResolvedParams Params = CaveConfig.Resolve();
 
 	UCellularAutomataGenerator2D* Generator = NewObject<UCellularAutomataGenerator2D>();
-	Generator->SetBounds(Bounds)
-		->SetSeed(Seed)
-		->SetGridSize(GridSize)
-		->SetFillProbability(Params.FillProbability)
-		->SetIterations(Params.Iterations)
-		->SetBirthRule(Params.BirthRule)
-		->SetSurvivalRule(Params.SurvivalRule)
-		->SetMinRegionSize(Params.MinRegionSize)
-		->SetKeepCenterRegion(Params.bKeepCenterRegion);
-
-	const double			  StartTime = FPlatformTime::Seconds();
-	FCellularAutomataGridData GridData = Generator->GenerateWithGridData();
-	const double			  GenerationTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	Generator->SetBounds(Bounds)->SetSeed(Seed)->SetGridSize(GridSize)->ApplyResolvedParams(Params);
+
+	FCellularAutomataGridData& GridData = LastGridData;
+	const double			   StartTime = FPlatformTime::Seconds();
+	Generator->GenerateWithGridData(GridData, GenerationScratch);
+	const double GenerationTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
 
 	// Clear previous state — FlushDebugStrings is needed separately because
 	// FlushPersistentDebugLines does not clear DrawDebugString text.
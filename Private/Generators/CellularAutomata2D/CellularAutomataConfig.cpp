@@ -187,6 +187,7 @@ FCellularAutomataResolvedParams FCellularAutomataConfig::Resolve() const
 {
 	FCellularAutomataResolvedParams Params;
 	Params.bKeepCenterRegion = bKeepCenterRegion;
+	Params.BoundarySimplifyTolerance = FMath::Max(BoundarySimplifyTolerance, 0.0f);
 
 	if (bUseAdvancedOverride)
 	{
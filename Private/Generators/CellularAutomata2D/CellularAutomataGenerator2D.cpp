@@ -1,7 +1,37 @@
 #include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
 
+#include "Generators/CellularAutomata2D/CellularAutomataHierarchy.h"
+#include "Generators/LayoutCache.h"
+#include "Generators/LayoutFrameArena.h"
+#include "GeometryUtils/GeometryFunctionLibrary.h"
 #include "ProceduralGeometry.h"
 
+namespace
+{
+	/** LSD radix sort of Keys on their low KeyBits bits, one byte per pass. Scratch is used as the ping-pong buffer. */
+	void RadixSortKeys(TArray<uint64>& Keys, TArray<uint64>& Scratch, const int32 KeyBits)
+	{
+		Scratch.SetNumUninitialized(Keys.Num());
+		for (int32 Shift = 0; Shift < KeyBits; Shift += 8)
+		{
+			int32 Counts[257] = {};
+			for (const uint64 Key : Keys)
+			{
+				++Counts[((Key >> Shift) & 0xFF) + 1];
+			}
+			for (int32 Digit = 0; Digit < 256; ++Digit)
+			{
+				Counts[Digit + 1] += Counts[Digit];
+			}
+			for (const uint64 Key : Keys)
+			{
+				Scratch[Counts[(Key >> Shift) & 0xFF]++] = Key;
+			}
+			Swap(Keys, Scratch);
+		}
+	}
+} // namespace
+
 UCellularAutomataGenerator2D::UCellularAutomataGenerator2D()
 {
 	Bounds = FBox2D(FVector2D(-500, -500), FVector2D(500, 500));
@@ -11,6 +41,7 @@ UCellularAutomataGenerator2D::UCellularAutomataGenerator2D()
 	SurvivalRule = { 3, 4, 5 };
 	MinRegionSize = 20;
 	bKeepCenterRegion = true;
+	BoundarySimplifyTolerance = 0.0f;
 	InitializeRandomStream();
 }
 
@@ -74,6 +105,24 @@ UCellularAutomataGenerator2D* UCellularAutomataGenerator2D::SetKeepCenterRegion(
 	return this;
 }
 
+UCellularAutomataGenerator2D* UCellularAutomataGenerator2D::SetBoundarySimplifyTolerance(float InTolerance)
+{
+	BoundarySimplifyTolerance = FMath::Max(0.0f, InTolerance);
+	return this;
+}
+
+UCellularAutomataGenerator2D* UCellularAutomataGenerator2D::ApplyResolvedParams(const FCellularAutomataResolvedParams& Params)
+{
+	SetFillProbability(Params.FillProbability);
+	SetIterations(Params.Iterations);
+	SetBirthRule(Params.BirthRule);
+	SetSurvivalRule(Params.SurvivalRule);
+	SetMinRegionSize(Params.MinRegionSize);
+	SetKeepCenterRegion(Params.bKeepCenterRegion);
+	SetBoundarySimplifyTolerance(Params.BoundarySimplifyTolerance);
+	return this;
+}
+
 uint16 UCellularAutomataGenerator2D::RuleToBitmask(const TArray<int32>& Rule)
 {
 	uint16 Mask = 0;
@@ -117,20 +166,77 @@ int32 UCellularAutomataGenerator2D::CountWallNeighbors(const TArray<bool>& Grid,
 
 FLayoutDiagram2D UCellularAutomataGenerator2D::Generate()
 {
-	return GenerateInternal().Diagram;
+	FLayoutDiagram2D Diagram = FLayoutGenerationCache::Get().FindOrGenerate<FLayoutDiagram2D>(RandomStream,
+		[this] { return MakeCacheKey(TEXT("Diagram")); },
+		[this] {
+			FCellularAutomataScratch Scratch;
+			GenerateInternal(false, Scratch.GridData, Scratch);
+			return MoveTemp(Scratch.GridData.Diagram);
+		});
+	ApplyDiagramPostPasses(Diagram);
+	return Diagram;
 }
 
 FCellularAutomataGridData UCellularAutomataGenerator2D::GenerateWithGridData()
 {
-	return GenerateInternal();
+	FCellularAutomataGridData GridData = FLayoutGenerationCache::Get().FindOrGenerate<FCellularAutomataGridData>(RandomStream,
+		[this] { return MakeCacheKey(TEXT("GridData")); },
+		[this] {
+			FCellularAutomataGridData Result;
+			FCellularAutomataScratch  Scratch;
+			GenerateInternal(true, Result, Scratch);
+			return Result;
+		});
+	ApplyDiagramPostPasses(GridData.Diagram);
+	return GridData;
+}
+
+void UCellularAutomataGenerator2D::Generate(FLayoutDiagram2D& OutDiagram, FCellularAutomataScratch& Scratch)
+{
+	if (FLayoutGenerationCache::IsEnabled())
+	{
+		OutDiagram = Generate();
+		return;
+	}
+
+	// Build straight into the caller's diagram: swapping only exchanges allocations.
+	Swap(Scratch.GridData.Diagram, OutDiagram);
+	GenerateInternal(false, Scratch.GridData, Scratch);
+	Swap(Scratch.GridData.Diagram, OutDiagram);
+	ApplyDiagramPostPasses(OutDiagram);
 }
 
-FCellularAutomataGridData UCellularAutomataGenerator2D::GenerateInternal()
+void UCellularAutomataGenerator2D::GenerateWithGridData(FCellularAutomataGridData& OutGridData, FCellularAutomataScratch& Scratch)
+{
+	if (FLayoutGenerationCache::IsEnabled())
+	{
+		OutGridData = GenerateWithGridData();
+		return;
+	}
+	GenerateInternal(true, OutGridData, Scratch);
+	ApplyDiagramPostPasses(OutGridData.Diagram);
+}
+
+FCellularAutomataHierarchicalDiagram UCellularAutomataGenerator2D::GenerateHierarchical()
+{
+	return FCellularAutomataHierarchicalDiagram::Build(GenerateWithGridData());
+}
+
+FString UCellularAutomataGenerator2D::MakeCacheKey(const TCHAR* Output) const
+{
+	FLayoutCacheKey Key(TEXT("CellularAutomata2D"), CacheAlgorithmVersion, Output);
+	AddCacheKeyInputs(Key);
+	Key.Add(FillProbability).Add(Iterations).Add(BirthRule).Add(SurvivalRule).Add(MinRegionSize).Add(bKeepCenterRegion);
+	Key.Add(BoundarySimplifyTolerance);
+	return Key.ToString();
+}
+
+void UCellularAutomataGenerator2D::GenerateInternal(bool bMaterializeGrid, FCellularAutomataGridData& Result, FCellularAutomataScratch& Scratch)
 {
 	const double StartTime = FPlatformTime::Seconds();
 
 	UE_LOG(LogRoguelikeGeometry,
-		Log,
+		Verbose,
 		TEXT("[CA] Generate() — Bounds=(%.1f,%.1f)-(%.1f,%.1f) GridSize=%d Seed='%s' FillProb=%.2f Iterations=%d MinRegion=%d KeepCenter=%s"),
 		Bounds.Min.X,
 		Bounds.Min.Y,
@@ -151,50 +257,52 @@ FCellularAutomataGridData UCellularAutomataGenerator2D::GenerateInternal()
 	if (BoundsWidth <= 0.0f || BoundsHeight <= 0.0f)
 	{
 		UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[CA] Invalid bounds (%.1fx%.1f) — nothing to generate."), BoundsWidth, BoundsHeight);
-		FCellularAutomataGridData EmptyResult;
-		EmptyResult.CenterRegionId = -1;
-		EmptyResult.GridWidth = 0;
-		EmptyResult.GridHeight = 0;
-		EmptyResult.CellSize = static_cast<float>(GridSize);
-		return EmptyResult;
+		Result = FCellularAutomataGridData();
+		Result.CenterRegionId = -1;
+		Result.GridWidth = 0;
+		Result.GridHeight = 0;
+		Result.CellSize = static_cast<float>(GridSize);
+		return;
 	}
 
 	bool bDegradedResolution = false;
 
 	// Enlarge the cell size so the grid fits the cell budget rather than refusing to generate. Solving
-	// (W/c)(H/c) <= MaxCells for c gives c >= sqrt(W*H / MaxCells).
+	// (W/c)(H/c) <= MaxCells for c gives c >= sqrt(W*H / MaxCells). The enlarged size is local to this run (and
+	// reported in Result.CellSize): GridSize stays as configured, so a cache hit or a reused generator sees the same
+	// inputs as a fresh one.
+	int32 EffectiveGridSize = GridSize;
 	if (static_cast<int64>(FMath::CeilToInt(BoundsWidth / static_cast<float>(GridSize)))
 			* static_cast<int64>(FMath::CeilToInt(BoundsHeight / static_cast<float>(GridSize)))
 		> MaxCells)
 	{
-		const int32	 OriginalGridSize = GridSize;
 		const double MinCellSize = FMath::Sqrt(static_cast<double>(BoundsWidth) * static_cast<double>(BoundsHeight) / static_cast<double>(MaxCells));
-		GridSize = FMath::Max(GridSize, FMath::CeilToInt(MinCellSize));
+		EffectiveGridSize = FMath::Max(GridSize, FMath::CeilToInt(MinCellSize));
 		bDegradedResolution = true;
 
-		const int32 DegradedWidth = FMath::CeilToInt(BoundsWidth / static_cast<float>(GridSize));
-		const int32 DegradedHeight = FMath::CeilToInt(BoundsHeight / static_cast<float>(GridSize));
+		const int32 DegradedWidth = FMath::CeilToInt(BoundsWidth / static_cast<float>(EffectiveGridSize));
+		const int32 DegradedHeight = FMath::CeilToInt(BoundsHeight / static_cast<float>(EffectiveGridSize));
 		UE_LOG(LogRoguelikeGeometry,
 			Warning,
 			TEXT("[CA] Cell budget exceeded: GridSize %d would produce >%lld cells; degrading to GridSize %d (%dx%d)."),
-			OriginalGridSize,
-			MaxCells,
 			GridSize,
+			MaxCells,
+			EffectiveGridSize,
 			DegradedWidth,
 			DegradedHeight);
 	}
 
-	const float CellSizeVal = static_cast<float>(GridSize);
+	const float CellSizeVal = static_cast<float>(EffectiveGridSize);
 
 	const int32 GWidth = FMath::CeilToInt(BoundsWidth / CellSizeVal);
 	const int32 GHeight = FMath::CeilToInt(BoundsHeight / CellSizeVal);
 
-	UE_LOG(LogRoguelikeGeometry, Log, TEXT("[CA] Grid dimensions: %dx%d (%d total cells)"), GWidth, GHeight, GWidth * GHeight);
+	UE_LOG(LogRoguelikeGeometry, Verbose, TEXT("[CA] Grid dimensions: %dx%d (%d total cells)"), GWidth, GHeight, GWidth * GHeight);
 
 	const int32 TotalCells = GWidth * GHeight;
 
-	TArray<bool> Grid;
-	Grid.Init(false, TotalCells);
+	TArray<bool>& Grid = Result.Grid;
+	InitReusing(Grid, false, TotalCells);
 
 	for (int32 Y = 0; Y < GHeight; ++Y)
 	{
@@ -211,8 +319,9 @@ FCellularAutomataGridData UCellularAutomataGenerator2D::GenerateInternal()
 	const uint16 BirthMask = RuleToBitmask(BirthRule);
 	const uint16 SurvivalMask = RuleToBitmask(SurvivalRule);
 
-	TArray<bool> NewGrid;
-	NewGrid.SetNum(TotalCells);
+	// Every cell of the double buffer is written each iteration.
+	TArray<bool>& NewGrid = Scratch.NextGrid;
+	NewGrid.SetNumUninitialized(TotalCells, EAllowShrinking::No);
 
 	for (int32 Iter = 0; Iter < Iterations; ++Iter)
 	{
@@ -255,52 +364,36 @@ FCellularAutomataGridData UCellularAutomataGenerator2D::GenerateInternal()
 			}
 		}
 		UE_LOG(LogRoguelikeGeometry,
-			Log,
+			Verbose,
 			TEXT("[CA] After %d iterations: %d floor cells (%.1f%% of grid)"),
 			Iterations,
 			FloorCount,
 			100.0f * FloorCount / TotalCells);
 	}
 
-	TArray<int32>			  RegionIds;
-	TArray<TArray<FIntPoint>> Regions;
-	int32					  CenterRegionId = -1;
-	const int32				  CenterX = GWidth / 2;
-	const int32				  CenterY = GHeight / 2;
+	TArray<int32>&			   RegionIds = Result.RegionIds;
+	TArray<TArray<FIntPoint>>& Regions = Result.Regions;
+	int32					   CenterRegionId = -1;
+	const int32				   CenterX = GWidth / 2;
+	const int32				   CenterY = GHeight / 2;
 
 	FloodFillRegions(Grid, GWidth, GHeight, CenterX, CenterY, RegionIds, Regions, CenterRegionId);
 
-	UE_LOG(LogRoguelikeGeometry, Log, TEXT("[CA] Flood-fill found %d regions, center region=%d"), Regions.Num(), CenterRegionId);
+	UE_LOG(LogRoguelikeGeometry, Verbose, TEXT("[CA] Flood-fill found %d regions, center region=%d"), Regions.Num(), CenterRegionId);
 
 	// When bKeepCenterRegion is set but the exact center cell is a wall, fall back to the region
 	// nearest the center so culling always has a target to preserve.
 	if (bKeepCenterRegion && CenterRegionId < 0 && Regions.Num() > 0)
 	{
-		const FVector2D CenterWorld(
-			Bounds.Min.X + (CenterX + 0.5f) * static_cast<float>(GridSize), Bounds.Min.Y + (CenterY + 0.5f) * static_cast<float>(GridSize));
-		float BestDistSq = FLT_MAX;
-		int32 BestRegion = 0;
-		for (int32 RegionId = 0; RegionId < Regions.Num(); ++RegionId)
-		{
-			for (const FIntPoint& Cell : Regions[RegionId])
-			{
-				const FVector2D CellWorld(
-					Bounds.Min.X + (Cell.X + 0.5f) * static_cast<float>(GridSize), Bounds.Min.Y + (Cell.Y + 0.5f) * static_cast<float>(GridSize));
-				const float DistSq = FVector2D::DistSquared(CellWorld, CenterWorld);
-				if (DistSq < BestDistSq)
-				{
-					BestDistSq = DistSq;
-					BestRegion = RegionId;
-				}
-			}
-		}
-		CenterRegionId = BestRegion;
-		UE_LOG(LogRoguelikeGeometry, Log, TEXT("[CA] Center cell is wall — KeepCenterRegion fallback to nearest region %d"), CenterRegionId);
+		CenterRegionId = FindNearestRegionId(RegionIds, GWidth, GHeight, CenterX, CenterY);
+		UE_LOG(LogRoguelikeGeometry, Verbose, TEXT("[CA] Center cell is wall — KeepCenterRegion fallback to nearest region %d"), CenterRegionId);
 	}
 
-	TArray<bool> SurvivingRegions;
-	SurvivingRegions.Init(true, Regions.Num());
+	TArray<bool>& SurvivingRegions = Result.SurvivingRegions;
+	InitReusing(SurvivingRegions, true, Regions.Num());
 
+	// Culling is a per-region flag; the diagram build reads it through a region -> cell remap, so culled cells are only
+	// written back to Grid when the caller asked for the grid itself.
 	int32 CulledCount = 0;
 	for (int32 RegionId = 0; RegionId < Regions.Num(); ++RegionId)
 	{
@@ -311,40 +404,95 @@ FCellularAutomataGridData UCellularAutomataGenerator2D::GenerateInternal()
 				continue;
 			}
 
-			for (const FIntPoint& Cell : Regions[RegionId])
-			{
-				Grid[Cell.Y * GWidth + Cell.X] = false;
-			}
 			SurvivingRegions[RegionId] = false;
 			++CulledCount;
 		}
 	}
 
+	if (bMaterializeGrid && CulledCount > 0)
+	{
+		for (int32 RegionId = 0; RegionId < Regions.Num(); ++RegionId)
+		{
+			if (!SurvivingRegions[RegionId])
+			{
+				for (const FIntPoint& Cell : Regions[RegionId])
+				{
+					Grid[Cell.Y * GWidth + Cell.X] = false;
+				}
+			}
+		}
+	}
+
 	UE_LOG(LogRoguelikeGeometry,
-		Log,
+		Verbose,
 		TEXT("[CA] Culled %d regions below MinRegionSize=%d, %d surviving"),
 		CulledCount,
 		MinRegionSize,
 		Regions.Num() - CulledCount);
 
-	FLayoutDiagram2D Diagram = BuildDiagramFromRegions(Grid, RegionIds, Regions, CenterRegionId, GWidth, GHeight);
+	BuildDiagramFromRegions(
+		SurvivingRegions, RegionIds, Regions, CenterRegionId, GWidth, GHeight, CellSizeVal, Result.RegionGraph, Result.Diagram, Scratch);
 
 	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
-	UE_LOG(LogRoguelikeGeometry, Log, TEXT("[CA] Generate() complete: %d cells in %.2fms"), Diagram.Cells.Num(), ElapsedMs);
+	UE_LOG(LogRoguelikeGeometry, Verbose, TEXT("[CA] Generate() complete: %d cells in %.2fms"), Result.Diagram.Cells.Num(), ElapsedMs);
 
-	FCellularAutomataGridData Result;
-	Result.Grid = MoveTemp(Grid);
-	Result.RegionIds = MoveTemp(RegionIds);
-	Result.Regions = MoveTemp(Regions);
-	Result.SurvivingRegions = MoveTemp(SurvivingRegions);
 	Result.CenterRegionId = CenterRegionId;
 	Result.GridWidth = GWidth;
 	Result.GridHeight = GHeight;
 	Result.CellSize = CellSizeVal;
 	Result.bDegradedResolution = bDegradedResolution;
-	Result.Diagram = MoveTemp(Diagram);
+}
+
+int32 UCellularAutomataGenerator2D::FindNearestRegionId(
+	const TArray<int32>& RegionIds, int32 InGridWidth, int32 InGridHeight, int32 CenterX, int32 CenterY)
+{
+	// Walk square (Chebyshev) rings outward from the center. Every cell on ring R is at least R*R away (squared, in
+	// cells), so once a floor cell at BestDistSq is known, rings with R*R > BestDistSq cannot beat it. Ties at equal
+	// distance go to the lowest region ID — the winner of a scan over regions in ID order with a strict '<'.
+	const int32 MaxRadius =
+		FMath::Max(FMath::Max(CenterX, InGridWidth - 1 - CenterX), FMath::Max(CenterY, InGridHeight - 1 - CenterY));
+
+	int32 BestDistSq = MAX_int32;
+	int32 BestRegion = INDEX_NONE;
+
+	auto Visit = [&](int32 X, int32 Y) {
+		if (X < 0 || X >= InGridWidth || Y < 0 || Y >= InGridHeight)
+		{
+			return;
+		}
+		const int32 RegionId = RegionIds[Y * InGridWidth + X];
+		if (RegionId < 0)
+		{
+			return;
+		}
+		const int32 DistSq = FMath::Square(X - CenterX) + FMath::Square(Y - CenterY);
+		if (DistSq < BestDistSq || (DistSq == BestDistSq && RegionId < BestRegion))
+		{
+			BestDistSq = DistSq;
+			BestRegion = RegionId;
+		}
+	};
+
+	for (int32 R = 0; R <= MaxRadius && static_cast<int64>(R) * R <= BestDistSq; ++R)
+	{
+		if (R == 0)
+		{
+			Visit(CenterX, CenterY);
+			continue;
+		}
+		for (int32 X = CenterX - R; X <= CenterX + R; ++X)
+		{
+			Visit(X, CenterY - R);
+			Visit(X, CenterY + R);
+		}
+		for (int32 Y = CenterY - R + 1; Y <= CenterY + R - 1; ++Y)
+		{
+			Visit(CenterX - R, Y);
+			Visit(CenterX + R, Y);
+		}
+	}
 
-	return Result;
+	return BestRegion;
 }
 
 void UCellularAutomataGenerator2D::CarveCorridors(FCellularAutomataGridData& GridData, float Probability, int32 Width, FRandomStream& InRandomStream)
@@ -357,8 +505,10 @@ void UCellularAutomataGenerator2D::CarveCorridors(FCellularAutomataGridData& Gri
 
 	Width = FMath::Max(1, Width);
 
+	FMemMark Mark(FMemStack::Get());
+
 	// Identify surviving region indices
-	TArray<int32> SurvivingIds;
+	TFrameArray<int32> SurvivingIds;
 	for (int32 i = 0; i < GridData.SurvivingRegions.Num(); ++i)
 	{
 		if (GridData.SurvivingRegions[i])
@@ -374,7 +524,7 @@ void UCellularAutomataGenerator2D::CarveCorridors(FCellularAutomataGridData& Gri
 	}
 
 	// Build neighbor set from current diagram for surviving regions
-	TMap<int32, int32> RegionToDiagramCell;
+	TFrameMap<int32, int32> RegionToDiagramCell;
 	for (int32 CellIdx = 0; CellIdx < GridData.Diagram.Cells.Num(); ++CellIdx)
 	{
 		// Map by finding which surviving region index this diagram cell corresponds to
@@ -386,7 +536,7 @@ void UCellularAutomataGenerator2D::CarveCorridors(FCellularAutomataGridData& Gri
 	}
 
 	// Find disconnected pairs (surviving regions that are NOT neighbors in the diagram)
-	TSet<TPair<int32, int32>> ConnectedPairs;
+	TFrameSet<TPair<int32, int32>> ConnectedPairs;
 	for (int32 CellIdx = 0; CellIdx < GridData.Diagram.Cells.Num(); ++CellIdx)
 	{
 		for (int32 NeighborIdx : GridData.Diagram.Cells[CellIdx].Neighbors)
@@ -397,8 +547,16 @@ void UCellularAutomataGenerator2D::CarveCorridors(FCellularAutomataGridData& Gri
 		}
 	}
 
-	int32 CorridorsCarved = 0;
-
+	// Pick the pairs first, in the same order and with the same draws as carving them one by one: the closest-pair
+	// search reads only the region cell lists, which carving does not change, so it can be batched per target region.
+	struct FCorridor
+	{
+		int32	  RegionIdA;
+		int32	  RegionIdB;
+		FIntPoint BestA;
+		FIntPoint BestB;
+	};
+	TFrameArray<FCorridor> Corridors;
 	for (int32 a = 0; a < SurvivingIds.Num(); ++a)
 	{
 		for (int32 b = a + 1; b < SurvivingIds.Num(); ++b)
@@ -426,87 +584,145 @@ void UCellularAutomataGenerator2D::CarveCorridors(FCellularAutomataGridData& Gri
 				continue;
 			}
 
-			// Find nearest cells between the two regions
-			const int32				 RegionIdA = SurvivingIds[a];
-			const int32				 RegionIdB = SurvivingIds[b];
-			const TArray<FIntPoint>& RegionCellsA = GridData.Regions[RegionIdA];
-			const TArray<FIntPoint>& RegionCellsB = GridData.Regions[RegionIdB];
+			Corridors.Add({ SurvivingIds[a], SurvivingIds[b], FIntPoint(0, 0), FIntPoint(0, 0) });
+		}
+	}
 
-			// Find the closest pair of cells between the two regions
-			float	  BestDistSq = FLT_MAX;
-			FIntPoint BestA(0, 0);
-			FIntPoint BestB(0, 0);
+	// Find the closest pair of cells between the two regions: the first A cell at the minimum distance, then the first
+	// B cell at that distance from it. Past a grid's worth of pairs, a distance transform from B's cells replaces the
+	// |A|*|B| scan; it is computed once per target region and shared by every corridor into it. Both pick the same pair.
+	const int32		   NumGridCells = GridData.GridWidth * GridData.GridHeight;
+	TFrameArray<int32> ByTarget;
+	for (int32 i = 0; i < Corridors.Num(); ++i)
+	{
+		FCorridor&				 Corridor = Corridors[i];
+		const TArray<FIntPoint>& RegionCellsA = GridData.Regions[Corridor.RegionIdA];
+		const TArray<FIntPoint>& RegionCellsB = GridData.Regions[Corridor.RegionIdB];
+		if (static_cast<int64>(RegionCellsA.Num()) * RegionCellsB.Num() > NumGridCells)
+		{
+			ByTarget.Add(i);
+			continue;
+		}
 
-			for (const FIntPoint& CellPtA : RegionCellsA)
+		int32 BestDistSq = MAX_int32;
+		for (const FIntPoint& CellPtA : RegionCellsA)
+		{
+			for (const FIntPoint& CellPtB : RegionCellsB)
 			{
-				for (const FIntPoint& CellPtB : RegionCellsB)
+				const int32 DistSq = FMath::Square(CellPtA.X - CellPtB.X) + FMath::Square(CellPtA.Y - CellPtB.Y);
+				if (DistSq < BestDistSq)
 				{
-					const float DistSq = static_cast<float>(FMath::Square(CellPtA.X - CellPtB.X) + FMath::Square(CellPtA.Y - CellPtB.Y));
+					BestDistSq = DistSq;
+					Corridor.BestA = CellPtA;
+					Corridor.BestB = CellPtB;
+				}
+			}
+		}
+	}
+
+	if (ByTarget.Num() > 0)
+	{
+		ByTarget.Sort([&Corridors](const int32 L, const int32 R) { return Corridors[L].RegionIdB < Corridors[R].RegionIdB; });
+
+		TArray<bool>  RegionMask;
+		TArray<int32> DistSqToRegion;
+		RegionMask.Init(false, NumGridCells);
+		for (int32 First = 0; First < ByTarget.Num();)
+		{
+			const int32				 RegionIdB = Corridors[ByTarget[First]].RegionIdB;
+			const TArray<FIntPoint>& RegionCellsB = GridData.Regions[RegionIdB];
+			for (const FIntPoint& CellPtB : RegionCellsB)
+			{
+				RegionMask[CellPtB.Y * GridData.GridWidth + CellPtB.X] = true;
+			}
+			FGeometryUtils::DistanceTransformSq(RegionMask, GridData.GridWidth, GridData.GridHeight, DistSqToRegion);
+			for (const FIntPoint& CellPtB : RegionCellsB)
+			{
+				RegionMask[CellPtB.Y * GridData.GridWidth + CellPtB.X] = false;
+			}
+
+			int32 Last = First;
+			for (; Last < ByTarget.Num() && Corridors[ByTarget[Last]].RegionIdB == RegionIdB; ++Last)
+			{
+				FCorridor& Corridor = Corridors[ByTarget[Last]];
+				int32	   BestDistSq = MAX_int32;
+				for (const FIntPoint& CellPtA : GridData.Regions[Corridor.RegionIdA])
+				{
+					const int32 DistSq = DistSqToRegion[CellPtA.Y * GridData.GridWidth + CellPtA.X];
 					if (DistSq < BestDistSq)
 					{
 						BestDistSq = DistSq;
-						BestA = CellPtA;
-						BestB = CellPtB;
+						Corridor.BestA = CellPtA;
+					}
+				}
+				for (const FIntPoint& CellPtB : RegionCellsB)
+				{
+					if (FMath::Square(Corridor.BestA.X - CellPtB.X) + FMath::Square(Corridor.BestA.Y - CellPtB.Y) == BestDistSq)
+					{
+						Corridor.BestB = CellPtB;
+						break;
 					}
 				}
 			}
+			First = Last;
+		}
+	}
 
-			// Carve a straight-line corridor from BestA to BestB
-			const int32 HalfWidth = Width / 2;
-
-			// Bresenham-like line from BestA to BestB
-			int32		X0 = BestA.X, Y0 = BestA.Y;
-			int32		X1 = BestB.X, Y1 = BestB.Y;
-			const int32 DX = FMath::Abs(X1 - X0);
-			const int32 DY = -FMath::Abs(Y1 - Y0);
-			const int32 SX = X0 < X1 ? 1 : -1;
-			const int32 SY = Y0 < Y1 ? 1 : -1;
-			int32		Err = DX + DY;
+	// Carve in pair order: where corridors overlap, the first one claims the cells.
+	const int32 HalfWidth = Width / 2;
+	for (const FCorridor& Corridor : Corridors)
+	{
+		// Bresenham-like line from BestA to BestB
+		int32		X0 = Corridor.BestA.X, Y0 = Corridor.BestA.Y;
+		int32		X1 = Corridor.BestB.X, Y1 = Corridor.BestB.Y;
+		const int32 DX = FMath::Abs(X1 - X0);
+		const int32 DY = -FMath::Abs(Y1 - Y0);
+		const int32 SX = X0 < X1 ? 1 : -1;
+		const int32 SY = Y0 < Y1 ? 1 : -1;
+		int32		Err = DX + DY;
 
-			while (true)
+		while (true)
+		{
+			// Carve a band of width cells centered on (X0, Y0)
+			for (int32 OffY = -HalfWidth; OffY <= HalfWidth; ++OffY)
 			{
-				// Carve a band of width cells centered on (X0, Y0)
-				for (int32 OffY = -HalfWidth; OffY <= HalfWidth; ++OffY)
+				for (int32 OffX = -HalfWidth; OffX <= HalfWidth; ++OffX)
 				{
-					for (int32 OffX = -HalfWidth; OffX <= HalfWidth; ++OffX)
-					{
-						const int32 CX = X0 + OffX;
-						const int32 CY = Y0 + OffY;
+					const int32 CX = X0 + OffX;
+					const int32 CY = Y0 + OffY;
 
-						// Stay within bounds, keep boundary walls intact
-						if (CX > 0 && CX < GridData.GridWidth - 1 && CY > 0 && CY < GridData.GridHeight - 1)
+					// Stay within bounds, keep boundary walls intact
+					if (CX > 0 && CX < GridData.GridWidth - 1 && CY > 0 && CY < GridData.GridHeight - 1)
+					{
+						const int32 Idx = CY * GridData.GridWidth + CX;
+						if (!GridData.Grid[Idx])
 						{
-							const int32 Idx = CY * GridData.GridWidth + CX;
-							if (!GridData.Grid[Idx])
-							{
-								GridData.Grid[Idx] = true;
-								GridData.RegionIds[Idx] = RegionIdA;
-							}
+							GridData.Grid[Idx] = true;
+							GridData.RegionIds[Idx] = Corridor.RegionIdA;
 						}
 					}
 				}
+			}
 
-				if (X0 == X1 && Y0 == Y1)
-				{
-					break;
-				}
-
-				const int32 E2 = 2 * Err;
-				if (E2 >= DY)
-				{
-					Err += DY;
-					X0 += SX;
-				}
-				if (E2 <= DX)
-				{
-					Err += DX;
-					Y0 += SY;
-				}
+			if (X0 == X1 && Y0 == Y1)
+			{
+				break;
 			}
 
-			++CorridorsCarved;
+			const int32 E2 = 2 * Err;
+			if (E2 >= DY)
+			{
+				Err += DY;
+				X0 += SX;
+			}
+			if (E2 <= DX)
+			{
+				Err += DX;
+				Y0 += SY;
+			}
 		}
 	}
+	const int32 CorridorsCarved = Corridors.Num();
 
 	UE_LOG(LogRoguelikeGeometry,
 		Log,
@@ -533,57 +749,101 @@ void UCellularAutomataGenerator2D::RebuildDiagram(FCellularAutomataGridData& Gri
 
 	GridData.CenterRegionId = NewCenterRegionId;
 
-	GridData.Diagram = BuildDiagramFromRegions(
-		GridData.Grid, GridData.RegionIds, GridData.Regions, GridData.CenterRegionId, GridData.GridWidth, GridData.GridHeight);
+	// Culled cells are already walls in a materialised Grid, so every region of the fresh flood fill survives.
+	GridData.SurvivingRegions.Init(true, GridData.Regions.Num());
+
+	FCellularAutomataScratch Scratch;
+	BuildDiagramFromRegions(GridData.SurvivingRegions,
+		GridData.RegionIds,
+		GridData.Regions,
+		GridData.CenterRegionId,
+		GridData.GridWidth,
+		GridData.GridHeight,
+		GridData.CellSize,
+		GridData.RegionGraph,
+		GridData.Diagram,
+		Scratch);
 
 	UE_LOG(LogRoguelikeGeometry, Log, TEXT("[CA] RebuildDiagram: produced %d cells"), GridData.Diagram.Cells.Num());
 }
 
-FLayoutDiagram2D UCellularAutomataGenerator2D::BuildDiagramFromRegions(const TArray<bool>& Grid,
-	const TArray<int32>&																   RegionIds,
-	const TArray<TArray<FIntPoint>>&													   Regions,
-	int32																				   CenterRegionId,
-	int32																				   InGridWidth,
-	int32																				   InGridHeight)
+void UCellularAutomataGenerator2D::BuildDiagramFromRegions(const TArray<bool>& SurvivingRegions,
+	const TArray<int32>&													   RegionIds,
+	const TArray<TArray<FIntPoint>>&										   Regions,
+	int32																	   CenterRegionId,
+	int32																	   InGridWidth,
+	int32																	   InGridHeight,
+	float																	   CellSize,
+	FCellularAutomataRegionGraph&											   OutRegionGraph,
+	FLayoutDiagram2D&														   Diagram,
+	FCellularAutomataScratch&												   Scratch)
 {
-	const float CellSize = static_cast<float>(GridSize);
+	OutRegionGraph.Offsets.Reset();
+	OutRegionGraph.Neighbors.Reset();
+	OutRegionGraph.ContactLength.Reset();
+	OutRegionGraph.WallThickness.Reset();
 
-	// Stage 1: Identify surviving regions
-	TMap<int32, int32> RegionToCellIndex;
-	TArray<int32>	   SurvivingRegionIds;
+	// Stage 1: Identify surviving regions (RegionToCell: region ID -> diagram cell index, INDEX_NONE if culled)
+	TArray<int32>& RegionToCell = Scratch.RegionToCell;
+	TArray<int32>& SurvivingRegionIds = Scratch.SurvivingRegionIds;
+	InitReusing(RegionToCell, INDEX_NONE, Regions.Num());
+	SurvivingRegionIds.Reset();
 
 	for (int32 RegionId = 0; RegionId < Regions.Num(); ++RegionId)
 	{
-		if (Regions[RegionId].Num() > 0 && Grid[Regions[RegionId][0].Y * InGridWidth + Regions[RegionId][0].X])
+		if (Regions[RegionId].Num() > 0 && SurvivingRegions[RegionId])
 		{
-			RegionToCellIndex.Add(RegionId, SurvivingRegionIds.Num());
+			RegionToCell[RegionId] = SurvivingRegionIds.Num();
 			SurvivingRegionIds.Add(RegionId);
 		}
 	}
 
-	UE_LOG(LogRoguelikeGeometry, Log, TEXT("[CA] BuildDiagramFromRegions: %d surviving regions"), SurvivingRegionIds.Num());
+	UE_LOG(LogRoguelikeGeometry, Verbose, TEXT("[CA] BuildDiagramFromRegions: %d surviving regions"), SurvivingRegionIds.Num());
 
 	if (SurvivingRegionIds.Num() == 0)
 	{
 		UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[CA] No surviving regions — returning empty diagram"));
-		return FLayoutDiagram2D();
+		Diagram.Cells.Reset();
+		Diagram.Bounds = FBox2D(ForceInit);
+		Diagram.CenterPoint = FVector2D::ZeroVector;
+		Diagram.CenterCellIndex = INDEX_NONE;
+		Diagram.Seed.Reset();
+		Diagram.ResetGridLookup();
+		Diagram.ResetCellBVH();
+		return;
 	}
 
-	// Stage 2: Trace boundaries and build cells
-	FLayoutDiagram2D Diagram;
+	// Stage 2: Trace boundaries and build cells. Cells surviving from a previous call keep their allocations.
 	Diagram.Bounds = Bounds;
 	Diagram.Seed = Seed;
 	Diagram.CenterPoint = CenterPoint;
 	Diagram.CenterCellIndex = INDEX_NONE;
+	Diagram.Cells.SetNum(SurvivingRegionIds.Num(), EAllowShrinking::No);
+
+	const bool			  bSimplify = BoundarySimplifyTolerance > 0.0f;
+	TArray<TArray<bool>>& OutlineLocks = Scratch.OutlineLocks;
+	if (bSimplify)
+	{
+		OutlineLocks.SetNum(SurvivingRegionIds.Num(), EAllowShrinking::No);
+	}
 
 	for (int32 i = 0; i < SurvivingRegionIds.Num(); ++i)
 	{
 		const int32				 RegionId = SurvivingRegionIds[i];
 		const TArray<FIntPoint>& Region = Regions[RegionId];
 
-		FLayoutCell2D Cell;
+		FLayoutCell2D& Cell = Diagram.Cells[i];
 		Cell.CellIndex = i;
-		Cell.Vertices = TraceBoundaryPolygon(Region, RegionIds, RegionId, InGridWidth, InGridHeight, CellSize);
+		TraceBoundaryPolygon(Region,
+			RegionIds,
+			SurvivingRegions,
+			RegionId,
+			InGridWidth,
+			InGridHeight,
+			CellSize,
+			Scratch,
+			Cell.Vertices,
+			bSimplify ? &OutlineLocks[i] : nullptr);
 
 		UE_LOG(LogRoguelikeGeometry,
 			Verbose,
@@ -610,56 +870,171 @@ FLayoutDiagram2D UCellularAutomataGenerator2D::BuildDiagramFromRegions(const TAr
 		Cell.Center = CenterSum / static_cast<float>(Region.Num());
 		Cell.bIsExterior = bTouchesBoundary;
 
-		Diagram.Cells.Add(Cell);
-
 		if (RegionId == CenterRegionId)
 		{
-			Diagram.CenterCellIndex = Diagram.Cells.Num() - 1;
+			Diagram.CenterCellIndex = i;
+		}
+	}
+
+	// Optional Douglas-Peucker pass over every outline at once. Corners where regions touch (or an outline pinches)
+	// are pinned, a boundary run walked by two outlines is simplified once for both, and any run whose result would
+	// cross, flip or swallow another outline is redone at a finer tolerance, so the tolerance needs no cap.
+	if (bSimplify)
+	{
+		TArray<TArray<FVector2D>*>& Outlines = Scratch.Outlines;
+		Outlines.Reset();
+		for (FLayoutCell2D& Cell : Diagram.Cells)
+		{
+			Outlines.Add(&Cell.Vertices);
 		}
+		FGeometryUtils::SimplifyPolygonSetDouglasPeucker(
+			Outlines, BoundarySimplifyTolerance, TArrayView<const TArray<bool>>(OutlineLocks.GetData(), Outlines.Num()));
 	}
 
-	// Stage 3: Compute region neighbors via wall cells
+	// Stage 3: Region adjacency graph. One linear pass over wall cells emits a packed (CellA, CellB, straight) key per
+	// pair of surviving regions the wall cell bridges; the flat key list is radix-sorted, run-length merged into
+	// per-edge contact counts and laid out as CSR. Diagram neighbor lists are slices of the CSR rows.
+	const int32	 NumCells = Diagram.Cells.Num();
+	const int32	 CellBits = FMath::Max(1, static_cast<int32>(FMath::CeilLogTwo(static_cast<uint32>(NumCells))));
+	const uint64 CellMask = (uint64(1) << CellBits) - 1;
+
 	const int32 DX[] = { 1, -1, 0, 0 };
 	const int32 DY[] = { 0, 0, 1, -1 };
 
+	TArray<uint64>& EdgeKeys = Scratch.EdgeKeys;
+	EdgeKeys.Reset();
+	// A cell counts as floor only if its region survived culling; culled pockets behave as walls.
+	auto SurvivingCellAt = [&](int32 Index) -> int32 {
+		const int32 RegionId = RegionIds[Index];
+		return RegionId >= 0 ? RegionToCell[RegionId] : INDEX_NONE;
+	};
+
 	for (int32 Y = 0; Y < InGridHeight; ++Y)
 	{
 		for (int32 X = 0; X < InGridWidth; ++X)
 		{
-			if (Grid[Y * InGridWidth + X])
+			if (SurvivingCellAt(Y * InGridWidth + X) != INDEX_NONE)
 			{
 				continue;
 			}
 
-			TArray<int32, TInlineAllocator<4>> AdjacentCellIndices;
+			int32 AdjacentCells[4];
+			uint8 AdjacentDirs[4];
+			int32 NumAdjacent = 0;
 
 			for (int32 Dir = 0; Dir < 4; ++Dir)
 			{
 				const int32 NX = X + DX[Dir];
 				const int32 NY = Y + DY[Dir];
 
-				if (NX >= 0 && NX < InGridWidth && NY >= 0 && NY < InGridHeight && Grid[NY * InGridWidth + NX])
+				if (NX < 0 || NX >= InGridWidth || NY < 0 || NY >= InGridHeight)
 				{
-					const int32	 NRegionId = RegionIds[NY * InGridWidth + NX];
-					const int32* CellIdx = RegionToCellIndex.Find(NRegionId);
-					if (CellIdx)
-					{
-						AdjacentCellIndices.AddUnique(*CellIdx);
-					}
+					continue;
+				}
+
+				const int32 CellIdx = SurvivingCellAt(NY * InGridWidth + NX);
+				if (CellIdx == INDEX_NONE)
+				{
+					continue;
+				}
+
+				int32 Slot = 0;
+				while (Slot < NumAdjacent && AdjacentCells[Slot] != CellIdx)
+				{
+					++Slot;
+				}
+				if (Slot == NumAdjacent)
+				{
+					AdjacentCells[NumAdjacent] = CellIdx;
+					AdjacentDirs[NumAdjacent] = 0;
+					++NumAdjacent;
 				}
+				AdjacentDirs[Slot] |= static_cast<uint8>(1 << Dir);
 			}
 
-			for (int32 a = 0; a < AdjacentCellIndices.Num(); ++a)
+			for (int32 a = 0; a < NumAdjacent; ++a)
 			{
-				for (int32 b = a + 1; b < AdjacentCellIndices.Num(); ++b)
+				// Mirror +X/-X and +Y/-Y so a set bit means "the opposite side of this wall cell".
+				const uint8 OppositeOfA = static_cast<uint8>(((AdjacentDirs[a] & 0x5) << 1) | ((AdjacentDirs[a] & 0xA) >> 1));
+				for (int32 b = a + 1; b < NumAdjacent; ++b)
 				{
-					Diagram.Cells[AdjacentCellIndices[a]].Neighbors.AddUnique(AdjacentCellIndices[b]);
-					Diagram.Cells[AdjacentCellIndices[b]].Neighbors.AddUnique(AdjacentCellIndices[a]);
+					const uint64 Lo = static_cast<uint64>(FMath::Min(AdjacentCells[a], AdjacentCells[b]));
+					const uint64 Hi = static_cast<uint64>(FMath::Max(AdjacentCells[a], AdjacentCells[b]));
+					const uint64 bStraight = (OppositeOfA & AdjacentDirs[b]) != 0 ? 1 : 0;
+					EdgeKeys.Add((Lo << (CellBits + 1)) | (Hi << 1) | bStraight);
 				}
 			}
 		}
 	}
 
+	// The sort ping-pongs between the two buffers, so either may end up holding the keys; EdgeKeys always names them.
+	RadixSortKeys(EdgeKeys, Scratch.SortBuffer, 2 * CellBits + 1);
+
+	// Merge runs of the same pair: run length = bridging wall cells, any straight key = wall crossable head-on.
+	using FMergedEdge = FCellularAutomataScratch::FMergedEdge;
+	TArray<FMergedEdge>& Edges = Scratch.Edges;
+	TArray<int32>&		 Degree = Scratch.Degree;
+	Edges.Reset();
+	InitReusing(Degree, 0, NumCells);
+
+	for (int32 k = 0; k < EdgeKeys.Num();)
+	{
+		const uint64 Pair = EdgeKeys[k] >> 1;
+		FMergedEdge	 Edge;
+		Edge.A = static_cast<int32>(Pair >> CellBits);
+		Edge.B = static_cast<int32>(Pair & CellMask);
+		Edge.ContactCells = 0;
+		Edge.bStraight = false;
+		for (; k < EdgeKeys.Num() && (EdgeKeys[k] >> 1) == Pair; ++k)
+		{
+			++Edge.ContactCells;
+			Edge.bStraight |= (EdgeKeys[k] & 1) != 0;
+		}
+		++Degree[Edge.A];
+		++Degree[Edge.B];
+		Edges.Add(Edge);
+	}
+
+	OutRegionGraph.Offsets.SetNumUninitialized(NumCells + 1);
+	OutRegionGraph.Offsets[0] = 0;
+	for (int32 i = 0; i < NumCells; ++i)
+	{
+		OutRegionGraph.Offsets[i + 1] = OutRegionGraph.Offsets[i] + Degree[i];
+	}
+
+	const int32 NumSlots = OutRegionGraph.Offsets[NumCells];
+	OutRegionGraph.Neighbors.SetNumUninitialized(NumSlots);
+	OutRegionGraph.ContactLength.SetNumUninitialized(NumSlots);
+	OutRegionGraph.WallThickness.SetNumUninitialized(NumSlots);
+
+	// Edges are sorted by (A, B), so every row is filled in ascending neighbor order: pairs where the row's cell is
+	// the larger index all precede pairs where it is the smaller one.
+	TArray<int32>& Cursor = Scratch.FillCursor;
+	Cursor.Reset(NumCells);
+	Cursor.Append(OutRegionGraph.Offsets.GetData(), NumCells);
+	for (const FMergedEdge& Edge : Edges)
+	{
+		const float Contact = Edge.ContactCells * CellSize;
+		const float Thickness = Edge.bStraight ? CellSize : 0.0f;
+
+		const int32 SlotA = Cursor[Edge.A]++;
+		OutRegionGraph.Neighbors[SlotA] = Edge.B;
+		OutRegionGraph.ContactLength[SlotA] = Contact;
+		OutRegionGraph.WallThickness[SlotA] = Thickness;
+
+		const int32 SlotB = Cursor[Edge.B]++;
+		OutRegionGraph.Neighbors[SlotB] = Edge.A;
+		OutRegionGraph.ContactLength[SlotB] = Contact;
+		OutRegionGraph.WallThickness[SlotB] = Thickness;
+	}
+
+	for (int32 CellIdx = 0; CellIdx < NumCells; ++CellIdx)
+	{
+		const TArrayView<const int32> Row = OutRegionGraph.GetNeighbors(CellIdx);
+		Diagram.Cells[CellIdx].Neighbors.Reset(Row.Num());
+		Diagram.Cells[CellIdx].Neighbors.Append(Row.GetData(), Row.Num());
+	}
+
 	// Fallback: if center region was culled, find closest cell
 	if (Diagram.CenterCellIndex == INDEX_NONE && Diagram.Cells.Num() > 0)
 	{
@@ -675,16 +1050,34 @@ FLayoutDiagram2D UCellularAutomataGenerator2D::BuildDiagramFromRegions(const TAr
 		}
 	}
 
-	return Diagram;
+	// Region outlines are arbitrary polygons: point lookups go through a hierarchy over their bounds, built on the first one.
+	Diagram.ResetGridLookup();
+	Diagram.ResetCellBVH();
 }
 
-TArray<FVector2D> UCellularAutomataGenerator2D::TraceBoundaryPolygon(
-	const TArray<FIntPoint>& Region, const TArray<int32>& RegionIds, int32 RegionId, int32 InGridWidth, int32 InGridHeight, float InCellSize) const
+void UCellularAutomataGenerator2D::TraceBoundaryPolygon(const TArray<FIntPoint>& Region,
+	const TArray<int32>&													RegionIds,
+	const TArray<bool>&														SurvivingRegions,
+	int32																	RegionId,
+	int32																	InGridWidth,
+	int32																	InGridHeight,
+	float																	InCellSize,
+	FCellularAutomataScratch&												Scratch,
+	TArray<FVector2D>&														OutVertices,
+	TArray<bool>*															OutLocked) const
 {
+	OutVertices.Reset();
+	if (OutLocked)
+	{
+		OutLocked->Reset();
+	}
+
 	// Collect directed boundary edges in grid corner coordinates (CCW, interior on left).
 	// A region can pinch to a single corner, emitting two outgoing edges from it, so allow multiple
 	// outgoing edges per start corner (multimap) and disambiguate during chaining.
-	TMultiMap<FIntPoint, FIntPoint> EdgeMap;
+	TMultiMap<FIntPoint, FIntPoint>& EdgeMap = Scratch.EdgeMap;
+	TArray<FIntPoint>&				 Outgoing = Scratch.Outgoing;
+	EdgeMap.Reset();
 
 	auto IsOutsideRegion = [&](int32 NX, int32 NY) -> bool {
 		if (NX < 0 || NX >= InGridWidth || NY < 0 || NY >= InGridHeight)
@@ -696,9 +1089,9 @@ TArray<FVector2D> UCellularAutomataGenerator2D::TraceBoundaryPolygon(
 
 	auto TryAddEdge = [&](const FIntPoint& Start, const FIntPoint& End) {
 		// Keep both edges from a pinched corner; only skip an exact duplicate of the same directed edge.
-		TArray<FIntPoint> Existing;
-		EdgeMap.MultiFind(Start, Existing);
-		if (!Existing.Contains(End))
+		Outgoing.Reset();
+		EdgeMap.MultiFind(Start, Outgoing);
+		if (!Outgoing.Contains(End))
 		{
 			EdgeMap.Add(Start, End);
 		}
@@ -729,13 +1122,16 @@ TArray<FVector2D> UCellularAutomataGenerator2D::TraceBoundaryPolygon(
 
 	if (EdgeMap.Num() == 0)
 	{
-		return TArray<FVector2D>();
+		return;
 	}
 
 	// Chain edges into closed loops. Track consumed *edges* (not just corners) so a corner shared by two
-	// loops (a pinch) is traversed correctly instead of dropping the second loop.
-	TArray<TArray<FIntPoint>>		  Loops;
-	TSet<TPair<FIntPoint, FIntPoint>> UsedEdges;
+	// loops (a pinch) is traversed correctly instead of dropping the second loop. Loop arrays are reused
+	// across calls; only the first NumLoops are live.
+	TArray<TArray<FIntPoint>>&		   Loops = Scratch.Loops;
+	TSet<TPair<FIntPoint, FIntPoint>>& UsedEdges = Scratch.UsedEdges;
+	int32							   NumLoops = 0;
+	UsedEdges.Reset();
 
 	for (const auto& Edge : EdgeMap)
 	{
@@ -744,16 +1140,21 @@ TArray<FVector2D> UCellularAutomataGenerator2D::TraceBoundaryPolygon(
 			continue;
 		}
 
-		const FIntPoint	  Start = Edge.Key;
-		TArray<FIntPoint> Loop;
-		FIntPoint		  Current = Start;
+		if (NumLoops == Loops.Num())
+		{
+			Loops.AddDefaulted();
+		}
+		const FIntPoint	   Start = Edge.Key;
+		TArray<FIntPoint>& Loop = Loops[NumLoops];
+		FIntPoint		   Current = Start;
+		Loop.Reset();
 
 		while (true)
 		{
 			Loop.Add(Current);
 
 			// Pick the first not-yet-consumed outgoing edge from Current.
-			TArray<FIntPoint> Outgoing;
+			Outgoing.Reset();
 			EdgeMap.MultiFind(Current, Outgoing);
 			FIntPoint Next;
 			bool	  bFound = false;
@@ -781,20 +1182,20 @@ TArray<FVector2D> UCellularAutomataGenerator2D::TraceBoundaryPolygon(
 
 		if (Loop.Num() >= 3 && Current == Start)
 		{
-			Loops.Add(MoveTemp(Loop));
+			++NumLoops;
 		}
 	}
 
-	if (Loops.Num() == 0)
+	if (NumLoops == 0)
 	{
-		return TArray<FVector2D>();
+		return;
 	}
 
 	// Select outer boundary (largest absolute area by shoelace)
 	int32 BestLoopIndex = 0;
 	float BestArea = 0.0f;
 
-	for (int32 i = 0; i < Loops.Num(); ++i)
+	for (int32 i = 0; i < NumLoops; ++i)
 	{
 		const float Area = ComputePolygonArea(Loops[i]);
 		if (Area > BestArea)
@@ -804,7 +1205,47 @@ TArray<FVector2D> UCellularAutomataGenerator2D::TraceBoundaryPolygon(
 		}
 	}
 
-	return SimplifyAndConvert(Loops[BestLoopIndex], InCellSize);
+	if (!OutLocked)
+	{
+		SimplifyAndConvert(Loops[BestLoopIndex], InCellSize, OutVertices);
+		return;
+	}
+
+	// Flag the corners the simplification pass must keep: where this region touches another surviving region or pinches
+	// against itself. Culled regions are wall by now; pinning corners against them would only hold the outline back.
+	TArray<FIntPoint>& Corners = Scratch.Corners;
+	SimplifyAndConvert(Loops[BestLoopIndex], InCellSize, OutVertices, &Corners);
+
+	OutLocked->SetNumUninitialized(Corners.Num(), EAllowShrinking::No);
+	for (int32 i = 0; i < Corners.Num(); ++i)
+	{
+		(*OutLocked)[i] = IsJunctionCorner(Corners[i], RegionIds, SurvivingRegions, RegionId, InGridWidth, InGridHeight);
+	}
+}
+
+bool UCellularAutomataGenerator2D::IsJunctionCorner(const FIntPoint& Corner,
+	const TArray<int32>&												RegionIds,
+	const TArray<bool>&													SurvivingRegions,
+	int32																RegionId,
+	int32																InGridWidth,
+	int32																InGridHeight)
+{
+	// The four cells sharing this grid corner: (-1,-1), (0,-1), (-1,0), (0,0).
+	bool bOwn[4];
+	for (int32 k = 0; k < 4; ++k)
+	{
+		const int32 CX = Corner.X - 1 + (k & 1);
+		const int32 CY = Corner.Y - 1 + (k >> 1);
+		const int32 Id = (CX >= 0 && CX < InGridWidth && CY >= 0 && CY < InGridHeight) ? RegionIds[CY * InGridWidth + CX] : INDEX_NONE;
+		if (Id >= 0 && Id != RegionId && SurvivingRegions.IsValidIndex(Id) && SurvivingRegions[Id])
+		{
+			return true;
+		}
+		bOwn[k] = (Id == RegionId);
+	}
+
+	// Own cells on exactly one diagonal: the outline pinches through this corner.
+	return bOwn[0] == bOwn[3] && bOwn[1] == bOwn[2] && bOwn[0] != bOwn[1];
 }
 
 float UCellularAutomataGenerator2D::ComputePolygonArea(const TArray<FIntPoint>& Loop)
@@ -819,10 +1260,16 @@ float UCellularAutomataGenerator2D::ComputePolygonArea(const TArray<FIntPoint>&
 	return FMath::Abs(Area) * 0.5f;
 }
 
-TArray<FVector2D> UCellularAutomataGenerator2D::SimplifyAndConvert(const TArray<FIntPoint>& Loop, float InCellSize) const
+void UCellularAutomataGenerator2D::SimplifyAndConvert(
+	const TArray<FIntPoint>& Loop, float InCellSize, TArray<FVector2D>& OutVertices, TArray<FIntPoint>* OutCorners) const
 {
-	TArray<FVector2D> Result;
-	const int32		  N = Loop.Num();
+	const int32 N = Loop.Num();
+	OutVertices.Reset();
+
+	if (OutCorners)
+	{
+		OutCorners->Reset();
+	}
 
 	for (int32 i = 0; i < N; ++i)
 	{
@@ -834,9 +1281,11 @@ TArray<FVector2D> UCellularAutomataGenerator2D::SimplifyAndConvert(const TArray<
 
 		if (Cross != 0)
 		{
-			Result.Add(FVector2D(Bounds.Min.X + B.X * InCellSize, Bounds.Min.Y + B.Y * InCellSize));
+			OutVertices.Add(FVector2D(Bounds.Min.X + B.X * InCellSize, Bounds.Min.Y + B.Y * InCellSize));
+			if (OutCorners)
+			{
+				OutCorners->Add(B);
+			}
 		}
 	}
-
-	return Result;
 }
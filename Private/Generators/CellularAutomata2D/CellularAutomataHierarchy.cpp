@@ -0,0 +1,228 @@
+#include "Generators/CellularAutomata2D/CellularAutomataHierarchy.h"
+
+#include "Generators/LayoutFrameArena.h"
+#include "Generators/LayoutGridCodec.h"
+#include "ProceduralGeometry.h"
+
+namespace
+{
+	SIZE_T DiagramAllocatedSize(const FLayoutDiagram2D& Diagram)
+	{
+		SIZE_T Size = Diagram.Cells.GetAllocatedSize();
+		for (const FLayoutCell2D& Cell : Diagram.Cells)
+		{
+			Size += Cell.Vertices.GetAllocatedSize() + Cell.Neighbors.GetAllocatedSize();
+		}
+		if (const FLayoutGridLookup* Lookup = Diagram.GetGridLookup())
+		{
+			Size += Lookup->GridToCellIndex.GetAllocatedSize();
+		}
+		if (const FLayoutCellBVH* BVH = Diagram.GetCellBVH())
+		{
+			Size += BVH->NodeBounds.GetAllocatedSize() + BVH->NodeStart.GetAllocatedSize() + BVH->NodeCount.GetAllocatedSize()
+				+ BVH->CellOrder.GetAllocatedSize();
+		}
+		if (const FLayoutPathFields* Fields = Diagram.GetPathFields())
+		{
+			Size += Fields->HopDistance.GetAllocatedSize() + Fields->Distance.GetAllocatedSize() + Fields->NextHopToSource.GetAllocatedSize()
+				+ Fields->NextHopSlots.GetAllocatedSize();
+		}
+		return Size;
+	}
+} // namespace
+
+FIntPoint FCellularAutomataRegionDetail::GetTile(int32 FineCellIndex) const
+{
+	const FLayoutGridLookup* Lookup = Cells.GetGridLookup();
+	if (!Cells.Cells.IsValidIndex(FineCellIndex) || !Lookup)
+	{
+		return FIntPoint(-1, -1);
+	}
+	const FVector2D Local = (Cells.Cells[FineCellIndex].Center - Lookup->Origin) / Lookup->CellSize;
+	return TileMin + FIntPoint(FMath::FloorToInt32(Local.X), FMath::FloorToInt32(Local.Y));
+}
+
+FCellularAutomataHierarchicalDiagram FCellularAutomataHierarchicalDiagram::Build(const FCellularAutomataGridData& GridData)
+{
+	FCellularAutomataHierarchicalDiagram Out;
+	Out.Regions = GridData.Diagram;
+	Out.RegionGraph = GridData.RegionGraph;
+	Out.GridOrigin = GridData.Diagram.Bounds.Min;
+	Out.CellSize = GridData.CellSize;
+	Out.GridWidth = GridData.GridWidth;
+	Out.GridHeight = GridData.GridHeight;
+	if (!Out.Regions.GetCellBVH())
+	{
+		Out.Regions.BuildCellBVH();
+	}
+
+	// Coarse cells are the non-empty surviving regions in ascending region id, as BuildDiagramFromRegions numbers them.
+	FMemMark		  Mark(FMemStack::Get());
+	TFrameArray<bool> Mask;
+	Out.Blocks.Reserve(Out.Regions.Cells.Num());
+	for (int32 RegionId = 0; RegionId < GridData.Regions.Num(); ++RegionId)
+	{
+		const TArray<FIntPoint>& Region = GridData.Regions[RegionId];
+		if (Region.Num() == 0 || !GridData.SurvivingRegions.IsValidIndex(RegionId) || !GridData.SurvivingRegions[RegionId])
+		{
+			continue;
+		}
+
+		FIntPoint TileMin(MAX_int32, MAX_int32);
+		FIntPoint TileMax(MIN_int32, MIN_int32);
+		for (const FIntPoint& Tile : Region)
+		{
+			TileMin = TileMin.ComponentMin(Tile);
+			TileMax = TileMax.ComponentMax(Tile);
+		}
+
+		FBlock& Block = Out.Blocks.AddDefaulted_GetRef();
+		Block.TileMin = TileMin;
+		Block.Width = TileMax.X - TileMin.X + 1;
+		Block.Height = TileMax.Y - TileMin.Y + 1;
+		Block.NumFineCells = Region.Num();
+
+		Mask.Reset();
+		Mask.SetNumZeroed(Block.Width * Block.Height);
+		for (const FIntPoint& Tile : Region)
+		{
+			Mask[(Tile.Y - TileMin.Y) * Block.Width + (Tile.X - TileMin.X)] = true;
+		}
+		Block.ByteOffset = Out.BlockBytes.Num();
+		FLayoutGridCodec::EncodeGrid(MakeArrayView(Mask), Block.Width, Out.BlockBytes);
+		Block.ByteCount = Out.BlockBytes.Num() - Block.ByteOffset;
+	}
+
+	if (Out.Blocks.Num() != Out.Regions.Cells.Num())
+	{
+		UE_LOG(LogRoguelikeGeometry,
+			Warning,
+			TEXT("[CA] Hierarchy: %d surviving regions but %d diagram cells — diagram is stale (RebuildDiagram?); no fine level."),
+			Out.Blocks.Num(),
+			Out.Regions.Cells.Num());
+		Out.Blocks.Reset();
+		Out.BlockBytes.Reset();
+	}
+	return Out;
+}
+
+bool FCellularAutomataHierarchicalDiagram::DecodeDetail(
+	int32 CoarseCellIndex, TArrayView<const uint8> Bytes, FCellularAutomataRegionDetail& OutDetail) const
+{
+	if (!Blocks.IsValidIndex(CoarseCellIndex))
+	{
+		return false;
+	}
+
+	const FBlock& Block = Blocks[CoarseCellIndex];
+	OutDetail.CoarseCellIndex = CoarseCellIndex;
+	OutDetail.TileMin = Block.TileMin;
+	OutDetail.Width = Block.Width;
+	OutDetail.Height = Block.Height;
+	if (!FLayoutGridCodec::DecodeGrid(Bytes, Block.Width * Block.Height, OutDetail.Floor))
+	{
+		return false;
+	}
+
+	FLayoutDiagram2D& Fine = OutDetail.Cells;
+	const FVector2D	  BoxMin = GridOrigin + FVector2D(Block.TileMin) * CellSize;
+	Fine.Bounds = FBox2D(BoxMin, BoxMin + FVector2D(Block.Width, Block.Height) * CellSize);
+	Fine.Seed = Regions.Seed;
+	Fine.CenterPoint = Regions.Cells[CoarseCellIndex].Center;
+	Fine.ResetPathFields();
+	ULayoutGenerator::BuildGridDiagram(OutDetail.Floor, Block.Width, Block.Height, BoxMin, CellSize, Fine);
+	if (Fine.Cells.Num() != Block.NumFineCells)
+	{
+		return false;
+	}
+
+	// The box edge is not the map edge: only tiles on the map border are exterior.
+	int32 FineIndex = 0;
+	for (int32 Y = 0; Y < Block.Height; ++Y)
+	{
+		for (int32 X = 0; X < Block.Width; ++X)
+		{
+			if (OutDetail.Floor[Y * Block.Width + X])
+			{
+				const FIntPoint Tile = Block.TileMin + FIntPoint(X, Y);
+				Fine.Cells[FineIndex++].bIsExterior = Tile.X == 0 || Tile.Y == 0 || Tile.X == GridWidth - 1 || Tile.Y == GridHeight - 1;
+			}
+		}
+	}
+	return true;
+}
+
+const FCellularAutomataRegionDetail* FCellularAutomataHierarchicalDiagram::LoadDetail(int32 CoarseCellIndex)
+{
+	if (const TUniquePtr<FCellularAutomataRegionDetail>* Loaded = LoadedDetails.Find(CoarseCellIndex))
+	{
+		return Loaded->Get();
+	}
+	if (!Blocks.IsValidIndex(CoarseCellIndex))
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FCellularAutomataRegionDetail> Detail = MakeUnique<FCellularAutomataRegionDetail>();
+	if (!DecodeDetail(CoarseCellIndex, GetBlockBytes(CoarseCellIndex), *Detail))
+	{
+		UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[CA] Hierarchy: block of region cell %d failed to decode."), CoarseCellIndex);
+		return nullptr;
+	}
+	return LoadedDetails.Add(CoarseCellIndex, MoveTemp(Detail)).Get();
+}
+
+void FCellularAutomataHierarchicalDiagram::UnloadDetail(int32 CoarseCellIndex)
+{
+	LoadedDetails.Remove(CoarseCellIndex);
+}
+
+const FCellularAutomataRegionDetail* FCellularAutomataHierarchicalDiagram::FindDetail(int32 CoarseCellIndex) const
+{
+	const TUniquePtr<FCellularAutomataRegionDetail>* Loaded = LoadedDetails.Find(CoarseCellIndex);
+	return Loaded ? Loaded->Get() : nullptr;
+}
+
+bool FCellularAutomataHierarchicalDiagram::FindCellAt(const FVector2D& WorldPos, int32& OutCoarseCell, int32& OutFineCell) const
+{
+	OutCoarseCell = Regions.FindCellAt(WorldPos);
+	OutFineCell = INDEX_NONE;
+	if (OutCoarseCell == INDEX_NONE)
+	{
+		return false;
+	}
+	if (const FCellularAutomataRegionDetail* Detail = FindDetail(OutCoarseCell))
+	{
+		OutFineCell = Detail->Cells.FindCellAt(WorldPos);
+		if (OutFineCell != INDEX_NONE)
+		{
+			return true;
+		}
+	}
+
+	// A region can sit inside another region's outline, so the polygon hit may not own the tile; ask the loaded details.
+	for (const TPair<int32, TUniquePtr<FCellularAutomataRegionDetail>>& Loaded : LoadedDetails)
+	{
+		const int32 FineCell = Loaded.Value->Cells.FindCellAt(WorldPos);
+		if (FineCell != INDEX_NONE)
+		{
+			OutCoarseCell = Loaded.Key;
+			OutFineCell = FineCell;
+			return true;
+		}
+	}
+	return false;
+}
+
+SIZE_T FCellularAutomataHierarchicalDiagram::GetAllocatedSize() const
+{
+	SIZE_T Size = DiagramAllocatedSize(Regions);
+	Size += RegionGraph.Offsets.GetAllocatedSize() + RegionGraph.Neighbors.GetAllocatedSize() + RegionGraph.ContactLength.GetAllocatedSize()
+		+ RegionGraph.WallThickness.GetAllocatedSize();
+	Size += Blocks.GetAllocatedSize() + BlockBytes.GetAllocatedSize() + LoadedDetails.GetAllocatedSize();
+	for (const TPair<int32, TUniquePtr<FCellularAutomataRegionDetail>>& Loaded : LoadedDetails)
+	{
+		Size += sizeof(FCellularAutomataRegionDetail) + Loaded.Value->Floor.GetAllocatedSize() + DiagramAllocatedSize(Loaded.Value->Cells);
+	}
+	return Size;
+}
@@ -56,9 +56,10 @@ void ADrunkardWalk2DVisualizer::OnConstruction(const FTransform& Transform)
 	UDrunkardWalkGenerator2D* Generator = NewObject<UDrunkardWalkGenerator2D>();
 	Generator->SetBounds(Bounds)->SetSeed(Seed)->SetGridSize(GridSize)->SetCenter(Bounds.GetCenter())->ApplyResolvedParams(Params);
 
-	const double		  StartTime = FPlatformTime::Seconds();
-	FDrunkardWalkGridData GridData = Generator->GenerateWithGridData();
-	const double		  GenerationTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	FDrunkardWalkGridData& GridData = LastGridData;
+	const double		   StartTime = FPlatformTime::Seconds();
+	Generator->GenerateWithGridData(GridData, GenerationScratch);
+	const double GenerationTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
 
 	// Clear previous state — FlushDebugStrings is needed separately because
 	// FlushPersistentDebugLines does not clear DrawDebugString text.
@@ -0,0 +1,519 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
+
+/**
+ * Open-addressing table from signed 32x32 tile coordinates to dense tile indices (allocation order).
+ * Shared by the drunkard walk's chunked grids; owners keep their per-tile payloads in parallel arrays
+ * of TileCells entries per tile. Lookups are const and never mutate.
+ */
+class FDrunkardWalkTileIndex
+{
+public:
+	static constexpr int32 TileShift = 5;
+	static constexpr int32 TileSize = 1 << TileShift;
+	static constexpr int32 TileMask = TileSize - 1;
+	static constexpr int32 TileCells = TileSize * TileSize;
+
+	FDrunkardWalkTileIndex() { Reset(); }
+
+	/** Forgets all tiles. The slot table keeps its size, so a reused index does not regrow (or reallocate) it. */
+	void Reset()
+	{
+		TileCoords.Reset();
+		if (Slots.Num() == 0)
+		{
+			Slots.Init(INDEX_NONE, 64);
+		}
+		else
+		{
+			for (int32& Slot : Slots)
+			{
+				Slot = INDEX_NONE;
+			}
+		}
+	}
+
+	int32 NumTiles() const { return TileCoords.Num(); }
+
+	const FIntPoint& GetTileCoord(int32 Tile) const { return TileCoords[Tile]; }
+
+	/** Floor division by TileSize (arithmetic shift rounds toward negative infinity). */
+	static FORCEINLINE FIntPoint TileCoordOf(const FIntPoint& P) { return FIntPoint(P.X >> TileShift, P.Y >> TileShift); }
+
+	static FORCEINLINE int32 LocalIndexOf(const FIntPoint& P) { return ((P.Y & TileMask) << TileShift) | (P.X & TileMask); }
+
+	/** Tile index holding P's tile, or INDEX_NONE. */
+	int32 FindTile(const FIntPoint& P) const
+	{
+		const FIntPoint T = TileCoordOf(P);
+		const uint32	Mask = static_cast<uint32>(Slots.Num() - 1);
+		for (uint32 Slot = HashTile(T) & Mask;; Slot = (Slot + 1) & Mask)
+		{
+			const int32 Tile = Slots[Slot];
+			if (Tile == INDEX_NONE || TileCoords[Tile] == T)
+			{
+				return Tile;
+			}
+		}
+	}
+
+	/** Tile index holding P's tile, allocating it if needed; bOutAdded reports a fresh tile the caller must initialize. */
+	int32 FindOrAddTile(const FIntPoint& P, bool& bOutAdded)
+	{
+		const FIntPoint T = TileCoordOf(P);
+		uint32			Mask = static_cast<uint32>(Slots.Num() - 1);
+		uint32			Slot = HashTile(T) & Mask;
+		for (;; Slot = (Slot + 1) & Mask)
+		{
+			const int32 Tile = Slots[Slot];
+			if (Tile == INDEX_NONE)
+			{
+				break;
+			}
+			if (TileCoords[Tile] == T)
+			{
+				bOutAdded = false;
+				return Tile;
+			}
+		}
+
+		const int32 NewTile = TileCoords.Add(T);
+		Slots[Slot] = NewTile;
+		bOutAdded = true;
+
+		// Keep the load factor at or below one half so probe chains stay short.
+		if (TileCoords.Num() * 2 > Slots.Num())
+		{
+			Slots.Init(INDEX_NONE, Slots.Num() * 2);
+			Mask = static_cast<uint32>(Slots.Num() - 1);
+			for (int32 Tile = 0; Tile < TileCoords.Num(); ++Tile)
+			{
+				uint32 S = HashTile(TileCoords[Tile]) & Mask;
+				while (Slots[S] != INDEX_NONE)
+				{
+					S = (S + 1) & Mask;
+				}
+				Slots[S] = Tile;
+			}
+		}
+		return NewTile;
+	}
+
+private:
+	static FORCEINLINE uint32 HashTile(const FIntPoint& T)
+	{
+		return (static_cast<uint32>(T.X) * 0x9E3779B1u) ^ (static_cast<uint32>(T.Y) * 0x85EBCA77u);
+	}
+
+	TArray<FIntPoint> TileCoords; // tile coordinate per allocated tile
+	TArray<int32>	  Slots;	  // tile index or INDEX_NONE; size is a power of two
+};
+
+/**
+ * Sparse-chunked dense storage for the drunkard walk's floor cells over an unbounded signed grid.
+ * Cells live in 32x32 tiles (type + room type arrays per tile, SoA across tiles) located through
+ * FDrunkardWalkTileIndex, so a lookup is one hash probe plus an array read. Extents are maintained
+ * incrementally as cells are set.
+ *
+ * Absent cells read as EDrunkardWalkCellType::Empty. Const accessors never mutate, so a fully built grid
+ * can be read from several threads at once.
+ */
+class FDrunkardWalkCellGrid
+{
+public:
+	static constexpr int32 TileSize = FDrunkardWalkTileIndex::TileSize;
+	static constexpr int32 TileCells = FDrunkardWalkTileIndex::TileCells;
+
+	FDrunkardWalkCellGrid() { Reset(); }
+
+	void Reset()
+	{
+		Tiles.Reset();
+		Types.Reset();
+		RoomTypes.Reset();
+		NumCells = 0;
+		MinCell = FIntPoint(MAX_int32, MAX_int32);
+		MaxCell = FIntPoint(MIN_int32, MIN_int32);
+	}
+
+	/** Number of floor cells stored. */
+	int32 Num() const { return NumCells; }
+
+	/** Number of allocated TileSize x TileSize tiles (an upper bound on the area the floor occupies). */
+	int32 NumTiles() const { return Tiles.NumTiles(); }
+
+	/** Inclusive bounds of all stored cells; only meaningful when Num() > 0. */
+	const FIntPoint& GetMin() const { return MinCell; }
+	const FIntPoint& GetMax() const { return MaxCell; }
+
+	/** Cell type at P, or EDrunkardWalkCellType::Empty if nothing was stored there. */
+	uint8 Get(const FIntPoint& P) const
+	{
+		const int32 Tile = Tiles.FindTile(P);
+		return Tile == INDEX_NONE ? EDrunkardWalkCellType::Empty : Types[Tile * TileCells + FDrunkardWalkTileIndex::LocalIndexOf(P)];
+	}
+
+	bool Contains(const FIntPoint& P) const { return Get(P) != EDrunkardWalkCellType::Empty; }
+
+	/** Room type index at P (-1 for corridor or absent cells). */
+	int32 GetRoomType(const FIntPoint& P) const
+	{
+		const int32 Tile = Tiles.FindTile(P);
+		return Tile == INDEX_NONE ? INDEX_NONE : RoomTypes[Tile * TileCells + FDrunkardWalkTileIndex::LocalIndexOf(P)];
+	}
+
+	/** Stores Type (Corridor or Room) at P, overwriting any previous value. Returns true if the cell was absent. */
+	bool Set(const FIntPoint& P, uint8 Type, int32 RoomType = INDEX_NONE)
+	{
+		const int32 Index = FindOrAddCell(P);
+		const bool	bAdded = Types[Index] == EDrunkardWalkCellType::Empty;
+		if (bAdded)
+		{
+			TrackNewCell(P);
+		}
+		Types[Index] = Type;
+		RoomTypes[Index] = RoomType;
+		return bAdded;
+	}
+
+	/** Stores Type at P only if the cell is currently absent. Returns true if it was written. */
+	bool SetIfEmpty(const FIntPoint& P, uint8 Type, int32 RoomType = INDEX_NONE)
+	{
+		const int32 Index = FindOrAddCell(P);
+		if (Types[Index] != EDrunkardWalkCellType::Empty)
+		{
+			return false;
+		}
+		TrackNewCell(P);
+		Types[Index] = Type;
+		RoomTypes[Index] = RoomType;
+		return true;
+	}
+
+	/** Calls Func(const FIntPoint& Cell, uint8 Type, int32 RoomType) for every stored cell (tile order, row-major within a tile). */
+	template <typename FuncType>
+	void ForEachCell(FuncType&& Func) const
+	{
+		for (int32 Tile = 0; Tile < Tiles.NumTiles(); ++Tile)
+		{
+			const FIntPoint Base = Tiles.GetTileCoord(Tile) * TileSize;
+			const uint8*	TileTypes = Types.GetData() + Tile * TileCells;
+			const int32*	TileRoomTypes = RoomTypes.GetData() + Tile * TileCells;
+			for (int32 Local = 0; Local < TileCells; ++Local)
+			{
+				if (TileTypes[Local] != EDrunkardWalkCellType::Empty)
+				{
+					const FIntPoint Cell(
+						Base.X + (Local & FDrunkardWalkTileIndex::TileMask), Base.Y + (Local >> FDrunkardWalkTileIndex::TileShift));
+					Func(Cell, TileTypes[Local], TileRoomTypes[Local]);
+				}
+			}
+		}
+	}
+
+private:
+	int32 FindOrAddCell(const FIntPoint& P)
+	{
+		bool		bAdded = false;
+		const int32 Tile = Tiles.FindOrAddTile(P, bAdded);
+		if (bAdded)
+		{
+			Types.AddUninitialized(TileCells);
+			RoomTypes.AddUninitialized(TileCells);
+			FMemory::Memset(Types.GetData() + Tile * TileCells, EDrunkardWalkCellType::Empty, TileCells);
+			FMemory::Memset(RoomTypes.GetData() + Tile * TileCells, 0xFF, TileCells * sizeof(int32)); // INDEX_NONE
+		}
+		return Tile * TileCells + FDrunkardWalkTileIndex::LocalIndexOf(P);
+	}
+
+	void TrackNewCell(const FIntPoint& P)
+	{
+		++NumCells;
+		MinCell.X = FMath::Min(MinCell.X, P.X);
+		MinCell.Y = FMath::Min(MinCell.Y, P.Y);
+		MaxCell.X = FMath::Max(MaxCell.X, P.X);
+		MaxCell.Y = FMath::Max(MaxCell.Y, P.Y);
+	}
+
+	FDrunkardWalkTileIndex Tiles;
+	TArray<uint8>		   Types;	  // TileCells entries per tile, EDrunkardWalkCellType (Empty = absent)
+	TArray<int32>		   RoomTypes; // TileCells entries per tile, room type index (-1 = none)
+	int32				   NumCells = 0;
+	FIntPoint			   MinCell;
+	FIntPoint			   MaxCell;
+};
+
+/**
+ * Committed floor dilated by a Chebyshev radius, kept as a per-cell count over the same signed tiling:
+ * Count(P) is the number of floor cells within Radius of P. Adding a floor cell costs (2R+1)^2 increments,
+ * paid once at commit; a clearance query is then a single read instead of a (2R+1)^2 scan.
+ */
+class FDrunkardWalkNearFloorGrid
+{
+public:
+	static constexpr int32 TileCells = FDrunkardWalkTileIndex::TileCells;
+
+	void Reset(int32 InRadius)
+	{
+		Tiles.Reset();
+		Counts.Reset();
+		Radius = FMath::Max(0, InRadius);
+	}
+
+	int32 GetRadius() const { return Radius; }
+
+	/** Registers a new floor cell (call once per cell). */
+	void AddFloor(const FIntPoint& P)
+	{
+		for (int32 Y = P.Y - Radius; Y <= P.Y + Radius; ++Y)
+		{
+			for (int32 X = P.X - Radius; X <= P.X + Radius; ++X)
+			{
+				const FIntPoint N(X, Y);
+				bool			bAdded = false;
+				const int32		Tile = Tiles.FindOrAddTile(N, bAdded);
+				if (bAdded)
+				{
+					Counts.AddZeroed(TileCells);
+				}
+				++Counts[Tile * TileCells + FDrunkardWalkTileIndex::LocalIndexOf(N)];
+			}
+		}
+	}
+
+	/** Number of floor cells within Radius (Chebyshev) of P. */
+	int32 Count(const FIntPoint& P) const
+	{
+		const int32 Tile = Tiles.FindTile(P);
+		return Tile == INDEX_NONE ? 0 : Counts[Tile * TileCells + FDrunkardWalkTileIndex::LocalIndexOf(P)];
+	}
+
+private:
+	FDrunkardWalkTileIndex Tiles;
+	TArray<int32>		   Counts; // TileCells entries per tile
+	int32				   Radius = 0;
+};
+
+/** Inclusive integer AABB used by the walk's broadphase. */
+struct FDrunkardWalkBox
+{
+	FIntPoint Min;
+	FIntPoint Max;
+
+	bool Intersects(const FDrunkardWalkBox& Other) const
+	{
+		return Min.X <= Other.Max.X && Other.Min.X <= Max.X && Min.Y <= Other.Max.Y && Other.Min.Y <= Max.Y;
+	}
+
+	FDrunkardWalkBox ExpandBy(int32 Amount) const { return { Min - FIntPoint(Amount, Amount), Max + FIntPoint(Amount, Amount) }; }
+
+	/** Grows the box to include P (start from Empty()). */
+	void Include(const FIntPoint& P)
+	{
+		Min = FIntPoint(FMath::Min(Min.X, P.X), FMath::Min(Min.Y, P.Y));
+		Max = FIntPoint(FMath::Max(Max.X, P.X), FMath::Max(Max.Y, P.Y));
+	}
+
+	static FDrunkardWalkBox Empty() { return { FIntPoint(MAX_int32, MAX_int32), FIntPoint(MIN_int32, MIN_int32) }; }
+};
+
+/**
+ * Spatial hash of committed boxes (room rects and straight corridor runs) bucketed by the shared 32x32 tiling.
+ * Each box is linked into every tile it overlaps, so an overlap query touches only the tiles under the query box.
+ */
+class FDrunkardWalkBoxHash
+{
+public:
+	void Reset()
+	{
+		Tiles.Reset();
+		TileHeads.Reset();
+		Entries.Reset();
+		Boxes.Reset();
+		Tags.Reset();
+	}
+
+	int32 Num() const { return Boxes.Num(); }
+
+	/** Adds a box with a caller tag (e.g. owning room index). Returns the box id. */
+	int32 Add(const FDrunkardWalkBox& Box, int32 Tag)
+	{
+		const int32		BoxId = Boxes.Add(Box);
+		const FIntPoint TMin = FDrunkardWalkTileIndex::TileCoordOf(Box.Min);
+		const FIntPoint TMax = FDrunkardWalkTileIndex::TileCoordOf(Box.Max);
+		Tags.Add(Tag);
+		for (int32 TY = TMin.Y; TY <= TMax.Y; ++TY)
+		{
+			for (int32 TX = TMin.X; TX <= TMax.X; ++TX)
+			{
+				bool		bAdded = false;
+				const int32 Tile = Tiles.FindOrAddTile(FIntPoint(TX, TY) * FDrunkardWalkTileIndex::TileSize, bAdded);
+				if (bAdded)
+				{
+					TileHeads.Add(INDEX_NONE);
+				}
+				TileHeads[Tile] = Entries.Add({ BoxId, TileHeads[Tile] });
+			}
+		}
+		return BoxId;
+	}
+
+	/** True if any stored box intersects Query, ignoring boxes whose tag equals IgnoreTag. */
+	bool AnyOverlap(const FDrunkardWalkBox& Query, int32 IgnoreTag = MIN_int32) const
+	{
+		const FIntPoint TMin = FDrunkardWalkTileIndex::TileCoordOf(Query.Min);
+		const FIntPoint TMax = FDrunkardWalkTileIndex::TileCoordOf(Query.Max);
+		for (int32 TY = TMin.Y; TY <= TMax.Y; ++TY)
+		{
+			for (int32 TX = TMin.X; TX <= TMax.X; ++TX)
+			{
+				const int32 Tile = Tiles.FindTile(FIntPoint(TX, TY) * FDrunkardWalkTileIndex::TileSize);
+				for (int32 Entry = Tile == INDEX_NONE ? INDEX_NONE : TileHeads[Tile]; Entry != INDEX_NONE; Entry = Entries[Entry].Next)
+				{
+					const int32 BoxId = Entries[Entry].BoxId;
+					if (Tags[BoxId] != IgnoreTag && Boxes[BoxId].Intersects(Query))
+					{
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+private:
+	struct FEntry
+	{
+		int32 BoxId;
+		int32 Next; // next entry in the same tile, or INDEX_NONE
+	};
+
+	FDrunkardWalkTileIndex	 Tiles;
+	TArray<int32>			 TileHeads; // per tile: first entry or INDEX_NONE
+	TArray<FEntry>			 Entries;
+	TArray<FDrunkardWalkBox> Boxes;
+	TArray<int32>			 Tags;
+};
+
+/**
+ * Epoch-stamped scratch occupancy for the walk's placement attempts, over the same signed tiling.
+ * Each cell carries three stamps: the attempt that laid it as pending geometry, the corridor that
+ * traced it, and the corridor band that covered it last. Starting a new attempt/corridor/band only
+ * bumps a counter, so resets are O(1) and every membership test is one stamp comparison.
+ *
+ * Band serials are global and skip one value at every corridor start, so the first band of a corridor
+ * never sees a "previous band" left over from another corridor.
+ */
+class FDrunkardWalkStampGrid
+{
+public:
+	static constexpr int32 TileCells = FDrunkardWalkTileIndex::TileCells;
+
+	FDrunkardWalkStampGrid() { Reset(); }
+
+	void Reset()
+	{
+		Tiles.Reset();
+		AttemptStamps.Reset();
+		CorridorStamps.Reset();
+		BandStamps.Reset();
+		AttemptEpoch = 1;
+		CorridorEpoch = 1;
+		BandSerial = 2;
+	}
+
+	/** Forgets all pending cells. */
+	void BeginAttempt()
+	{
+		if (++AttemptEpoch == 0)
+		{
+			Rewind(AttemptStamps, AttemptEpoch);
+		}
+	}
+
+	/** Forgets the previous corridor's cells and bands. */
+	void BeginCorridor()
+	{
+		if (++CorridorEpoch == 0)
+		{
+			Rewind(CorridorStamps, CorridorEpoch);
+		}
+		AdvanceBand(2);
+	}
+
+	/** Starts the next band of the current corridor; the band just finished becomes the previous band. */
+	void BeginBand() { AdvanceBand(1); }
+
+	/** Flat index of P's stamps, or INDEX_NONE if no stamp was ever written in its tile (all tests false). */
+	int32 FindCell(const FIntPoint& P) const
+	{
+		const int32 Tile = Tiles.FindTile(P);
+		return Tile == INDEX_NONE ? INDEX_NONE : Tile * TileCells + FDrunkardWalkTileIndex::LocalIndexOf(P);
+	}
+
+	/** Flat index of P's stamps, allocating its tile if needed. */
+	int32 FindOrAddCell(const FIntPoint& P)
+	{
+		bool		bAdded = false;
+		const int32 Tile = Tiles.FindOrAddTile(P, bAdded);
+		if (bAdded)
+		{
+			AttemptStamps.AddZeroed(TileCells);
+			CorridorStamps.AddZeroed(TileCells);
+			BandStamps.AddZeroed(TileCells);
+		}
+		return Tile * TileCells + FDrunkardWalkTileIndex::LocalIndexOf(P);
+	}
+
+	bool IsPending(int32 Cell) const { return AttemptStamps[Cell] == AttemptEpoch; }
+	bool IsCorridor(int32 Cell) const { return CorridorStamps[Cell] == CorridorEpoch; }
+	bool InCurrentOrPreviousBand(int32 Cell) const { return BandSerial - BandStamps[Cell] <= 1; }
+
+	bool IsPending(const FIntPoint& P) const
+	{
+		const int32 Cell = FindCell(P);
+		return Cell != INDEX_NONE && IsPending(Cell);
+	}
+
+	/** Marks P as pending in the current attempt. Returns false if it already was. */
+	bool MarkPending(const FIntPoint& P)
+	{
+		const int32 Cell = FindOrAddCell(P);
+		if (AttemptStamps[Cell] == AttemptEpoch)
+		{
+			return false;
+		}
+		AttemptStamps[Cell] = AttemptEpoch;
+		return true;
+	}
+
+	void MarkCorridor(const FIntPoint& P) { CorridorStamps[FindOrAddCell(P)] = CorridorEpoch; }
+	void MarkBand(const FIntPoint& P) { BandStamps[FindOrAddCell(P)] = BandSerial; }
+
+private:
+	void AdvanceBand(uint32 Step)
+	{
+		BandSerial += Step;
+		if (BandSerial < Step + 2) // wrapped; stale stamps could alias the current band
+		{
+			FMemory::Memzero(BandStamps.GetData(), BandStamps.Num() * sizeof(uint32));
+			BandSerial = 2 + Step;
+		}
+	}
+
+	static void Rewind(TArray<uint32>& Stamps, uint32& Epoch)
+	{
+		FMemory::Memzero(Stamps.GetData(), Stamps.Num() * sizeof(uint32));
+		Epoch = 1;
+	}
+
+	FDrunkardWalkTileIndex Tiles;
+	TArray<uint32>		   AttemptStamps;  // TileCells entries per tile; == AttemptEpoch => pending this attempt
+	TArray<uint32>		   CorridorStamps; // == CorridorEpoch => traced by the current corridor
+	TArray<uint32>		   BandStamps;	   // band serial that last covered the cell
+	uint32				   AttemptEpoch = 1;
+	uint32				   CorridorEpoch = 1;
+	uint32				   BandSerial = 2;
+};
@@ -18,6 +18,7 @@ FDrunkardWalkResolvedParams FDrunkardWalkConfig::Resolve() const
 	Params.MaxPlacementAttemptsPerExit = FMath::Max(1, MaxPlacementAttemptsPerExit);
 	Params.bShuffleRoomOrder = bShuffleRoomOrder;
 	Params.BranchProbability = FMath::Clamp(BranchProbability, 0.0f, 1.0f);
+	Params.bMergeFloorRectangles = bMergeFloorRectangles;
 
 	// Copy and clamp room types; drop zero-weight or degenerate entries.
 	Params.RoomTypes.Reserve(RoomTypes.Num());
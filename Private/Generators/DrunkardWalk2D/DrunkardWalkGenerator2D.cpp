@@ -1,6 +1,16 @@
 #include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
 
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkCellGrid.h"
+#include "Generators/LayoutCache.h"
+#include "Generators/LayoutDiagramCompact.h"
+#include "Generators/LayoutFrameArena.h"
+#include "GeometryUtils/GeometryFunctionLibrary.h"
 #include "ProceduralGeometry.h"
+#include "SeedHashing.h"
+
+#include <atomic>
 
 namespace
 {
@@ -12,12 +22,83 @@ namespace
 	/** A room under construction during the walk, in signed grid coordinates. */
 	struct FWalkRoom
 	{
-		FIntPoint	  Min;	 // footprint min corner (inclusive)
-		int32		  W = 0; // footprint width  (X extent)
-		int32		  H = 0; // footprint height (Y extent)
-		int32		  TypeIndex = -1;
-		int32		  PlacedIndex = -1; // index into PlacedRoomsSigned / PlacedRooms
-		TArray<int32> AvailableSides;	// exit sides not yet attempted (entry side excluded)
+		FIntPoint						   Min;	  // footprint min corner (inclusive)
+		int32							   W = 0; // footprint width  (X extent)
+		int32							   H = 0; // footprint height (Y extent)
+		int32							   TypeIndex = -1;
+		int32							   PlacedIndex = -1; // index into PlacedRoomsSigned / PlacedRooms
+		TArray<int32, TInlineAllocator<4>> AvailableSides;	 // exit sides not yet attempted (entry side excluded)
+	};
+
+	// --- Per-attempt accumulators: a corridor system (main corridor + forks) is traced into these,
+	//     validated for clearance, then committed atomically (or discarded and retried). ---
+	struct FPendingRoom
+	{
+		FIntPoint Min;
+		int32	  W = 0;
+		int32	  H = 0;
+		int32	  TypeIndex = -1;
+		int32	  EntrySide = -1;
+		int32	  PlacedIndex = -1;
+	};
+	struct FPendingRail
+	{
+		int32 RailBegin = 0; // rail points and widths are FAttemptScratch::RailPoints/RailWidths[RailBegin, RailEnd)
+		int32 RailEnd = 0;
+		int32 SourcePlaced = -1;
+		int32 TargetPending = -1;
+	};
+	// Bounds of one straight corridor run or one room laid this attempt, owning PendingCells[CellBegin, CellEnd).
+	struct FPendingBox
+	{
+		FDrunkardWalkBox Box;
+		int32			 CellBegin = 0;
+		int32			 CellEnd = 0;
+		bool			 bRoom = false;
+	};
+
+	// --- Debug counters (summarized at the end) ---
+	struct FAttemptStats
+	{
+		int32 TraceCalls = 0;	   // TraceOne invocations
+		int32 RejectSelfTouch = 0; // corridor would fold onto itself
+		int32 RejectRoomFit = 0;   // room edge couldn't cover the corridor end
+		int32 RejectClearance = 0; // candidate touched committed geometry
+		int32 Turns = 0;		   // total corridor bends
+		int32 ForkSeeds = 0;	   // fork opportunities raised
+		int32 ForksPlaced = 0;	   // forks that became rooms
+	};
+
+	// Everything one placement attempt writes. Attempts only read committed geometry (Cells, NearFloor,
+	// CommittedBoxes), so several can run at once, one scratch per worker slot.
+	struct FAttemptScratch
+	{
+		FRandomStream		   Stream; // per-attempt sub-stream
+		TArray<FPendingRoom>   PendingRooms;
+		TArray<FPendingRail>   PendingRails;
+		TArray<FIntPoint>	   RailPoints; // rails of PendingRails, back to back
+		TArray<int32>		   RailWidths; // band width per rail point (parallel to RailPoints)
+		TArray<FIntPoint>	   PendingCorridorCells;
+		TArray<FIntPoint>	   PendingCells; // unique corridor + room cells laid this attempt (clearance iteration)
+		TArray<FPendingBox>	   PendingBoxes; // partitions PendingCells by run/room for the broadphase
+		FDrunkardWalkStampGrid Stamps;		 // pending/corridor/band membership by epoch stamp (collision/clearance)
+		int32				   QueueCursor = 0;
+		FAttemptStats		   Stats;
+
+		void Reset(uint32 StreamKey, int32 InQueueCursor)
+		{
+			Stream.Initialize(static_cast<int32>(StreamKey));
+			PendingRooms.Reset();
+			PendingRails.Reset();
+			RailPoints.Reset();
+			RailWidths.Reset();
+			PendingCorridorCells.Reset();
+			PendingCells.Reset();
+			PendingBoxes.Reset();
+			Stamps.BeginAttempt();
+			QueueCursor = InQueueCursor;
+			Stats = FAttemptStats();
+		}
 	};
 
 	FORCEINLINE bool InRect(const FIntPoint& P, const FIntPoint& Min, int32 W, int32 H)
@@ -54,8 +135,265 @@ namespace
 		}
 		return 3;
 	}
+
+	/**
+	 * Rasterizes floor cells (signed coords, shifted by Offset into the grid-array frame) into sparse tiles. Every tile
+	 * within wall reach of floor is built from a window padded by the wall thickness, dilated for walls and flood-filled
+	 * on its own; components are then joined across tile edges and numbered in row-major order of their first cell,
+	 * which is the order the dense FloodFillRegions scan assigns.
+	 */
+	void RasterizeTiles(const FDrunkardWalkCellGrid& Cells,
+		const FIntPoint&								 Offset,
+		int32											 WallThickness,
+		const FIntPoint&								 CenterCell,
+		FDrunkardWalkTiledGridData&						 Out)
+	{
+		using FTiled = FDrunkardWalkTiledGridData;
+		constexpr int32 TS = FTiled::TileSize;
+		const int32		WT = FMath::Max(1, WallThickness);
+		const int32		TileReach = FMath::DivideAndRoundUp(WT, TS);
+		const int32		Window = TS + 2 * WT;
+
+		FMemMark Mark(FMemStack::Get());
+
+		// Candidate tiles: every tile holding floor, plus those within wall reach of one.
+		TFrameSet<FIntPoint> FloorTiles;
+		FIntPoint			 LastTile(MIN_int32, MIN_int32);
+		Cells.ForEachCell([&](const FIntPoint& Cell, uint8 /*Type*/, int32 /*RoomType*/) {
+			const FIntPoint Tile((Cell.X + Offset.X) >> FTiled::TileShift, (Cell.Y + Offset.Y) >> FTiled::TileShift);
+			if (Tile != LastTile)
+			{
+				FloorTiles.Add(Tile);
+				LastTile = Tile;
+			}
+		});
+		TFrameSet<FIntPoint> Candidates;
+		for (const FIntPoint& Tile : FloorTiles)
+		{
+			for (int32 dy = -TileReach; dy <= TileReach; ++dy)
+			{
+				for (int32 dx = -TileReach; dx <= TileReach; ++dx)
+				{
+					Candidates.Add(Tile + FIntPoint(dx, dy));
+				}
+			}
+		}
+		TFrameArray<FIntPoint> Coords;
+		Coords.Reserve(Candidates.Num());
+		for (const FIntPoint& Tile : Candidates)
+		{
+			Coords.Add(Tile);
+		}
+		Coords.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.Y != B.Y ? A.Y < B.Y : A.X < B.X; });
+
+		// Per tile: cell types with walls, then local 4-connected floor components (labels 0..N-1).
+		TArray<FTiled::FTile> Built; // tiles move into Out, so these stay on the heap
+		TFrameArray<int32>	  LabelCounts;
+		Built.SetNum(Coords.Num());
+		LabelCounts.Init(0, Coords.Num());
+		ParallelFor(Coords.Num(), [&](const int32 i) {
+			FTiled::FTile&	Tile = Built[i];
+			const FIntPoint WindowMin = Coords[i] * TS - Offset - FIntPoint(WT, WT); // signed coords of window cell (0, 0)
+
+			// Window buffers come from this worker's own stack, released when the tile is done.
+			FMemMark		   TileMark(FMemStack::Get());
+			TFrameArray<uint8> Types;
+			TFrameArray<bool>  Floor;
+			TFrameArray<bool>  NearFloor;
+			Types.SetNumUninitialized(Window * Window);
+			Floor.SetNumUninitialized(Window * Window);
+			NearFloor.SetNumUninitialized(Window * Window);
+			for (int32 y = 0; y < Window; ++y)
+			{
+				for (int32 x = 0; x < Window; ++x)
+				{
+					const int32 W = y * Window + x;
+					Types[W] = Cells.Get(WindowMin + FIntPoint(x, y));
+					Floor[W] = Types[W] != EDrunkardWalkCellType::Empty;
+				}
+			}
+			FGeometryUtils::DilateChebyshev(Floor, Window, Window, WT, NearFloor);
+
+			bool bAny = false;
+			Tile.CellType.SetNumUninitialized(FTiled::TileCells);
+			for (int32 y = 0; y < TS; ++y)
+			{
+				for (int32 x = 0; x < TS; ++x)
+				{
+					const int32 W = (y + WT) * Window + (x + WT);
+					const uint8 Type = Floor[W] ? Types[W] : (NearFloor[W] ? EDrunkardWalkCellType::Wall : EDrunkardWalkCellType::Empty);
+					Tile.CellType[y * TS + x] = Type;
+					bAny |= Type != EDrunkardWalkCellType::Empty;
+				}
+			}
+			if (!bAny)
+			{
+				Tile.CellType.Empty();
+				return;
+			}
+			Tile.Coord = Coords[i];
+
+			auto IsFloor = [&Tile](int32 Local) {
+				return Tile.CellType[Local] == EDrunkardWalkCellType::Corridor || Tile.CellType[Local] == EDrunkardWalkCellType::Room;
+			};
+			Tile.RegionIds.Init(-1, FTiled::TileCells);
+			TFrameArray<int32> Stack;
+			int32			   NumLabels = 0;
+			for (int32 Seed = 0; Seed < FTiled::TileCells; ++Seed)
+			{
+				if (!IsFloor(Seed) || Tile.RegionIds[Seed] >= 0)
+				{
+					continue;
+				}
+				Tile.RegionIds[Seed] = NumLabels;
+				Stack.Add(Seed);
+				while (Stack.Num() > 0)
+				{
+					const int32 Local = Stack.Pop(EAllowShrinking::No);
+					const int32 X = Local & (TS - 1);
+					const int32 Y = Local >> FTiled::TileShift;
+					const int32 Neighbors[4] = { X + 1 < TS ? Local + 1 : -1, X > 0 ? Local - 1 : -1, Y + 1 < TS ? Local + TS : -1, Y > 0 ? Local - TS : -1 };
+					for (const int32 N : Neighbors)
+					{
+						if (N >= 0 && IsFloor(N) && Tile.RegionIds[N] < 0)
+						{
+							Tile.RegionIds[N] = NumLabels;
+							Stack.Add(N);
+						}
+					}
+				}
+				++NumLabels;
+			}
+			LabelCounts[i] = NumLabels;
+		});
+
+		// Keep populated tiles; shift local labels into one global label space.
+		int32 NumLabels = 0;
+		for (int32 i = 0; i < Built.Num(); ++i)
+		{
+			if (Built[i].CellType.Num() == 0)
+			{
+				continue;
+			}
+			for (int32& Label : Built[i].RegionIds)
+			{
+				Label = Label >= 0 ? Label + NumLabels : Label;
+			}
+			NumLabels += LabelCounts[i];
+			Out.TileLookup.Add(Built[i].Coord, Out.Tiles.Num());
+			Out.Tiles.Add(MoveTemp(Built[i]));
+		}
+
+		// Join labels that touch across the right and top tile edges (union-find with path halving).
+		TFrameArray<int32> Parent;
+		Parent.SetNumUninitialized(NumLabels);
+		for (int32 Label = 0; Label < NumLabels; ++Label)
+		{
+			Parent[Label] = Label;
+		}
+		auto Find = [&Parent](int32 Label) {
+			while (Parent[Label] != Label)
+			{
+				Parent[Label] = Parent[Parent[Label]];
+				Label = Parent[Label];
+			}
+			return Label;
+		};
+		auto Union = [&](int32 A, int32 B) {
+			if (A >= 0 && B >= 0)
+			{
+				A = Find(A);
+				B = Find(B);
+				Parent[FMath::Max(A, B)] = FMath::Min(A, B);
+			}
+		};
+		for (const FTiled::FTile& Tile : Out.Tiles)
+		{
+			if (const int32* Right = Out.TileLookup.Find(Tile.Coord + FIntPoint(1, 0)))
+			{
+				for (int32 y = 0; y < TS; ++y)
+				{
+					Union(Tile.RegionIds[y * TS + TS - 1], Out.Tiles[*Right].RegionIds[y * TS]);
+				}
+			}
+			if (const int32* Top = Out.TileLookup.Find(Tile.Coord + FIntPoint(0, 1)))
+			{
+				for (int32 x = 0; x < TS; ++x)
+				{
+					Union(Tile.RegionIds[(TS - 1) * TS + x], Out.Tiles[*Top].RegionIds[x]);
+				}
+			}
+		}
+
+		// Number regions by their first cell in row-major (Y, then X) order, as the dense scan does.
+		TFrameArray<int64> FirstKey;
+		TFrameArray<int32> Size;
+		FirstKey.Init(MAX_int64, NumLabels);
+		Size.Init(0, NumLabels);
+		for (const FTiled::FTile& Tile : Out.Tiles)
+		{
+			for (int32 Local = 0; Local < FTiled::TileCells; ++Local)
+			{
+				if (Tile.RegionIds[Local] >= 0)
+				{
+					const int32 Root = Find(Tile.RegionIds[Local]);
+					const int64 X = Tile.Coord.X * TS + (Local & (TS - 1));
+					const int64 Y = Tile.Coord.Y * TS + (Local >> FTiled::TileShift);
+					FirstKey[Root] = FMath::Min(FirstKey[Root], (Y << 32) | (X & 0xFFFFFFFF));
+					++Size[Root];
+				}
+			}
+		}
+		TFrameArray<int32> Roots;
+		for (int32 Label = 0; Label < NumLabels; ++Label)
+		{
+			if (Size[Label] > 0)
+			{
+				Roots.Add(Label);
+			}
+		}
+		Roots.Sort([&FirstKey](int32 A, int32 B) { return FirstKey[A] < FirstKey[B]; });
+		TFrameArray<int32> RegionOfRoot;
+		RegionOfRoot.Init(-1, NumLabels);
+		Out.RegionSizes.Reset(Roots.Num());
+		for (const int32 Root : Roots)
+		{
+			RegionOfRoot[Root] = Out.RegionSizes.Add(Size[Root]);
+		}
+		for (FTiled::FTile& Tile : Out.Tiles)
+		{
+			for (int32& Label : Tile.RegionIds)
+			{
+				Label = Label >= 0 ? RegionOfRoot[Find(Label)] : Label;
+			}
+		}
+		Out.CenterRegionId = Out.GetRegionId(CenterCell);
+	}
 } // namespace
 
+struct FDrunkardWalkScratch::FImpl
+{
+	TArray<int32>			   Queue;
+	FDrunkardWalkCellGrid	   Cells;
+	FDrunkardWalkNearFloorGrid NearFloor;
+	FDrunkardWalkBoxHash	   CommittedBoxes;
+	TArray<FWalkRoom>		   OpenRooms;
+	TArray<FWalkRoom>		   PlacedRoomsSigned;
+	TArray<TArray<int32>>	   CorridorWidths; // only the first (number of corridors) entries are live
+	TArray<FAttemptScratch>	   Attempts;
+	TArray<bool>			   DilatedFloor;
+	TArray<int32>			   GroupIds;
+	TArray<int32>			   GridToCellIndex; // compact output's cell numbering
+	FDrunkardWalkGridData	   GridData;		// Generate(FLayoutDiagram2D&, ...) and GenerateCompact work in here
+};
+
+FDrunkardWalkScratch::FDrunkardWalkScratch()
+	: Impl(MakeUnique<FImpl>())
+{
+}
+
+FDrunkardWalkScratch::~FDrunkardWalkScratch() = default;
+
 UDrunkardWalkGenerator2D::UDrunkardWalkGenerator2D()
 {
 	Bounds = FBox2D(FVector2D(-500, -500), FVector2D(500, 500));
@@ -70,6 +408,8 @@ UDrunkardWalkGenerator2D::UDrunkardWalkGenerator2D()
 	MaxPlacementAttemptsPerExit = 8;
 	bShuffleRoomOrder = true;
 	BranchProbability = 0.0f;
+	bMergeFloorRectangles = false;
+	PlacementWorkers = 0;
 	InitializeRandomStream();
 }
 
@@ -166,6 +506,18 @@ UDrunkardWalkGenerator2D* UDrunkardWalkGenerator2D::SetBranchProbability(float I
 	return this;
 }
 
+UDrunkardWalkGenerator2D* UDrunkardWalkGenerator2D::SetMergeFloorRectangles(bool bInMerge)
+{
+	bMergeFloorRectangles = bInMerge;
+	return this;
+}
+
+UDrunkardWalkGenerator2D* UDrunkardWalkGenerator2D::SetPlacementWorkers(int32 InWorkers)
+{
+	PlacementWorkers = FMath::Max(0, InWorkers);
+	return this;
+}
+
 UDrunkardWalkGenerator2D* UDrunkardWalkGenerator2D::ApplyResolvedParams(const FDrunkardWalkResolvedParams& Params)
 {
 	RoomTypes = Params.RoomTypes;
@@ -180,29 +532,132 @@ UDrunkardWalkGenerator2D* UDrunkardWalkGenerator2D::ApplyResolvedParams(const FD
 	MaxPlacementAttemptsPerExit = Params.MaxPlacementAttemptsPerExit;
 	bShuffleRoomOrder = Params.bShuffleRoomOrder;
 	BranchProbability = Params.BranchProbability;
+	bMergeFloorRectangles = Params.bMergeFloorRectangles;
 	return this;
 }
 
 FLayoutDiagram2D UDrunkardWalkGenerator2D::Generate()
 {
-	return GenerateInternal().Diagram;
+	FLayoutDiagram2D Diagram = FLayoutGenerationCache::Get().FindOrGenerate<FLayoutDiagram2D>(RandomStream,
+		[this] { return MakeCacheKey(TEXT("Diagram")); },
+		[this] {
+			FDrunkardWalkScratch Scratch;
+			GenerateInternal(Scratch.Impl->GridData, Scratch);
+			return MoveTemp(Scratch.Impl->GridData.Diagram);
+		});
+	ApplyDiagramPostPasses(Diagram);
+	return Diagram;
+}
+
+FLayoutDiagramCompact UDrunkardWalkGenerator2D::GenerateCompact()
+{
+	return FLayoutGenerationCache::Get().FindOrGenerate<FLayoutDiagramCompact>(RandomStream,
+		[this] { return MakeCacheKey(TEXT("Compact")); },
+		[this] {
+			FLayoutDiagramCompact Compact;
+			FDrunkardWalkScratch  Scratch;
+			GenerateInternal(Scratch.Impl->GridData, Scratch, nullptr, nullptr, &Compact);
+			return Compact;
+		});
 }
 
 FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateWithGridData()
 {
-	return GenerateInternal();
+	FDrunkardWalkGridData GridData = FLayoutGenerationCache::Get().FindOrGenerate<FDrunkardWalkGridData>(RandomStream,
+		[this] { return MakeCacheKey(TEXT("GridData")); },
+		[this] {
+			FDrunkardWalkGridData Result;
+			FDrunkardWalkScratch  Scratch;
+			GenerateInternal(Result, Scratch);
+			return Result;
+		});
+	ApplyDiagramPostPasses(GridData.Diagram);
+	return GridData;
+}
+
+void UDrunkardWalkGenerator2D::Generate(FLayoutDiagram2D& OutDiagram, FDrunkardWalkScratch& Scratch)
+{
+	if (FLayoutGenerationCache::IsEnabled())
+	{
+		OutDiagram = Generate();
+		return;
+	}
+
+	// Build straight into the caller's diagram: swapping only exchanges allocations.
+	FDrunkardWalkGridData& GridData = Scratch.Impl->GridData;
+	Swap(GridData.Diagram, OutDiagram);
+	GenerateInternal(GridData, Scratch);
+	Swap(GridData.Diagram, OutDiagram);
+	ApplyDiagramPostPasses(OutDiagram);
 }
 
-FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
+void UDrunkardWalkGenerator2D::GenerateCompact(FLayoutDiagramCompact& OutCompact, FDrunkardWalkScratch& Scratch)
 {
-	const double StartTime = FPlatformTime::Seconds();
+	if (FLayoutGenerationCache::IsEnabled())
+	{
+		OutCompact = GenerateCompact();
+		return;
+	}
+	GenerateInternal(Scratch.Impl->GridData, Scratch, nullptr, nullptr, &OutCompact);
+}
+
+void UDrunkardWalkGenerator2D::GenerateWithGridData(FDrunkardWalkGridData& OutGridData, FDrunkardWalkScratch& Scratch)
+{
+	if (FLayoutGenerationCache::IsEnabled())
+	{
+		OutGridData = GenerateWithGridData();
+		return;
+	}
+	GenerateInternal(OutGridData, Scratch);
+	ApplyDiagramPostPasses(OutGridData.Diagram);
+}
+
+FString UDrunkardWalkGenerator2D::MakeCacheKey(const TCHAR* Output) const
+{
+	FLayoutCacheKey Key(TEXT("DrunkardWalk2D"), CacheAlgorithmVersion, Output);
+	AddCacheKeyInputs(Key);
+	Key.Add(RoomTypes.Num());
+	for (const FRoomTypeConfig& RoomType : RoomTypes)
+	{
+		Key.Add(RoomType.Tag).Add(RoomType.FootprintWidthCells).Add(RoomType.FootprintHeightCells).Add(RoomType.Weight);
+		Key.Add(RoomType.Min).Add(RoomType.Max);
+	}
+	Key.Add(CorridorLengthMin).Add(CorridorLengthMax).Add(CorridorWidthMin).Add(CorridorWidthMax);
+	Key.Add(CorridorTurnProbability).Add(CorridorBranchProbability).Add(RoomBorderMargin).Add(WallThickness);
+	Key.Add(MaxPlacementAttemptsPerExit).Add(bShuffleRoomOrder).Add(BranchProbability).Add(bMergeFloorRectangles);
+	return Key.ToString();
+}
+
+FDungeonGraph2D UDrunkardWalkGenerator2D::GenerateGraph()
+{
+	FDungeonGraph2D		 Graph;
+	FDrunkardWalkScratch Scratch;
+	GenerateInternal(Scratch.Impl->GridData, Scratch, &Graph);
+	return Graph;
+}
+
+FDrunkardWalkTiledGridData UDrunkardWalkGenerator2D::GenerateTiled()
+{
+	FDrunkardWalkTiledGridData Tiled;
+	FDrunkardWalkScratch	   Scratch;
+	GenerateInternal(Scratch.Impl->GridData, Scratch, nullptr, &Tiled);
+	return Tiled;
+}
+
+void UDrunkardWalkGenerator2D::GenerateInternal(FDrunkardWalkGridData& Result, FDrunkardWalkScratch& Scratch, FDungeonGraph2D* OutGraphOnly,
+	FDrunkardWalkTiledGridData* OutTiled, FLayoutDiagramCompact* OutCompact)
+{
+	const double				 StartTime = FPlatformTime::Seconds();
+	FDrunkardWalkScratch::FImpl& Work = *Scratch.Impl;
+	FMemMark					 FrameMark(FMemStack::Get()); // releases this generation's temporaries in one shot
 
 	// Build the placement queue (type indices expanded by Weight). Optionally shuffled for variety.
-	TArray<int32> Queue = BuildRoomQueue(RoomTypes, bShuffleRoomOrder, RandomStream);
-	const int32	  RequestedRoomCount = Queue.Num();
+	TArray<int32>& Queue = Work.Queue;
+	BuildRoomQueue(RoomTypes, bShuffleRoomOrder, RandomStream, Queue);
+	const int32 RequestedRoomCount = Queue.Num();
 
 	UE_LOG(LogRoguelikeGeometry,
-		Log,
+		Verbose,
 		TEXT("[DW] Generate() — GridSize=%d Seed='%s' RoomTypes=%d RequestedRooms=%d CorridorLen=[%d,%d] Width=[%d,%d] Turn=%.2f CorridorBranch=%.2f "
 			 "Border=%d Wall=%d Attempts=%d Shuffle=%s Branch=%.2f"),
 		GridSize,
@@ -223,33 +678,49 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 
 	float CellSizeVal = static_cast<float>(GridSize);
 
-	auto MakeEmptyResult = [&]() -> FDrunkardWalkGridData {
-		FDrunkardWalkGridData EmptyResult;
-		EmptyResult.CenterRegionId = -1;
-		EmptyResult.RequestedRoomCount = RequestedRoomCount;
-		EmptyResult.GridWidth = 0;
-		EmptyResult.GridHeight = 0;
-		EmptyResult.CellSize = CellSizeVal;
-		return EmptyResult;
+	auto SetEmptyResult = [&]() {
+		Result = FDrunkardWalkGridData();
+		Result.CenterRegionId = -1;
+		Result.RequestedRoomCount = RequestedRoomCount;
+		Result.GridWidth = 0;
+		Result.GridHeight = 0;
+		Result.CellSize = CellSizeVal;
 	};
 
+	if (OutGraphOnly)
+	{
+		*OutGraphOnly = FDungeonGraph2D();
+		OutGraphOnly->RequestedRoomCount = RequestedRoomCount;
+		OutGraphOnly->CellSize = CellSizeVal;
+		OutGraphOnly->AdjacencyOffsets.Add(0);
+	}
+
 	if (RequestedRoomCount == 0)
 	{
 		UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[DW] No room types with positive count — nothing to generate."));
-		return MakeEmptyResult();
+		SetEmptyResult();
+		return;
 	}
 
 	// --- Walk over an unbounded signed integer grid ---
 
-	// Floor cells (corridor + room) keyed by signed position.
-	TMap<FIntPoint, uint8> CellTypeMap;
-	TMap<FIntPoint, int32> CellRoomTypeMap;
+	// Floor cells (corridor + room) by signed position, with the owning room type per room cell.
+	FDrunkardWalkCellGrid& Cells = Work.Cells;
+	Cells.Reset();
+
+	// Committed floor dilated by RoomBorderMargin (per-cell near-floor counts) for O(1) clearance reads.
+	FDrunkardWalkNearFloorGrid& NearFloor = Work.NearFloor;
+	NearFloor.Reset(RoomBorderMargin);
+
+	// Broadphase: committed room rects (tagged with their placed index) and straight corridor runs (INDEX_NONE).
+	FDrunkardWalkBoxHash& CommittedBoxes = Work.CommittedBoxes;
+	CommittedBoxes.Reset();
 
 	auto FootprintW = [&](int32 TypeIdx) { return FMath::Max(1, RoomTypes[TypeIdx].FootprintWidthCells); };
 	auto FootprintH = [&](int32 TypeIdx) { return FMath::Max(1, RoomTypes[TypeIdx].FootprintHeightCells); };
 
-	auto ShuffledSidesExcluding = [&](int32 ExcludeSide) -> TArray<int32> {
-		TArray<int32> Sides;
+	auto ShuffledSidesExcluding = [&](int32 ExcludeSide) {
+		TArray<int32, TInlineAllocator<4>> Sides;
 		for (int32 s = 0; s < 4; ++s)
 		{
 			if (s != ExcludeSide)
@@ -271,22 +742,32 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 			for (int32 dx = 0; dx < R.W; ++dx)
 			{
 				const FIntPoint P(R.Min.X + dx, R.Min.Y + dy);
-				CellTypeMap.Add(P, EDrunkardWalkCellType::Room);
-				CellRoomTypeMap.Add(P, R.TypeIndex);
+				if (Cells.Set(P, EDrunkardWalkCellType::Room, R.TypeIndex))
+				{
+					NearFloor.AddFloor(P);
+				}
 			}
 		}
+		CommittedBoxes.Add({ R.Min, R.Min + FIntPoint(R.W - 1, R.H - 1) }, R.PlacedIndex);
 	};
 
 	// Open rooms = placed rooms that still have an untried exit side. The next room normally grows from
 	// the most-recently-opened room (a single winding path); with BranchProbability it grows from a
 	// random open room instead, creating branch points. Reserve so element references stay stable across Add.
-	TArray<FWalkRoom> OpenRooms;
-	OpenRooms.Reserve(RequestedRoomCount + 1);
-
-	TArray<FWalkRoom>		  PlacedRoomsSigned;
-	TArray<TArray<FIntPoint>> CorridorPolylines;  // center rail per corridor segment (signed)
-	TArray<int32>			  CorridorSourceRoom; // PlacedRoomsSigned index each corridor starts from
-	TArray<int32>			  CorridorTargetRoom; // PlacedRoomsSigned index each corridor leads to
+	TArray<FWalkRoom>& OpenRooms = Work.OpenRooms;
+	OpenRooms.Reset(RequestedRoomCount + 1);
+
+	// Rails are traced straight into the result's WalkerPaths and shifted into the grid-array frame once the grid is
+	// sized. Rail and width arrays left from a previous call are reused in place; NumCorridors of them are live.
+	TArray<FWalkRoom>&			PlacedRoomsSigned = Work.PlacedRoomsSigned;
+	TArray<TArray<FIntPoint>>&	CorridorPolylines = Result.WalkerPaths;		   // center rail per corridor segment (signed)
+	TArray<TArray<int32>>&		CorridorWidths = Work.CorridorWidths;		   // band width per rail point (parallel to CorridorPolylines)
+	TArray<int32>&				CorridorSourceRoom = Result.CorridorSourceRoom; // PlacedRoomsSigned index each corridor starts from
+	TArray<int32>&				CorridorTargetRoom = Result.CorridorTargetRoom; // PlacedRoomsSigned index each corridor leads to
+	int32						NumCorridors = 0;
+	PlacedRoomsSigned.Reset();
+	CorridorSourceRoom.Reset();
+	CorridorTargetRoom.Reset();
 
 	// Place the first room centered on the origin.
 	{
@@ -302,83 +783,64 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 		OpenRooms.Add(First);
 	}
 
-	// --- Per-attempt accumulators: a corridor system (main corridor + forks) is traced into these,
-	//     validated for clearance, then committed atomically (or discarded and retried). ---
-	struct FPendingRoom
+	FAttemptStats Stats;
+	int32		  StatBacktracks = 0; // open-room drops (cornered sources)
+
+	// Attempts for one exit are traced in waves of NumSlots, each on its own sub-stream keyed by (queue position,
+	// attempt, source room, side); the lowest-index success wins, so the layout does not depend on the slot count.
+	const int32 DefaultSlots = FTaskGraphInterface::IsRunning() ? FTaskGraphInterface::Get().GetNumWorkerThreads() + 1 : 1;
+	const int32 NumSlots = FMath::Clamp(PlacementWorkers > 0 ? PlacementWorkers : DefaultSlots, 1, FMath::Max(1, MaxPlacementAttemptsPerExit));
+	const uint32 AttemptSeedBase = RandomStream.GetUnsignedInt();
+	TArray<FAttemptScratch>& Scratches = Work.Attempts;
+	Scratches.SetNum(NumSlots);
+	for (FAttemptScratch& Attempt : Scratches)
 	{
-		FIntPoint Min;
-		int32	  W = 0;
-		int32	  H = 0;
-		int32	  TypeIndex = -1;
-		int32	  EntrySide = -1;
-		int32	  PlacedIndex = -1;
-	};
-	struct FPendingRail
-	{
-		TArray<FIntPoint> Rail;
-		int32			  SourcePlaced = -1;
-		int32			  TargetPending = -1;
-	};
-
-	TArray<FPendingRoom> PendingRooms;
-	TArray<FPendingRail> PendingRails;
-	TArray<FIntPoint>	 PendingCorridorCells;
-	TSet<FIntPoint>		 PendingCellSet; // corridor + room cells laid this attempt (collision/clearance)
-	int32				 LocalQueueCursor = 0;
-
-	auto ResetPending = [&]() {
-		PendingRooms.Reset();
-		PendingRails.Reset();
-		PendingCorridorCells.Reset();
-		PendingCellSet.Reset();
-	};
-
-	// --- Debug counters (summarized at the end) ---
-	int32 StatTraceCalls = 0;	   // TraceOne invocations
-	int32 StatRejectSelfTouch = 0; // corridor would fold onto itself
-	int32 StatRejectRoomFit = 0;   // room edge couldn't cover the corridor end
-	int32 StatRejectClearance = 0; // candidate touched committed geometry
-	int32 StatTurns = 0;		   // total corridor bends
-	int32 StatForkSeeds = 0;	   // fork opportunities raised
-	int32 StatForksPlaced = 0;	   // forks that became rooms
-	int32 StatBacktracks = 0;	   // open-room drops (cornered sources)
+		Attempt.Stamps.Reset();
+	}
 
 	// Traces one corridor (bending + variable width via bounded random walk) from StartOutside heading
 	// InitialDir, then places its room (next from the queue) at the terminal. Appends geometry to the
 	// pending accumulators. When bCollectForks, fork seeds (cell + dir) are appended to OutForkSeeds.
 	// Returns true if the room fit (geometry appended), false otherwise (nothing appended).
-	auto TraceOne = [&](FIntPoint							 StartOutside,
-						FIntPoint							 InitialDir,
-						int32								 InitialWidth,
-						int32								 SourcePlacedForGraph,
-						bool								 bCollectForks,
-						TArray<TPair<FIntPoint, FIntPoint>>& OutForkSeeds) -> bool {
-		if (LocalQueueCursor >= Queue.Num())
+	// Trace buffers live on the calling thread's frame arena, under the mark RunAttempt opens.
+	auto TraceOne = [&](FAttemptScratch&						  A,
+						FIntPoint								  StartOutside,
+						FIntPoint								  InitialDir,
+						int32									  InitialWidth,
+						int32									  SourcePlacedForGraph,
+						bool									  bCollectForks,
+						TFrameArray<TPair<FIntPoint, FIntPoint>>& OutForkSeeds) -> bool {
+		if (A.QueueCursor >= Queue.Num())
 		{
 			return false;
 		}
-		++StatTraceCalls;
-		const int32 MySlot = LocalQueueCursor;
+		++A.Stats.TraceCalls;
+		const int32 MySlot = A.QueueCursor;
 		const int32 MyType = Queue[MySlot];
 		const int32 MyW = FootprintW(MyType);
 		const int32 MyH = FootprintH(MyType);
 
-		const int32 Len = RandomStream.RandRange(CorridorLengthMin, CorridorLengthMax);
+		const int32 Len = A.Stream.RandRange(CorridorLengthMin, CorridorLengthMax);
 
 		FIntPoint Dir = InitialDir;
 		FIntPoint Cur = StartOutside;
 		int32	  Width = FMath::Clamp(InitialWidth, CorridorWidthMin, CorridorWidthMax);
 
-		TArray<FIntPoint>					Rail;
-		TArray<FIntPoint>					MyCells;
-		TArray<FIntPoint>					EndBand;
-		TArray<TPair<FIntPoint, FIntPoint>> ForkSeeds;
+		TFrameArray<FIntPoint>					 Rail;
+		TFrameArray<int32>						 RailWidths;
+		TFrameArray<FIntPoint>					 MyCells;
+		TFrameArray<FIntPoint>					 Band;
+		TFrameArray<FIntPoint>					 EndBand;
+		TFrameArray<TPair<FIntPoint, FIntPoint>> ForkSeeds;
+		TFrameArray<FDrunkardWalkBox>			 RunBoxes;		// one box per straight run, split at each turn
+		TFrameArray<int32>						 RunCellCounts; // MyCells laid by each run (parallel to RunBoxes)
 		Rail.Reserve(Len);
+		RailWidths.Reserve(Len);
+		Band.Reserve(CorridorWidthMax);
 
-		// Self-avoidance: track this corridor's own cells so it can never fold back onto itself (which
+		// Self-avoidance: stamp this corridor's own cells so it can never fold back onto itself (which
 		// would merge bands into a blob). The new band may only touch the immediately previous band.
-		TSet<FIntPoint> SelfSet;
-		TSet<FIntPoint> PrevBandSet;
+		A.Stamps.BeginCorridor();
 
 		// Bends are spaced at least MinSegment cells apart, so corridors read as clean hallways with
 		// occasional corners rather than per-step erosion jitter.
@@ -387,31 +849,32 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 
 		for (int32 k = 0; k < Len; ++k)
 		{
-			if (k > 0 && CorridorTurnProbability > 0.0f && StepsSinceTurn >= MinSegment && RandomStream.FRand() < CorridorTurnProbability)
+			bool bNewRun = (k == 0);
+			if (k > 0 && CorridorTurnProbability > 0.0f && StepsSinceTurn >= MinSegment && A.Stream.FRand() < CorridorTurnProbability)
 			{
-				Dir = TurnDir(Dir, RandomStream.FRand() < 0.5f);
+				Dir = TurnDir(Dir, A.Stream.FRand() < 0.5f);
 				StepsSinceTurn = 0;
-				++StatTurns;
+				++A.Stats.Turns;
+				bNewRun = true;
 			}
 			else
 			{
 				++StepsSinceTurn;
 			}
 
-			if (CorridorWidthMax > CorridorWidthMin && RandomStream.FRand() < 0.5f)
+			if (CorridorWidthMax > CorridorWidthMin && A.Stream.FRand() < 0.5f)
 			{
-				Width = FMath::Clamp(Width + (RandomStream.FRand() < 0.5f ? -1 : 1), CorridorWidthMin, CorridorWidthMax);
+				Width = FMath::Clamp(Width + (A.Stream.FRand() < 0.5f ? -1 : 1), CorridorWidthMin, CorridorWidthMax);
 			}
 
-			const FIntPoint	  Perp = PerpOf(Dir);
-			TArray<FIntPoint> Band;
-			TSet<FIntPoint>	  CurBandSet;
-			Band.Reserve(Width);
+			const FIntPoint Perp = PerpOf(Dir);
+			Band.Reset();
+			A.Stamps.BeginBand();
 			for (int32 j = 0; j < Width; ++j)
 			{
 				const FIntPoint C = Cur + Perp * (j - Width / 2);
 				Band.Add(C);
-				CurBandSet.Add(C);
+				A.Stamps.MarkBand(C);
 			}
 
 			// Reject if the new band folds onto itself or overlaps pending geometry from earlier
@@ -424,44 +887,51 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 				{
 					for (int32 nx = -1; nx <= 1; ++nx)
 					{
-						const FIntPoint N(C.X + nx, C.Y + ny);
-						if (CurBandSet.Contains(N) || PrevBandSet.Contains(N))
+						const int32 N = A.Stamps.FindCell(FIntPoint(C.X + nx, C.Y + ny));
+						if (N == INDEX_NONE || A.Stamps.InCurrentOrPreviousBand(N))
 						{
 							continue;
 						}
-						if (SelfSet.Contains(N))
+						if (A.Stamps.IsCorridor(N))
 						{
-							++StatRejectSelfTouch;
+							++A.Stats.RejectSelfTouch;
 							return false;
 						}
-						if (PendingCellSet.Contains(N))
+						if (A.Stamps.IsPending(N))
 						{
-							++StatRejectClearance;
+							++A.Stats.RejectClearance;
 							return false;
 						}
 					}
 				}
 			}
 
+			if (bNewRun)
+			{
+				RunBoxes.Add(FDrunkardWalkBox::Empty());
+				RunCellCounts.Add(0);
+			}
 			for (const FIntPoint& C : Band)
 			{
-				SelfSet.Add(C);
+				A.Stamps.MarkCorridor(C);
 				MyCells.Add(C);
+				RunBoxes.Last().Include(C);
 			}
+			RunCellCounts.Last() += Band.Num();
 			Rail.Add(Cur);
+			RailWidths.Add(Width);
 			if (k == Len - 1)
 			{
 				EndBand = Band;
 			}
 
-			if (bCollectForks && k > 0 && k < Len - 1 && CorridorBranchProbability > 0.0f && RandomStream.FRand() < CorridorBranchProbability)
+			if (bCollectForks && k > 0 && k < Len - 1 && CorridorBranchProbability > 0.0f && A.Stream.FRand() < CorridorBranchProbability)
 			{
-				const FIntPoint ForkDir = TurnDir(Dir, RandomStream.FRand() < 0.5f);
+				const FIntPoint ForkDir = TurnDir(Dir, A.Stream.FRand() < 0.5f);
 				ForkSeeds.Add(TPair<FIntPoint, FIntPoint>(Cur + ForkDir, ForkDir));
-				++StatForkSeeds;
+				++A.Stats.ForkSeeds;
 			}
 
-			PrevBandSet = MoveTemp(CurBandSet);
 			Cur += Dir;
 		}
 
@@ -483,10 +953,10 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 		const int32 RoomPerpDim = bHorizontal ? MyH : MyW;
 		if (EndSpan > RoomPerpDim)
 		{
-			++StatRejectRoomFit;
+			++A.Stats.RejectRoomFit;
 			return false; // room entry edge can't cover the corridor end
 		}
-		const int32 Q = RandomStream.RandRange(0, RoomPerpDim - EndSpan);
+		const int32 Q = A.Stream.RandRange(0, RoomPerpDim - EndSpan);
 
 		// Place the room on the far side of the end band, along FinalDir.
 		FIntPoint MyMin;
@@ -507,32 +977,66 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 			MyMin = FIntPoint(BMin.X - Q, BMin.Y - MyH);
 		}
 
-		// Reject if the footprint collides with cells already laid this attempt.
-		for (int32 dy = 0; dy < MyH; ++dy)
+		// Reject if the footprint collides with cells already laid this attempt. Pending cells all lie inside
+		// pending boxes, so only the footprint's intersection with each overlapping box needs a per-cell test.
+		const FDrunkardWalkBox Footprint{ MyMin, MyMin + FIntPoint(MyW - 1, MyH - 1) };
+		for (const FPendingBox& PB : A.PendingBoxes)
 		{
-			for (int32 dx = 0; dx < MyW; ++dx)
+			if (!PB.Box.Intersects(Footprint))
+			{
+				continue;
+			}
+			const FIntPoint IMin(FMath::Max(PB.Box.Min.X, Footprint.Min.X), FMath::Max(PB.Box.Min.Y, Footprint.Min.Y));
+			const FIntPoint IMax(FMath::Min(PB.Box.Max.X, Footprint.Max.X), FMath::Min(PB.Box.Max.Y, Footprint.Max.Y));
+			for (int32 y = IMin.Y; y <= IMax.Y; ++y)
 			{
-				if (PendingCellSet.Contains(FIntPoint(MyMin.X + dx, MyMin.Y + dy)))
+				for (int32 x = IMin.X; x <= IMax.X; ++x)
 				{
-					++StatRejectRoomFit;
-					return false;
+					if (A.Stamps.IsPending(FIntPoint(x, y)))
+					{
+						++A.Stats.RejectRoomFit;
+						return false;
+					}
 				}
 			}
 		}
 
 		// Commit into pending accumulators.
-		LocalQueueCursor = MySlot + 1;
-		for (const FIntPoint& C : MyCells)
+		A.QueueCursor = MySlot + 1;
+		int32 CellCursor = 0;
+		for (int32 r = 0; r < RunBoxes.Num(); ++r)
 		{
-			PendingCorridorCells.Add(C);
-			PendingCellSet.Add(C);
+			FPendingBox& RunBox = A.PendingBoxes.AddDefaulted_GetRef();
+			RunBox.Box = RunBoxes[r];
+			RunBox.CellBegin = A.PendingCells.Num();
+			for (const int32 RunEnd = CellCursor + RunCellCounts[r]; CellCursor < RunEnd; ++CellCursor)
+			{
+				const FIntPoint& C = MyCells[CellCursor];
+				A.PendingCorridorCells.Add(C);
+				if (A.Stamps.MarkPending(C))
+				{
+					A.PendingCells.Add(C);
+				}
+			}
+			RunBox.CellEnd = A.PendingCells.Num();
 		}
-		for (int32 dy = 0; dy < MyH; ++dy)
 		{
-			for (int32 dx = 0; dx < MyW; ++dx)
+			FPendingBox& RoomBox = A.PendingBoxes.AddDefaulted_GetRef();
+			RoomBox.Box = Footprint;
+			RoomBox.CellBegin = A.PendingCells.Num();
+			RoomBox.bRoom = true;
+			for (int32 dy = 0; dy < MyH; ++dy)
 			{
-				PendingCellSet.Add(FIntPoint(MyMin.X + dx, MyMin.Y + dy));
+				for (int32 dx = 0; dx < MyW; ++dx)
+				{
+					const FIntPoint P(MyMin.X + dx, MyMin.Y + dy);
+					if (A.Stamps.MarkPending(P))
+					{
+						A.PendingCells.Add(P);
+					}
+				}
 			}
+			RoomBox.CellEnd = A.PendingCells.Num();
 		}
 
 		FPendingRoom PR;
@@ -541,13 +1045,16 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 		PR.H = MyH;
 		PR.TypeIndex = MyType;
 		PR.EntrySide = SideFromDir(FinalDir) ^ 1; // entry side faces back along the corridor
-		const int32 PendingIdx = PendingRooms.Add(PR);
+		const int32 PendingIdx = A.PendingRooms.Add(PR);
 
 		FPendingRail Prail;
-		Prail.Rail = MoveTemp(Rail);
+		Prail.RailBegin = A.RailPoints.Num();
+		A.RailPoints.Append(Rail);
+		A.RailWidths.Append(RailWidths);
+		Prail.RailEnd = A.RailPoints.Num();
 		Prail.SourcePlaced = SourcePlacedForGraph;
 		Prail.TargetPending = PendingIdx;
-		PendingRails.Add(MoveTemp(Prail));
+		A.PendingRails.Add(MoveTemp(Prail));
 
 		if (bCollectForks)
 		{
@@ -611,73 +1118,189 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 					break;
 			}
 
-			for (int32 Attempt = 0; Attempt < MaxPlacementAttemptsPerExit && !bPlaced; ++Attempt)
-			{
-				ResetPending();
-				LocalQueueCursor = QueueIdx;
+			// Committed floor cells in C's margin window that are not part of the source room, from the near-floor count.
+			auto SourceOverlap = [&](const FIntPoint& C) -> int32 {
+				const int32 OX = FMath::Min(C.X + RoomBorderMargin, CurMin.X + CurW - 1) - FMath::Max(C.X - RoomBorderMargin, CurMin.X) + 1;
+				const int32 OY = FMath::Min(C.Y + RoomBorderMargin, CurMin.Y + CurH - 1) - FMath::Max(C.Y - RoomBorderMargin, CurMin.Y) + 1;
+				return (OX > 0 && OY > 0) ? OX * OY : 0;
+			};
+
+			// Exact per-cell clearance: no committed floor within the margin of C, except the source room and cells
+			// this attempt has laid itself.
+			auto CellClear = [&](const FAttemptScratch& A, const FIntPoint& C) -> bool {
+				for (int32 ny = -RoomBorderMargin; ny <= RoomBorderMargin; ++ny)
+				{
+					for (int32 nx = -RoomBorderMargin; nx <= RoomBorderMargin; ++nx)
+					{
+						const FIntPoint N(C.X + nx, C.Y + ny);
+						if (!A.Stamps.IsPending(N) && !InRect(N, CurMin, CurW, CurH) && Cells.Contains(N))
+						{
+							return false;
+						}
+					}
+				}
+				return true;
+			};
+
+			// One placement attempt from this exit: main corridor + room, fork branches, then clearance against
+			// committed geometry. Reads only committed state and writes only A, so attempts can run concurrently.
+			auto RunAttempt = [&](FAttemptScratch& A, int32 Attempt) -> bool {
+				FMemMark AttemptMark(FMemStack::Get()); // trace temporaries of this attempt, on the running thread's stack
+				A.Reset(PGSeed::Mix(PGSeed::Mix(AttemptSeedBase, QueueIdx, Attempt), SourcePlacedIndex, Side), QueueIdx);
 
 				// Choose a starting width that fits the source edge and a band offset along the edge.
-				const int32		StartWidth = RandomStream.RandRange(CorridorWidthMin, FMath::Min(CorridorWidthMax, EdgeLen));
-				const int32		P0 = RandomStream.RandRange(0, EdgeLen - StartWidth);
+				const int32		StartWidth = A.Stream.RandRange(CorridorWidthMin, FMath::Min(CorridorWidthMax, EdgeLen));
+				const int32		P0 = A.Stream.RandRange(0, EdgeLen - StartWidth);
 				const FIntPoint StartOutside = O + Perp * (P0 + StartWidth / 2);
 
 				// Trace the main corridor + room; collect any fork seeds.
-				TArray<TPair<FIntPoint, FIntPoint>> ForkSeeds;
-				if (!TraceOne(StartOutside, Dir, StartWidth, SourcePlacedIndex, true, ForkSeeds))
+				TFrameArray<TPair<FIntPoint, FIntPoint>> ForkSeeds;
+				if (!TraceOne(A, StartOutside, Dir, StartWidth, SourcePlacedIndex, true, ForkSeeds))
 				{
-					continue; // main room didn't fit this attempt
+					return false; // main room didn't fit this attempt
+				}
+
+				// Pre-reject before tracing forks: the main room has to clear committed floor, and a fork could only
+				// help by laying pending cells over that floor. Each attempt draws from its own sub-stream, so skipping
+				// a failed attempt's fork draws changes no other attempt. A near-floor count equal to the source
+				// overlap means nothing else is in reach.
+				const FPendingBox& MainRoomBox = A.PendingBoxes.Last();
+				if (CommittedBoxes.AnyOverlap(MainRoomBox.Box.ExpandBy(RoomBorderMargin), SourcePlacedIndex))
+				{
+					for (int32 i = MainRoomBox.CellBegin; i < MainRoomBox.CellEnd; ++i)
+					{
+						const FIntPoint& C = A.PendingCells[i];
+						if (NearFloor.Count(C) != SourceOverlap(C) && !CellClear(A, C))
+						{
+							++A.Stats.RejectClearance;
+							return false;
+						}
+					}
 				}
 
 				// Trace fork branches (one level deep). Each fork connects back to the same source room.
 				for (const TPair<FIntPoint, FIntPoint>& ForkSeed : ForkSeeds)
 				{
-					if (LocalQueueCursor >= Queue.Num())
+					if (A.QueueCursor >= Queue.Num())
 					{
 						break;
 					}
-					const int32							ForkWidth = RandomStream.RandRange(CorridorWidthMin, CorridorWidthMax);
-					TArray<TPair<FIntPoint, FIntPoint>> Unused;
-					if (TraceOne(ForkSeed.Key, ForkSeed.Value, ForkWidth, SourcePlacedIndex, false, Unused))
+					const int32								 ForkWidth = A.Stream.RandRange(CorridorWidthMin, CorridorWidthMax);
+					TFrameArray<TPair<FIntPoint, FIntPoint>> Unused;
+					if (TraceOne(A, ForkSeed.Key, ForkSeed.Value, ForkWidth, SourcePlacedIndex, false, Unused))
 					{
-						++StatForksPlaced;
+						++A.Stats.ForksPlaced;
 					}
 				}
 
 				// Clearance: every pending cell must keep a RoomBorderMargin gap from committed floor,
 				// except cells of the source room (the door connection is allowed to touch).
-				bool bClear = true;
-				for (const FIntPoint& C : PendingCellSet)
+				// Fast path: the near-floor count of C covers exactly the committed cells in its window; the
+				// source room is all floor, so C is clear iff the count equals the window's overlap with the
+				// source rect. That is exact unless some pending cell sits on committed floor outside the
+				// source room (such a cell is exempt from the scan below), so only then fall back to the scan.
+				// Broadphase: committed floor lies inside committed boxes, so a pending run/room whose box (grown
+				// by the margin) meets no committed box other than the source room is clear without per-cell work.
+				TArray<int32, TInlineAllocator<16>> NearBoxes; // A.PendingBoxes that need per-cell checks
+				bool								bPendingOnFloor = false;
+				for (int32 b = 0; b < A.PendingBoxes.Num(); ++b)
 				{
-					for (int32 ny = -RoomBorderMargin; ny <= RoomBorderMargin && bClear; ++ny)
+					const FPendingBox& PB = A.PendingBoxes[b];
+					if (!CommittedBoxes.AnyOverlap(PB.Box.ExpandBy(RoomBorderMargin), SourcePlacedIndex))
 					{
-						for (int32 nx = -RoomBorderMargin; nx <= RoomBorderMargin; ++nx)
+						continue;
+					}
+					NearBoxes.Add(b);
+					if (!bPendingOnFloor && CommittedBoxes.AnyOverlap(PB.Box, SourcePlacedIndex))
+					{
+						for (int32 i = PB.CellBegin; i < PB.CellEnd; ++i)
 						{
-							const FIntPoint N(C.X + nx, C.Y + ny);
-							if (PendingCellSet.Contains(N) || InRect(N, CurMin, CurW, CurH))
+							if (Cells.Contains(A.PendingCells[i]) && !InRect(A.PendingCells[i], CurMin, CurW, CurH))
 							{
-								continue;
+								bPendingOnFloor = true;
+								break;
 							}
-							if (CellTypeMap.Contains(N))
+						}
+					}
+				}
+
+				bool bClear = true;
+				for (int32 n = 0; n < NearBoxes.Num() && bClear; ++n)
+				{
+					const FPendingBox& PB = A.PendingBoxes[NearBoxes[n]];
+					for (int32 i = PB.CellBegin; i < PB.CellEnd; ++i)
+					{
+						const FIntPoint& C = A.PendingCells[i];
+						const int32 NearCount = NearFloor.Count(C);
+						if (NearCount == 0)
+						{
+							continue;
+						}
+						if (!bPendingOnFloor)
+						{
+							if (NearCount != SourceOverlap(C))
 							{
 								bClear = false;
 								break;
 							}
+							continue;
+						}
+						if (!CellClear(A, C))
+						{
+							bClear = false;
+							break;
 						}
-					}
-					if (!bClear)
-					{
-						break;
 					}
 				}
 
 				if (!bClear)
 				{
-					++StatRejectClearance;
+					++A.Stats.RejectClearance;
+				}
+				return bClear;
+			};
+
+			for (int32 WaveStart = 0; WaveStart < MaxPlacementAttemptsPerExit && !bPlaced; WaveStart += NumSlots)
+			{
+				const int32		   WaveSize = FMath::Min(NumSlots, MaxPlacementAttemptsPerExit - WaveStart);
+				std::atomic<int32> FirstSuccess{ MAX_int32 }; // lowest successful slot in this wave
+
+				ParallelFor(WaveSize, [&](const int32 Slot) {
+					if (Slot > FirstSuccess.load())
+					{
+						return; // a lower-index attempt already won
+					}
+					if (RunAttempt(Scratches[Slot], WaveStart + Slot))
+					{
+						int32 Best = FirstSuccess.load();
+						while (Slot < Best && !FirstSuccess.compare_exchange_weak(Best, Slot))
+						{
+						}
+					}
+				});
+
+				// Stats cover every attempt up to the winner (all of which ran), independent of the slot count.
+				const int32 Winner = FirstSuccess.load();
+				for (int32 Slot = 0; Slot < WaveSize && Slot <= Winner; ++Slot)
+				{
+					const FAttemptStats& S = Scratches[Slot].Stats;
+					Stats.TraceCalls += S.TraceCalls;
+					Stats.RejectSelfTouch += S.RejectSelfTouch;
+					Stats.RejectRoomFit += S.RejectRoomFit;
+					Stats.RejectClearance += S.RejectClearance;
+					Stats.Turns += S.Turns;
+					Stats.ForkSeeds += S.ForkSeeds;
+					Stats.ForksPlaced += S.ForksPlaced;
+				}
+				if (Winner == MAX_int32)
+				{
 					continue;
 				}
 
+				FAttemptScratch& W = Scratches[Winner];
+
 				// Commit: rooms first (assign placed indices in order), then corridors (rooms win), then rails.
-				for (FPendingRoom& PR : PendingRooms)
+				for (FPendingRoom& PR : W.PendingRooms)
 				{
 					FWalkRoom NewRoom;
 					NewRoom.TypeIndex = PR.TypeIndex;
@@ -691,21 +1314,40 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 					PlacedRoomsSigned.Add(NewRoom);
 					OpenRooms.Add(NewRoom); // Reserve prevents realloc — SourceIdx stays valid
 				}
-				for (const FIntPoint& C : PendingCorridorCells)
+				for (const FIntPoint& C : W.PendingCorridorCells)
 				{
-					if (!CellTypeMap.Contains(C)) // never overwrite a room cell
+					if (Cells.SetIfEmpty(C, EDrunkardWalkCellType::Corridor)) // never overwrite a room cell
 					{
-						CellTypeMap.Add(C, EDrunkardWalkCellType::Corridor);
+						NearFloor.AddFloor(C);
 					}
 				}
-				for (const FPendingRail& PRail : PendingRails)
+				for (const FPendingBox& PB : W.PendingBoxes)
 				{
-					CorridorPolylines.Add(PRail.Rail);
+					if (!PB.bRoom)
+					{
+						CommittedBoxes.Add(PB.Box, INDEX_NONE); // rooms were added by StampRoom
+					}
+				}
+				for (const FPendingRail& PRail : W.PendingRails)
+				{
+					if (NumCorridors == CorridorPolylines.Num())
+					{
+						CorridorPolylines.AddDefaulted();
+					}
+					if (NumCorridors == CorridorWidths.Num())
+					{
+						CorridorWidths.AddDefaulted();
+					}
+					const int32 RailNum = PRail.RailEnd - PRail.RailBegin;
+					CorridorPolylines[NumCorridors].Reset();
+					CorridorPolylines[NumCorridors].Append(W.RailPoints.GetData() + PRail.RailBegin, RailNum);
+					CorridorWidths[NumCorridors].Reset();
+					CorridorWidths[NumCorridors].Append(W.RailWidths.GetData() + PRail.RailBegin, RailNum);
+					++NumCorridors;
 					CorridorSourceRoom.Add(PRail.SourcePlaced);
-					CorridorTargetRoom.Add(PendingRooms[PRail.TargetPending].PlacedIndex);
+					CorridorTargetRoom.Add(W.PendingRooms[PRail.TargetPending].PlacedIndex);
 				}
-
-				QueueIdx = LocalQueueCursor;
+				QueueIdx = W.QueueCursor;
 				bPlaced = true;
 			}
 		}
@@ -724,6 +1366,8 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 		}
 	}
 
+	CorridorPolylines.SetNum(NumCorridors, EAllowShrinking::No);
+
 	const int32 PlacedCount = PlacedRoomsSigned.Num();
 	if (PlacedCount < RequestedRoomCount)
 	{
@@ -736,73 +1380,151 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 	}
 
 	UE_LOG(LogRoguelikeGeometry,
-		Log,
+		Verbose,
 		TEXT("[DW] Stats: traceCalls=%d turns=%d forkSeeds=%d forksPlaced=%d | rejects: selfTouch=%d roomFit=%d clearance=%d | backtracks=%d | "
 			 "corridors=%d"),
-		StatTraceCalls,
-		StatTurns,
-		StatForkSeeds,
-		StatForksPlaced,
-		StatRejectSelfTouch,
-		StatRejectRoomFit,
-		StatRejectClearance,
+		Stats.TraceCalls,
+		Stats.Turns,
+		Stats.ForkSeeds,
+		Stats.ForksPlaced,
+		Stats.RejectSelfTouch,
+		Stats.RejectRoomFit,
+		Stats.RejectClearance,
 		StatBacktracks,
 		CorridorPolylines.Num());
 
-	// --- Rasterize signed cells into a final grid sized to actual extents ---
+	if (OutGraphOnly)
+	{
+		// Graph-only: place everything in the full-resolution grid-array frame rasterization would use, then stop.
+		const int32		GraphPad = FMath::Max(1, WallThickness);
+		const FIntPoint GraphOffset(GraphPad - Cells.GetMin().X, GraphPad - Cells.GetMin().Y);
 
-	constexpr int64 MaxCells = 4'194'304;
+		FDungeonGraph2D& Graph = *OutGraphOnly;
+		Graph.Rooms.Reserve(PlacedCount);
+		for (const FWalkRoom& R : PlacedRoomsSigned)
+		{
+			FDrunkardWalkPlacedRoom& PR = Graph.Rooms.AddDefaulted_GetRef();
+			PR.Min = R.Min + GraphOffset;
+			PR.Width = R.W;
+			PR.Height = R.H;
+			PR.TypeIndex = R.TypeIndex;
+		}
 
-	auto ComputeExtents = [&](FIntPoint& OutMin, FIntPoint& OutMax) {
-		OutMin = FIntPoint(MAX_int32, MAX_int32);
-		OutMax = FIntPoint(MIN_int32, MIN_int32);
-		for (const TPair<FIntPoint, uint8>& Pair : CellTypeMap)
+		Graph.Corridors.Reserve(CorridorPolylines.Num());
+		for (int32 i = 0; i < CorridorPolylines.Num(); ++i)
 		{
-			OutMin.X = FMath::Min(OutMin.X, Pair.Key.X);
-			OutMin.Y = FMath::Min(OutMin.Y, Pair.Key.Y);
-			OutMax.X = FMath::Max(OutMax.X, Pair.Key.X);
-			OutMax.Y = FMath::Max(OutMax.Y, Pair.Key.Y);
+			FDungeonGraphCorridor& Corridor = Graph.Corridors.AddDefaulted_GetRef();
+			Corridor.Path.Reserve(CorridorPolylines[i].Num());
+			for (const FIntPoint& P : CorridorPolylines[i])
+			{
+				Corridor.Path.Add(P + GraphOffset);
+			}
+			Corridor.Widths = MoveTemp(CorridorWidths[i]);
+			Corridor.SourceRoom = CorridorSourceRoom[i];
+			Corridor.TargetRoom = CorridorTargetRoom[i];
 		}
-	};
 
-	FIntPoint MinExtent;
-	FIntPoint MaxExtent;
-	ComputeExtents(MinExtent, MaxExtent);
+		// CSR room adjacency: count degrees, prefix-sum, fill, then sort each row by neighbor.
+		Graph.AdjacencyOffsets.Init(0, PlacedCount + 1);
+		for (const FDungeonGraphCorridor& Corridor : Graph.Corridors)
+		{
+			++Graph.AdjacencyOffsets[Corridor.SourceRoom + 1];
+			++Graph.AdjacencyOffsets[Corridor.TargetRoom + 1];
+		}
+		for (int32 i = 0; i < PlacedCount; ++i)
+		{
+			Graph.AdjacencyOffsets[i + 1] += Graph.AdjacencyOffsets[i];
+		}
+		Graph.AdjacentRooms.SetNumUninitialized(Graph.AdjacencyOffsets[PlacedCount]);
+		Graph.AdjacentCorridors.SetNumUninitialized(Graph.AdjacencyOffsets[PlacedCount]);
+		TFrameArray<int32> Fill(Graph.AdjacencyOffsets.GetData(), PlacedCount);
+		for (int32 CorridorIdx = 0; CorridorIdx < Graph.Corridors.Num(); ++CorridorIdx)
+		{
+			const int32 A = Graph.Corridors[CorridorIdx].SourceRoom;
+			const int32 B = Graph.Corridors[CorridorIdx].TargetRoom;
+			Graph.AdjacentRooms[Fill[A]] = B;
+			Graph.AdjacentCorridors[Fill[A]++] = CorridorIdx;
+			Graph.AdjacentRooms[Fill[B]] = A;
+			Graph.AdjacentCorridors[Fill[B]++] = CorridorIdx;
+		}
+		TFrameArray<TPair<int32, int32>> Row;
+		for (int32 RoomIdx = 0; RoomIdx < PlacedCount; ++RoomIdx)
+		{
+			const int32 Begin = Graph.AdjacencyOffsets[RoomIdx];
+			const int32 End = Graph.AdjacencyOffsets[RoomIdx + 1];
+			Row.Reset();
+			for (int32 i = Begin; i < End; ++i)
+			{
+				Row.Emplace(Graph.AdjacentRooms[i], Graph.AdjacentCorridors[i]);
+			}
+			Row.Sort();
+			for (int32 i = Begin; i < End; ++i)
+			{
+				Graph.AdjacentRooms[i] = Row[i - Begin].Key;
+				Graph.AdjacentCorridors[i] = Row[i - Begin].Value;
+			}
+		}
 
-	if (CellTypeMap.Num() == 0)
+		// World frame matches GenerateWithGridData(): the first room's center cell is centered on CenterPoint.
+		const FIntPoint CenterCell(Graph.Rooms[0].Min.X + Graph.Rooms[0].Width / 2, Graph.Rooms[0].Min.Y + Graph.Rooms[0].Height / 2);
+		Graph.WorldOrigin = FVector2D(CenterPoint.X - (CenterCell.X + 0.5f) * CellSizeVal, CenterPoint.Y - (CenterCell.Y + 0.5f) * CellSizeVal);
+
+		UE_LOG(LogRoguelikeGeometry,
+			Verbose,
+			TEXT("[DW] GenerateGraph() complete: %d rooms, %d corridors in %.2fms"),
+			Graph.Rooms.Num(),
+			Graph.Corridors.Num(),
+			(FPlatformTime::Seconds() - StartTime) * 1000.0);
+		SetEmptyResult();
+		return;
+	}
+
+	// --- Rasterize signed cells into a final grid sized to actual extents ---
+
+	constexpr int64 MaxCells = 4'194'304;
+
+	// Extents are tracked by the cell grid as cells are stamped.
+	FIntPoint MinExtent = Cells.GetMin();
+	FIntPoint MaxExtent = Cells.GetMax();
+
+	if (Cells.Num() == 0)
 	{
 		UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[DW] No floor cells produced — nothing to generate."));
-		return MakeEmptyResult();
+		SetEmptyResult();
+		return;
 	}
 
 	bool bDegradedResolution = false;
 
 	// The walk footprint is intrinsic, so we cannot shrink it by retuning bounds. To honor the cell budget we
 	// merge the signed cell map down by an integer factor (combining S*S cells into one) and enlarge the physical
-	// cell size by the same factor, preserving world extents at a coarser resolution.
+	// cell size by the same factor, preserving world extents at a coarser resolution. The tiled raster only stores
+	// blocks near floor, so there the budget applies to the populated tile area instead of the bounding box.
 	{
 		const int32 Pad = FMath::Max(1, WallThickness);
 		const int64 RawWidth = (MaxExtent.X - MinExtent.X + 1) + 2 * Pad;
 		const int64 RawHeight = (MaxExtent.Y - MinExtent.Y + 1) + 2 * Pad;
-		if (RawWidth * RawHeight > MaxCells)
+		const int64 RasterCells = OutTiled ? static_cast<int64>(Cells.NumTiles()) * FDrunkardWalkCellGrid::TileCells : RawWidth * RawHeight;
+		if (RasterCells > MaxCells)
 		{
 			const int32 DownsampleFactor =
-				FMath::CeilToInt(FMath::Sqrt(static_cast<double>(RawWidth) * static_cast<double>(RawHeight) / static_cast<double>(MaxCells)));
+				FMath::CeilToInt(FMath::Sqrt(static_cast<double>(RasterCells) / static_cast<double>(MaxCells)));
 
 			auto CoarsenCoord = [DownsampleFactor](int32 V) { return FMath::FloorToInt(static_cast<float>(V) / DownsampleFactor); };
 
-			TMap<FIntPoint, uint8> CoarseCellTypeMap;
-			CoarseCellTypeMap.Reserve(CellTypeMap.Num());
-			for (const TPair<FIntPoint, uint8>& Pair : CellTypeMap)
-			{
-				const FIntPoint Coarse(CoarsenCoord(Pair.Key.X), CoarsenCoord(Pair.Key.Y));
-				uint8&			Existing = CoarseCellTypeMap.FindOrAdd(Coarse, Pair.Value);
-				if (Pair.Value == EDrunkardWalkCellType::Room)
+			FDrunkardWalkCellGrid CoarseCells;
+			Cells.ForEachCell([&](const FIntPoint& Cell, uint8 Type, int32 RoomType) {
+				const FIntPoint Coarse(CoarsenCoord(Cell.X), CoarsenCoord(Cell.Y));
+				if (Type == EDrunkardWalkCellType::Room)
 				{
-					Existing = EDrunkardWalkCellType::Room; // Room beats Corridor where they collapse together.
+					CoarseCells.Set(Coarse, Type, RoomType); // Room beats Corridor where they collapse together.
 				}
-			}
-			CellTypeMap = MoveTemp(CoarseCellTypeMap);
+				else
+				{
+					CoarseCells.SetIfEmpty(Coarse, Type);
+				}
+			});
+			Cells = MoveTemp(CoarseCells);
 
 			for (FWalkRoom& R : PlacedRoomsSigned)
 			{
@@ -823,11 +1545,13 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 
 			CellSizeVal *= DownsampleFactor;
 			bDegradedResolution = true;
-			ComputeExtents(MinExtent, MaxExtent);
+			MinExtent = Cells.GetMin();
+			MaxExtent = Cells.GetMax();
 
 			UE_LOG(LogRoguelikeGeometry,
 				Warning,
-				TEXT("[DW] Cell budget exceeded: %lldx%lld would exceed %lld cells; degrading by %dx (CellSize=%.1f)."),
+				TEXT("[DW] Cell budget exceeded: %lld raster cells (%lldx%lld extent) would exceed %lld; degrading by %dx (CellSize=%.1f)."),
+				RasterCells,
 				RawWidth,
 				RawHeight,
 				MaxCells,
@@ -841,70 +1565,25 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 	const int32		GWidth = (MaxExtent.X - MinExtent.X + 1) + 2 * Pad;
 	const int32		GHeight = (MaxExtent.Y - MinExtent.Y + 1) + 2 * Pad;
 
-	UE_LOG(LogRoguelikeGeometry, Log, TEXT("[DW] Grid dimensions: %dx%d (%d total cells)"), GWidth, GHeight, GWidth * GHeight);
+	UE_LOG(LogRoguelikeGeometry,
+		Verbose,
+		TEXT("[DW] Grid dimensions: %dx%d (%lld total cells)"),
+		GWidth,
+		GHeight,
+		static_cast<int64>(GWidth) * GHeight);
 
 	if (GWidth <= 0 || GHeight <= 0)
 	{
 		UE_LOG(LogRoguelikeGeometry, Error, TEXT("[DW] Invalid grid dimensions: %dx%d"), GWidth, GHeight);
-		return MakeEmptyResult();
-	}
-
-	const int32 TotalCells = GWidth * GHeight;
-
-	TArray<bool> Grid;
-	Grid.Init(false, TotalCells);
-	TArray<uint8> CellType;
-	CellType.Init(EDrunkardWalkCellType::Empty, TotalCells); // non-floor defaults to Empty; walls added below
-
-	for (const TPair<FIntPoint, uint8>& Pair : CellTypeMap)
-	{
-		const int32 AX = Pair.Key.X + Offset.X;
-		const int32 AY = Pair.Key.Y + Offset.Y;
-		const int32 Index = AY * GWidth + AX;
-		Grid[Index] = true;
-		CellType[Index] = Pair.Value;
-	}
-
-	// Wall classification: only non-floor cells within WallThickness (Chebyshev) of a floor cell become
-	// walls; everything farther stays Empty (carved away — no wall).
-	const int32 WT = FMath::Max(1, WallThickness);
-	for (int32 Y = 0; Y < GHeight; ++Y)
-	{
-		for (int32 X = 0; X < GWidth; ++X)
-		{
-			if (!Grid[Y * GWidth + X])
-			{
-				continue; // seed only from floor cells
-			}
-			for (int32 dy = -WT; dy <= WT; ++dy)
-			{
-				const int32 NY = Y + dy;
-				if (NY < 0 || NY >= GHeight)
-				{
-					continue;
-				}
-				for (int32 dx = -WT; dx <= WT; ++dx)
-				{
-					const int32 NX = X + dx;
-					if (NX < 0 || NX >= GWidth)
-					{
-						continue;
-					}
-					const int32 NIdx = NY * GWidth + NX;
-					if (!Grid[NIdx] && CellType[NIdx] == EDrunkardWalkCellType::Empty)
-					{
-						CellType[NIdx] = EDrunkardWalkCellType::Wall;
-					}
-				}
-			}
-		}
+		SetEmptyResult();
+		return;
 	}
 
 	// Convert placed rooms / corridor polylines to grid-array coordinates.
-	TArray<FDrunkardWalkPlacedRoom> PlacedRooms;
-	TArray<FIntPoint>				RoomCenters;
-	PlacedRooms.Reserve(PlacedRoomsSigned.Num());
-	RoomCenters.Reserve(PlacedRoomsSigned.Num());
+	TArray<FDrunkardWalkPlacedRoom>& PlacedRooms = Result.PlacedRooms;
+	TArray<FIntPoint>&				 RoomCenters = Result.RoomCenters;
+	PlacedRooms.Reset(PlacedRoomsSigned.Num());
+	RoomCenters.Reset(PlacedRoomsSigned.Num());
 	for (const FWalkRoom& R : PlacedRoomsSigned)
 	{
 		FDrunkardWalkPlacedRoom PR;
@@ -916,15 +1595,12 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 		RoomCenters.Add(FIntPoint(PR.Min.X + R.W / 2, PR.Min.Y + R.H / 2));
 	}
 
-	TArray<TArray<FIntPoint>> WalkerPaths;
-	WalkerPaths.Reserve(CorridorPolylines.Num());
-	for (const TArray<FIntPoint>& Poly : CorridorPolylines)
+	// The rails already live in Result.WalkerPaths; shift them in place.
+	for (TArray<FIntPoint>& Poly : CorridorPolylines)
 	{
-		TArray<FIntPoint>& Out = WalkerPaths.AddDefaulted_GetRef();
-		Out.Reserve(Poly.Num());
-		for (const FIntPoint& P : Poly)
+		for (FIntPoint& P : Poly)
 		{
-			Out.Add(FIntPoint(P.X + Offset.X, P.Y + Offset.Y));
+			P += Offset;
 		}
 	}
 
@@ -932,20 +1608,76 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 	const int32 CenterX = (PlacedRoomsSigned.Num() > 0) ? RoomCenters[0].X : GWidth / 2;
 	const int32 CenterY = (PlacedRoomsSigned.Num() > 0) ? RoomCenters[0].Y : GHeight / 2;
 
+	if (OutTiled)
+	{
+		FDrunkardWalkTiledGridData& Tiled = *OutTiled;
+		Tiled = FDrunkardWalkTiledGridData();
+		RasterizeTiles(Cells, Offset, WallThickness, FIntPoint(CenterX, CenterY), Tiled);
+		Tiled.WalkerPaths = MoveTemp(CorridorPolylines);
+		Tiled.CorridorSourceRoom = MoveTemp(CorridorSourceRoom);
+		Tiled.CorridorTargetRoom = MoveTemp(CorridorTargetRoom);
+		Tiled.RoomCenters = MoveTemp(RoomCenters);
+		Tiled.PlacedRooms = MoveTemp(PlacedRooms);
+		Tiled.RequestedRoomCount = RequestedRoomCount;
+		Tiled.GridWidth = GWidth;
+		Tiled.GridHeight = GHeight;
+		Tiled.CellSize = CellSizeVal;
+		Tiled.bDegradedResolution = bDegradedResolution;
+		Tiled.WorldOrigin = FVector2D(CenterPoint.X - (CenterX + 0.5f) * CellSizeVal, CenterPoint.Y - (CenterY + 0.5f) * CellSizeVal);
+
+		UE_LOG(LogRoguelikeGeometry,
+			Verbose,
+			TEXT("[DW] GenerateTiled() complete: %d tiles (%lld cells, dense would be %lld), %d regions in %.2fms"),
+			Tiled.Tiles.Num(),
+			Tiled.NumStoredCells(),
+			static_cast<int64>(GWidth) * GHeight,
+			Tiled.RegionSizes.Num(),
+			(FPlatformTime::Seconds() - StartTime) * 1000.0);
+		SetEmptyResult();
+		return;
+	}
+
+	const int32 TotalCells = GWidth * GHeight;
+
+	TArray<bool>& Grid = Result.Grid;
+	InitReusing(Grid, false, TotalCells);
+	TArray<uint8>& CellType = Result.CellType;
+	InitReusing(CellType, EDrunkardWalkCellType::Empty, TotalCells); // non-floor defaults to Empty; walls added below
+
+	Cells.ForEachCell([&](const FIntPoint& Cell, uint8 Type, int32 /*RoomType*/) {
+		const int32 Index = (Cell.Y + Offset.Y) * GWidth + (Cell.X + Offset.X);
+		Grid[Index] = true;
+		CellType[Index] = Type;
+	});
+
+	// Wall classification: only non-floor cells within WallThickness (Chebyshev) of a floor cell become
+	// walls; everything farther stays Empty (carved away — no wall). Separable dilation keeps this
+	// O(cells) whatever the thickness.
+	const int32	  WT = FMath::Max(1, WallThickness);
+	TArray<bool>& DilatedFloor = Work.DilatedFloor;
+	FGeometryUtils::DilateChebyshev(Grid, GWidth, GHeight, WT, DilatedFloor, /*bParallel=*/true);
+	for (int32 Index = 0; Index < TotalCells; ++Index)
+	{
+		if (!Grid[Index] && DilatedFloor[Index])
+		{
+			CellType[Index] = EDrunkardWalkCellType::Wall;
+		}
+	}
+
 	// Flood-fill: identify connected floor regions
-	TArray<int32>			  RegionIds;
-	TArray<TArray<FIntPoint>> Regions;
-	int32					  CenterRegionId = -1;
+	TArray<int32>&			   RegionIds = Result.RegionIds;
+	TArray<TArray<FIntPoint>>& Regions = Result.Regions;
+	int32					   CenterRegionId = -1;
 
 	FloodFillRegions(Grid, GWidth, GHeight, CenterX, CenterY, RegionIds, Regions, CenterRegionId);
 
 	UE_LOG(LogRoguelikeGeometry,
-		Log,
+		Verbose,
 		TEXT("[DW] Walk complete: %d/%d rooms placed, %d corridor segments, %d floor cells, %d regions, center region=%d"),
 		PlacedCount,
 		RequestedRoomCount,
 		CorridorPolylines.Num(),
-		CellTypeMap.Num(),
+		Cells.Num(),
 		Regions.Num(),
 		CenterRegionId);
 
@@ -957,37 +1689,68 @@ FDrunkardWalkGridData UDrunkardWalkGenerator2D::GenerateInternal()
 	// output frame for that call, then restore so Generate() does not mutate caller-configured state.
 	const FBox2D SavedBounds = Bounds;
 	Bounds = OutputBounds;
-	FLayoutDiagram2D Diagram = ConvertGridToDiagram(Grid, GWidth, GHeight);
+	FLayoutDiagram2D& Diagram = Result.Diagram;
+	if (bMergeFloorRectangles)
+	{
+		// Merge groups: each placed room's cells form one group, all corridor cells another, so a room stays a
+		// single rectangle and corridors split into straight runs.
+		TArray<int32>& GroupIds = Work.GroupIds;
+		InitReusing(GroupIds, static_cast<int32>(INDEX_NONE), TotalCells);
+		for (int32 RoomIdx = 0; RoomIdx < PlacedRooms.Num(); ++RoomIdx)
+		{
+			const FDrunkardWalkPlacedRoom& PR = PlacedRooms[RoomIdx];
+			for (int32 Y = PR.Min.Y; Y < PR.Min.Y + PR.Height; ++Y)
+			{
+				for (int32 X = PR.Min.X; X < PR.Min.X + PR.Width; ++X)
+				{
+					const int32 Index = Y * GWidth + X;
+					if (CellType[Index] == EDrunkardWalkCellType::Room)
+					{
+						GroupIds[Index] = RoomIdx;
+					}
+				}
+			}
+		}
+		ConvertGridToRectDiagram(Grid, GroupIds, GWidth, GHeight, CenterX, CenterY, Diagram);
+		if (OutCompact)
+		{
+			// Rectangles are few; flattening the merged diagram is cheap. Compact output only ever runs on the
+			// scratch's result, so the merged diagram stays there with its memory for the next call.
+			FLayoutDiagramCompact::FromDiagram(Diagram, *OutCompact);
+		}
+	}
+	else if (OutCompact)
+	{
+		ConvertGridToCompact(Grid, GWidth, GHeight, *OutCompact, Work.GridToCellIndex);
+	}
+	else
+	{
+		ConvertGridToDiagram(Grid, GWidth, GHeight, Diagram);
+	}
 	Bounds = SavedBounds;
 
 	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
-	UE_LOG(LogRoguelikeGeometry, Log, TEXT("[DW] Generate() complete: %d cells in %.2fms"), Diagram.Cells.Num(), ElapsedMs);
+	UE_LOG(LogRoguelikeGeometry,
+		Verbose,
+		TEXT("[DW] Generate() complete: %d cells in %.2fms"),
+		OutCompact ? OutCompact->Num() : Diagram.Cells.Num(),
+		ElapsedMs);
 
-	FDrunkardWalkGridData Result;
-	Result.Grid = MoveTemp(Grid);
-	Result.CellType = MoveTemp(CellType);
-	Result.RegionIds = MoveTemp(RegionIds);
-	Result.Regions = MoveTemp(Regions);
+	// Grid, cell types, regions, paths, rooms and the diagram were written in place above.
 	Result.CenterRegionId = CenterRegionId;
-	Result.WalkerPaths = MoveTemp(WalkerPaths);
-	Result.CorridorSourceRoom = MoveTemp(CorridorSourceRoom);
-	Result.CorridorTargetRoom = MoveTemp(CorridorTargetRoom);
-	Result.RoomCenters = MoveTemp(RoomCenters);
-	Result.PlacedRooms = MoveTemp(PlacedRooms);
 	Result.RequestedRoomCount = RequestedRoomCount;
 	Result.GridWidth = GWidth;
 	Result.GridHeight = GHeight;
 	Result.CellSize = CellSizeVal;
 	Result.bDegradedResolution = bDegradedResolution;
-	Result.Diagram = MoveTemp(Diagram);
-
-	return Result;
 }
 
-TArray<int32> UDrunkardWalkGenerator2D::BuildRoomQueue(const TArray<FRoomTypeConfig>& RoomTypes, bool bShuffle, FRandomStream& RandomStream)
+void UDrunkardWalkGenerator2D::BuildRoomQueue(
+	const TArray<FRoomTypeConfig>& RoomTypes, bool bShuffle, FRandomStream& RandomStream, TArray<int32>& OutQueue)
 {
 	// Expand each type by its Weight (resolved absolute count after Resolve()/ResolveForTotal()).
-	TArray<int32> Queue;
+	TArray<int32>& Queue = OutQueue;
+	Queue.Reset();
 	for (int32 TypeIdx = 0; TypeIdx < RoomTypes.Num(); ++TypeIdx)
 	{
 		const int32 Count = FMath::Max(0, RoomTypes[TypeIdx].Weight);
@@ -1006,6 +1769,4 @@ TArray<int32> UDrunkardWalkGenerator2D::BuildRoomQueue(const TArray<FRoomTypeCon
 			Queue.Swap(i, j);
 		}
 	}
-
-	return Queue;
 }
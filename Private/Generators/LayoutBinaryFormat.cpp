@@ -0,0 +1,868 @@
+#include "Generators/LayoutBinaryFormat.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Generators/LayoutGridCodec.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "ProceduralGeometry.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "The layout binary format is little-endian and read in place");
+static_assert(sizeof(FVector2D) == 16, "Vertex sections store FVector2D as two doubles");
+static_assert(sizeof(FIntPoint) == 8, "Point sections store FIntPoint as two int32");
+
+using namespace PGLayoutBinary;
+
+namespace
+{
+	// Diagram
+	constexpr uint32 TagDiagramMeta = MakeTag("DMET");
+	constexpr uint32 TagDiagramSeed = MakeTag("DSED");
+	constexpr uint32 TagVertices = MakeTag("DVRT");
+	constexpr uint32 TagVertexOffsets = MakeTag("DVOF");
+	constexpr uint32 TagNeighbors = MakeTag("DNBR");
+	constexpr uint32 TagNeighborOffsets = MakeTag("DNOF");
+	constexpr uint32 TagCenters = MakeTag("DCEN");
+	constexpr uint32 TagExterior = MakeTag("DEXT");
+
+	// Full diagrams only, when they carry a grid lookup (version 3+)
+	constexpr uint32 TagLookupMeta = MakeTag("LKUM");
+	constexpr uint32 TagLookupCells = MakeTag("LKUC");
+
+	// Grid data shared by CA and DW
+	constexpr uint32 TagGridMeta = MakeTag("GDIM");
+	constexpr uint32 TagGrid = MakeTag("GRID");
+	constexpr uint32 TagRegionIds = MakeTag("RGID");
+	constexpr uint32 TagRegionOffsets = MakeTag("RGOF");
+	constexpr uint32 TagRegionCells = MakeTag("RGPT");
+
+	// CA only
+	constexpr uint32 TagSurvivingRegions = MakeTag("SURV");
+	constexpr uint32 TagGraphOffsets = MakeTag("AGOF");
+	constexpr uint32 TagGraphNeighbors = MakeTag("AGNB");
+	constexpr uint32 TagGraphContact = MakeTag("AGCL");
+	constexpr uint32 TagGraphThickness = MakeTag("AGWT");
+
+	// DW only
+	constexpr uint32 TagCellTypes = MakeTag("CTYP");
+	constexpr uint32 TagPathOffsets = MakeTag("WPOF");
+	constexpr uint32 TagPathPoints = MakeTag("WPPT");
+	constexpr uint32 TagCorridorSource = MakeTag("CSRC");
+	constexpr uint32 TagCorridorTarget = MakeTag("CTGT");
+	constexpr uint32 TagRoomCenters = MakeTag("RCEN");
+	constexpr uint32 TagRooms = MakeTag("ROOM");
+
+	struct FDiagramMeta
+	{
+		double BoundsMin[2];
+		double BoundsMax[2];
+		double CenterPoint[2];
+		int32  CenterCellIndex;
+		uint8  bBoundsValid;
+		uint8  Pad[3];
+	};
+
+	struct FGridMeta
+	{
+		int32 GridWidth;
+		int32 GridHeight;
+		float CellSize;
+		int32 CenterRegionId;
+		int32 RequestedRoomCount; // DW only
+		uint8 bDegradedResolution;
+		uint8 Pad[3];
+	};
+
+	struct FLookupMeta
+	{
+		double Origin[2];
+		double CellSize;
+		int32  Width;
+		int32  Height;
+	};
+
+	struct FRoomRecord
+	{
+		int32 MinX;
+		int32 MinY;
+		int32 Width;
+		int32 Height;
+		int32 TypeIndex;
+	};
+
+	uint64 AlignUp(uint64 Value)
+	{
+		return (Value + PayloadAlignment - 1) & ~static_cast<uint64>(PayloadAlignment - 1);
+	}
+
+	void WriteDiagramSections(FLayoutBinaryWriter& Writer, const FLayoutDiagramCompact& Diagram)
+	{
+		FDiagramMeta Meta = {};
+		Meta.BoundsMin[0] = Diagram.Bounds.Min.X;
+		Meta.BoundsMin[1] = Diagram.Bounds.Min.Y;
+		Meta.BoundsMax[0] = Diagram.Bounds.Max.X;
+		Meta.BoundsMax[1] = Diagram.Bounds.Max.Y;
+		Meta.CenterPoint[0] = Diagram.CenterPoint.X;
+		Meta.CenterPoint[1] = Diagram.CenterPoint.Y;
+		Meta.CenterCellIndex = Diagram.CenterCellIndex;
+		Meta.bBoundsValid = Diagram.Bounds.bIsValid ? 1 : 0;
+		Writer.AddArray<FDiagramMeta>(TagDiagramMeta, MakeArrayView(&Meta, 1));
+		Writer.AddString(TagDiagramSeed, Diagram.Seed);
+
+		Writer.AddArray<FVector2D>(TagVertices, Diagram.Vertices);
+		Writer.AddArray<int32>(TagVertexOffsets, Diagram.VertexOffsets);
+		Writer.AddArray<int32>(TagNeighbors, Diagram.Neighbors);
+		Writer.AddArray<int32>(TagNeighborOffsets, Diagram.NeighborOffsets);
+		Writer.AddArray<FVector2D>(TagCenters, Diagram.Centers);
+
+		TArray<bool> Exterior;
+		Exterior.SetNumUninitialized(Diagram.Num());
+		for (int32 CellIndex = 0; CellIndex < Diagram.Num(); ++CellIndex)
+		{
+			Exterior[CellIndex] = Diagram.IsExterior(CellIndex);
+		}
+		Writer.AddBits(TagExterior, Exterior);
+	}
+
+	void WriteGridLookupSections(FLayoutBinaryWriter& Writer, const FLayoutDiagram2D& Diagram)
+	{
+		const FLayoutGridLookup* Lookup = Diagram.GetGridLookup();
+		if (!Lookup)
+		{
+			return;
+		}
+		FLookupMeta Meta = {};
+		Meta.Origin[0] = Lookup->Origin.X;
+		Meta.Origin[1] = Lookup->Origin.Y;
+		Meta.CellSize = Lookup->CellSize;
+		Meta.Width = Lookup->Width;
+		Meta.Height = Lookup->Height;
+		Writer.AddArray<FLookupMeta>(TagLookupMeta, MakeArrayView(&Meta, 1));
+		Writer.AddGridInt32(TagLookupCells, Lookup->GridToCellIndex, Lookup->Width);
+	}
+
+	/** A missing lookup (older files, polygon diagrams) reads as an empty one; a damaged one fails the read. */
+	bool ReadGridLookupSections(const FLayoutBinaryReader& Reader, int32 NumDiagramCells, FLayoutGridLookup& OutLookup)
+	{
+		OutLookup.Reset();
+		if (!Reader.FindSection(TagLookupMeta))
+		{
+			return true;
+		}
+
+		const TArrayView<const FLookupMeta> Meta = Reader.GetArray<FLookupMeta>(TagLookupMeta);
+		if (Meta.Num() != 1 || !(Meta[0].CellSize > 0.0) || Meta[0].Width <= 0 || Meta[0].Height <= 0
+			|| static_cast<int64>(Meta[0].Width) * Meta[0].Height > MAX_int32
+			|| !Reader.ReadGridInt32(TagLookupCells, Meta[0].Width * Meta[0].Height, OutLookup.GridToCellIndex))
+		{
+			return false;
+		}
+		for (const int32 CellIndex : OutLookup.GridToCellIndex)
+		{
+			if (CellIndex < INDEX_NONE || CellIndex >= NumDiagramCells)
+			{
+				return false;
+			}
+		}
+		OutLookup.Origin = FVector2D(Meta[0].Origin[0], Meta[0].Origin[1]);
+		OutLookup.CellSize = Meta[0].CellSize;
+		OutLookup.Width = Meta[0].Width;
+		OutLookup.Height = Meta[0].Height;
+		return true;
+	}
+
+	/** Hands a lookup read back to its diagram; an empty one leaves the diagram without a lookup. */
+	void AdoptGridLookup(FLayoutDiagram2D& Diagram, FLayoutGridLookup&& Lookup)
+	{
+		if (Lookup.IsValid())
+		{
+			Diagram.WriteGridLookup() = MoveTemp(Lookup);
+		}
+	}
+
+	/** True if Offsets is a valid CSR offset array for NumRows rows over NumItems items. */
+	bool IsValidCsr(TArrayView<const int32> Offsets, int32 NumRows, int32 NumItems)
+	{
+		if (Offsets.Num() != NumRows + 1 || Offsets[0] != 0 || Offsets[NumRows] != NumItems)
+		{
+			return false;
+		}
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			if (Offsets[Row + 1] < Offsets[Row])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ReadDiagramSections(const FLayoutBinaryReader& Reader, FLayoutDiagramCompact& Out)
+	{
+		const TArrayView<const FDiagramMeta> Meta = Reader.GetArray<FDiagramMeta>(TagDiagramMeta);
+		if (Meta.Num() != 1)
+		{
+			return false;
+		}
+
+		FLayoutDiagramCompact Diagram;
+		if (!Reader.ReadArray(TagVertices, Diagram.Vertices) || !Reader.ReadArray(TagVertexOffsets, Diagram.VertexOffsets)
+			|| !Reader.ReadArray(TagNeighbors, Diagram.Neighbors) || !Reader.ReadArray(TagNeighborOffsets, Diagram.NeighborOffsets)
+			|| !Reader.ReadArray(TagCenters, Diagram.Centers) || !Reader.ReadString(TagDiagramSeed, Diagram.Seed))
+		{
+			return false;
+		}
+
+		const int32 NumCells = Diagram.Centers.Num();
+		TArray<bool> Exterior;
+		if (!Reader.ReadBits(TagExterior, NumCells, Exterior) || !IsValidCsr(Diagram.VertexOffsets, NumCells, Diagram.Vertices.Num())
+			|| !IsValidCsr(Diagram.NeighborOffsets, NumCells, Diagram.Neighbors.Num()))
+		{
+			return false;
+		}
+		for (const int32 Neighbor : Diagram.Neighbors)
+		{
+			if (Neighbor < 0 || Neighbor >= NumCells)
+			{
+				return false;
+			}
+		}
+		Diagram.ExteriorBits.Init(false, NumCells);
+		for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+		{
+			Diagram.ExteriorBits[CellIndex] = Exterior[CellIndex];
+		}
+
+		Diagram.Bounds = FBox2D(FVector2D(Meta[0].BoundsMin[0], Meta[0].BoundsMin[1]), FVector2D(Meta[0].BoundsMax[0], Meta[0].BoundsMax[1]));
+		Diagram.Bounds.bIsValid = Meta[0].bBoundsValid != 0;
+		Diagram.CenterPoint = FVector2D(Meta[0].CenterPoint[0], Meta[0].CenterPoint[1]);
+		Diagram.CenterCellIndex = Meta[0].CenterCellIndex;
+		Out = MoveTemp(Diagram);
+		return true;
+	}
+
+	FGridMeta MakeGridMeta(int32 GridWidth, int32 GridHeight, float CellSize, int32 CenterRegionId, bool bDegradedResolution)
+	{
+		FGridMeta Meta = {};
+		Meta.GridWidth = GridWidth;
+		Meta.GridHeight = GridHeight;
+		Meta.CellSize = CellSize;
+		Meta.CenterRegionId = CenterRegionId;
+		Meta.bDegradedResolution = bDegradedResolution ? 1 : 0;
+		return Meta;
+	}
+
+	/** Reads the grid meta and checks the per-cell sections against its dimensions. */
+	bool ReadGridSections(const FLayoutBinaryReader& Reader,
+		FGridMeta&									 OutMeta,
+		TArray<bool>&								 OutGrid,
+		TArray<int32>&								 OutRegionIds,
+		TArray<TArray<FIntPoint>>&					 OutRegions)
+	{
+		const TArrayView<const FGridMeta> Meta = Reader.GetArray<FGridMeta>(TagGridMeta);
+		if (Meta.Num() != 1 || Meta[0].GridWidth < 0 || Meta[0].GridHeight < 0)
+		{
+			return false;
+		}
+		OutMeta = Meta[0];
+		const int64 NumCells = static_cast<int64>(OutMeta.GridWidth) * OutMeta.GridHeight;
+		if (NumCells > MAX_int32)
+		{
+			return false;
+		}
+		return Reader.ReadBits(TagGrid, static_cast<int32>(NumCells), OutGrid)
+			&& Reader.ReadGridInt32(TagRegionIds, static_cast<int32>(NumCells), OutRegionIds)
+			&& Reader.ReadNested(TagRegionOffsets, TagRegionCells, OutRegions);
+	}
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Writer
+
+void FLayoutBinaryWriter::AddRaw(uint32 Tag, const void* Data, int32 ElementSize, int32 Count)
+{
+	FPendingSection& Pending = Sections.AddDefaulted_GetRef();
+	Pending.Section = {};
+	Pending.Section.Tag = Tag;
+	Pending.Section.Encoding = static_cast<uint16>(EEncoding::Raw);
+	Pending.Section.ElementSize = static_cast<uint16>(ElementSize);
+	Pending.Section.Count = static_cast<uint32>(Count);
+	Pending.Bytes.Append(static_cast<const uint8*>(Data), ElementSize * Count);
+}
+
+void FLayoutBinaryWriter::AddEncoded(uint32 Tag, EEncoding Encoding, int32 ElementSize, int32 Count, TArray<uint8>&& Bytes)
+{
+	FPendingSection& Pending = Sections.AddDefaulted_GetRef();
+	Pending.Section = {};
+	Pending.Section.Tag = Tag;
+	Pending.Section.Encoding = static_cast<uint16>(Encoding);
+	Pending.Section.ElementSize = static_cast<uint16>(ElementSize);
+	Pending.Section.Count = static_cast<uint32>(Count);
+	Pending.Bytes = MoveTemp(Bytes);
+}
+
+void FLayoutBinaryWriter::AddBits(uint32 Tag, const TArray<bool>& Cells)
+{
+	FPendingSection& Pending = Sections.AddDefaulted_GetRef();
+	Pending.Section = {};
+	Pending.Section.Tag = Tag;
+	Pending.Section.Encoding = static_cast<uint16>(EEncoding::Bits1);
+	Pending.Section.Count = static_cast<uint32>(Cells.Num());
+	Pending.Bytes.SetNumZeroed((Cells.Num() + 7) / 8);
+	for (int32 i = 0; i < Cells.Num(); ++i)
+	{
+		Pending.Bytes[i >> 3] |= Cells[i] ? static_cast<uint8>(1u << (i & 7)) : 0;
+	}
+}
+
+void FLayoutBinaryWriter::AddBits2(uint32 Tag, const TArray<uint8>& Values)
+{
+	FPendingSection& Pending = Sections.AddDefaulted_GetRef();
+	Pending.Section = {};
+	Pending.Section.Tag = Tag;
+	Pending.Section.Encoding = static_cast<uint16>(EEncoding::Bits2);
+	Pending.Section.Count = static_cast<uint32>(Values.Num());
+	Pending.Bytes.SetNumZeroed((Values.Num() + 3) / 4);
+	for (int32 i = 0; i < Values.Num(); ++i)
+	{
+		check(Values[i] < 4);
+		Pending.Bytes[i >> 2] |= static_cast<uint8>((Values[i] & 3) << ((i & 3) * 2));
+	}
+}
+
+void FLayoutBinaryWriter::AddGridBits(uint32 Tag, const TArray<bool>& Cells, int32 Width)
+{
+	if (bCompressGrids)
+	{
+		TArray<uint8> Runs;
+		FLayoutGridCodec::EncodeGrid(Cells, Width, Runs);
+		if (Runs.Num() < (Cells.Num() + 7) / 8)
+		{
+			AddEncoded(Tag, EEncoding::RowRuns, sizeof(bool), Cells.Num(), MoveTemp(Runs));
+			return;
+		}
+	}
+	AddBits(Tag, Cells);
+}
+
+void FLayoutBinaryWriter::AddGridBits2(uint32 Tag, const TArray<uint8>& Values, int32 Width)
+{
+	if (bCompressGrids)
+	{
+		TArray<uint8> Runs;
+		FLayoutGridCodec::EncodeGrid(Values, Width, Runs);
+		if (Runs.Num() < (Values.Num() + 3) / 4)
+		{
+			AddEncoded(Tag, EEncoding::RowRuns, sizeof(uint8), Values.Num(), MoveTemp(Runs));
+			return;
+		}
+	}
+	AddBits2(Tag, Values);
+}
+
+void FLayoutBinaryWriter::AddGridInt32(uint32 Tag, const TArray<int32>& Values, int32 Width)
+{
+	if (bCompressGrids)
+	{
+		TArray<uint8> Runs;
+		FLayoutGridCodec::EncodeGrid(Values, Width, Runs);
+		if (Runs.Num() < Values.Num() * static_cast<int32>(sizeof(int32)))
+		{
+			AddEncoded(Tag, EEncoding::RowRuns, sizeof(int32), Values.Num(), MoveTemp(Runs));
+			return;
+		}
+	}
+	AddArray<int32>(Tag, Values);
+}
+
+void FLayoutBinaryWriter::AddString(uint32 Tag, const FString& Value)
+{
+	const FTCHARToUTF8 Utf8(*Value);
+	AddArray<uint8>(Tag, TArrayView<const uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()));
+}
+
+void FLayoutBinaryWriter::AddNested(uint32 OffsetsTag, uint32 ItemsTag, const TArray<TArray<FIntPoint>>& Lists)
+{
+	TArray<int32>	  Offsets;
+	TArray<FIntPoint> Items;
+	Offsets.Reserve(Lists.Num() + 1);
+	Offsets.Add(0);
+	for (const TArray<FIntPoint>& List : Lists)
+	{
+		Items.Append(List);
+		Offsets.Add(Items.Num());
+	}
+	AddArray<int32>(OffsetsTag, Offsets);
+	if (bCompressGrids)
+	{
+		TArray<uint8> Deltas;
+		FLayoutGridCodec::EncodePoints(Items, Deltas);
+		AddEncoded(ItemsTag, EEncoding::PointDeltas, sizeof(FIntPoint), Items.Num(), MoveTemp(Deltas));
+		return;
+	}
+	AddArray<FIntPoint>(ItemsTag, Items);
+}
+
+TArray<uint8> FLayoutBinaryWriter::Finish() const
+{
+	TArray<FSection> Table;
+	Table.Reserve(Sections.Num());
+	uint64 Cursor = AlignUp(sizeof(FHeader) + sizeof(FSection) * Sections.Num());
+	for (const FPendingSection& Pending : Sections)
+	{
+		FSection& Section = Table.Add_GetRef(Pending.Section);
+		Section.Offset = Cursor;
+		Section.Size = Pending.Bytes.Num();
+		Section.Crc = FCrc::MemCrc32(Pending.Bytes.GetData(), Pending.Bytes.Num());
+		Cursor = AlignUp(Cursor + Section.Size);
+	}
+
+	FHeader Header = {};
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.HeaderSize = sizeof(FHeader);
+	Header.Kind = static_cast<uint32>(Kind);
+	Header.NumSections = Table.Num();
+	Header.FileSize = Cursor;
+	Header.TableCrc = FCrc::MemCrc32(Table.GetData(), Table.Num() * sizeof(FSection));
+
+	TArray<uint8> Bytes;
+	Bytes.SetNumZeroed(Cursor);
+	FMemory::Memcpy(Bytes.GetData(), &Header, sizeof(FHeader));
+	FMemory::Memcpy(Bytes.GetData() + sizeof(FHeader), Table.GetData(), Table.Num() * sizeof(FSection));
+	for (int32 i = 0; i < Sections.Num(); ++i)
+	{
+		FMemory::Memcpy(Bytes.GetData() + Table[i].Offset, Sections[i].Bytes.GetData(), Sections[i].Bytes.Num());
+	}
+	return Bytes;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Reader
+
+FLayoutBinaryReader::~FLayoutBinaryReader()
+{
+	delete MappedRegion;
+	delete MappedHandle;
+}
+
+TUniquePtr<FLayoutBinaryReader> FLayoutBinaryReader::OpenFile(const FString& Path, bool bVerifyChecksums, FString* OutError)
+{
+	TUniquePtr<FLayoutBinaryReader> Reader(new FLayoutBinaryReader());
+	FString							Error;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (IMappedFileHandle* Handle = PlatformFile.OpenMapped(*Path))
+	{
+		Reader->MappedHandle = Handle;
+		Reader->MappedRegion = Handle->MapRegion(0, Handle->GetFileSize());
+	}
+	if (Reader->MappedRegion)
+	{
+		Reader->Data = TArrayView<const uint8>(Reader->MappedRegion->GetMappedPtr(), Reader->MappedRegion->GetMappedSize());
+	}
+	else if (FFileHelper::LoadFileToArray(Reader->OwnedBytes, *Path, FILEREAD_Silent))
+	{
+		Reader->Data = Reader->OwnedBytes;
+	}
+	else
+	{
+		Error = FString::Printf(TEXT("cannot open '%s'"), *Path);
+	}
+
+	if (Error.IsEmpty() && Reader->Validate(bVerifyChecksums, Error))
+	{
+		return Reader;
+	}
+	UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[LayoutBinary] Rejected file: %s"), *Error);
+	if (OutError)
+	{
+		*OutError = Error;
+	}
+	return nullptr;
+}
+
+TUniquePtr<FLayoutBinaryReader> FLayoutBinaryReader::OpenBytes(TArrayView<const uint8> Bytes, bool bVerifyChecksums, FString* OutError)
+{
+	TUniquePtr<FLayoutBinaryReader> Reader(new FLayoutBinaryReader());
+	if (IsAligned(Bytes.GetData(), PayloadAlignment))
+	{
+		Reader->Data = Bytes;
+	}
+	else
+	{
+		// Sections are read in place, so they need the same alignment the file layout assumes.
+		Reader->OwnedBytes = TArray<uint8>(Bytes);
+		Reader->Data = Reader->OwnedBytes;
+	}
+
+	FString Error;
+	if (Reader->Validate(bVerifyChecksums, Error))
+	{
+		return Reader;
+	}
+	UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[LayoutBinary] Rejected buffer: %s"), *Error);
+	if (OutError)
+	{
+		*OutError = Error;
+	}
+	return nullptr;
+}
+
+bool FLayoutBinaryReader::Validate(bool bVerifyChecksums, FString& OutError)
+{
+	const uint64 FileSize = static_cast<uint64>(Data.Num());
+	if (FileSize < sizeof(FHeader) || !IsAligned(Data.GetData(), PayloadAlignment))
+	{
+		OutError = TEXT("truncated or misaligned header");
+		return false;
+	}
+	const FHeader& H = Header();
+	if (H.Magic != Magic || H.HeaderSize != sizeof(FHeader))
+	{
+		OutError = TEXT("not a layout binary");
+		return false;
+	}
+	if (H.Version == 0 || H.Version > Version)
+	{
+		OutError = FString::Printf(TEXT("unsupported version %u (reader supports up to %u)"), H.Version, Version);
+		return false;
+	}
+	if (H.FileSize != FileSize)
+	{
+		OutError = FString::Printf(TEXT("size mismatch: header says %llu bytes, got %llu"), H.FileSize, FileSize);
+		return false;
+	}
+	const uint64 TableEnd = sizeof(FHeader) + static_cast<uint64>(H.NumSections) * sizeof(FSection);
+	if (TableEnd > FileSize)
+	{
+		OutError = TEXT("section table out of bounds");
+		return false;
+	}
+	if (FCrc::MemCrc32(Data.GetData() + sizeof(FHeader), H.NumSections * sizeof(FSection)) != H.TableCrc)
+	{
+		OutError = TEXT("section table checksum mismatch");
+		return false;
+	}
+
+	for (const FSection& Section : Table())
+	{
+		const bool bInBounds = Section.Offset >= TableEnd && Section.Offset <= FileSize && Section.Size <= FileSize - Section.Offset;
+		if (!bInBounds || Section.Offset % PayloadAlignment != 0)
+		{
+			OutError = FString::Printf(TEXT("section %08x out of bounds or misaligned"), Section.Tag);
+			return false;
+		}
+
+		// Coded sections have data-dependent sizes; their decoders bounds-check instead.
+		bool bSizeMatches = false;
+		switch (static_cast<EEncoding>(Section.Encoding))
+		{
+			case EEncoding::Raw:
+				bSizeMatches = Section.Size == static_cast<uint64>(Section.Count) * Section.ElementSize;
+				break;
+			case EEncoding::Bits1:
+				bSizeMatches = Section.Size == (static_cast<uint64>(Section.Count) + 7) / 8;
+				break;
+			case EEncoding::Bits2:
+				bSizeMatches = Section.Size == (static_cast<uint64>(Section.Count) + 3) / 4;
+				break;
+			case EEncoding::RowRuns:
+				bSizeMatches = (Section.ElementSize == 1 || Section.ElementSize == 4) && Section.Size <= static_cast<uint64>(MAX_int32);
+				break;
+			case EEncoding::PointDeltas:
+				bSizeMatches = Section.ElementSize == sizeof(FIntPoint) && Section.Size <= static_cast<uint64>(MAX_int32);
+				break;
+			default:
+				OutError = FString::Printf(TEXT("section %08x has unknown encoding %u"), Section.Tag, Section.Encoding);
+				return false;
+		}
+		if (!bSizeMatches || Section.Count > static_cast<uint32>(MAX_int32))
+		{
+			OutError = FString::Printf(TEXT("section %08x size does not match its encoding"), Section.Tag);
+			return false;
+		}
+		if (bVerifyChecksums && FCrc::MemCrc32(Data.GetData() + Section.Offset, Section.Size) != Section.Crc)
+		{
+			OutError = FString::Printf(TEXT("section %08x checksum mismatch"), Section.Tag);
+			return false;
+		}
+	}
+	return true;
+}
+
+const FSection* FLayoutBinaryReader::FindSection(uint32 Tag) const
+{
+	for (const FSection& Section : Table())
+	{
+		if (Section.Tag == Tag)
+		{
+			return &Section;
+		}
+	}
+	return nullptr;
+}
+
+bool FLayoutBinaryReader::ReadBits(uint32 Tag, int32 ExpectedCount, TArray<bool>& Out) const
+{
+	const FSection* Section = FindSection(Tag);
+	if (!Section || ExpectedCount < 0 || Section->Count != static_cast<uint32>(ExpectedCount))
+	{
+		return false;
+	}
+	if (Section->Encoding == static_cast<uint16>(EEncoding::RowRuns) && Section->ElementSize == sizeof(bool))
+	{
+		return FLayoutGridCodec::DecodeGrid(Payload(*Section), ExpectedCount, Out);
+	}
+	if (Section->Encoding != static_cast<uint16>(EEncoding::Bits1))
+	{
+		return false;
+	}
+	const uint8* Bytes = Data.GetData() + Section->Offset;
+	Out.SetNumUninitialized(ExpectedCount);
+	for (int32 i = 0; i < Out.Num(); ++i)
+	{
+		Out[i] = ((Bytes[i >> 3] >> (i & 7)) & 1) != 0;
+	}
+	return true;
+}
+
+bool FLayoutBinaryReader::ReadBits2(uint32 Tag, int32 ExpectedCount, TArray<uint8>& Out) const
+{
+	const FSection* Section = FindSection(Tag);
+	if (!Section || ExpectedCount < 0 || Section->Count != static_cast<uint32>(ExpectedCount))
+	{
+		return false;
+	}
+	if (Section->Encoding == static_cast<uint16>(EEncoding::RowRuns) && Section->ElementSize == sizeof(uint8))
+	{
+		return FLayoutGridCodec::DecodeGrid(Payload(*Section), ExpectedCount, Out)
+			&& !Out.ContainsByPredicate([](uint8 Value) { return Value > 3; });
+	}
+	if (Section->Encoding != static_cast<uint16>(EEncoding::Bits2))
+	{
+		return false;
+	}
+	const uint8* Bytes = Data.GetData() + Section->Offset;
+	Out.SetNumUninitialized(ExpectedCount);
+	for (int32 i = 0; i < Out.Num(); ++i)
+	{
+		Out[i] = (Bytes[i >> 2] >> ((i & 3) * 2)) & 3;
+	}
+	return true;
+}
+
+bool FLayoutBinaryReader::ReadGridInt32(uint32 Tag, int32 ExpectedCount, TArray<int32>& Out) const
+{
+	const FSection* Section = FindSection(Tag);
+	if (!Section || ExpectedCount < 0 || Section->Count != static_cast<uint32>(ExpectedCount))
+	{
+		return false;
+	}
+	if (Section->Encoding == static_cast<uint16>(EEncoding::RowRuns) && Section->ElementSize == sizeof(int32))
+	{
+		return FLayoutGridCodec::DecodeGrid(Payload(*Section), ExpectedCount, Out);
+	}
+	return ReadArray(Tag, Out);
+}
+
+bool FLayoutBinaryReader::ReadString(uint32 Tag, FString& Out) const
+{
+	const TArrayView<const uint8> Utf8 = GetArray<uint8>(Tag);
+	if (!FindSection(Tag))
+	{
+		return false;
+	}
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+	Out = FString(Converted.Length(), Converted.Get());
+	return true;
+}
+
+bool FLayoutBinaryReader::ReadNested(uint32 OffsetsTag, uint32 ItemsTag, TArray<TArray<FIntPoint>>& Out) const
+{
+	const TArrayView<const int32> Offsets = GetArray<int32>(OffsetsTag);
+	const FSection*				  ItemsSection = FindSection(ItemsTag);
+	TArrayView<const FIntPoint>	  Items = GetArray<FIntPoint>(ItemsTag);
+	TArray<FIntPoint>			  DecodedItems;
+	if (ItemsSection && ItemsSection->Encoding == static_cast<uint16>(EEncoding::PointDeltas))
+	{
+		if (!FLayoutGridCodec::DecodePoints(Payload(*ItemsSection), ItemsSection->Count, DecodedItems))
+		{
+			return false;
+		}
+		Items = DecodedItems;
+	}
+	if (Offsets.Num() == 0 || !ItemsSection || !IsValidCsr(Offsets, Offsets.Num() - 1, Items.Num()))
+	{
+		return false;
+	}
+	Out.SetNum(Offsets.Num() - 1);
+	for (int32 Row = 0; Row < Out.Num(); ++Row)
+	{
+		Out[Row] = TArray<FIntPoint>(Items.GetData() + Offsets[Row], Offsets[Row + 1] - Offsets[Row]);
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Structs
+
+void FLayoutBinaryFormat::AddSections(FLayoutBinaryWriter& Writer, const FLayoutDiagramCompact& Diagram)
+{
+	check(Writer.GetKind() == EPayloadKind::Diagram);
+	WriteDiagramSections(Writer, Diagram);
+}
+
+void FLayoutBinaryFormat::AddSections(FLayoutBinaryWriter& Writer, const FLayoutDiagram2D& Diagram)
+{
+	AddSections(Writer, FLayoutDiagramCompact::FromDiagram(Diagram));
+	WriteGridLookupSections(Writer, Diagram);
+}
+
+void FLayoutBinaryFormat::AddSections(FLayoutBinaryWriter& Writer, const FCellularAutomataGridData& Data)
+{
+	check(Writer.GetKind() == EPayloadKind::CellularAutomata);
+	const FGridMeta Meta = MakeGridMeta(Data.GridWidth, Data.GridHeight, Data.CellSize, Data.CenterRegionId, Data.bDegradedResolution);
+	Writer.AddArray<FGridMeta>(TagGridMeta, MakeArrayView(&Meta, 1));
+	Writer.AddGridBits(TagGrid, Data.Grid, Data.GridWidth);
+	Writer.AddGridInt32(TagRegionIds, Data.RegionIds, Data.GridWidth);
+	Writer.AddNested(TagRegionOffsets, TagRegionCells, Data.Regions);
+	Writer.AddBits(TagSurvivingRegions, Data.SurvivingRegions);
+	Writer.AddArray<int32>(TagGraphOffsets, Data.RegionGraph.Offsets);
+	Writer.AddArray<int32>(TagGraphNeighbors, Data.RegionGraph.Neighbors);
+	Writer.AddArray<float>(TagGraphContact, Data.RegionGraph.ContactLength);
+	Writer.AddArray<float>(TagGraphThickness, Data.RegionGraph.WallThickness);
+	WriteDiagramSections(Writer, FLayoutDiagramCompact::FromDiagram(Data.Diagram));
+	WriteGridLookupSections(Writer, Data.Diagram);
+}
+
+void FLayoutBinaryFormat::AddSections(FLayoutBinaryWriter& Writer, const FDrunkardWalkGridData& Data)
+{
+	check(Writer.GetKind() == EPayloadKind::DrunkardWalk);
+	FGridMeta Meta = MakeGridMeta(Data.GridWidth, Data.GridHeight, Data.CellSize, Data.CenterRegionId, Data.bDegradedResolution);
+	Meta.RequestedRoomCount = Data.RequestedRoomCount;
+	Writer.AddArray<FGridMeta>(TagGridMeta, MakeArrayView(&Meta, 1));
+	Writer.AddGridBits(TagGrid, Data.Grid, Data.GridWidth);
+	Writer.AddGridBits2(TagCellTypes, Data.CellType, Data.GridWidth);
+	Writer.AddGridInt32(TagRegionIds, Data.RegionIds, Data.GridWidth);
+	Writer.AddNested(TagRegionOffsets, TagRegionCells, Data.Regions);
+	Writer.AddNested(TagPathOffsets, TagPathPoints, Data.WalkerPaths);
+	Writer.AddArray<int32>(TagCorridorSource, Data.CorridorSourceRoom);
+	Writer.AddArray<int32>(TagCorridorTarget, Data.CorridorTargetRoom);
+	Writer.AddArray<FIntPoint>(TagRoomCenters, Data.RoomCenters);
+
+	TArray<FRoomRecord> Rooms;
+	Rooms.Reserve(Data.PlacedRooms.Num());
+	for (const FDrunkardWalkPlacedRoom& Room : Data.PlacedRooms)
+	{
+		Rooms.Add({ Room.Min.X, Room.Min.Y, Room.Width, Room.Height, Room.TypeIndex });
+	}
+	Writer.AddArray<FRoomRecord>(TagRooms, Rooms);
+	WriteDiagramSections(Writer, FLayoutDiagramCompact::FromDiagram(Data.Diagram));
+	WriteGridLookupSections(Writer, Data.Diagram);
+}
+
+bool FLayoutBinaryFormat::Read(const FLayoutBinaryReader& Reader, FLayoutDiagramCompact& OutDiagram)
+{
+	return Reader.GetKind() == EPayloadKind::Diagram && ReadDiagramSections(Reader, OutDiagram);
+}
+
+bool FLayoutBinaryFormat::Read(const FLayoutBinaryReader& Reader, FLayoutDiagram2D& OutDiagram)
+{
+	FLayoutDiagramCompact Compact;
+	FLayoutGridLookup	  Lookup;
+	if (!Read(Reader, Compact) || !ReadGridLookupSections(Reader, Compact.Num(), Lookup))
+	{
+		return false;
+	}
+	OutDiagram = Compact.ToDiagram();
+	AdoptGridLookup(OutDiagram, MoveTemp(Lookup));
+	return true;
+}
+
+bool FLayoutBinaryFormat::Read(const FLayoutBinaryReader& Reader, FCellularAutomataGridData& OutData)
+{
+	if (Reader.GetKind() != EPayloadKind::CellularAutomata)
+	{
+		return false;
+	}
+
+	FCellularAutomataGridData Data;
+	FGridMeta				  Meta;
+	FLayoutDiagramCompact	  Diagram;
+	FLayoutGridLookup		  Lookup;
+	if (!ReadGridSections(Reader, Meta, Data.Grid, Data.RegionIds, Data.Regions)
+		|| !Reader.ReadBits(TagSurvivingRegions, Data.Regions.Num(), Data.SurvivingRegions)
+		|| !Reader.ReadArray(TagGraphOffsets, Data.RegionGraph.Offsets) || !Reader.ReadArray(TagGraphNeighbors, Data.RegionGraph.Neighbors)
+		|| !Reader.ReadArray(TagGraphContact, Data.RegionGraph.ContactLength) || !Reader.ReadArray(TagGraphThickness, Data.RegionGraph.WallThickness)
+		|| !ReadDiagramSections(Reader, Diagram) || !ReadGridLookupSections(Reader, Diagram.Num(), Lookup))
+	{
+		return false;
+	}
+
+	Data.GridWidth = Meta.GridWidth;
+	Data.GridHeight = Meta.GridHeight;
+	Data.CellSize = Meta.CellSize;
+	Data.CenterRegionId = Meta.CenterRegionId;
+	Data.bDegradedResolution = Meta.bDegradedResolution != 0;
+	Data.Diagram = Diagram.ToDiagram();
+	AdoptGridLookup(Data.Diagram, MoveTemp(Lookup));
+	OutData = MoveTemp(Data);
+	return true;
+}
+
+bool FLayoutBinaryFormat::Read(const FLayoutBinaryReader& Reader, FDrunkardWalkGridData& OutData)
+{
+	if (Reader.GetKind() != EPayloadKind::DrunkardWalk)
+	{
+		return false;
+	}
+
+	FDrunkardWalkGridData Data;
+	FGridMeta			  Meta;
+	FLayoutDiagramCompact Diagram;
+	FLayoutGridLookup	  Lookup;
+	if (!ReadGridSections(Reader, Meta, Data.Grid, Data.RegionIds, Data.Regions) || !Reader.ReadBits2(TagCellTypes, Data.Grid.Num(), Data.CellType)
+		|| !Reader.ReadNested(TagPathOffsets, TagPathPoints, Data.WalkerPaths)
+		|| !Reader.ReadArray(TagCorridorSource, Data.CorridorSourceRoom) || !Reader.ReadArray(TagCorridorTarget, Data.CorridorTargetRoom)
+		|| !Reader.ReadArray(TagRoomCenters, Data.RoomCenters) || !ReadDiagramSections(Reader, Diagram)
+		|| !ReadGridLookupSections(Reader, Diagram.Num(), Lookup))
+	{
+		return false;
+	}
+
+	const TArrayView<const FRoomRecord> Rooms = Reader.GetArray<FRoomRecord>(TagRooms);
+	if (!Reader.FindSection(TagRooms) || Rooms.Num() != static_cast<int32>(Reader.FindSection(TagRooms)->Count))
+	{
+		return false;
+	}
+	Data.PlacedRooms.Reserve(Rooms.Num());
+	for (const FRoomRecord& Record : Rooms)
+	{
+		FDrunkardWalkPlacedRoom& Room = Data.PlacedRooms.AddDefaulted_GetRef();
+		Room.Min = FIntPoint(Record.MinX, Record.MinY);
+		Room.Width = Record.Width;
+		Room.Height = Record.Height;
+		Room.TypeIndex = Record.TypeIndex;
+	}
+
+	Data.GridWidth = Meta.GridWidth;
+	Data.GridHeight = Meta.GridHeight;
+	Data.CellSize = Meta.CellSize;
+	Data.CenterRegionId = Meta.CenterRegionId;
+	Data.RequestedRoomCount = Meta.RequestedRoomCount;
+	Data.bDegradedResolution = Meta.bDegradedResolution != 0;
+	Data.Diagram = Diagram.ToDiagram();
+	AdoptGridLookup(Data.Diagram, MoveTemp(Lookup));
+	OutData = MoveTemp(Data);
+	return true;
+}
+
+bool FLayoutBinaryFormat::SaveToFile(const TArray<uint8>& Bytes, const FString& Path)
+{
+	if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+	{
+		UE_LOG(LogRoguelikeGeometry, Error, TEXT("[LayoutBinary] Failed to write '%s'"), *Path);
+		return false;
+	}
+	return true;
+}
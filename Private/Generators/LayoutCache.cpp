@@ -0,0 +1,280 @@
+#include "Generators/LayoutCache.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProceduralGeometry.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarLayoutCache(TEXT("pg.LayoutCache"),
+		0,
+		TEXT("1 = load generated layouts from the on-disk layout cache and store new ones; 0 = always generate."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarLayoutCacheMaxSizeMB(TEXT("pg.LayoutCache.MaxSizeMB"),
+		256,
+		TEXT("Size cap of the on-disk layout cache in MB; least recently used entries are evicted beyond it."),
+		ECVF_Default);
+
+	const TCHAR* const CacheFileExtension = TEXT(".pglb");
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Key
+
+FLayoutCacheKey::FLayoutCacheKey(const TCHAR* GeneratorType, uint32 AlgorithmVersion, const TCHAR* Output)
+{
+	Add(FString(GeneratorType)).Add(AlgorithmVersion).Add(FString(Output)).Add(static_cast<uint32>(PGLayoutBinary::Version));
+}
+
+FLayoutCacheKey& FLayoutCacheKey::Add(const FString& Value)
+{
+	const FTCHARToUTF8 Utf8(*Value);
+	Add(Utf8.Length());
+	return AddBytes(Utf8.Get(), Utf8.Length());
+}
+
+FLayoutCacheKey& FLayoutCacheKey::AddBytes(const void* Data, int64 Size)
+{
+	Hash.Update(static_cast<const uint8*>(Data), Size);
+	return *this;
+}
+
+FString FLayoutCacheKey::ToString()
+{
+	Hash.Final();
+	FSHAHash Digest;
+	Hash.GetHash(Digest.Hash);
+	return Digest.ToString();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Cache
+
+FLayoutGenerationCache& FLayoutGenerationCache::Get()
+{
+	static FLayoutGenerationCache Instance;
+	return Instance;
+}
+
+bool FLayoutGenerationCache::IsEnabled()
+{
+	return CVarLayoutCache.GetValueOnAnyThread() != 0;
+}
+
+void FLayoutGenerationCache::SetDirectory(const FString& InDirectory)
+{
+	FScopeLock ScopeLock(&Lock);
+	Directory = InDirectory;
+	Entries.Reset();
+	TotalBytes = 0;
+	bIndexed = false;
+}
+
+FString FLayoutGenerationCache::GetDirectory() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Directory.IsEmpty() ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("LayoutCache")) : Directory;
+}
+
+void FLayoutGenerationCache::SetMaxBytes(int64 InMaxBytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	MaxBytesOverride = InMaxBytes;
+	EnsureIndexed();
+	EvictToFit(GetMaxBytes());
+}
+
+int64 FLayoutGenerationCache::GetMaxBytes() const
+{
+	FScopeLock ScopeLock(&Lock);
+	if (MaxBytesOverride >= 0)
+	{
+		return MaxBytesOverride;
+	}
+	return static_cast<int64>(FMath::Max(0, CVarLayoutCacheMaxSizeMB.GetValueOnAnyThread())) * 1024 * 1024;
+}
+
+FString FLayoutGenerationCache::PathFor(const FString& Key) const
+{
+	return FPaths::Combine(GetDirectory(), Key + CacheFileExtension);
+}
+
+void FLayoutGenerationCache::EnsureIndexed()
+{
+	if (bIndexed)
+	{
+		return;
+	}
+	bIndexed = true;
+
+	const FString  Dir = GetDirectory();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*Dir);
+	PlatformFile.IterateDirectoryStat(*Dir,
+		[this](const TCHAR* Path, const FFileStatData& StatData) {
+			const FString File(Path);
+			if (!StatData.bIsDirectory && File.EndsWith(CacheFileExtension))
+			{
+				FEntry& Entry = Entries.Add(FPaths::GetBaseFilename(File));
+				Entry.Size = StatData.FileSize;
+				Entry.LastUse = StatData.ModificationTime.GetTicks();
+				TotalBytes += Entry.Size;
+				LastTick = FMath::Max(LastTick, Entry.LastUse);
+			}
+			return true;
+		});
+	Stats.Entries = Entries.Num();
+	Stats.TotalBytes = TotalBytes;
+}
+
+int64 FLayoutGenerationCache::NextUseTick()
+{
+	LastTick = FMath::Max(LastTick + 1, FDateTime::UtcNow().GetTicks());
+	return LastTick;
+}
+
+void FLayoutGenerationCache::EvictToFit(int64 MaxBytes)
+{
+	if (TotalBytes <= MaxBytes)
+	{
+		return;
+	}
+
+	TArray<TPair<int64, FString>> ByAge;
+	ByAge.Reserve(Entries.Num());
+	for (const TPair<FString, FEntry>& Pair : Entries)
+	{
+		ByAge.Emplace(Pair.Value.LastUse, Pair.Key);
+	}
+	ByAge.Sort([](const TPair<int64, FString>& A, const TPair<int64, FString>& B) { return A.Key < B.Key; });
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	for (int32 i = 0; i < ByAge.Num() && TotalBytes > MaxBytes; ++i)
+	{
+		const FString& Key = ByAge[i].Value;
+		PlatformFile.DeleteFile(*PathFor(Key));
+		TotalBytes -= Entries.FindChecked(Key).Size;
+		Entries.Remove(Key);
+		++Stats.Evictions;
+	}
+	Stats.Entries = Entries.Num();
+	Stats.TotalBytes = TotalBytes;
+}
+
+TUniquePtr<FLayoutBinaryReader> FLayoutGenerationCache::Open(const FString& Key)
+{
+	const FString Path = PathFor(Key);
+	{
+		FScopeLock ScopeLock(&Lock);
+		EnsureIndexed();
+		FEntry* Entry = Entries.Find(Key);
+		if (!Entry)
+		{
+			++Stats.Misses;
+			return nullptr;
+		}
+		Entry->LastUse = NextUseTick();
+	}
+
+	// Bump the file time too, so recency survives a restart. Best effort: the file may be mapped elsewhere.
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.SetTimeStamp(*Path, FDateTime::UtcNow());
+
+	TUniquePtr<FLayoutBinaryReader> Reader = FLayoutBinaryReader::OpenFile(Path);
+	FScopeLock						ScopeLock(&Lock);
+	if (!Reader)
+	{
+		// Evicted by another process, or corrupt; either way it is gone now.
+		if (const FEntry* Entry = Entries.Find(Key))
+		{
+			TotalBytes -= Entry->Size;
+			Entries.Remove(Key);
+		}
+		PlatformFile.DeleteFile(*Path);
+		++Stats.Misses;
+		Stats.Entries = Entries.Num();
+		Stats.TotalBytes = TotalBytes;
+		return nullptr;
+	}
+	++Stats.Hits;
+	UE_LOG(LogRoguelikeGeometry, Verbose, TEXT("[LayoutCache] Hit %s"), *Key);
+	return Reader;
+}
+
+void FLayoutGenerationCache::Discard(const FString& Key)
+{
+	FScopeLock ScopeLock(&Lock);
+	UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[LayoutCache] Discarding unreadable entry %s"), *Key);
+	if (const FEntry* Entry = Entries.Find(Key))
+	{
+		TotalBytes -= Entry->Size;
+		Entries.Remove(Key);
+	}
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*PathFor(Key));
+	--Stats.Hits;
+	++Stats.Misses;
+	Stats.Entries = Entries.Num();
+	Stats.TotalBytes = TotalBytes;
+}
+
+void FLayoutGenerationCache::StoreBytes(const FString& Key, const TArray<uint8>& Bytes)
+{
+	if (Bytes.Num() > GetMaxBytes())
+	{
+		return;
+	}
+
+	// Write to a unique temp name and move into place, so readers never see a partial file.
+	const FString  Path = PathFor(Key);
+	const FString  TempPath = Path + TEXT(".") + FGuid::NewGuid().ToString(EGuidFormats::Digits) + TEXT(".tmp");
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	{
+		FScopeLock ScopeLock(&Lock);
+		EnsureIndexed();
+	}
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+	{
+		UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[LayoutCache] Failed to write '%s'"), *TempPath);
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	PlatformFile.DeleteFile(*Path);
+	if (!PlatformFile.MoveFile(*Path, *TempPath))
+	{
+		// Another thread or process stored the same key first; its file is identical.
+		PlatformFile.DeleteFile(*TempPath);
+		return;
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(Key);
+	TotalBytes += Bytes.Num() - Entry.Size;
+	Entry.Size = Bytes.Num();
+	Entry.LastUse = NextUseTick();
+	EvictToFit(GetMaxBytes());
+	Stats.Entries = Entries.Num();
+	Stats.TotalBytes = TotalBytes;
+}
+
+void FLayoutGenerationCache::Clear()
+{
+	FScopeLock ScopeLock(&Lock);
+	EnsureIndexed();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	for (const TPair<FString, FEntry>& Pair : Entries)
+	{
+		PlatformFile.DeleteFile(*PathFor(Pair.Key));
+	}
+	Entries.Reset();
+	TotalBytes = 0;
+	Stats = FLayoutCacheStats();
+}
+
+FLayoutCacheStats FLayoutGenerationCache::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Stats;
+}
@@ -0,0 +1,85 @@
+#include "Generators/LayoutCellLocator.h"
+
+#include "Algo/Sort.h"
+#include "Generators/LayoutFrameArena.h"
+
+void FLayoutGridLookup::Reset()
+{
+	Origin = FVector2D::ZeroVector;
+	CellSize = 0.0;
+	Width = 0;
+	Height = 0;
+	GridToCellIndex.Reset();
+}
+
+void FLayoutCellBVH::Reset()
+{
+	NodeBounds.Reset();
+	NodeStart.Reset();
+	NodeCount.Reset();
+	CellOrder.Reset();
+}
+
+void FLayoutCellBVH::Build(TArrayView<const FBox2D> CellBounds)
+{
+	Reset();
+	for (int32 Cell = 0; Cell < CellBounds.Num(); ++Cell)
+	{
+		if (CellBounds[Cell].bIsValid)
+		{
+			CellOrder.Add(Cell);
+		}
+	}
+	if (CellOrder.Num() == 0)
+	{
+		return;
+	}
+
+	struct FPendingNode
+	{
+		int32 Node;
+		int32 Begin;
+		int32 End;
+	};
+
+	FMemMark				  Mark(FMemStack::Get());
+	TFrameArray<FPendingNode> Pending;
+
+	// Appends a node over CellOrder[Begin, End) as a leaf; splitting it later turns it into an inner node.
+	auto AddNode = [this, &Pending, &CellBounds](int32 Begin, int32 End) {
+		FBox2D Box(ForceInit);
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Box += CellBounds[CellOrder[i]];
+		}
+		const int32 Node = NodeBounds.Add(Box);
+		NodeStart.Add(Begin);
+		NodeCount.Add(End - Begin);
+		Pending.Add({ Node, Begin, End });
+		return Node;
+	};
+
+	AddNode(0, CellOrder.Num());
+	while (Pending.Num() > 0)
+	{
+		const FPendingNode Item = Pending.Pop(EAllowShrinking::No);
+		if (Item.End - Item.Begin <= MaxLeafCells)
+		{
+			continue;
+		}
+
+		// Split at the median cell center along the node's longer axis.
+		const FVector2D Extent = NodeBounds[Item.Node].GetSize();
+		const int32		Axis = Extent.X >= Extent.Y ? 0 : 1;
+		Algo::Sort(MakeArrayView(CellOrder.GetData() + Item.Begin, Item.End - Item.Begin), [&CellBounds, Axis](int32 A, int32 B) {
+			const double CA = CellBounds[A].GetCenter()[Axis];
+			const double CB = CellBounds[B].GetCenter()[Axis];
+			return CA < CB || (CA == CB && A < B);
+		});
+
+		const int32 Mid = Item.Begin + (Item.End - Item.Begin) / 2;
+		NodeStart[Item.Node] = AddNode(Item.Begin, Mid);
+		NodeCount[Item.Node] = 0;
+		AddNode(Mid, Item.End);
+	}
+}
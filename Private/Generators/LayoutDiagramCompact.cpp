@@ -0,0 +1,91 @@
+#include "Generators/LayoutDiagramCompact.h"
+
+void FLayoutDiagramCompact::Reset()
+{
+	Vertices.Reset();
+	VertexOffsets.Reset();
+	VertexOffsets.Add(0);
+	Neighbors.Reset();
+	NeighborOffsets.Reset();
+	NeighborOffsets.Add(0);
+	Centers.Reset();
+	ExteriorBits.Reset();
+	CenterCellIndex = INDEX_NONE;
+}
+
+void FLayoutDiagramCompact::Reserve(int32 NumCells, int32 NumVertices, int32 NumNeighbors)
+{
+	Vertices.Reserve(NumVertices);
+	VertexOffsets.Reserve(NumCells + 1);
+	Neighbors.Reserve(NumNeighbors);
+	NeighborOffsets.Reserve(NumCells + 1);
+	Centers.Reserve(NumCells);
+	ExteriorBits.Reserve(NumCells);
+}
+
+int32 FLayoutDiagramCompact::AddCell(TArrayView<const FVector2D> CellVertices, const FVector2D& Center, bool bIsExterior)
+{
+	Vertices.Append(CellVertices.GetData(), CellVertices.Num());
+	VertexOffsets.Add(Vertices.Num());
+	ExteriorBits.Add(bIsExterior);
+	return Centers.Add(Center);
+}
+
+FLayoutDiagramCompact FLayoutDiagramCompact::FromDiagram(const FLayoutDiagram2D& Diagram)
+{
+	FLayoutDiagramCompact Compact;
+	FromDiagram(Diagram, Compact);
+	return Compact;
+}
+
+void FLayoutDiagramCompact::FromDiagram(const FLayoutDiagram2D& Diagram, FLayoutDiagramCompact& OutCompact)
+{
+	OutCompact.Reset();
+	OutCompact.Bounds = Diagram.Bounds;
+	OutCompact.CenterPoint = Diagram.CenterPoint;
+	OutCompact.CenterCellIndex = Diagram.CenterCellIndex;
+	OutCompact.Seed = Diagram.Seed;
+
+	int32 NumVertices = 0;
+	int32 NumNeighbors = 0;
+	for (const FLayoutCell2D& Cell : Diagram.Cells)
+	{
+		NumVertices += Cell.Vertices.Num();
+		NumNeighbors += Cell.Neighbors.Num();
+	}
+	OutCompact.Reserve(Diagram.Cells.Num(), NumVertices, NumNeighbors);
+
+	for (const FLayoutCell2D& Cell : Diagram.Cells)
+	{
+		OutCompact.AddCell(Cell.Vertices, Cell.Center, Cell.bIsExterior);
+		OutCompact.Neighbors.Append(Cell.Neighbors);
+		OutCompact.FinishNeighbors();
+	}
+}
+
+FLayoutDiagram2D FLayoutDiagramCompact::ToDiagram() const
+{
+	FLayoutDiagram2D Diagram;
+	Diagram.Bounds = Bounds;
+	Diagram.CenterPoint = CenterPoint;
+	Diagram.CenterCellIndex = CenterCellIndex;
+	Diagram.Seed = Seed;
+
+	Diagram.Cells.SetNum(Num());
+	for (int32 CellIndex = 0; CellIndex < Num(); ++CellIndex)
+	{
+		FLayoutCell2D& Cell = Diagram.Cells[CellIndex];
+		Cell.Vertices = TArray<FVector2D>(GetVertices(CellIndex));
+		Cell.Neighbors = TArray<int32>(GetNeighbors(CellIndex));
+		Cell.Center = Centers[CellIndex];
+		Cell.CellIndex = CellIndex;
+		Cell.bIsExterior = IsExterior(CellIndex);
+	}
+	return Diagram;
+}
+
+SIZE_T FLayoutDiagramCompact::GetAllocatedSize() const
+{
+	return Vertices.GetAllocatedSize() + VertexOffsets.GetAllocatedSize() + Neighbors.GetAllocatedSize() + NeighborOffsets.GetAllocatedSize()
+		+ Centers.GetAllocatedSize() + ExteriorBits.GetAllocatedSize() + Seed.GetAllocatedSize();
+}
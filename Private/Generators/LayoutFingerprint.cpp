@@ -0,0 +1,144 @@
+#include "Generators/LayoutFingerprint.h"
+
+namespace
+{
+	// Codes for values with no quantised form; quantised values are clamped to +-2^62 and never reach them.
+	constexpr int64	 NaNCode = MIN_int64;
+	constexpr int64	 PositiveInfinityCode = MIN_int64 + 1;
+	constexpr int64	 NegativeInfinityCode = MIN_int64 + 2;
+	constexpr double MaxSteps = 4611686018427387904.0; // 2^62
+} // namespace
+
+FLayoutFingerprint::FLayoutFingerprint(double InQuantum)
+	: InvQuantum(1.0 / (InQuantum > 0.0 ? InQuantum : DefaultQuantum))
+{
+	Hash.Reset();
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(double Value)
+{
+	if (FMath::IsNaN(Value))
+	{
+		return Add(NaNCode);
+	}
+	if (!FMath::IsFinite(Value))
+	{
+		return Add(Value > 0.0 ? PositiveInfinityCode : NegativeInfinityCode);
+	}
+	// -0 and +0 both round to 0.
+	return Add(static_cast<int64>(FMath::RoundHalfFromZero(FMath::Clamp(Value * InvQuantum, -MaxSteps, MaxSteps))));
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FString& Value)
+{
+	const FTCHARToUTF8 Utf8(*Value);
+	Add(Utf8.Length());
+	return AddBytes(Utf8.Get(), Utf8.Length());
+}
+
+FLayoutFingerprint& FLayoutFingerprint::AddBytes(const void* Data, int64 Size)
+{
+	if (Size > 0)
+	{
+		Hash.Update(Data, static_cast<uint64>(Size));
+	}
+	return *this;
+}
+
+FLayoutFingerprint& FLayoutFingerprint::AddCell(
+	TArrayView<const FVector2D> Vertices, TArrayView<const int32> Neighbors, const FVector2D& Center, int32 CellIndex, bool bIsExterior)
+{
+	return Add(Vertices).Add(Neighbors).Add(Center).Add(CellIndex).Add(bIsExterior);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Diagrams
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FLayoutCell2D& Cell)
+{
+	return AddCell(Cell.Vertices, Cell.Neighbors, Cell.Center, Cell.CellIndex, Cell.bIsExterior);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FLayoutDiagram2D& Diagram)
+{
+	Add(Diagram.Cells);
+	return Add(Diagram.Bounds).Add(Diagram.CenterPoint).Add(Diagram.CenterCellIndex).Add(Diagram.Seed);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FLayoutDiagramCompact& Diagram)
+{
+	// Same stream as the full diagram: the cell count, then each cell with its index.
+	Add(Diagram.Num());
+	for (int32 CellIndex = 0; CellIndex < Diagram.Num(); ++CellIndex)
+	{
+		const FLayoutCellView Cell = Diagram.GetCell(CellIndex);
+		AddCell(Cell.Vertices, Cell.Neighbors, Cell.Center, Cell.CellIndex, Cell.bIsExterior);
+	}
+	return Add(Diagram.Bounds).Add(Diagram.CenterPoint).Add(Diagram.CenterCellIndex).Add(Diagram.Seed);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FVoronoiCell2D& Cell)
+{
+	Add(Cell.Vertices).Add(Cell.Neighbors).Add(Cell.SiteLocation).Add(Cell.CellIndex);
+	return Add(Cell.bIsValid).Add(Cell.bIsBoundaryCell);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FVoronoiDiagram2D& Diagram)
+{
+	return Add(Diagram.Cells).Add(Diagram.Bounds).Add(Diagram.Sites).Add(Diagram.Seed);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Cellular automata
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FCellularAutomataRegionGraph& Graph)
+{
+	return Add(Graph.Offsets).Add(Graph.Neighbors).Add(Graph.ContactLength).Add(Graph.WallThickness);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FCellularAutomataGridData& Data)
+{
+	Add(Data.Grid).Add(Data.RegionIds).Add(Data.Regions).Add(Data.SurvivingRegions).Add(Data.CenterRegionId);
+	Add(Data.GridWidth).Add(Data.GridHeight).Add(Data.CellSize).Add(Data.bDegradedResolution);
+	return Add(Data.Diagram).Add(Data.RegionGraph);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Drunkard walk
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FDrunkardWalkPlacedRoom& Room)
+{
+	return Add(Room.Min).Add(Room.Width).Add(Room.Height).Add(Room.TypeIndex);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FDungeonGraphCorridor& Corridor)
+{
+	return Add(Corridor.Path).Add(Corridor.Widths).Add(Corridor.SourceRoom).Add(Corridor.TargetRoom);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FDungeonGraph2D& Graph)
+{
+	Add(Graph.Rooms).Add(Graph.Corridors).Add(Graph.AdjacencyOffsets).Add(Graph.AdjacentRooms).Add(Graph.AdjacentCorridors);
+	return Add(Graph.RequestedRoomCount).Add(Graph.CellSize).Add(Graph.WorldOrigin);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FDrunkardWalkGridData& Data)
+{
+	Add(Data.Grid).Add(Data.CellType).Add(Data.RegionIds).Add(Data.Regions).Add(Data.CenterRegionId);
+	Add(Data.WalkerPaths).Add(Data.CorridorSourceRoom).Add(Data.CorridorTargetRoom).Add(Data.RoomCenters).Add(Data.PlacedRooms);
+	Add(Data.RequestedRoomCount).Add(Data.GridWidth).Add(Data.GridHeight).Add(Data.CellSize).Add(Data.bDegradedResolution);
+	return Add(Data.Diagram);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FDrunkardWalkTiledGridData::FTile& Tile)
+{
+	return Add(Tile.Coord).Add(Tile.CellType).Add(Tile.RegionIds);
+}
+
+FLayoutFingerprint& FLayoutFingerprint::Add(const FDrunkardWalkTiledGridData& Data)
+{
+	Add(Data.Tiles).Add(Data.RegionSizes).Add(Data.CenterRegionId);
+	Add(Data.WalkerPaths).Add(Data.CorridorSourceRoom).Add(Data.CorridorTargetRoom).Add(Data.RoomCenters).Add(Data.PlacedRooms);
+	Add(Data.RequestedRoomCount).Add(Data.GridWidth).Add(Data.GridHeight).Add(Data.CellSize).Add(Data.bDegradedResolution);
+	return Add(Data.WorldOrigin);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+/**
+ * Containers for generator temporaries (BFS stacks, trace buffers, per-tile windows, sort keys) backed by the
+ * thread-local FMemStack. Open an FMemMark on FMemStack::Get() before declaring them: allocation is a pointer bump
+ * in thread-local pages, and everything allocated under the mark is released in one shot when it goes out of scope,
+ * so generators running concurrently on workers never contend on the global heap for scratch.
+ *
+ * The stack is per thread, so a ParallelFor body that needs temporaries opens its own mark. A frame container must
+ * not grow while a nested mark is open on the same thread: the new block would be released by the inner mark.
+ */
+template <typename ElementType>
+using TFrameArray = TArray<ElementType, TMemStackAllocator<>>;
+
+using FFrameSetAllocator = TSetAllocator<TSparseArrayAllocator<TMemStackAllocator<>, TMemStackAllocator<>>, TMemStackAllocator<>>;
+
+template <typename ElementType>
+using TFrameSet = TSet<ElementType, DefaultKeyFuncs<ElementType>, FFrameSetAllocator>;
+
+template <typename KeyType, typename ValueType>
+using TFrameMap = TMap<KeyType, ValueType, FFrameSetAllocator>;
@@ -1,7 +1,104 @@
 ﻿#include "Generators/LayoutGenerator.h"
 
+#include "Async/ParallelFor.h"
+#include "Generators/LayoutCache.h"
+#include "Generators/LayoutDiagramCompact.h"
+#include "Generators/LayoutFrameArena.h"
+#include "GeometryUtils/GeometryFunctionLibrary.h"
 #include "SeedHashing.h"
 
+namespace
+{
+	/** The diagram's own instance behind Shared: kept when no copy shares it, else replaced by a fresh one. */
+	template <typename T>
+	T& MakeUnique(TSharedPtr<T>& Shared)
+	{
+		if (!Shared.IsValid() || !Shared.IsUnique())
+		{
+			Shared = MakeShared<T>();
+		}
+		return *Shared;
+	}
+
+	void BuildCellBVHOver(const TArray<FLayoutCell2D>& Cells, FLayoutCellBVH& OutBVH)
+	{
+		FMemMark			Mark(FMemStack::Get());
+		TFrameArray<FBox2D> CellBounds;
+		CellBounds.Reserve(Cells.Num());
+		for (const FLayoutCell2D& Cell : Cells)
+		{
+			CellBounds.Add(Cell.Vertices.Num() > 0 ? FBox2D(Cell.Vertices) : FBox2D(ForceInit));
+		}
+		OutBVH.Build(CellBounds);
+	}
+} // namespace
+
+int32 FLayoutDiagram2D::FindCellAt(const FVector2D& WorldPos) const
+{
+	if (const FLayoutGridLookup* Lookup = GetGridLookup())
+	{
+		return Lookup->FindCellAt(WorldPos);
+	}
+	return FindOrBuildCellBVH().FindFirst(
+		WorldPos, [this, &WorldPos](int32 CellIndex) { return FGeometryUtils::PointInPolygon(Cells[CellIndex].Vertices, WorldPos); });
+}
+
+void FLayoutDiagram2D::FindCellsAt(TArrayView<const FVector2D> WorldPositions, TArray<int32>& OutCells, bool bParallel) const
+{
+	OutCells.SetNumUninitialized(WorldPositions.Num(), EAllowShrinking::No);
+
+	// Grid lookups are a few arithmetic ops each: not worth a task. Polygon lookups go wide in blocks.
+	constexpr int32 PointsPerTask = 256;
+	if (GetGridLookup() || !bParallel || WorldPositions.Num() <= PointsPerTask)
+	{
+		for (int32 i = 0; i < WorldPositions.Num(); ++i)
+		{
+			OutCells[i] = FindCellAt(WorldPositions[i]);
+		}
+		return;
+	}
+
+	// Build the BVH here, not racing in the tasks' first queries.
+	FindOrBuildCellBVH();
+	const int32 NumBlocks = FMath::DivideAndRoundUp(WorldPositions.Num(), PointsPerTask);
+	ParallelFor(NumBlocks, [&](const int32 Block) {
+		const int32 Last = FMath::Min((Block + 1) * PointsPerTask, WorldPositions.Num());
+		for (int32 i = Block * PointsPerTask; i < Last; ++i)
+		{
+			OutCells[i] = FindCellAt(WorldPositions[i]);
+		}
+	});
+}
+
+FLayoutGridLookup& FLayoutDiagram2D::WriteGridLookup()
+{
+	FLayoutGridLookup& Lookup = MakeUnique(GridLookup);
+	Lookup.Reset();
+	return Lookup;
+}
+
+void FLayoutDiagram2D::BuildCellBVH()
+{
+	BuildCellBVHOver(Cells, MakeUnique(CellBVH));
+}
+
+const FLayoutCellBVH& FLayoutDiagram2D::FindOrBuildCellBVH() const
+{
+	if (!CellBVH.IsValid())
+	{
+		CellBVH = MakeShared<FLayoutCellBVH>();
+		BuildCellBVHOver(Cells, *CellBVH);
+	}
+	return *CellBVH;
+}
+
+const FLayoutPathFields& FLayoutDiagram2D::BuildPathFields(int32 MaxNextHopTableCells, int32 SourceCell)
+{
+	FLayoutPathFields& Fields = MakeUnique(PathFields);
+	FLayoutPathFields::Build(*this, Fields, MaxNextHopTableCells, SourceCell);
+	return Fields;
+}
+
 ULayoutGenerator::ULayoutGenerator()
 {
 	Bounds = FBox2D();
@@ -39,6 +136,25 @@ ULayoutGenerator* ULayoutGenerator::SetGridSize(int32 InSize)
 	return this;
 }
 
+ULayoutGenerator* ULayoutGenerator::SetPathFields(bool bInBuild, int32 InMaxNextHopTableCells)
+{
+	bBuildPathFields = bInBuild;
+	MaxNextHopTableCells = FMath::Max(0, InMaxNextHopTableCells);
+	return this;
+}
+
+void ULayoutGenerator::ApplyDiagramPostPasses(FLayoutDiagram2D& Diagram) const
+{
+	if (bBuildPathFields)
+	{
+		Diagram.BuildPathFields(MaxNextHopTableCells);
+	}
+	else
+	{
+		Diagram.ResetPathFields();
+	}
+}
+
 void ULayoutGenerator::InitializeRandomStream()
 {
 	if (Seed.IsEmpty())
@@ -48,6 +164,16 @@ void ULayoutGenerator::InitializeRandomStream()
 	RandomStream = FRandomStream(static_cast<int32>(PGSeed::HashSeedString(Seed)));
 }
 
+FLayoutDiagramCompact ULayoutGenerator::GenerateCompact()
+{
+	return FLayoutDiagramCompact::FromDiagram(Generate());
+}
+
+void ULayoutGenerator::AddCacheKeyInputs(FLayoutCacheKey& Key) const
+{
+	Key.Add(Bounds).Add(CenterPoint).Add(GridSize).Add(Seed).Add(RandomStream.GetCurrentSeed());
+}
+
 FVector2D ULayoutGenerator::ClampToBounds(const FVector2D& Point) const
 {
 	return FVector2D(FMath::Clamp(Point.X, Bounds.Min.X, Bounds.Max.X), FMath::Clamp(Point.Y, Bounds.Min.Y, Bounds.Max.Y));
@@ -56,100 +182,319 @@ FVector2D ULayoutGenerator::ClampToBounds(const FVector2D& Point) const
 FLayoutDiagram2D ULayoutGenerator::ConvertGridToDiagram(const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight) const
 {
 	FLayoutDiagram2D Diagram;
+	ConvertGridToDiagram(Grid, GridWidth, GridHeight, Diagram);
+	return Diagram;
+}
+
+void ULayoutGenerator::ConvertGridToDiagram(const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight, FLayoutDiagram2D& Diagram) const
+{
+	Diagram.Bounds = Bounds;
+	Diagram.Seed = Seed;
+	Diagram.CenterPoint = CenterPoint;
+	BuildGridDiagram(Grid, GridWidth, GridHeight, Bounds.Min, static_cast<float>(GridSize), Diagram);
+}
+
+namespace
+{
+	/** Numbers the floor cells of a row-major grid in row-major order; walls map to INDEX_NONE. Returns the cell count. */
+	template <typename IndexArrayType>
+	int32 NumberGridCells(const TArray<bool>& Grid, int32 NumGridCells, IndexArrayType& OutGridToCellIndex)
+	{
+		OutGridToCellIndex.SetNumUninitialized(NumGridCells, EAllowShrinking::No);
+		int32 NumCells = 0;
+		for (int32 GridIndex = 0; GridIndex < NumGridCells; ++GridIndex)
+		{
+			OutGridToCellIndex[GridIndex] = Grid[GridIndex] ? NumCells++ : INDEX_NONE;
+		}
+		return NumCells;
+	}
+
+	/**
+	 * Per-cell emission shared by the full and compact grid diagrams. Visits the numbered cells in index order and calls
+	 * Emit(CellIndex, Corners, Center, bIsExterior, Neighbors) with the CCW square corners and the floor neighbors in
+	 * +X, -X, +Y, -Y order. Returns the cell whose center is nearest CenterPoint (INDEX_NONE if there are no cells).
+	 */
+	template <typename IndexArrayType, typename EmitFuncType>
+	int32 EmitGridCells(const IndexArrayType& GridToCellIndex,
+		int32								  GridWidth,
+		int32								  GridHeight,
+		const FVector2D&					  Origin,
+		float								  CellSize,
+		const FVector2D&					  CenterPoint,
+		EmitFuncType&&						  Emit)
+	{
+		const float MinX = Origin.X;
+		const float MinY = Origin.Y;
+		const int32 DX[] = { 1, -1, 0, 0 };
+		const int32 DY[] = { 0, 0, 1, -1 };
+
+		float BestCenterDistSq = FLT_MAX;
+		int32 CenterCellIndex = INDEX_NONE;
+		for (int32 Y = 0; Y < GridHeight; ++Y)
+		{
+			for (int32 X = 0; X < GridWidth; ++X)
+			{
+				const int32 CellIndex = GridToCellIndex[Y * GridWidth + X];
+				if (CellIndex == INDEX_NONE)
+				{
+					continue;
+				}
+
+				// CCW rectangle vertices: bottom-left, bottom-right, top-right, top-left
+				const float		X0 = MinX + X * CellSize;
+				const float		Y0 = MinY + Y * CellSize;
+				const float		X1 = MinX + (X + 1) * CellSize;
+				const float		Y1 = MinY + (Y + 1) * CellSize;
+				const FVector2D Corners[4] = { FVector2D(X0, Y0), FVector2D(X1, Y0), FVector2D(X1, Y1), FVector2D(X0, Y1) };
+				const FVector2D Center(MinX + (X + 0.5f) * CellSize, MinY + (Y + 0.5f) * CellSize);
+
+				int32 Neighbors[4];
+				int32 NumNeighbors = 0;
+				for (int32 Dir = 0; Dir < 4; ++Dir)
+				{
+					const int32 NX = X + DX[Dir];
+					const int32 NY = Y + DY[Dir];
+					if (NX >= 0 && NX < GridWidth && NY >= 0 && NY < GridHeight && GridToCellIndex[NY * GridWidth + NX] != INDEX_NONE)
+					{
+						Neighbors[NumNeighbors++] = GridToCellIndex[NY * GridWidth + NX];
+					}
+				}
+
+				// Exterior: on the grid boundary.
+				const bool bIsExterior = X == 0 || X == GridWidth - 1 || Y == 0 || Y == GridHeight - 1;
+				Emit(CellIndex, MakeArrayView(Corners), Center, bIsExterior, MakeArrayView(Neighbors, NumNeighbors));
+
+				const float DistSq = FVector2D::DistSquared(Center, CenterPoint);
+				if (DistSq < BestCenterDistSq)
+				{
+					BestCenterDistSq = DistSq;
+					CenterCellIndex = CellIndex;
+				}
+			}
+		}
+		return CenterCellIndex;
+	}
+} // namespace
+
+void ULayoutGenerator::BuildGridDiagram(
+	const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight, const FVector2D& Origin, float CellSize, FLayoutDiagram2D& Diagram)
+{
+	Diagram.ResetCellBVH();
+
+	// Map from grid linear index to cell index; the map stays in the diagram for point lookups.
+	FLayoutGridLookup& Lookup = Diagram.WriteGridLookup();
+	Lookup.Origin = FVector2D(static_cast<float>(Origin.X), static_cast<float>(Origin.Y));
+	Lookup.CellSize = CellSize;
+	Lookup.Width = GridWidth;
+	Lookup.Height = GridHeight;
+	const int32 NumCells = NumberGridCells(Grid, GridWidth * GridHeight, Lookup.GridToCellIndex);
+
+	// Cells that survive from a previous call keep their vertex and neighbor allocations.
+	Diagram.Cells.SetNum(NumCells, EAllowShrinking::No);
+	Diagram.CenterCellIndex = EmitGridCells(Lookup.GridToCellIndex,
+		GridWidth,
+		GridHeight,
+		Origin,
+		CellSize,
+		Diagram.CenterPoint,
+		[&Diagram](int32 CellIndex, TArrayView<const FVector2D> Corners, const FVector2D& Center, bool bExterior, TArrayView<const int32> Neighbors) {
+			FLayoutCell2D& Cell = Diagram.Cells[CellIndex];
+			Cell.CellIndex = CellIndex;
+			Cell.Vertices.Reset();
+			Cell.Vertices.Append(Corners.GetData(), Corners.Num());
+			Cell.Neighbors.Reset();
+			Cell.Neighbors.Append(Neighbors.GetData(), Neighbors.Num());
+			Cell.Center = Center;
+			Cell.bIsExterior = bExterior;
+		});
+}
+
+FLayoutDiagramCompact ULayoutGenerator::ConvertGridToCompact(const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight) const
+{
+	FLayoutDiagramCompact Compact;
+	TArray<int32>		  GridToCellIndex;
+	ConvertGridToCompact(Grid, GridWidth, GridHeight, Compact, GridToCellIndex);
+	return Compact;
+}
+
+void ULayoutGenerator::ConvertGridToCompact(
+	const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight, FLayoutDiagramCompact& Compact, TArray<int32>& GridToCellIndex) const
+{
+	Compact.Reset();
+	Compact.Bounds = Bounds;
+	Compact.Seed = Seed;
+	Compact.CenterPoint = CenterPoint;
+
+	const int32 NumCells = NumberGridCells(Grid, GridWidth * GridHeight, GridToCellIndex);
+	Compact.Reserve(NumCells, NumCells * 4, NumCells * 4);
+
+	// Cells are emitted in index order, so each cell's CSR neighbor row follows directly.
+	Compact.CenterCellIndex = EmitGridCells(GridToCellIndex,
+		GridWidth,
+		GridHeight,
+		Bounds.Min,
+		static_cast<float>(GridSize),
+		CenterPoint,
+		[&Compact](int32 CellIndex, TArrayView<const FVector2D> Corners, const FVector2D& Center, bool bExterior, TArrayView<const int32> Neighbors) {
+			Compact.AddCell(Corners, Center, bExterior);
+			for (const int32 Neighbor : Neighbors)
+			{
+				Compact.AddNeighbor(Neighbor);
+			}
+			Compact.FinishNeighbors();
+		});
+}
+
+FLayoutDiagram2D ULayoutGenerator::ConvertGridToRectDiagram(
+	const TArray<bool>& Grid, const TArray<int32>& GroupIds, int32 GridWidth, int32 GridHeight, int32 CenterX, int32 CenterY) const
+{
+	FLayoutDiagram2D Diagram;
+	ConvertGridToRectDiagram(Grid, GroupIds, GridWidth, GridHeight, CenterX, CenterY, Diagram);
+	return Diagram;
+}
+
+void ULayoutGenerator::ConvertGridToRectDiagram(const TArray<bool>& Grid,
+	const TArray<int32>&											 GroupIds,
+	int32															 GridWidth,
+	int32															 GridHeight,
+	int32															 CenterX,
+	int32															 CenterY,
+	FLayoutDiagram2D&												 Diagram) const
+{
 	Diagram.Bounds = Bounds;
 	Diagram.Seed = Seed;
 	Diagram.CenterPoint = CenterPoint;
 	Diagram.CenterCellIndex = INDEX_NONE;
+	Diagram.ResetCellBVH();
 
 	const float CellSize = static_cast<float>(GridSize);
 	const float MinX = Bounds.Min.X;
 	const float MinY = Bounds.Min.Y;
 
-	// Map from grid linear index to cell index
-	TArray<int32> GridToCellIndex;
-	GridToCellIndex.Init(INDEX_NONE, GridWidth * GridHeight);
-
-	// First pass: create cells for carved grid positions
+	// Map from grid linear index to the rectangle (cell) covering it; kept in the diagram for point lookups.
+	FLayoutGridLookup& Lookup = Diagram.WriteGridLookup();
+	Lookup.Origin = FVector2D(MinX, MinY);
+	Lookup.CellSize = CellSize;
+	Lookup.Width = GridWidth;
+	Lookup.Height = GridHeight;
+	TArray<int32>& GridToCellIndex = Lookup.GridToCellIndex;
+	InitReusing(GridToCellIndex, static_cast<int32>(INDEX_NONE), GridWidth * GridHeight);
+
+	auto IsFree = [&](int32 X, int32 Y, int32 Group) {
+		const int32 Index = Y * GridWidth + X;
+		return Grid[Index] && GridToCellIndex[Index] == INDEX_NONE && GroupIds[Index] == Group;
+	};
+
+	// First pass: greedy row-major cover. Each unclaimed floor cell starts a rectangle that grows right
+	// while the row stays free and in the same group, then up while the whole span does. Cells that survive
+	// from a previous call keep their vertex and neighbor allocations.
+	int32 NumCells = 0;
 	for (int32 Y = 0; Y < GridHeight; ++Y)
 	{
 		for (int32 X = 0; X < GridWidth; ++X)
 		{
 			const int32 GridIndex = Y * GridWidth + X;
-			if (!Grid[GridIndex])
+			if (!Grid[GridIndex] || GridToCellIndex[GridIndex] != INDEX_NONE)
 			{
 				continue;
 			}
 
-			const int32 CellIndex = Diagram.Cells.Num();
-			GridToCellIndex[GridIndex] = CellIndex;
+			const int32 Group = GroupIds[GridIndex];
+			int32		X1 = X + 1;
+			while (X1 < GridWidth && IsFree(X1, Y, Group))
+			{
+				++X1;
+			}
+			int32 Y1 = Y + 1;
+			for (; Y1 < GridHeight; ++Y1)
+			{
+				bool bRowFree = true;
+				for (int32 RX = X; RX < X1 && bRowFree; ++RX)
+				{
+					bRowFree = IsFree(RX, Y1, Group);
+				}
+				if (!bRowFree)
+				{
+					break;
+				}
+			}
+
+			const int32 CellIndex = NumCells++;
+			for (int32 RY = Y; RY < Y1; ++RY)
+			{
+				for (int32 RX = X; RX < X1; ++RX)
+				{
+					GridToCellIndex[RY * GridWidth + RX] = CellIndex;
+				}
+			}
 
-			FLayoutCell2D Cell;
+			FLayoutCell2D& Cell = CellIndex < Diagram.Cells.Num() ? Diagram.Cells[CellIndex] : Diagram.Cells.AddDefaulted_GetRef();
 			Cell.CellIndex = CellIndex;
 
 			// CCW rectangle vertices
-			const float X0 = MinX + X * CellSize;
-			const float Y0 = MinY + Y * CellSize;
-			const float X1 = MinX + (X + 1) * CellSize;
-			const float Y1 = MinY + (Y + 1) * CellSize;
-
-			Cell.Vertices.SetNum(4);
-			Cell.Vertices[0] = FVector2D(X0, Y0); // bottom-left
-			Cell.Vertices[1] = FVector2D(X1, Y0); // bottom-right
-			Cell.Vertices[2] = FVector2D(X1, Y1); // top-right
-			Cell.Vertices[3] = FVector2D(X0, Y1); // top-left
-
-			Cell.Center = FVector2D(MinX + (X + 0.5f) * CellSize, MinY + (Y + 0.5f) * CellSize);
-
-			// bIsExterior: on grid boundary or adjacent to an uncarved cell at grid edge
-			Cell.bIsExterior = (X == 0 || X == GridWidth - 1 || Y == 0 || Y == GridHeight - 1);
-
-			Diagram.Cells.Add(Cell);
+			const float WX0 = MinX + X * CellSize;
+			const float WY0 = MinY + Y * CellSize;
+			const float WX1 = MinX + X1 * CellSize;
+			const float WY1 = MinY + Y1 * CellSize;
+
+			Cell.Vertices.SetNum(4, EAllowShrinking::No);
+			Cell.Vertices[0] = FVector2D(WX0, WY0); // bottom-left
+			Cell.Vertices[1] = FVector2D(WX1, WY0); // bottom-right
+			Cell.Vertices[2] = FVector2D(WX1, WY1); // top-right
+			Cell.Vertices[3] = FVector2D(WX0, WY1); // top-left
+			Cell.Neighbors.Reset();
+
+			Cell.Center = FVector2D((WX0 + WX1) * 0.5f, (WY0 + WY1) * 0.5f);
+			Cell.bIsExterior = (X == 0 || X1 == GridWidth || Y == 0 || Y1 == GridHeight);
 		}
 	}
+	Diagram.Cells.SetNum(NumCells, EAllowShrinking::No);
 
-	// Second pass: compute neighbors and find center cell
-	float		BestCenterDistSq = FLT_MAX;
-	const int32 DX[] = { 1, -1, 0, 0 };
-	const int32 DY[] = { 0, 0, 1, -1 };
-
+	// Second pass: adjacency from 4-neighbour contacts across rectangle borders, deduplicated per cell and sorted.
 	for (int32 Y = 0; Y < GridHeight; ++Y)
 	{
 		for (int32 X = 0; X < GridWidth; ++X)
 		{
-			const int32 GridIndex = Y * GridWidth + X;
-			const int32 CellIndex = GridToCellIndex[GridIndex];
-			if (CellIndex == INDEX_NONE)
+			const int32 A = GridToCellIndex[Y * GridWidth + X];
+			if (A == INDEX_NONE)
 			{
 				continue;
 			}
-
-			FLayoutCell2D& Cell = Diagram.Cells[CellIndex];
-
-			for (int32 Dir = 0; Dir < 4; ++Dir)
+			const int32 Right = (X + 1 < GridWidth) ? GridToCellIndex[Y * GridWidth + X + 1] : INDEX_NONE;
+			const int32 Up = (Y + 1 < GridHeight) ? GridToCellIndex[(Y + 1) * GridWidth + X] : INDEX_NONE;
+			for (const int32 B : { Right, Up })
 			{
-				const int32 NX = X + DX[Dir];
-				const int32 NY = Y + DY[Dir];
-
-				if (NX >= 0 && NX < GridWidth && NY >= 0 && NY < GridHeight)
+				if (B != INDEX_NONE && B != A)
 				{
-					const int32 NeighborCellIndex = GridToCellIndex[NY * GridWidth + NX];
-					if (NeighborCellIndex != INDEX_NONE)
-					{
-						Cell.Neighbors.Add(NeighborCellIndex);
-					}
+					Diagram.Cells[A].Neighbors.AddUnique(B);
+					Diagram.Cells[B].Neighbors.AddUnique(A);
 				}
 			}
+		}
+	}
+	for (FLayoutCell2D& Cell : Diagram.Cells)
+	{
+		Cell.Neighbors.Sort();
+	}
 
+	// Center: the rectangle covering the center cell, else the rectangle whose center is nearest CenterPoint.
+	if (CenterX >= 0 && CenterX < GridWidth && CenterY >= 0 && CenterY < GridHeight)
+	{
+		Diagram.CenterCellIndex = GridToCellIndex[CenterY * GridWidth + CenterX];
+	}
+	if (Diagram.CenterCellIndex == INDEX_NONE)
+	{
+		float BestCenterDistSq = FLT_MAX;
+		for (const FLayoutCell2D& Cell : Diagram.Cells)
+		{
 			const float DistSq = FVector2D::DistSquared(Cell.Center, CenterPoint);
 			if (DistSq < BestCenterDistSq)
 			{
 				BestCenterDistSq = DistSq;
-				Diagram.CenterCellIndex = CellIndex;
+				Diagram.CenterCellIndex = Cell.CellIndex;
 			}
 		}
 	}
-
-	return Diagram;
 }
 
 void ULayoutGenerator::FloodFillRegions(const TArray<bool>& Grid,
@@ -162,13 +507,15 @@ void ULayoutGenerator::FloodFillRegions(const TArray<bool>& Grid,
 	int32&													OutCenterRegionId)
 {
 	const int32 TotalCells = GridWidth * GridHeight;
-	OutRegionIds.Init(-1, TotalCells);
-	OutRegions.Reset();
+	InitReusing(OutRegionIds, -1, TotalCells);
 	OutCenterRegionId = -1;
 
 	const int32 DX[] = { 1, -1, 0, 0 };
 	const int32 DY[] = { 0, 0, 1, -1 };
 
+	// Region arrays from a previous call are reused in place and only trimmed at the end.
+	int32 NumRegions = 0;
+
 	for (int32 Y = 0; Y < GridHeight; ++Y)
 	{
 		for (int32 X = 0; X < GridWidth; ++X)
@@ -179,18 +526,22 @@ void ULayoutGenerator::FloodFillRegions(const TArray<bool>& Grid,
 				continue;
 			}
 
-			const int32		   RegionId = OutRegions.Num();
-			TArray<FIntPoint>& Region = OutRegions.AddDefaulted_GetRef();
+			const int32 RegionId = NumRegions++;
+			if (RegionId == OutRegions.Num())
+			{
+				OutRegions.AddDefaulted();
+			}
+			TArray<FIntPoint>& Region = OutRegions[RegionId];
+			Region.Reset();
 
-			TArray<FIntPoint> Queue;
-			Queue.Add(FIntPoint(X, Y));
+			// The region list doubles as the BFS queue: cells are appended in visit order and never removed.
+			Region.Add(FIntPoint(X, Y));
 			OutRegionIds[Index] = RegionId;
 			int32 Head = 0;
 
-			while (Head < Queue.Num())
+			while (Head < Region.Num())
 			{
-				const FIntPoint Cell = Queue[Head++];
-				Region.Add(Cell);
+				const FIntPoint Cell = Region[Head++];
 
 				for (int32 Dir = 0; Dir < 4; ++Dir)
 				{
@@ -202,7 +553,7 @@ void ULayoutGenerator::FloodFillRegions(const TArray<bool>& Grid,
 						if (Grid[NIndex] && OutRegionIds[NIndex] < 0)
 						{
 							OutRegionIds[NIndex] = RegionId;
-							Queue.Add(FIntPoint(NX, NY));
+							Region.Add(FIntPoint(NX, NY));
 						}
 					}
 				}
@@ -218,4 +569,6 @@ void ULayoutGenerator::FloodFillRegions(const TArray<bool>& Grid,
 			}
 		}
 	}
-}
\ No newline at end of file
+
+	OutRegions.SetNum(NumRegions, EAllowShrinking::No);
+}
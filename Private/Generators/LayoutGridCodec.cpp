@@ -0,0 +1,220 @@
+#include "Generators/LayoutGridCodec.h"
+
+namespace
+{
+	FORCEINLINE void WriteVarint(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(Value | 0x80));
+			Value >>= 7;
+		}
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	FORCEINLINE bool ReadVarint(TArrayView<const uint8> Bytes, int32& Cursor, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (Cursor >= Bytes.Num())
+			{
+				return false;
+			}
+			const uint8 Byte = Bytes[Cursor++];
+			OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Zigzag of the wrapping difference Value - Previous, so small steps in either direction stay small. */
+	FORCEINLINE uint32 ZigZagDelta(int32 Value, int32 Previous)
+	{
+		const uint32 Delta = static_cast<uint32>(Value) - static_cast<uint32>(Previous);
+		return (Delta << 1) ^ (0u - (Delta >> 31));
+	}
+
+	FORCEINLINE int32 UnZigZagDelta(uint32 ZigZag, int32 Previous)
+	{
+		const uint32 Delta = (ZigZag >> 1) ^ (0u - (ZigZag & 1));
+		return static_cast<int32>(static_cast<uint32>(Previous) + Delta);
+	}
+
+	template <typename ElementType>
+	void EncodeGridImpl(TArrayView<const ElementType> Cells, int32 Width, TArray<uint8>& Out)
+	{
+		check(Width > 0 || Cells.Num() == 0);
+		Out.Reserve(Out.Num() + 16 + Cells.Num() / 8);
+		WriteVarint(Out, static_cast<uint32>(Width));
+
+		int32 Previous = 0;
+		for (int32 RowStart = 0; RowStart < Cells.Num(); RowStart += Width)
+		{
+			const int32 RowEnd = FMath::Min(RowStart + Width, Cells.Num());
+			for (int32 i = RowStart; i < RowEnd;)
+			{
+				int32 CopyLen = 0;
+				if (RowStart > 0)
+				{
+					while (i + CopyLen < RowEnd && Cells[i + CopyLen] == Cells[i + CopyLen - Width])
+					{
+						++CopyLen;
+					}
+				}
+				int32 LiteralLen = 1;
+				while (i + LiteralLen < RowEnd && Cells[i + LiteralLen] == Cells[i])
+				{
+					++LiteralLen;
+				}
+
+				if (CopyLen >= LiteralLen)
+				{
+					WriteVarint(Out, (static_cast<uint32>(CopyLen - 1) << 1) | 1);
+					i += CopyLen;
+				}
+				else
+				{
+					const int32 Value = static_cast<int32>(Cells[i]);
+					WriteVarint(Out, static_cast<uint32>(LiteralLen - 1) << 1);
+					WriteVarint(Out, ZigZagDelta(Value, Previous));
+					Previous = Value;
+					i += LiteralLen;
+				}
+			}
+		}
+	}
+
+	template <typename ElementType>
+	bool DecodeGridImpl(TArrayView<const uint8> Bytes, int32 Count, TArray<ElementType>& Out, int64 MinValue, int64 MaxValue)
+	{
+		int32  Cursor = 0;
+		uint32 Width = 0;
+		if (Count < 0 || !ReadVarint(Bytes, Cursor, Width) || (Count > 0 && (Width == 0 || Width > static_cast<uint32>(MAX_int32))))
+		{
+			return false;
+		}
+		// Every row costs at least one token byte, so a count the bytes cannot cover fails before allocating.
+		if (Count > 0 && (static_cast<int64>(Count) + Width - 1) / Width > Bytes.Num() - Cursor)
+		{
+			return false;
+		}
+
+		Out.SetNumUninitialized(Count);
+		ElementType* Data = Out.GetData();
+		int32		 Previous = 0;
+		for (int64 RowStart = 0; RowStart < Count; RowStart += Width)
+		{
+			const int32 RowEnd = static_cast<int32>(FMath::Min<int64>(RowStart + Width, Count));
+			for (int32 i = static_cast<int32>(RowStart); i < RowEnd;)
+			{
+				uint32 Token = 0;
+				if (!ReadVarint(Bytes, Cursor, Token) || (Token >> 1) >= static_cast<uint32>(RowEnd - i))
+				{
+					return false;
+				}
+				const int32 Run = static_cast<int32>(Token >> 1) + 1;
+
+				if (Token & 1)
+				{
+					if (RowStart == 0)
+					{
+						return false;
+					}
+					// Source and destination never overlap: a run ends within its row.
+					FMemory::Memcpy(Data + i, Data + i - Width, Run * sizeof(ElementType));
+				}
+				else
+				{
+					uint32 ZigZag = 0;
+					if (!ReadVarint(Bytes, Cursor, ZigZag))
+					{
+						return false;
+					}
+					const int32 Value = UnZigZagDelta(ZigZag, Previous);
+					if (Value < MinValue || Value > MaxValue)
+					{
+						return false;
+					}
+					Previous = Value;
+					const ElementType Element = static_cast<ElementType>(Value);
+					for (int32 k = 0; k < Run; ++k)
+					{
+						Data[i + k] = Element;
+					}
+				}
+				i += Run;
+			}
+		}
+		return Cursor == Bytes.Num();
+	}
+} // namespace
+
+void FLayoutGridCodec::EncodeGrid(TArrayView<const bool> Cells, int32 Width, TArray<uint8>& Out)
+{
+	EncodeGridImpl(Cells, Width, Out);
+}
+
+void FLayoutGridCodec::EncodeGrid(TArrayView<const uint8> Cells, int32 Width, TArray<uint8>& Out)
+{
+	EncodeGridImpl(Cells, Width, Out);
+}
+
+void FLayoutGridCodec::EncodeGrid(TArrayView<const int32> Cells, int32 Width, TArray<uint8>& Out)
+{
+	EncodeGridImpl(Cells, Width, Out);
+}
+
+bool FLayoutGridCodec::DecodeGrid(TArrayView<const uint8> Bytes, int32 Count, TArray<bool>& Out)
+{
+	return DecodeGridImpl(Bytes, Count, Out, 0, 1);
+}
+
+bool FLayoutGridCodec::DecodeGrid(TArrayView<const uint8> Bytes, int32 Count, TArray<uint8>& Out)
+{
+	return DecodeGridImpl(Bytes, Count, Out, 0, MAX_uint8);
+}
+
+bool FLayoutGridCodec::DecodeGrid(TArrayView<const uint8> Bytes, int32 Count, TArray<int32>& Out)
+{
+	return DecodeGridImpl(Bytes, Count, Out, MIN_int32, MAX_int32);
+}
+
+void FLayoutGridCodec::EncodePoints(TArrayView<const FIntPoint> Points, TArray<uint8>& Out)
+{
+	Out.Reserve(Out.Num() + Points.Num() * 2);
+	FIntPoint Previous(0, 0);
+	for (const FIntPoint& Point : Points)
+	{
+		WriteVarint(Out, ZigZagDelta(Point.X, Previous.X));
+		WriteVarint(Out, ZigZagDelta(Point.Y, Previous.Y));
+		Previous = Point;
+	}
+}
+
+bool FLayoutGridCodec::DecodePoints(TArrayView<const uint8> Bytes, int32 Count, TArray<FIntPoint>& Out)
+{
+	// Each point is two varints of at least one byte each.
+	if (Count < 0 || Count > Bytes.Num() / 2)
+	{
+		return false;
+	}
+	Out.SetNumUninitialized(Count);
+	int32	  Cursor = 0;
+	FIntPoint Previous(0, 0);
+	for (FIntPoint& Point : Out)
+	{
+		uint32 ZigZagX = 0;
+		uint32 ZigZagY = 0;
+		if (!ReadVarint(Bytes, Cursor, ZigZagX) || !ReadVarint(Bytes, Cursor, ZigZagY))
+		{
+			return false;
+		}
+		Point = FIntPoint(UnZigZagDelta(ZigZagX, Previous.X), UnZigZagDelta(ZigZagY, Previous.Y));
+		Previous = Point;
+	}
+	return Cursor == Bytes.Num();
+}
@@ -0,0 +1,239 @@
+#include "Generators/LayoutPathFields.h"
+
+#include "Async/ParallelFor.h"
+#include "Generators/LayoutDiagramCompact.h"
+#include "Generators/LayoutFrameArena.h"
+#include "Generators/LayoutGenerator.h"
+#include "ProceduralGeometry.h"
+
+namespace
+{
+	struct FDiagramGraph
+	{
+		const FLayoutDiagram2D& Diagram;
+
+		int32					Num() const { return Diagram.Cells.Num(); }
+		TArrayView<const int32> GetNeighbors(int32 Cell) const { return Diagram.Cells[Cell].Neighbors; }
+		const FVector2D&		GetCenter(int32 Cell) const { return Diagram.Cells[Cell].Center; }
+	};
+
+	struct FCompactGraph
+	{
+		const FLayoutDiagramCompact& Diagram;
+
+		int32					Num() const { return Diagram.Num(); }
+		TArrayView<const int32> GetNeighbors(int32 Cell) const { return Diagram.GetNeighbors(Cell); }
+		const FVector2D&		GetCenter(int32 Cell) const { return Diagram.Centers[Cell]; }
+	};
+
+	struct FQueueEntry
+	{
+		float Distance;
+		int32 Cell;
+
+		// Ties pop in cell order, so the trees (and the next-hop table) do not depend on heap layout.
+		bool operator<(const FQueueEntry& Other) const { return Distance < Other.Distance || (Distance == Other.Distance && Cell < Other.Cell); }
+	};
+
+	/** Dijkstra from Source over center-to-center edge lengths. OutParent[i] is i's predecessor: its next step back to Source. */
+	template <typename GraphType, typename HeapAllocator>
+	void RunDijkstra(
+		const GraphType& Graph, int32 Source, TArrayView<float> OutDistance, TArrayView<int32> OutParent, TArray<FQueueEntry, HeapAllocator>& Heap)
+	{
+		for (int32 i = 0; i < OutDistance.Num(); ++i)
+		{
+			OutDistance[i] = -1.f;
+			OutParent[i] = INDEX_NONE;
+		}
+
+		Heap.Reset();
+		OutDistance[Source] = 0.f;
+		Heap.HeapPush({ 0.f, Source });
+		while (Heap.Num() > 0)
+		{
+			FQueueEntry Entry;
+			Heap.HeapPop(Entry, EAllowShrinking::No);
+			if (Entry.Distance > OutDistance[Entry.Cell])
+			{
+				continue; // stale: the cell was reached more cheaply after this entry was pushed
+			}
+
+			const FVector2D& Center = Graph.GetCenter(Entry.Cell);
+			for (const int32 Neighbor : Graph.GetNeighbors(Entry.Cell))
+			{
+				if (Neighbor < 0 || Neighbor >= Graph.Num())
+				{
+					continue;
+				}
+				const float Candidate = Entry.Distance + static_cast<float>(FVector2D::Distance(Center, Graph.GetCenter(Neighbor)));
+				if (OutDistance[Neighbor] < 0.f || Candidate < OutDistance[Neighbor])
+				{
+					OutDistance[Neighbor] = Candidate;
+					OutParent[Neighbor] = Entry.Cell;
+					Heap.HeapPush({ Candidate, Neighbor });
+				}
+			}
+		}
+	}
+
+	template <typename GraphType>
+	bool CanBuildNextHopTable(const GraphType& Graph, int32 MaxNextHopTableCells)
+	{
+		const int32 Num = Graph.Num();
+		if (Num > MaxNextHopTableCells)
+		{
+			return false;
+		}
+		if (static_cast<int64>(Num) * Num > MAX_int32)
+		{
+			UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[PathFields] %d cells is too many for a next-hop table — skipped."), Num);
+			return false;
+		}
+		for (int32 Cell = 0; Cell < Num; ++Cell)
+		{
+			if (Graph.GetNeighbors(Cell).Num() >= FLayoutPathFields::NoSlot)
+			{
+				UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[PathFields] Cell %d has too many neighbors for a next-hop table — skipped."), Cell);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename GraphType>
+	void BuildFields(const GraphType& Graph, int32 CenterCellIndex, FLayoutPathFields& Out, int32 MaxNextHopTableCells, int32 SourceCell)
+	{
+		Out.Reset();
+		const int32 Num = Graph.Num();
+		const int32 Source = SourceCell != INDEX_NONE ? SourceCell : CenterCellIndex;
+		if (Source < 0 || Source >= Num)
+		{
+			if (Num > 0)
+			{
+				UE_LOG(LogRoguelikeGeometry, Warning, TEXT("[PathFields] Source cell %d is outside the diagram (%d cells)."), Source, Num);
+			}
+			return;
+		}
+
+		Out.NumCells = Num;
+		Out.SourceCellIndex = Source;
+		Out.HopDistance.SetNumUninitialized(Num);
+		Out.Distance.SetNumUninitialized(Num);
+		Out.NextHopToSource.SetNumUninitialized(Num);
+
+		FMemMark Mark(FMemStack::Get());
+
+		// Hops: plain BFS, the queue is the visit order.
+		for (int32& Hops : Out.HopDistance)
+		{
+			Hops = INDEX_NONE;
+		}
+		TFrameArray<int32> Queue;
+		Queue.Reserve(Num);
+		Queue.Add(Source);
+		Out.HopDistance[Source] = 0;
+		for (int32 Head = 0; Head < Queue.Num(); ++Head)
+		{
+			const int32 Cell = Queue[Head];
+			for (const int32 Neighbor : Graph.GetNeighbors(Cell))
+			{
+				if (Neighbor >= 0 && Neighbor < Num && Out.HopDistance[Neighbor] == INDEX_NONE)
+				{
+					Out.HopDistance[Neighbor] = Out.HopDistance[Cell] + 1;
+					Queue.Add(Neighbor);
+				}
+			}
+		}
+
+		TFrameArray<FQueueEntry> Heap;
+		RunDijkstra(Graph, Source, MakeArrayView(Out.Distance), MakeArrayView(Out.NextHopToSource), Heap);
+		Out.FarthestCellIndex = Source;
+		for (int32 Cell = 0; Cell < Num; ++Cell)
+		{
+			if (Out.Distance[Cell] > Out.Distance[Out.FarthestCellIndex])
+			{
+				Out.FarthestCellIndex = Cell;
+			}
+		}
+
+		if (!CanBuildNextHopTable(Graph, MaxNextHopTableCells))
+		{
+			return;
+		}
+
+		// One independent Dijkstra per target row; each row's temporaries live in that task's own frame.
+		Out.NextHopSlots.SetNumUninitialized(Num * Num);
+		ParallelFor(Num, [&Graph, &Out, Num](const int32 Target) {
+			FMemMark				 TargetMark(FMemStack::Get());
+			TFrameArray<float>		 Distance;
+			TFrameArray<int32>		 Parent;
+			TFrameArray<FQueueEntry> TargetHeap;
+			Distance.SetNumUninitialized(Num);
+			Parent.SetNumUninitialized(Num);
+			RunDijkstra(Graph, Target, MakeArrayView(Distance), MakeArrayView(Parent), TargetHeap);
+
+			uint8* Row = Out.NextHopSlots.GetData() + Target * Num;
+			for (int32 Cell = 0; Cell < Num; ++Cell)
+			{
+				Row[Cell] = Parent[Cell] == INDEX_NONE ? FLayoutPathFields::NoSlot : static_cast<uint8>(Graph.GetNeighbors(Cell).Find(Parent[Cell]));
+			}
+		});
+	}
+} // namespace
+
+void FLayoutPathFields::Reset()
+{
+	SourceCellIndex = INDEX_NONE;
+	FarthestCellIndex = INDEX_NONE;
+	HopDistance.Reset();
+	Distance.Reset();
+	NextHopToSource.Reset();
+	NextHopSlots.Reset();
+	NumCells = 0;
+}
+
+int32 FLayoutPathFields::GetNextHop(const FLayoutDiagram2D& Diagram, int32 Cell, int32 Target) const
+{
+	if (Target == SourceCellIndex && NextHopToSource.IsValidIndex(Cell))
+	{
+		return NextHopToSource[Cell];
+	}
+	if (!HasNextHopTable() || Cell < 0 || Cell >= NumCells || Target < 0 || Target >= NumCells)
+	{
+		return INDEX_NONE;
+	}
+	const int32 Slot = GetNextHopSlot(Cell, Target);
+	return Slot == INDEX_NONE ? INDEX_NONE : Diagram.Cells[Cell].Neighbors[Slot];
+}
+
+bool FLayoutPathFields::GetPath(const FLayoutDiagram2D& Diagram, int32 From, int32 Target, TArray<int32>& OutPath) const
+{
+	OutPath.Reset();
+	if (!IsValid() || From < 0 || From >= NumCells || Target < 0 || Target >= NumCells)
+	{
+		return false;
+	}
+
+	OutPath.Add(From);
+	for (int32 Cell = From; Cell != Target;)
+	{
+		Cell = GetNextHop(Diagram, Cell, Target);
+		if (Cell == INDEX_NONE || OutPath.Num() > NumCells)
+		{
+			OutPath.Reset();
+			return false;
+		}
+		OutPath.Add(Cell);
+	}
+	return true;
+}
+
+void FLayoutPathFields::Build(const FLayoutDiagram2D& Diagram, FLayoutPathFields& OutFields, int32 MaxNextHopTableCells, int32 SourceCell)
+{
+	BuildFields(FDiagramGraph{ Diagram }, Diagram.CenterCellIndex, OutFields, MaxNextHopTableCells, SourceCell);
+}
+
+void FLayoutPathFields::Build(const FLayoutDiagramCompact& Diagram, FLayoutPathFields& OutFields, int32 MaxNextHopTableCells, int32 SourceCell)
+{
+	BuildFields(FCompactGraph{ Diagram }, Diagram.CenterCellIndex, OutFields, MaxNextHopTableCells, SourceCell);
+}
@@ -0,0 +1,153 @@
+#include "Generators/LayoutSeedFarm.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "ProceduralGeometry.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include <atomic>
+
+namespace
+{
+	/**
+	 * Shared farm loop. Seeds are claimed in index order from an atomic cursor; once K seeds are accepted, the K-th
+	 * lowest accepted index becomes the cutoff and workers stop claiming seeds past it. Every seed below the cutoff
+	 * has then been claimed, so the kept set is exactly the K lowest accepted indices — deterministic for any worker
+	 * count. Each worker generates into its own scratch context and output, so rejected seeds reuse their memory.
+	 */
+	template <typename GeneratorType, typename GridDataType, typename ScratchType, typename ConfigureType>
+	TLayoutSeedFarmResult<GridDataType> RunFarm(
+		const FLayoutSeedFarmOptions& Options, ConfigureType&& Configure, const TFunction<bool(const GridDataType&)>& Accept, const TCHAR* Label)
+	{
+		TLayoutSeedFarmResult<GridDataType> Result;
+
+		const int32 NumSeeds = Options.Seeds.Num();
+		Result.Stats.SetNum(NumSeeds);
+		for (int32 i = 0; i < NumSeeds; ++i)
+		{
+			Result.Stats[i].Seed = Options.Seeds[i];
+		}
+		if (NumSeeds == 0)
+		{
+			return Result;
+		}
+
+		const int32 MaxAccepted = Options.MaxAccepted > 0 ? Options.MaxAccepted : NumSeeds;
+		const int32 DefaultWorkers = FTaskGraphInterface::IsRunning() ? FTaskGraphInterface::Get().GetNumWorkerThreads() + 1 : 1;
+		const int32 NumWorkers = FMath::Clamp(Options.NumWorkers > 0 ? Options.NumWorkers : DefaultWorkers, 1, NumSeeds);
+
+		// One generator per worker, created and rooted on the calling thread.
+		TArray<TStrongObjectPtr<GeneratorType>> Generators;
+		Generators.Reserve(NumWorkers);
+		for (int32 w = 0; w < NumWorkers; ++w)
+		{
+			GeneratorType* Generator = NewObject<GeneratorType>();
+			Generator->SetBounds(Options.Bounds)->SetGridSize(Options.GridSize);
+			Configure(Generator);
+			Generators.Emplace(Generator);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		std::atomic<int32>	 NextSeed{ 0 };
+		std::atomic<int32>	 Cutoff{ MAX_int32 };
+		FCriticalSection	 AcceptLock;
+		TArray<int32>		 Accepted; // sorted ascending, guarded by AcceptLock
+		TArray<GridDataType> Layouts;  // per seed; only accepted slots are filled
+		Layouts.SetNum(NumSeeds);
+
+		ParallelFor(NumWorkers, [&](const int32 Worker) {
+			GeneratorType* Generator = Generators[Worker].Get();
+			ScratchType	   Scratch;
+			GridDataType   Data;
+			for (;;)
+			{
+				const int32 SeedIdx = NextSeed.fetch_add(1);
+				if (SeedIdx >= NumSeeds || SeedIdx > Cutoff.load())
+				{
+					break;
+				}
+
+				const double			  SeedStart = FPlatformTime::Seconds();
+				FLayoutSeedFarmSeedStats& Stats = Result.Stats[SeedIdx];
+				Generator->SetSeed(Options.Seeds[SeedIdx]);
+				Generator->GenerateWithGridData(Data, Scratch);
+
+				Stats.bEvaluated = true;
+				Stats.bAccepted = !Accept || Accept(Data);
+				Stats.DiagramCells = Data.Diagram.Cells.Num();
+				Stats.Regions = Data.Regions.Num();
+				Stats.ElapsedMs = (FPlatformTime::Seconds() - SeedStart) * 1000.0;
+
+				if (Stats.bAccepted)
+				{
+					FScopeLock Lock(&AcceptLock);
+					Accepted.Insert(SeedIdx, Algo::LowerBound(Accepted, SeedIdx));
+					Layouts[SeedIdx] = MoveTemp(Data);
+					if (Accepted.Num() >= MaxAccepted)
+					{
+						Cutoff.store(Accepted[MaxAccepted - 1]);
+					}
+				}
+			}
+		});
+
+		const int32 Keep = FMath::Min(Accepted.Num(), MaxAccepted);
+		Result.AcceptedSeedIndices.Append(Accepted.GetData(), Keep);
+		Result.AcceptedLayouts.Reserve(Keep);
+		for (const int32 SeedIdx : Result.AcceptedSeedIndices)
+		{
+			Result.AcceptedLayouts.Add(MoveTemp(Layouts[SeedIdx]));
+		}
+
+		int32 Evaluated = 0;
+		for (const FLayoutSeedFarmSeedStats& Stats : Result.Stats)
+		{
+			Evaluated += Stats.bEvaluated ? 1 : 0;
+		}
+		UE_LOG(LogRoguelikeGeometry,
+			Log,
+			TEXT("[SeedFarm] %s: %d/%d accepted from %d evaluated of %d seeds on %d workers in %.2fms"),
+			Label,
+			Keep,
+			MaxAccepted,
+			Evaluated,
+			NumSeeds,
+			NumWorkers,
+			(FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+		return Result;
+	}
+} // namespace
+
+TArray<FString> FLayoutSeedFarm::MakeSeedRange(const FString& Prefix, int32 First, int32 Count)
+{
+	TArray<FString> Seeds;
+	Seeds.Reserve(FMath::Max(0, Count));
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Seeds.Add(FString::Printf(TEXT("%s%d"), *Prefix, First + i));
+	}
+	return Seeds;
+}
+
+TLayoutSeedFarmResult<FDrunkardWalkGridData> FLayoutSeedFarm::RunDrunkardWalk(
+	const FDrunkardWalkResolvedParams& Params, const FLayoutSeedFarmOptions& Options, TFunction<bool(const FDrunkardWalkGridData&)> Accept)
+{
+	return RunFarm<UDrunkardWalkGenerator2D, FDrunkardWalkGridData, FDrunkardWalkScratch>(
+		Options,
+		[&Params](UDrunkardWalkGenerator2D* Generator) {
+			// The farm already spreads seeds across workers; speculative placement would only oversubscribe them.
+			Generator->ApplyResolvedParams(Params)->SetPlacementWorkers(1);
+		},
+		Accept,
+		TEXT("DrunkardWalk"));
+}
+
+TLayoutSeedFarmResult<FCellularAutomataGridData> FLayoutSeedFarm::RunCellularAutomata(
+	const FCellularAutomataResolvedParams& Params, const FLayoutSeedFarmOptions& Options, TFunction<bool(const FCellularAutomataGridData&)> Accept)
+{
+	return RunFarm<UCellularAutomataGenerator2D, FCellularAutomataGridData, FCellularAutomataScratch>(
+		Options, [&Params](UCellularAutomataGenerator2D* Generator) { Generator->ApplyResolvedParams(Params); }, Accept, TEXT("CellularAutomata"));
+}
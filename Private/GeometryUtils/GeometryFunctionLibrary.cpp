@@ -1,5 +1,9 @@
 ﻿#include "GeometryUtils/GeometryFunctionLibrary.h"
 
+#include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
+#include "Misc/MemStack.h"
+
 bool FGeometryUtils::SortPlaneVerticesByAngle(const TArray<FVector2D>& InVertices, TArray<FVector2D>& OutSortedVertices)
 {
 	if (InVertices.Num() < 3)
@@ -616,3 +620,649 @@ void FGeometryUtils::OffsetPolylineToRibbon(const TArray<FVector2D>& Polyline, c
 		OutRibbon.Add(Polyline[i] - Nrm[i] * H);
 	}
 }
+
+namespace
+{
+	/** Strict (proper) segment crossing test; shared endpoints and collinear touching do not count. */
+	bool SegmentsCrossProperly(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D)
+	{
+		const double D1 = FVector2D::CrossProduct(B - A, C - A);
+		const double D2 = FVector2D::CrossProduct(B - A, D - A);
+		const double D3 = FVector2D::CrossProduct(D - C, A - C);
+		const double D4 = FVector2D::CrossProduct(D - C, B - C);
+		return ((D1 > 0.0 && D2 < 0.0) || (D1 < 0.0 && D2 > 0.0)) && ((D3 > 0.0 && D4 < 0.0) || (D3 < 0.0 && D4 > 0.0));
+	}
+
+	/** Lexicographic (X, then Y) ordering used to pick a traversal direction independent of the input winding. */
+	bool LexicographicLess(const FVector2D& A, const FVector2D& B)
+	{
+		return A.X < B.X || (A.X == B.X && A.Y < B.Y);
+	}
+
+	/** Iterative Douglas-Peucker over the open chain Points; sets Keep[i] for every retained interior point. */
+	void DouglasPeuckerChain(const TArray<FVector2D>& Points, const double ToleranceSq, TArray<bool>& Keep)
+	{
+		TArray<TPair<int32, int32>, TInlineAllocator<32>> Stack;
+		Stack.Emplace(0, Points.Num() - 1);
+
+		while (Stack.Num() > 0)
+		{
+			const TPair<int32, int32> Span = Stack.Pop(EAllowShrinking::No);
+			const FVector2D&		  A = Points[Span.Key];
+			const FVector2D&		  B = Points[Span.Value];
+			const FVector2D			  AB = B - A;
+			const double			  LenSq = AB.SizeSquared();
+
+			double MaxDistSq = -1.0;
+			int32  MaxIndex = INDEX_NONE;
+			for (int32 i = Span.Key + 1; i < Span.Value; ++i)
+			{
+				const FVector2D AP = Points[i] - A;
+				double			DistSq;
+				if (LenSq < UE_SMALL_NUMBER)
+				{
+					DistSq = AP.SizeSquared();
+				}
+				else
+				{
+					const double Cross = FVector2D::CrossProduct(AB, AP);
+					DistSq = Cross * Cross / LenSq;
+				}
+				if (DistSq > MaxDistSq)
+				{
+					MaxDistSq = DistSq;
+					MaxIndex = i;
+				}
+			}
+
+			if (MaxIndex != INDEX_NONE && MaxDistSq > ToleranceSq)
+			{
+				Keep[MaxIndex] = true;
+				Stack.Emplace(Span.Key, MaxIndex);
+				Stack.Emplace(MaxIndex, Span.Value);
+			}
+		}
+	}
+
+	/** One anchor-to-anchor run of an outline, stored in canonical direction and shared by every outline that walks it. */
+	struct FSimplifyChain
+	{
+		TArray<FVector2D> Points;
+		TArray<bool>	  Keep;
+		double			  ToleranceSq = 0.0;
+		bool			  bDirty = true;
+	};
+
+	/** An outline's use of a chain; bReversed when the outline walks it against the canonical direction. */
+	struct FSimplifyChainRef
+	{
+		int32 Chain = INDEX_NONE;
+		bool  bReversed = false;
+	};
+
+	/** A point of one polygon tested against another outline, with its side of the exact outline. */
+	struct FContainmentProbe
+	{
+		int32	  Polygon = INDEX_NONE;
+		FVector2D Point = FVector2D::ZeroVector;
+		bool	  bInside = false;
+	};
+
+	/** Twice the signed area (positive for CCW). */
+	double SignedArea2(const TArray<FVector2D>& Polygon)
+	{
+		double Area2 = 0.0;
+		for (int32 i = 0, j = Polygon.Num() - 1; i < Polygon.Num(); j = i++)
+		{
+			Area2 += FVector2D::CrossProduct(Polygon[j], Polygon[i]);
+		}
+		return Area2;
+	}
+
+	bool PointOnOutline(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+	{
+		for (int32 i = 0, j = Polygon.Num() - 1; i < Polygon.Num(); j = i++)
+		{
+			const FVector2D A = Polygon[j];
+			const FVector2D AB = Polygon[i] - A;
+			const FVector2D AP = Point - A;
+			const double	LenSq = AB.SizeSquared();
+			const double	Cross = FVector2D::CrossProduct(AB, AP);
+			const double	Dot = FVector2D::DotProduct(AB, AP);
+			if (Cross * Cross <= UE_KINDA_SMALL_NUMBER * LenSq && Dot >= 0.0 && Dot <= LenSq)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Sets OutBad for every chain with a kept segment that properly crosses another; segments are bucketed on a uniform grid. */
+	void MarkCrossingChains(const TArray<FSimplifyChain>& Chains, TArray<bool>& OutBad)
+	{
+		struct FSegment
+		{
+			FVector2D A;
+			FVector2D B;
+			int32	  Chain;
+		};
+
+		TArray<FSegment> Segments;
+		FBox2D			 Box(ForceInit);
+		for (int32 c = 0; c < Chains.Num(); ++c)
+		{
+			const FSimplifyChain& Chain = Chains[c];
+			for (int32 Prev = 0, i = 1; i < Chain.Points.Num(); ++i)
+			{
+				if (Chain.Keep[i])
+				{
+					Segments.Add({ Chain.Points[Prev], Chain.Points[i], c });
+					Box += Chain.Points[i];
+					Prev = i;
+				}
+			}
+			if (Chain.Points.Num() > 0)
+			{
+				Box += Chain.Points[0];
+			}
+		}
+		if (Segments.Num() < 2)
+		{
+			return;
+		}
+
+		const int32		Side = FMath::Clamp(FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(Segments.Num()))), 1, 256);
+		const FVector2D BucketSize = (Box.GetSize() / Side).ComponentMax(FVector2D(UE_KINDA_SMALL_NUMBER, UE_KINDA_SMALL_NUMBER));
+
+		auto BucketOf = [&](const FVector2D& P) {
+			const FVector2D Local = (P - Box.Min) / BucketSize;
+			return FIntPoint(FMath::Clamp(FMath::FloorToInt32(Local.X), 0, Side - 1), FMath::Clamp(FMath::FloorToInt32(Local.Y), 0, Side - 1));
+		};
+
+		TArray<TArray<int32>> Buckets;
+		Buckets.SetNum(Side * Side);
+		for (int32 s = 0; s < Segments.Num(); ++s)
+		{
+			const FIntPoint Lo = BucketOf(Segments[s].A.ComponentMin(Segments[s].B));
+			const FIntPoint Hi = BucketOf(Segments[s].A.ComponentMax(Segments[s].B));
+			for (int32 Y = Lo.Y; Y <= Hi.Y; ++Y)
+			{
+				for (int32 X = Lo.X; X <= Hi.X; ++X)
+				{
+					Buckets[Y * Side + X].Add(s);
+				}
+			}
+		}
+
+		for (const TArray<int32>& Bucket : Buckets)
+		{
+			for (int32 i = 0; i < Bucket.Num(); ++i)
+			{
+				const FSegment& S = Segments[Bucket[i]];
+				for (int32 j = i + 1; j < Bucket.Num(); ++j)
+				{
+					const FSegment& T = Segments[Bucket[j]];
+					if ((!OutBad[S.Chain] || !OutBad[T.Chain]) && SegmentsCrossProperly(S.A, S.B, T.A, T.B))
+					{
+						OutBad[S.Chain] = true;
+						OutBad[T.Chain] = true;
+					}
+				}
+			}
+		}
+	}
+} // namespace
+
+void FGeometryUtils::SimplifyPolygonDouglasPeucker(TArray<FVector2D>& Vertices, const float Tolerance, const TArray<bool>& Locked)
+{
+	TArray<FVector2D>* const Polygons[] = { &Vertices };
+	SimplifyPolygonSetDouglasPeucker(Polygons, Tolerance, TArrayView<const TArray<bool>>(&Locked, 1));
+}
+
+void FGeometryUtils::SimplifyPolygonSetDouglasPeucker(
+	TArrayView<TArray<FVector2D>* const> Polygons, const float Tolerance, TArrayView<const TArray<bool>> Locked)
+{
+	if (Tolerance <= 0.0f)
+	{
+		return;
+	}
+
+	const int32	 NumPolygons = Polygons.Num();
+	const double ToleranceSq = static_cast<double>(Tolerance) * static_cast<double>(Tolerance);
+
+	// --- Split each outline into anchor-to-anchor chains; a chain walked by several outlines is stored once ---
+	TArray<FSimplifyChain>			  Chains;
+	TArray<TArray<FSimplifyChainRef>> PolygonChains;
+	TMultiMap<uint32, int32>		  ChainsByHash;
+	TArray<int32>					  Anchors;
+	TArray<FVector2D>				  ChainPoints;
+	PolygonChains.SetNum(NumPolygons);
+
+	for (int32 p = 0; p < NumPolygons; ++p)
+	{
+		const TArray<FVector2D>& Vertices = *Polygons[p];
+		const int32				 N = Vertices.Num();
+		if (N < 3)
+		{
+			continue;
+		}
+
+		// Locked vertices, topped up to two so every chain has distinct endpoints; a triangle keeps all three.
+		Anchors.Reset();
+		for (int32 i = 0; i < N; ++i)
+		{
+			if (N == 3 || (Locked.IsValidIndex(p) && Locked[p].IsValidIndex(i) && Locked[p][i]))
+			{
+				Anchors.Add(i);
+			}
+		}
+		if (Anchors.Num() == 0)
+		{
+			int32 MinIndex = 0;
+			for (int32 i = 1; i < N; ++i)
+			{
+				if (LexicographicLess(Vertices[i], Vertices[MinIndex]))
+				{
+					MinIndex = i;
+				}
+			}
+			Anchors.Add(MinIndex);
+		}
+		if (Anchors.Num() == 1)
+		{
+			// Farthest vertex, ties broken by position so both windings pick the same one.
+			int32  FarIndex = INDEX_NONE;
+			double FarDistSq = -1.0;
+			for (int32 i = 0; i < N; ++i)
+			{
+				const double DistSq = FVector2D::DistSquared(Vertices[i], Vertices[Anchors[0]]);
+				if (i != Anchors[0] && (DistSq > FarDistSq || (DistSq == FarDistSq && LexicographicLess(Vertices[i], Vertices[FarIndex]))))
+				{
+					FarDistSq = DistSq;
+					FarIndex = i;
+				}
+			}
+			Anchors.Add(FarIndex);
+			Anchors.Sort();
+		}
+
+		for (int32 a = 0; a < Anchors.Num(); ++a)
+		{
+			const int32 Start = Anchors[a];
+			const int32 End = Anchors[(a + 1) % Anchors.Num()];
+
+			ChainPoints.Reset();
+			for (int32 i = Start;; i = (i + 1) % N)
+			{
+				ChainPoints.Add(Vertices[i]);
+				if (i == End && ChainPoints.Num() > 1)
+				{
+					break;
+				}
+			}
+
+			// Canonical direction: lexicographically smaller end first; a chain closing on itself compares its second points.
+			const FVector2D& First = ChainPoints[0];
+			const FVector2D& Last = ChainPoints.Last();
+			const bool		 bReversed = LexicographicLess(Last, First)
+				|| (Last == First && ChainPoints.Num() > 2 && LexicographicLess(ChainPoints.Last(1), ChainPoints[1]));
+			if (bReversed)
+			{
+				Algo::Reverse(ChainPoints);
+			}
+
+			const uint32 Hash = FCrc::MemCrc32(ChainPoints.GetData(), ChainPoints.Num() * sizeof(FVector2D));
+			int32		 ChainIndex = INDEX_NONE;
+			for (TMultiMap<uint32, int32>::TConstKeyIterator It = ChainsByHash.CreateConstKeyIterator(Hash); It; ++It)
+			{
+				if (Chains[It.Value()].Points == ChainPoints)
+				{
+					ChainIndex = It.Value();
+					break;
+				}
+			}
+			if (ChainIndex == INDEX_NONE)
+			{
+				ChainIndex = Chains.Num();
+				FSimplifyChain& Chain = Chains.AddDefaulted_GetRef();
+				Chain.Points = ChainPoints;
+				Chain.ToleranceSq = ToleranceSq;
+				ChainsByHash.Add(Hash, ChainIndex);
+			}
+			PolygonChains[p].Add({ ChainIndex, bReversed });
+		}
+	}
+
+	// --- Exact reference: signed areas, and for each pair of overlapping boxes an anchor of one off the other's outline ---
+	TArray<double>			  ExactArea2;
+	TArray<FBox2D>			  Boxes;
+	TArray<FContainmentProbe> Probes;
+	ExactArea2.SetNumZeroed(NumPolygons);
+	Boxes.Init(FBox2D(ForceInit), NumPolygons);
+	for (int32 p = 0; p < NumPolygons; ++p)
+	{
+		if (PolygonChains[p].Num() > 0)
+		{
+			ExactArea2[p] = SignedArea2(*Polygons[p]);
+			Boxes[p] = FBox2D(*Polygons[p]);
+		}
+	}
+	for (int32 p = 0; p < NumPolygons; ++p)
+	{
+		for (int32 q = 0; q < NumPolygons; ++q)
+		{
+			if (p == q || PolygonChains[p].Num() == 0 || PolygonChains[q].Num() == 0 || !Boxes[p].Intersect(Boxes[q]))
+			{
+				continue;
+			}
+			for (const FSimplifyChainRef& Ref : PolygonChains[q])
+			{
+				const TArray<FVector2D>& Points = Chains[Ref.Chain].Points;
+				const FVector2D&		 Anchor = Ref.bReversed ? Points.Last() : Points[0];
+				if (!PointOnOutline(*Polygons[p], Anchor))
+				{
+					Probes.Add({ p, Anchor, PointInPolygon(*Polygons[p], Anchor) });
+					break;
+				}
+			}
+		}
+	}
+
+	// --- Simplify, check, and halve the tolerance of every chain involved in a topology change until none is left ---
+	const double			  MinToleranceSq = ToleranceSq / 4096.0;
+	TArray<TArray<FVector2D>> Results;
+	TArray<bool>			  Bad;
+	Results.SetNum(NumPolygons);
+
+	for (;;)
+	{
+		for (FSimplifyChain& Chain : Chains)
+		{
+			if (!Chain.bDirty)
+			{
+				continue;
+			}
+			Chain.bDirty = false;
+			Chain.Keep.Init(Chain.ToleranceSq <= 0.0, Chain.Points.Num());
+			Chain.Keep[0] = true;
+			Chain.Keep.Last() = true;
+			if (Chain.ToleranceSq > 0.0)
+			{
+				DouglasPeuckerChain(Chain.Points, Chain.ToleranceSq, Chain.Keep);
+			}
+		}
+
+		for (int32 p = 0; p < NumPolygons; ++p)
+		{
+			TArray<FVector2D>& Result = Results[p];
+			Result.Reset();
+			for (const FSimplifyChainRef& Ref : PolygonChains[p])
+			{
+				// Every point but the last, which the next chain starts with.
+				const FSimplifyChain& Chain = Chains[Ref.Chain];
+				const int32			  Last = Chain.Points.Num() - 1;
+				for (int32 k = 0; k < Last; ++k)
+				{
+					const int32 i = Ref.bReversed ? Last - k : k;
+					if (Chain.Keep[i])
+					{
+						Result.Add(Chain.Points[i]);
+					}
+				}
+			}
+		}
+
+		Bad.Init(false, Chains.Num());
+		MarkCrossingChains(Chains, Bad);
+		auto MarkPolygon = [&](int32 p) {
+			for (const FSimplifyChainRef& Ref : PolygonChains[p])
+			{
+				Bad[Ref.Chain] = true;
+			}
+		};
+		for (int32 p = 0; p < NumPolygons; ++p)
+		{
+			if (PolygonChains[p].Num() > 0 && (Results[p].Num() < 3 || SignedArea2(Results[p]) * ExactArea2[p] <= 0.0))
+			{
+				MarkPolygon(p);
+			}
+		}
+		for (const FContainmentProbe& Probe : Probes)
+		{
+			if (PointInPolygon(Results[Probe.Polygon], Probe.Point) != Probe.bInside)
+			{
+				MarkPolygon(Probe.Polygon);
+			}
+		}
+
+		bool bRefined = false;
+		for (int32 c = 0; c < Chains.Num(); ++c)
+		{
+			FSimplifyChain& Chain = Chains[c];
+			if (Bad[c] && Chain.ToleranceSq > 0.0)
+			{
+				Chain.ToleranceSq = Chain.ToleranceSq * 0.25 < MinToleranceSq ? 0.0 : Chain.ToleranceSq * 0.25;
+				Chain.bDirty = true;
+				bRefined = true;
+			}
+		}
+		if (!bRefined)
+		{
+			break;
+		}
+	}
+
+	for (int32 p = 0; p < NumPolygons; ++p)
+	{
+		if (PolygonChains[p].Num() > 0)
+		{
+			*Polygons[p] = MoveTemp(Results[p]);
+		}
+	}
+}
+
+namespace
+{
+	/** Sentinel for "no feature" inside the transform; far above any real squared distance on a budgeted grid. */
+	constexpr int64 DistanceTransformInfinity = int64(1) << 40;
+
+	/** Lines handed to one ParallelFor task; keeps per-task scratch allocation amortised. */
+	constexpr int32 DistanceTransformLinesPerTask = 16;
+
+	/** 1D squared distance transform of sampled function F (lower envelope of parabolas). V and Z are scratch of N and N+1. */
+	void DistanceTransform1D(const int64* F, int64* D, const int32 N, int32* V, double* Z)
+	{
+		int32 K = 0;
+		V[0] = 0;
+		Z[0] = -TNumericLimits<double>::Max();
+		Z[1] = TNumericLimits<double>::Max();
+
+		for (int32 Q = 1; Q < N; ++Q)
+		{
+			double S;
+			while (true)
+			{
+				const int32 P = V[K];
+				S = static_cast<double>((F[Q] + int64(Q) * Q) - (F[P] + int64(P) * P)) / (2.0 * (Q - P));
+				if (S > Z[K])
+				{
+					break;
+				}
+				--K;
+			}
+			++K;
+			V[K] = Q;
+			Z[K] = S;
+			Z[K + 1] = TNumericLimits<double>::Max();
+		}
+
+		K = 0;
+		for (int32 Q = 0; Q < N; ++Q)
+		{
+			while (Z[K + 1] < Q)
+			{
+				++K;
+			}
+			D[Q] = int64(Q - V[K]) * (Q - V[K]) + F[V[K]];
+		}
+	}
+
+	/** Runs Body(First, Last) over [0, NumLines), in fixed-size blocks across worker threads when bParallel. */
+	template <typename BodyType>
+	void ForEachLineBlock(const int32 NumLines, const bool bParallel, BodyType&& Body)
+	{
+		if (!bParallel || NumLines <= DistanceTransformLinesPerTask)
+		{
+			Body(0, NumLines);
+			return;
+		}
+
+		const int32 NumBlocks = FMath::DivideAndRoundUp(NumLines, DistanceTransformLinesPerTask);
+		ParallelFor(NumBlocks, [&](const int32 Block) {
+			const int32 First = Block * DistanceTransformLinesPerTask;
+			Body(First, FMath::Min(First + DistanceTransformLinesPerTask, NumLines));
+		});
+	}
+
+	template <typename IsFeatureType>
+	void DistanceTransformSqImpl(const int32 Width, const int32 Height, IsFeatureType&& IsFeature, TArray<int32>& OutDistSq, const bool bParallel)
+	{
+		OutDistSq.Reset();
+		if (Width <= 0 || Height <= 0)
+		{
+			return;
+		}
+		OutDistSq.SetNumUninitialized(Width * Height);
+
+		// Saturates: squared distances reach 2^31 once a span exceeds 46341 cells, and must not wrap negative.
+		auto ToStored = [](const int64 Value) -> int32 {
+			return static_cast<int32>(FMath::Min<int64>(Value, MAX_int32));
+		};
+
+		// --- Pass 1: columns. Stores squared vertical distance (or MAX_int32) ---
+		ForEachLineBlock(Width, bParallel, [&](const int32 FirstX, const int32 LastX) {
+			TArray<int64>  F, D;
+			TArray<int32>  V;
+			TArray<double> Z;
+			F.SetNumUninitialized(Height);
+			D.SetNumUninitialized(Height);
+			V.SetNumUninitialized(Height);
+			Z.SetNumUninitialized(Height + 1);
+
+			for (int32 X = FirstX; X < LastX; ++X)
+			{
+				for (int32 Y = 0; Y < Height; ++Y)
+				{
+					F[Y] = IsFeature(Y * Width + X) ? 0 : DistanceTransformInfinity;
+				}
+				DistanceTransform1D(F.GetData(), D.GetData(), Height, V.GetData(), Z.GetData());
+				for (int32 Y = 0; Y < Height; ++Y)
+				{
+					OutDistSq[Y * Width + X] = ToStored(D[Y]);
+				}
+			}
+		});
+
+		// --- Pass 2: rows, in place over the column result ---
+		ForEachLineBlock(Height, bParallel, [&](const int32 FirstY, const int32 LastY) {
+			TArray<int64>  F, D;
+			TArray<int32>  V;
+			TArray<double> Z;
+			F.SetNumUninitialized(Width);
+			D.SetNumUninitialized(Width);
+			V.SetNumUninitialized(Width);
+			Z.SetNumUninitialized(Width + 1);
+
+			for (int32 Y = FirstY; Y < LastY; ++Y)
+			{
+				int32* Row = OutDistSq.GetData() + Y * Width;
+				for (int32 X = 0; X < Width; ++X)
+				{
+					F[X] = Row[X] == MAX_int32 ? DistanceTransformInfinity : Row[X];
+				}
+				DistanceTransform1D(F.GetData(), D.GetData(), Width, V.GetData(), Z.GetData());
+				for (int32 X = 0; X < Width; ++X)
+				{
+					Row[X] = ToStored(D[X]);
+				}
+			}
+		});
+	}
+
+	/** 1D Chebyshev dilation of one line: Out[i] = any In[j] with |i - j| <= Radius. Two sweeps, O(N) for any Radius. */
+	void DilateLine1D(const bool* In, bool* Out, const int32 N, const int32 Stride, const int32 Radius)
+	{
+		int32 Gap = Radius + 1; // distance to the nearest set cell behind the sweep (saturates above Radius)
+		for (int32 I = 0; I < N; ++I)
+		{
+			Gap = In[I * Stride] ? 0 : FMath::Min(Gap + 1, Radius + 1);
+			Out[I * Stride] = Gap <= Radius;
+		}
+		Gap = Radius + 1;
+		for (int32 I = N - 1; I >= 0; --I)
+		{
+			Gap = In[I * Stride] ? 0 : FMath::Min(Gap + 1, Radius + 1);
+			Out[I * Stride] |= Gap <= Radius;
+		}
+	}
+} // namespace
+
+void FGeometryUtils::DilateChebyshev(
+	const TArray<bool>& Mask, const int32 Width, const int32 Height, const int32 Radius, TArray<bool>& OutDilated, const bool bParallel)
+{
+	check(Mask.Num() == Width * Height);
+	OutDilated.Reset();
+	if (Width <= 0 || Height <= 0)
+	{
+		return;
+	}
+	OutDilated.SetNumUninitialized(Width * Height);
+	DilateChebyshev(MakeArrayView(Mask), Width, Height, Radius, MakeArrayView(OutDilated), bParallel);
+}
+
+void FGeometryUtils::DilateChebyshev(
+	TArrayView<const bool> Mask, const int32 Width, const int32 Height, const int32 Radius, TArrayView<bool> OutDilated, const bool bParallel)
+{
+	check(Mask.Num() == Width * Height && OutDilated.Num() == Width * Height);
+	if (Width <= 0 || Height <= 0)
+	{
+		return;
+	}
+	if (Radius <= 0)
+	{
+		FMemory::Memcpy(OutDilated.GetData(), Mask.GetData(), Width * Height * sizeof(bool));
+		return;
+	}
+
+	// The Chebyshev (square) window is separable: dilate every row, then every column of the row result.
+	FMemMark						   Mark(FMemStack::Get()); // row pass is scratch for this call only
+	TArray<bool, TMemStackAllocator<>> RowPass;
+	RowPass.SetNumUninitialized(Width * Height);
+
+	ForEachLineBlock(Height, bParallel, [&](const int32 FirstY, const int32 LastY) {
+		for (int32 Y = FirstY; Y < LastY; ++Y)
+		{
+			DilateLine1D(Mask.GetData() + Y * Width, RowPass.GetData() + Y * Width, Width, 1, Radius);
+		}
+	});
+
+	ForEachLineBlock(Width, bParallel, [&](const int32 FirstX, const int32 LastX) {
+		for (int32 X = FirstX; X < LastX; ++X)
+		{
+			DilateLine1D(RowPass.GetData() + X, OutDilated.GetData() + X, Height, Width, Radius);
+		}
+	});
+}
+
+void FGeometryUtils::DistanceTransformSq(const TArray<bool>& Features, const int32 Width, const int32 Height, TArray<int32>& OutDistSq, const bool bParallel)
+{
+	check(Features.Num() == Width * Height);
+	DistanceTransformSqImpl(Width, Height, [&Features](const int32 Index) { return Features[Index]; }, OutDistSq, bParallel);
+}
+
+void FGeometryUtils::DistanceTransformSq(
+	const TArray<uint8>& Grid, const uint8 FeatureValue, const int32 Width, const int32 Height, TArray<int32>& OutDistSq, const bool bParallel)
+{
+	check(Grid.Num() == Width * Height);
+	DistanceTransformSqImpl(Width, Height, [&Grid, FeatureValue](const int32 Index) { return Grid[Index] == FeatureValue; }, OutDistSq, bParallel);
+}
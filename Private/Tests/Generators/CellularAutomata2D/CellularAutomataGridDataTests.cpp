@@ -192,4 +192,104 @@ bool FCellularAutomataGridDataCullingTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+// Test 5: RegionGraph is a symmetric CSR mirror of the diagram neighbor lists with sane contact metrics
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCellularAutomataGridDataRegionGraphTest, "ProceduralGeometry.CellularAutomataGenerator2D.RegionGraphMatchesDiagram", DefaultTestFlags)
+
+bool FCellularAutomataGridDataRegionGraphTest::RunTest(const FString& Parameters)
+{
+	// Small cells and a low MinRegionSize give many pockets separated by thin walls.
+	UCellularAutomataGenerator2D* Generator = NewObject<UCellularAutomataGenerator2D>();
+	Generator->SetBounds(FBox2D(FVector2D(-500, -500), FVector2D(500, 500)))->SetGridSize(10)->SetSeed(TEXT("RegionGraphTest"));
+	Generator->SetMinRegionSize(3);
+
+	const FCellularAutomataGridData		GridData = Generator->GenerateWithGridData();
+	const FCellularAutomataRegionGraph& Graph = GridData.RegionGraph;
+	const int32							NumCells = GridData.Diagram.Cells.Num();
+
+	TestEqual("One CSR row per diagram cell", Graph.NumCells(), NumCells);
+	TestEqual("Per-edge arrays are parallel", Graph.ContactLength.Num(), Graph.Neighbors.Num());
+	TestEqual("Per-edge arrays are parallel", Graph.WallThickness.Num(), Graph.Neighbors.Num());
+
+	int32 NumEdges = 0;
+	for (int32 CellIdx = 0; CellIdx < Graph.NumCells(); ++CellIdx)
+	{
+		const TArrayView<const int32> Row = Graph.GetNeighbors(CellIdx);
+		TestTrue(FString::Printf(TEXT("Cell %d row matches diagram neighbors"), CellIdx),
+			TArray<int32>(Row.GetData(), Row.Num()) == GridData.Diagram.Cells[CellIdx].Neighbors);
+
+		for (int32 Local = 0; Local < Row.Num(); ++Local)
+		{
+			const int32 Slot = Graph.Offsets[CellIdx] + Local;
+			const int32 Other = Row[Local];
+			++NumEdges;
+
+			TestTrue(FString::Printf(TEXT("Cell %d row is strictly ascending"), CellIdx), Local == 0 || Row[Local - 1] < Other);
+			TestTrue(FString::Printf(TEXT("Edge %d-%d has positive contact"), CellIdx, Other), Graph.ContactLength[Slot] >= GridData.CellSize);
+
+			const int32 Reverse = Graph.FindEdge(Other, CellIdx);
+			if (TestTrue(FString::Printf(TEXT("Edge %d-%d is symmetric"), CellIdx, Other), Reverse != INDEX_NONE))
+			{
+				TestEqual(TEXT("Symmetric contact length"), Graph.ContactLength[Reverse], Graph.ContactLength[Slot]);
+				TestEqual(TEXT("Symmetric wall thickness"), Graph.WallThickness[Reverse], Graph.WallThickness[Slot]);
+			}
+		}
+	}
+
+	if (NumEdges == 0)
+	{
+		AddWarning(TEXT("Seed produced no adjacent regions — edge metric assertions skipped"));
+	}
+
+	return true;
+}
+
+// Test 6: Lazy culling — Generate() (Grid never materialised) and GenerateWithGridData() build the same diagram
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCellularAutomataGridDataLazyCullingTest, "ProceduralGeometry.CellularAutomataGenerator2D.LazyCullingMatchesMaterialized", DefaultTestFlags)
+
+bool FCellularAutomataGridDataLazyCullingTest::RunTest(const FString& Parameters)
+{
+	// SwissCheese-like rules with a high MinRegionSize cull many small pockets.
+	auto MakeGenerator = []() {
+		UCellularAutomataGenerator2D* Generator = NewObject<UCellularAutomataGenerator2D>();
+		Generator->SetBounds(FBox2D(FVector2D(-500, -500), FVector2D(500, 500)))->SetGridSize(10)->SetSeed(TEXT("LazyCullingTest"));
+		Generator->SetBirthRule({ 6, 7, 8 })->SetSurvivalRule({ 3, 4, 5 })->SetMinRegionSize(40);
+		return Generator;
+	};
+
+	const FCellularAutomataGridData GridData = MakeGenerator()->GenerateWithGridData();
+	const FLayoutDiagram2D			Diagram = MakeGenerator()->Generate();
+
+	int32 CulledCount = 0;
+	for (const bool bSurvived : GridData.SurvivingRegions)
+	{
+		CulledCount += bSurvived ? 0 : 1;
+	}
+	if (CulledCount == 0)
+	{
+		AddWarning(TEXT("Seed culled no regions — lazy culling path not exercised"));
+	}
+
+	TestEqual("Same cell count", Diagram.Cells.Num(), GridData.Diagram.Cells.Num());
+	TestEqual("Same center cell", Diagram.CenterCellIndex, GridData.Diagram.CenterCellIndex);
+	for (int32 i = 0; i < FMath::Min(Diagram.Cells.Num(), GridData.Diagram.Cells.Num()); ++i)
+	{
+		TestTrue(FString::Printf(TEXT("Cell %d vertices match"), i), Diagram.Cells[i].Vertices == GridData.Diagram.Cells[i].Vertices);
+		TestTrue(FString::Printf(TEXT("Cell %d neighbors match"), i), Diagram.Cells[i].Neighbors == GridData.Diagram.Cells[i].Neighbors);
+	}
+
+	// Materialised grid: no culled region keeps a floor cell
+	for (int32 RegionId = 0; RegionId < GridData.Regions.Num(); ++RegionId)
+	{
+		if (!GridData.SurvivingRegions[RegionId] && GridData.Regions[RegionId].Num() > 0)
+		{
+			const FIntPoint& Cell = GridData.Regions[RegionId][0];
+			TestFalse(FString::Printf(TEXT("Culled region %d cleared in Grid"), RegionId), GridData.Grid[Cell.Y * GridData.GridWidth + Cell.X]);
+		}
+	}
+
+	return true;
+}
+
 #endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,175 @@
+#include "Generators/CellularAutomata2D/CellularAutomataHierarchy.h"
+#include "../../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	UCellularAutomataGenerator2D* MakeHierarchyGenerator()
+	{
+		UCellularAutomataGenerator2D* Generator = NewObject<UCellularAutomataGenerator2D>();
+		Generator->SetBounds(FBox2D(FVector2D(-2000, -2000), FVector2D(2000, 2000)));
+		Generator->SetSeed(TEXT("Hierarchy"));
+		return Generator;
+	}
+
+	/** Surviving, non-empty region ids in coarse cell order. */
+	TArray<int32> SurvivingRegionIds(const FCellularAutomataGridData& GridData)
+	{
+		TArray<int32> Ids;
+		for (int32 RegionId = 0; RegionId < GridData.Regions.Num(); ++RegionId)
+		{
+			if (GridData.Regions[RegionId].Num() > 0 && GridData.SurvivingRegions[RegionId])
+			{
+				Ids.Add(RegionId);
+			}
+		}
+		return Ids;
+	}
+
+	FVector2D TileCenter(const FCellularAutomataHierarchicalDiagram& Hierarchy, const FIntPoint& Tile)
+	{
+		return Hierarchy.GridOrigin + (FVector2D(Tile) + FVector2D(0.5, 0.5)) * Hierarchy.CellSize;
+	}
+} // namespace
+
+// Test 1: Levels and links — the coarse level is the regular diagram and region graph, and each
+// block decodes to exactly the tiles of its region, linked back to its coarse cell.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCellularAutomataHierarchyLevelsTest, "ProceduralGeometry.CellularAutomataGenerator2D.HierarchyLevels", DefaultTestFlags)
+
+bool FCellularAutomataHierarchyLevelsTest::RunTest(const FString& Parameters)
+{
+	UCellularAutomataGenerator2D*		 Generator = MakeHierarchyGenerator();
+	const FCellularAutomataGridData		 GridData = Generator->GenerateWithGridData();
+	FCellularAutomataHierarchicalDiagram Hierarchy = Generator->GenerateHierarchical();
+
+	TestEqual("Coarse cells match the diagram", Hierarchy.NumRegions(), GridData.Diagram.Cells.Num());
+	TestTrue("Region graph kept", Hierarchy.RegionGraph.Neighbors == GridData.RegionGraph.Neighbors);
+	TestEqual("One block per coarse cell", Hierarchy.Blocks.Num(), Hierarchy.NumRegions());
+	TestTrue("Has several regions", Hierarchy.NumRegions() > 1);
+	TestEqual("Nothing loaded up front", Hierarchy.NumLoadedDetails(), 0);
+
+	const TArray<int32> RegionIds = SurvivingRegionIds(GridData);
+	for (int32 Cell = 0; Cell < Hierarchy.NumRegions(); ++Cell)
+	{
+		const TArray<FIntPoint>&			 Region = GridData.Regions[RegionIds[Cell]];
+		const FCellularAutomataRegionDetail* Detail = Hierarchy.LoadDetail(Cell);
+		if (!TestNotNull(FString::Printf(TEXT("Region cell %d decodes"), Cell), Detail))
+		{
+			return false;
+		}
+		TestEqual(FString::Printf(TEXT("Region cell %d: link back"), Cell), Detail->CoarseCellIndex, Cell);
+		TestEqual(FString::Printf(TEXT("Region cell %d: one fine cell per tile"), Cell), Detail->Cells.Cells.Num(), Region.Num());
+
+		TSet<FIntPoint> Tiles(Region);
+		for (int32 Fine = 0; Fine < Detail->Cells.Cells.Num(); ++Fine)
+		{
+			const FIntPoint Tile = Detail->GetTile(Fine);
+			if (!TestTrue(FString::Printf(TEXT("Region cell %d: fine cell %d on a region tile"), Cell, Fine), Tiles.Remove(Tile) == 1))
+			{
+				return false;
+			}
+			const bool bMapEdge = Tile.X == 0 || Tile.Y == 0 || Tile.X == GridData.GridWidth - 1 || Tile.Y == GridData.GridHeight - 1;
+			TestEqual(FString::Printf(TEXT("Region cell %d: fine cell %d exterior"), Cell, Fine), Detail->Cells.Cells[Fine].bIsExterior, bMapEdge);
+		}
+		TestEqual(FString::Printf(TEXT("Region cell %d: every tile covered"), Cell), Tiles.Num(), 0);
+	}
+	TestEqual("All loaded", Hierarchy.NumLoadedDetails(), Hierarchy.NumRegions());
+	return true;
+}
+
+// Test 2: Cross-level lookup — a tile center resolves to its region and fine cell once the region
+// is loaded, and only to the region before.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCellularAutomataHierarchyLookupTest, "ProceduralGeometry.CellularAutomataGenerator2D.HierarchyLookup", DefaultTestFlags)
+
+bool FCellularAutomataHierarchyLookupTest::RunTest(const FString& Parameters)
+{
+	UCellularAutomataGenerator2D*		 Generator = MakeHierarchyGenerator();
+	const FCellularAutomataGridData		 GridData = Generator->GenerateWithGridData();
+	FCellularAutomataHierarchicalDiagram Hierarchy = FCellularAutomataHierarchicalDiagram::Build(GridData);
+	const TArray<int32>					 RegionIds = SurvivingRegionIds(GridData);
+
+	const FIntPoint Probe = GridData.Regions[RegionIds[0]][0];
+	int32			Coarse = INDEX_NONE;
+	int32			Fine = INDEX_NONE;
+	TestFalse("Unloaded: no fine cell", Hierarchy.FindCellAt(TileCenter(Hierarchy, Probe), Coarse, Fine));
+	TestTrue("Unloaded: region found", Coarse != INDEX_NONE);
+	TestEqual("Unloaded: fine is none", Fine, static_cast<int32>(INDEX_NONE));
+
+	for (int32 Cell = 0; Cell < Hierarchy.NumRegions(); ++Cell)
+	{
+		Hierarchy.LoadDetail(Cell);
+	}
+	for (int32 Cell = 0; Cell < Hierarchy.NumRegions(); ++Cell)
+	{
+		const FCellularAutomataRegionDetail* Detail = Hierarchy.FindDetail(Cell);
+		for (const FIntPoint& Tile : GridData.Regions[RegionIds[Cell]])
+		{
+			const bool bFound = Hierarchy.FindCellAt(TileCenter(Hierarchy, Tile), Coarse, Fine);
+			if (!TestTrue(FString::Printf(TEXT("Tile (%d, %d) resolves"), Tile.X, Tile.Y), bFound && Coarse == Cell && Detail->GetTile(Fine) == Tile))
+			{
+				return false;
+			}
+		}
+	}
+
+	int32 WallTiles = 0;
+	int32 WallMisses = 0;
+	for (int32 i = 0; i < GridData.Grid.Num(); ++i)
+	{
+		if (!GridData.Grid[i])
+		{
+			const FIntPoint Tile(i % GridData.GridWidth, i / GridData.GridWidth);
+			++WallTiles;
+			WallMisses += !Hierarchy.FindCellAt(TileCenter(Hierarchy, Tile), Coarse, Fine);
+		}
+	}
+	TestEqual("Walls have no fine cell", WallMisses, WallTiles);
+	return true;
+}
+
+// Test 3: Streaming — loading grows memory and unloading returns it, and a block whose bytes
+// are damaged or belong to another region is rejected.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCellularAutomataHierarchyStreamingTest, "ProceduralGeometry.CellularAutomataGenerator2D.HierarchyStreaming", DefaultTestFlags)
+
+bool FCellularAutomataHierarchyStreamingTest::RunTest(const FString& Parameters)
+{
+	FCellularAutomataHierarchicalDiagram Hierarchy = MakeHierarchyGenerator()->GenerateHierarchical();
+	const SIZE_T						 Resident = Hierarchy.GetAllocatedSize();
+
+	const FCellularAutomataRegionDetail* First = Hierarchy.LoadDetail(0);
+	TestNotNull("Load", First);
+	TestTrue("Load is idempotent", Hierarchy.LoadDetail(0) == First);
+	TestEqual("One loaded", Hierarchy.NumLoadedDetails(), 1);
+	TestTrue("Loading grows memory", Hierarchy.GetAllocatedSize() > Resident);
+
+	const SIZE_T Loaded = Hierarchy.GetAllocatedSize();
+	Hierarchy.UnloadDetail(0);
+	TestEqual("Unloaded", Hierarchy.NumLoadedDetails(), 0);
+	TestNull("Unloaded: not found", Hierarchy.FindDetail(0));
+	TestTrue("Unloading frees memory", Hierarchy.GetAllocatedSize() < Loaded);
+
+	FCellularAutomataRegionDetail Detail;
+	TestTrue("Decode from outside bytes", Hierarchy.DecodeDetail(0, TArray<uint8>(Hierarchy.GetBlockBytes(0)), Detail));
+	TestFalse("Truncated bytes rejected", Hierarchy.DecodeDetail(0, Hierarchy.GetBlockBytes(0).LeftChop(1), Detail));
+	TestFalse("Out of range rejected", Hierarchy.DecodeDetail(Hierarchy.NumRegions(), Hierarchy.GetBlockBytes(0), Detail));
+	TestNull("Out of range load", Hierarchy.LoadDetail(-1));
+
+	// Another region's bytes only pass when the boxes and tile counts happen to agree.
+	for (int32 Other = 1; Other < Hierarchy.NumRegions(); ++Other)
+	{
+		const FCellularAutomataHierarchicalDiagram::FBlock& A = Hierarchy.GetBlock(0);
+		const FCellularAutomataHierarchicalDiagram::FBlock& B = Hierarchy.GetBlock(Other);
+		if (A.Width * A.Height != B.Width * B.Height || A.NumFineCells != B.NumFineCells)
+		{
+			TestFalse("Foreign block rejected", Hierarchy.DecodeDetail(0, Hierarchy.GetBlockBytes(Other), Detail));
+			break;
+		}
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -1,6 +1,7 @@
 #include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
 #include "Generators/CellularAutomata2D/CellularAutomataConfig.h"
 #include "../../ProceduralGeometryTestFlags.h"
+#include "Algo/Count.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -449,4 +450,161 @@ bool FCellularAutomataCarveCorridorsAllConnectedTest::RunTest(const FString& Par
 	return true;
 }
 
+// Test 13: Boundary simplification at more than a cell of tolerance cuts vertex counts substantially
+// without changing the region graph or pushing any outline across another
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCellularAutomataBoundarySimplifyTest, "ProceduralGeometry.CellularAutomata.BoundarySimplifyTolerance", DefaultTestFlags)
+
+bool FCellularAutomataBoundarySimplifyTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 CellSize = 20;
+
+	auto MakeGenerator = [](float Tolerance) {
+		UCellularAutomataGenerator2D* Generator = NewObject<UCellularAutomataGenerator2D>();
+		Generator->SetBounds(FBox2D(FVector2D(-2000, -2000), FVector2D(2000, 2000)))->SetGridSize(CellSize)->SetSeed(TEXT("SimplifyTest"));
+		Generator->SetMinRegionSize(10);
+		Generator->SetBoundarySimplifyTolerance(Tolerance);
+		return Generator;
+	};
+
+	const FLayoutDiagram2D Exact = MakeGenerator(0.0f)->Generate();
+	const FLayoutDiagram2D Simplified = MakeGenerator(1.5f * CellSize)->Generate();
+
+	TestEqual("Same cell count", Simplified.Cells.Num(), Exact.Cells.Num());
+	TestEqual("Same center cell", Simplified.CenterCellIndex, Exact.CenterCellIndex);
+
+	int32 ExactVertices = 0;
+	int32 SimplifiedVertices = 0;
+	for (int32 i = 0; i < FMath::Min(Exact.Cells.Num(), Simplified.Cells.Num()); ++i)
+	{
+		ExactVertices += Exact.Cells[i].Vertices.Num();
+		SimplifiedVertices += Simplified.Cells[i].Vertices.Num();
+		TestTrue(FString::Printf(TEXT("Cell %d keeps >= 3 vertices"), i), Simplified.Cells[i].Vertices.Num() >= 3);
+		TestTrue(FString::Printf(TEXT("Cell %d never gains vertices"), i), Simplified.Cells[i].Vertices.Num() <= Exact.Cells[i].Vertices.Num());
+		TestTrue(FString::Printf(TEXT("Cell %d keeps its neighbors"), i), Simplified.Cells[i].Neighbors == Exact.Cells[i].Neighbors);
+	}
+
+	// Staircase outlines at 1.5 cells of tolerance keep well under half their corners.
+	TestTrue(FString::Printf(TEXT("Simplification at 1.5 cells at least halves vertices (%d -> %d)"), ExactVertices, SimplifiedVertices),
+		SimplifiedVertices * 2 <= ExactVertices);
+	AddInfo(FString::Printf(TEXT("Simplification at 1.5 cells: %.1fx fewer vertices"), static_cast<double>(ExactVertices) / FMath::Max(1, SimplifiedVertices)));
+
+	// No simplified edge properly crosses another, within one outline or between two.
+	TArray<TPair<FVector2D, FVector2D>> Segments;
+	for (const FLayoutCell2D& Cell : Simplified.Cells)
+	{
+		for (int32 i = 0; i < Cell.Vertices.Num(); ++i)
+		{
+			Segments.Emplace(Cell.Vertices[i], Cell.Vertices[(i + 1) % Cell.Vertices.Num()]);
+		}
+	}
+	auto Side = [](const FVector2D& A, const FVector2D& B, const FVector2D& P) { return FMath::Sign(FVector2D::CrossProduct(B - A, P - A)); };
+
+	int32 Crossings = 0;
+	for (int32 i = 0; i < Segments.Num(); ++i)
+	{
+		const FVector2D& A = Segments[i].Key;
+		const FVector2D& B = Segments[i].Value;
+		for (int32 j = i + 1; j < Segments.Num(); ++j)
+		{
+			const FVector2D& C = Segments[j].Key;
+			const FVector2D& D = Segments[j].Value;
+			Crossings += Side(A, B, C) * Side(A, B, D) < 0 && Side(C, D, A) * Side(C, D, B) < 0;
+		}
+	}
+	TestEqual("No outline edges cross", Crossings, 0);
+
+	return true;
+}
+
+// Test 14: KeepCenterRegion fallback picks the nearest region, lowest region ID on distance ties
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCellularAutomataNearestRegionFallbackTest, "ProceduralGeometry.CellularAutomata.KeepCenterNearestRegionFallback", DefaultTestFlags)
+
+bool FCellularAutomataNearestRegionFallbackTest::RunTest(const FString& Parameters)
+{
+	int32 FallbackCases = 0;
+	for (int32 SeedIdx = 0; SeedIdx < 32; ++SeedIdx)
+	{
+		UCellularAutomataGenerator2D* Generator = NewObject<UCellularAutomataGenerator2D>();
+		Generator->SetBounds(FBox2D(FVector2D(-500, -500), FVector2D(500, 500)))->SetGridSize(20);
+		Generator->SetSeed(FString::Printf(TEXT("NearestRegion_%d"), SeedIdx));
+		Generator->SetFillProbability(0.55f);
+		Generator->SetKeepCenterRegion(true);
+
+		const FCellularAutomataGridData GridData = Generator->GenerateWithGridData();
+		const int32						CenterX = GridData.GridWidth / 2;
+		const int32						CenterY = GridData.GridHeight / 2;
+		if (GridData.Regions.Num() == 0 || GridData.RegionIds[CenterY * GridData.GridWidth + CenterX] >= 0)
+		{
+			continue;
+		}
+		++FallbackCases;
+
+		// Reference: full scan over regions in ID order with a strict '<'
+		int32 BestDistSq = MAX_int32;
+		int32 Expected = INDEX_NONE;
+		for (int32 RegionId = 0; RegionId < GridData.Regions.Num(); ++RegionId)
+		{
+			for (const FIntPoint& Cell : GridData.Regions[RegionId])
+			{
+				const int32 DistSq = FMath::Square(Cell.X - CenterX) + FMath::Square(Cell.Y - CenterY);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					Expected = RegionId;
+				}
+			}
+		}
+
+		TestEqual(FString::Printf(TEXT("Seed %d nearest region"), SeedIdx), GridData.CenterRegionId, Expected);
+	}
+
+	if (FallbackCases == 0)
+	{
+		AddWarning(TEXT("No seed in the family put a wall on the center cell — fallback assertions skipped"));
+	}
+
+	return true;
+}
+
+// Test 15: CarveCorridors between two large regions (distance-transform closest pair) carves the shortest gap
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCellularAutomataCarveCorridorsLargeRegionsTest, "ProceduralGeometry.CellularAutomata.CarveCorridorsLargeRegionsShortestGap", DefaultTestFlags)
+
+bool FCellularAutomataCarveCorridorsLargeRegionsTest::RunTest(const FString& Parameters)
+{
+	// Two 20x20 rooms side by side, 8 wall columns apart: 400*400 cell pairs is well past the 60x30 grid.
+	constexpr int32 Gap = 8;
+
+	FCellularAutomataGridData GridData;
+	GridData.GridWidth = 60;
+	GridData.GridHeight = 30;
+	GridData.CellSize = 20.0f;
+	GridData.Grid.Init(false, GridData.GridWidth * GridData.GridHeight);
+	for (int32 Y = 5; Y < 25; ++Y)
+	{
+		for (int32 X = 0; X < 20; ++X)
+		{
+			GridData.Grid[Y * GridData.GridWidth + 2 + X] = true;
+			GridData.Grid[Y * GridData.GridWidth + 22 + Gap + X] = true;
+		}
+	}
+
+	UCellularAutomataGenerator2D* Generator = NewObject<UCellularAutomataGenerator2D>();
+	Generator->SetBounds(FBox2D(FVector2D(0, 0), FVector2D(1200, 600)))->SetGridSize(20);
+	Generator->RebuildDiagram(GridData);
+	TestEqual("Two separate rooms", GridData.Diagram.Cells.Num(), 2);
+
+	const int32	  FloorBefore = Algo::Count(GridData.Grid, true);
+	FRandomStream CorridorStream(42);
+	UCellularAutomataGenerator2D::CarveCorridors(GridData, 1.0f, 1, CorridorStream);
+	TestEqual("A one-wide corridor straight across the gap", Algo::Count(GridData.Grid, true) - FloorBefore, Gap);
+
+	Generator->RebuildDiagram(GridData);
+	TestEqual("Rooms joined", GridData.Diagram.Cells.Num(), 1);
+
+	return true;
+}
+
 #endif // WITH_DEV_AUTOMATION_TESTS
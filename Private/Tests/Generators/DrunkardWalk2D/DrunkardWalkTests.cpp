@@ -2,30 +2,13 @@
 
 #include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
 #include "Generators/DrunkardWalk2D/DrunkardWalkConfig.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkCellGrid.h"
+#include "Generators/LayoutDiagramCompact.h"
+#include "../../ProceduralGeometryTestFixtures.h"
 #include "../../ProceduralGeometryTestFlags.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
-namespace
-{
-	/** Creates a DrunkardWalk generator pre-configured with N identical rooms. */
-	UDrunkardWalkGenerator2D* MakeDrunkardGenerator(const FString& Seed, int32 RoomCount, int32 FootprintCells = 4)
-	{
-		UDrunkardWalkGenerator2D* Gen = NewObject<UDrunkardWalkGenerator2D>();
-		Gen->SetSeed(Seed);
-		Gen->SetGridSize(100);
-
-		FRoomTypeConfig RoomType;
-		RoomType.Tag = FName(TEXT("Test"));
-		RoomType.FootprintWidthCells = FootprintCells;
-		RoomType.FootprintHeightCells = FootprintCells;
-		RoomType.Weight = RoomCount;
-
-		Gen->SetRoomTypes({ RoomType });
-		return Gen;
-	}
-} // namespace
-
 // ============================================================
 // Test 1: Default generation produces a non-empty diagram.
 // ============================================================
@@ -33,7 +16,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkDefaultGenerateTest, "ProceduralGe
 
 bool FDrunkardWalkDefaultGenerateTest::RunTest(const FString& Parameters)
 {
-	UDrunkardWalkGenerator2D*	Gen = MakeDrunkardGenerator(TEXT("DefaultTest"), /*RoomCount=*/3);
+	UDrunkardWalkGenerator2D*	Gen = MakeTestDrunkardWalk(TEXT("DefaultTest"), /*RoomCount=*/3);
 	const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
 
 	TestTrue("DefaultGenerate: Diagram has cells", Data.Diagram.Cells.Num() > 0);
@@ -49,8 +32,8 @@ bool FDrunkardWalkDeterminismTest::RunTest(const FString& Parameters)
 {
 	const FString Seed = TEXT("DeterminismSeed42");
 
-	UDrunkardWalkGenerator2D* Gen1 = MakeDrunkardGenerator(Seed, 4);
-	UDrunkardWalkGenerator2D* Gen2 = MakeDrunkardGenerator(Seed, 4);
+	UDrunkardWalkGenerator2D* Gen1 = MakeTestDrunkardWalk(Seed, 4);
+	UDrunkardWalkGenerator2D* Gen2 = MakeTestDrunkardWalk(Seed, 4);
 
 	const FDrunkardWalkGridData Data1 = Gen1->GenerateWithGridData();
 	const FDrunkardWalkGridData Data2 = Gen2->GenerateWithGridData();
@@ -74,7 +57,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkParallelArraySizesTest, "Procedura
 
 bool FDrunkardWalkParallelArraySizesTest::RunTest(const FString& Parameters)
 {
-	UDrunkardWalkGenerator2D*	Gen = MakeDrunkardGenerator(TEXT("ParallelArrayTest"), 3);
+	UDrunkardWalkGenerator2D*	Gen = MakeTestDrunkardWalk(TEXT("ParallelArrayTest"), 3);
 	const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
 
 	if (Data.GridWidth == 0 || Data.GridHeight == 0)
@@ -105,7 +88,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 
 bool FDrunkardWalkRoomCountMatchesPlacementTest::RunTest(const FString& Parameters)
 {
-	UDrunkardWalkGenerator2D*	Gen = MakeDrunkardGenerator(TEXT("RoomCountTest"), 5);
+	UDrunkardWalkGenerator2D*	Gen = MakeTestDrunkardWalk(TEXT("RoomCountTest"), 5);
 	const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
 
 	if (Data.RequestedRoomCount == 0)
@@ -130,7 +113,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkOOMGuardTest, "ProceduralGeometry.
 
 bool FDrunkardWalkOOMGuardTest::RunTest(const FString& Parameters)
 {
-	UDrunkardWalkGenerator2D*	Gen = MakeDrunkardGenerator(TEXT("OOMTest"), 1, /*FootprintCells=*/2500);
+	UDrunkardWalkGenerator2D*	Gen = MakeTestDrunkardWalk(TEXT("OOMTest"), 1, /*FootprintWidth=*/2500, /*FootprintHeight=*/2500);
 	const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
 
 	TestTrue("OOMGuard: degraded resolution flagged", Data.bDegradedResolution);
@@ -169,7 +152,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 
 bool FDrunkardWalkAllFloorCellsHaveValidRegionTest::RunTest(const FString& Parameters)
 {
-	UDrunkardWalkGenerator2D*	Gen = MakeDrunkardGenerator(TEXT("RegionValidTest"), 4);
+	UDrunkardWalkGenerator2D*	Gen = MakeTestDrunkardWalk(TEXT("RegionValidTest"), 4);
 	const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
 
 	if (Data.Grid.Num() == 0)
@@ -203,7 +186,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkCellTypeConsistencyTest, "Procedur
 
 bool FDrunkardWalkCellTypeConsistencyTest::RunTest(const FString& Parameters)
 {
-	UDrunkardWalkGenerator2D*	Gen = MakeDrunkardGenerator(TEXT("CellTypeTest"), 4);
+	UDrunkardWalkGenerator2D*	Gen = MakeTestDrunkardWalk(TEXT("CellTypeTest"), 4);
 	const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
 
 	if (Data.Grid.Num() == 0)
@@ -249,7 +232,7 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 
 bool FDrunkardWalkCorridorGraphIndicesValidTest::RunTest(const FString& Parameters)
 {
-	UDrunkardWalkGenerator2D*	Gen = MakeDrunkardGenerator(TEXT("CorridorIndexTest"), 4);
+	UDrunkardWalkGenerator2D*	Gen = MakeTestDrunkardWalk(TEXT("CorridorIndexTest"), 4);
 	const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
 
 	const int32 RoomCount = Data.PlacedRooms.Num();
@@ -502,4 +485,468 @@ bool FDWConfigResolveForTotalMaxRespectedTest::RunTest(const FString& Parameters
 	return true;
 }
 
+// ============================================================
+// Test 18: Chunked cell grid — signed coordinates across tile boundaries,
+// incremental extents and SetIfEmpty never overwriting a stored cell.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkCellGridSignedTilesTest, "ProceduralGeometry.DrunkardWalk.CellGrid.SignedTiles", DefaultTestFlags)
+
+bool FDrunkardWalkCellGridSignedTilesTest::RunTest(const FString& Parameters)
+{
+	FDrunkardWalkCellGrid Cells;
+	TestEqual("CellGrid: starts empty", Cells.Num(), 0);
+
+	// Straddle the origin and several tile edges in both directions, plus far-away tiles to force table growth.
+	TMap<FIntPoint, uint8> Expected;
+	for (int32 i = -70; i <= 70; ++i)
+	{
+		const FIntPoint P(i, -i / 3);
+		const uint8		Type = (i % 2 == 0) ? EDrunkardWalkCellType::Room : EDrunkardWalkCellType::Corridor;
+		Cells.Set(P, Type, Type == EDrunkardWalkCellType::Room ? 7 : INDEX_NONE);
+		Expected.Add(P, Type);
+	}
+	for (int32 t = 0; t < 100; ++t)
+	{
+		const FIntPoint P(t * 97 - 5000, 3000 - t * 61);
+		Cells.Set(P, EDrunkardWalkCellType::Corridor);
+		Expected.Add(P, EDrunkardWalkCellType::Corridor);
+	}
+
+	TestEqual("CellGrid: Num matches distinct cells", Cells.Num(), Expected.Num());
+
+	FIntPoint ExpMin(MAX_int32, MAX_int32);
+	FIntPoint ExpMax(MIN_int32, MIN_int32);
+	for (const TPair<FIntPoint, uint8>& Pair : Expected)
+	{
+		TestEqual(FString::Printf(TEXT("CellGrid: Get(%d,%d)"), Pair.Key.X, Pair.Key.Y), Cells.Get(Pair.Key), Pair.Value);
+		ExpMin.X = FMath::Min(ExpMin.X, Pair.Key.X);
+		ExpMin.Y = FMath::Min(ExpMin.Y, Pair.Key.Y);
+		ExpMax.X = FMath::Max(ExpMax.X, Pair.Key.X);
+		ExpMax.Y = FMath::Max(ExpMax.Y, Pair.Key.Y);
+	}
+	TestTrue("CellGrid: min extent", Cells.GetMin() == ExpMin);
+	TestTrue("CellGrid: max extent", Cells.GetMax() == ExpMax);
+
+	TestFalse("CellGrid: unset neighbor of a stored cell is absent", Cells.Contains(FIntPoint(-33, 0)));
+	TestEqual("CellGrid: room type stored", Cells.GetRoomType(FIntPoint(-64, 21)), 7);
+
+	TestFalse("CellGrid: SetIfEmpty keeps the room cell", Cells.SetIfEmpty(FIntPoint(-64, 21), EDrunkardWalkCellType::Corridor));
+	TestEqual("CellGrid: room cell unchanged", Cells.Get(FIntPoint(-64, 21)), EDrunkardWalkCellType::Room);
+	TestTrue("CellGrid: SetIfEmpty fills an absent cell", Cells.SetIfEmpty(FIntPoint(-33, 0), EDrunkardWalkCellType::Corridor));
+
+	int32 Visited = 0;
+	Cells.ForEachCell([&](const FIntPoint& Cell, uint8 Type, int32 /*RoomType*/) {
+		++Visited;
+		TestEqual("CellGrid: ForEachCell type matches Get", Type, Cells.Get(Cell));
+	});
+	TestEqual("CellGrid: ForEachCell visits every stored cell", Visited, Cells.Num());
+	return true;
+}
+
+// ============================================================
+// Test 19: Epoch-stamped occupancy — begin calls forget the previous
+// attempt/corridor in O(1) and band membership covers exactly the current
+// and previous band of the current corridor.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkStampGridEpochsTest, "ProceduralGeometry.DrunkardWalk.StampGrid.Epochs", DefaultTestFlags)
+
+bool FDrunkardWalkStampGridEpochsTest::RunTest(const FString& Parameters)
+{
+	FDrunkardWalkStampGrid Stamps;
+	const FIntPoint		   A(-40, 3);
+	const FIntPoint		   B(-39, 3);
+	const FIntPoint		   C(-38, 3);
+
+	Stamps.BeginAttempt();
+	TestTrue("StampGrid: first MarkPending adds", Stamps.MarkPending(A));
+	TestFalse("StampGrid: second MarkPending is a duplicate", Stamps.MarkPending(A));
+	TestTrue("StampGrid: A pending", Stamps.IsPending(A));
+	TestFalse("StampGrid: untouched tile reads as not pending", Stamps.IsPending(FIntPoint(5000, -5000)));
+	Stamps.BeginAttempt();
+	TestFalse("StampGrid: new attempt forgets pending cells", Stamps.IsPending(A));
+
+	Stamps.BeginCorridor();
+	Stamps.BeginBand();
+	Stamps.MarkBand(A);
+	Stamps.MarkCorridor(A);
+	Stamps.BeginBand();
+	Stamps.MarkBand(B);
+	TestTrue("StampGrid: previous band exempt", Stamps.InCurrentOrPreviousBand(Stamps.FindCell(A)));
+	TestTrue("StampGrid: current band exempt", Stamps.InCurrentOrPreviousBand(Stamps.FindCell(B)));
+	Stamps.MarkCorridor(B);
+	Stamps.BeginBand();
+	Stamps.MarkBand(C);
+	TestFalse("StampGrid: two bands back is not exempt", Stamps.InCurrentOrPreviousBand(Stamps.FindCell(A)));
+	TestTrue("StampGrid: A traced by this corridor", Stamps.IsCorridor(Stamps.FindCell(A)));
+
+	Stamps.BeginCorridor();
+	Stamps.BeginBand();
+	TestFalse("StampGrid: new corridor forgets traced cells", Stamps.IsCorridor(Stamps.FindCell(A)));
+	TestFalse("StampGrid: last band of the old corridor is not a previous band", Stamps.InCurrentOrPreviousBand(Stamps.FindCell(C)));
+	return true;
+}
+
+// ============================================================
+// Test 20: Near-floor dilation — per-cell counts match a brute-force
+// Chebyshev window count over signed coordinates.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkNearFloorCountsTest, "ProceduralGeometry.DrunkardWalk.NearFloor.Counts", DefaultTestFlags)
+
+bool FDrunkardWalkNearFloorCountsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Radius = 2;
+
+	FDrunkardWalkNearFloorGrid NearFloor;
+	NearFloor.Reset(Radius);
+
+	FRandomStream	Rng(1234);
+	TSet<FIntPoint> Floor;
+	for (int32 i = 0; i < 200; ++i)
+	{
+		const FIntPoint P(Rng.RandRange(-40, 40), Rng.RandRange(-40, 40));
+		if (!Floor.Contains(P))
+		{
+			Floor.Add(P);
+			NearFloor.AddFloor(P);
+		}
+	}
+
+	int32 Mismatches = 0;
+	for (int32 Y = -45; Y <= 45; ++Y)
+	{
+		for (int32 X = -45; X <= 45; ++X)
+		{
+			int32 Expected = 0;
+			for (int32 dy = -Radius; dy <= Radius; ++dy)
+			{
+				for (int32 dx = -Radius; dx <= Radius; ++dx)
+				{
+					Expected += Floor.Contains(FIntPoint(X + dx, Y + dy)) ? 1 : 0;
+				}
+			}
+			Mismatches += (NearFloor.Count(FIntPoint(X, Y)) != Expected) ? 1 : 0;
+		}
+	}
+	TestEqual("NearFloor: counts match brute force", Mismatches, 0);
+	return true;
+}
+
+// ============================================================
+// Test 21: Rectangle output — same floor coverage as the per-cell diagram,
+// far fewer cells, symmetric adjacency and the same connected components.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkMergeFloorRectanglesTest, "ProceduralGeometry.DrunkardWalk.MergeFloorRectangles", DefaultTestFlags)
+
+bool FDrunkardWalkMergeFloorRectanglesTest::RunTest(const FString& Parameters)
+{
+	UDrunkardWalkGenerator2D* Gen = MakeTestDrunkardWalk(TEXT("RectMerge"), 12, 6, 6);
+	Gen->SetCorridorWidthRange(1, 3)->SetCorridorTurnProbability(0.2f)->SetMergeFloorRectangles(true);
+	const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
+	if (!TestTrue("MergeFloorRectangles: produced cells", Data.Diagram.Cells.Num() > 0))
+	{
+		return false;
+	}
+
+	int32 FloorCells = 0;
+	for (const bool bFloor : Data.Grid)
+	{
+		FloorCells += bFloor ? 1 : 0;
+	}
+	TestTrue("MergeFloorRectangles: fewer cells than floor cells", Data.Diagram.Cells.Num() < FloorCells);
+	TestTrue("MergeFloorRectangles: at least one rectangle per placed room", Data.Diagram.Cells.Num() >= Data.PlacedRooms.Num());
+
+	// Every rectangle covers floor only, and the rectangles tile the floor exactly once.
+	const double  Size = Data.CellSize;
+	const FBox2D& B = Data.Diagram.Bounds;
+	TArray<int32> Cover;
+	Cover.Init(0, Data.Grid.Num());
+	for (const FLayoutCell2D& Cell : Data.Diagram.Cells)
+	{
+		const int32 X0 = FMath::RoundToInt((Cell.Vertices[0].X - B.Min.X) / Size);
+		const int32 Y0 = FMath::RoundToInt((Cell.Vertices[0].Y - B.Min.Y) / Size);
+		const int32 X1 = FMath::RoundToInt((Cell.Vertices[2].X - B.Min.X) / Size);
+		const int32 Y1 = FMath::RoundToInt((Cell.Vertices[2].Y - B.Min.Y) / Size);
+		for (int32 Y = Y0; Y < Y1; ++Y)
+		{
+			for (int32 X = X0; X < X1; ++X)
+			{
+				++Cover[Y * Data.GridWidth + X];
+			}
+		}
+		for (const int32 N : Cell.Neighbors)
+		{
+			TestTrue("MergeFloorRectangles: adjacency is symmetric", Data.Diagram.Cells[N].Neighbors.Contains(Cell.CellIndex));
+		}
+	}
+	int32 CoverMismatches = 0;
+	for (int32 i = 0; i < Cover.Num(); ++i)
+	{
+		CoverMismatches += (Cover[i] != (Data.Grid[i] ? 1 : 0)) ? 1 : 0;
+	}
+	TestEqual("MergeFloorRectangles: rectangles tile the floor exactly", CoverMismatches, 0);
+
+	// Connected components over rectangle adjacency match the floor regions.
+	TArray<bool> Visited;
+	Visited.Init(false, Data.Diagram.Cells.Num());
+	int32 Components = 0;
+	for (int32 Start = 0; Start < Data.Diagram.Cells.Num(); ++Start)
+	{
+		if (Visited[Start])
+		{
+			continue;
+		}
+		++Components;
+		TArray<int32> Stack = { Start };
+		Visited[Start] = true;
+		while (Stack.Num() > 0)
+		{
+			const int32 Cur = Stack.Pop();
+			for (const int32 N : Data.Diagram.Cells[Cur].Neighbors)
+			{
+				if (!Visited[N])
+				{
+					Visited[N] = true;
+					Stack.Add(N);
+				}
+			}
+		}
+	}
+	TestEqual("MergeFloorRectangles: components match flood-fill regions", Components, Data.Regions.Num());
+	TestTrue("MergeFloorRectangles: center cell set", Data.Diagram.Cells.IsValidIndex(Data.Diagram.CenterCellIndex));
+	return true;
+}
+
+// ============================================================
+// Test 22: GenerateGraph matches the rooms and corridors of GenerateWithGridData
+// for the same seed, with per-point widths and symmetric CSR adjacency.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkGenerateGraphTest, "ProceduralGeometry.DrunkardWalk.GenerateGraph", DefaultTestFlags)
+
+bool FDrunkardWalkGenerateGraphTest::RunTest(const FString& Parameters)
+{
+	auto Configure = [](UDrunkardWalkGenerator2D* Gen) {
+		Gen->SetCorridorWidthRange(1, 3)->SetCorridorTurnProbability(0.15f)->SetCorridorBranchProbability(0.1f)->SetBranchProbability(0.3f);
+	};
+
+	UDrunkardWalkGenerator2D* GridGen = MakeTestDrunkardWalk(TEXT("GraphOnly"), 10);
+	UDrunkardWalkGenerator2D* GraphGen = MakeTestDrunkardWalk(TEXT("GraphOnly"), 10);
+	Configure(GridGen);
+	Configure(GraphGen);
+
+	const FDrunkardWalkGridData Data = GridGen->GenerateWithGridData();
+	const FDungeonGraph2D		Graph = GraphGen->GenerateGraph();
+
+	if (!TestEqual("GenerateGraph: room count", Graph.Rooms.Num(), Data.PlacedRooms.Num())
+		|| !TestEqual("GenerateGraph: corridor count", Graph.Corridors.Num(), Data.WalkerPaths.Num()))
+	{
+		return false;
+	}
+	TestEqual("GenerateGraph: requested rooms", Graph.RequestedRoomCount, Data.RequestedRoomCount);
+
+	for (int32 i = 0; i < Graph.Rooms.Num(); ++i)
+	{
+		const FDrunkardWalkPlacedRoom& A = Graph.Rooms[i];
+		const FDrunkardWalkPlacedRoom& B = Data.PlacedRooms[i];
+		TestTrue(FString::Printf(TEXT("GenerateGraph: room %d matches"), i),
+			A.Min == B.Min && A.Width == B.Width && A.Height == B.Height && A.TypeIndex == B.TypeIndex);
+	}
+	for (int32 i = 0; i < Graph.Corridors.Num(); ++i)
+	{
+		const FDungeonGraphCorridor& C = Graph.Corridors[i];
+		TestTrue(FString::Printf(TEXT("GenerateGraph: corridor %d path matches"), i), C.Path == Data.WalkerPaths[i]);
+		TestEqual(FString::Printf(TEXT("GenerateGraph: corridor %d widths parallel to path"), i), C.Widths.Num(), C.Path.Num());
+		TestEqual(FString::Printf(TEXT("GenerateGraph: corridor %d source"), i), C.SourceRoom, Data.CorridorSourceRoom[i]);
+		TestEqual(FString::Printf(TEXT("GenerateGraph: corridor %d target"), i), C.TargetRoom, Data.CorridorTargetRoom[i]);
+	}
+
+	TestEqual("GenerateGraph: CSR offsets sized Rooms + 1", Graph.AdjacencyOffsets.Num(), Graph.Rooms.Num() + 1);
+	TestEqual("GenerateGraph: two adjacency entries per corridor", Graph.AdjacentRooms.Num(), 2 * Graph.Corridors.Num());
+	for (int32 R = 0; R < Graph.NumRooms(); ++R)
+	{
+		const TArrayView<const int32> Neighbors = Graph.GetNeighbors(R);
+		const TArrayView<const int32> Via = Graph.GetNeighborCorridors(R);
+		for (int32 k = 0; k < Neighbors.Num(); ++k)
+		{
+			const FDungeonGraphCorridor& C = Graph.Corridors[Via[k]];
+			TestTrue("GenerateGraph: adjacency entry matches its corridor",
+				(C.SourceRoom == R && C.TargetRoom == Neighbors[k]) || (C.TargetRoom == R && C.SourceRoom == Neighbors[k]));
+			TestTrue("GenerateGraph: adjacency is symmetric", Graph.GetNeighbors(Neighbors[k]).Contains(R));
+			TestTrue("GenerateGraph: row sorted", k == 0 || Neighbors[k - 1] <= Neighbors[k]);
+		}
+	}
+	return true;
+}
+
+// ============================================================
+// Test 23: Box hash broadphase — overlap queries (with and without an
+// ignored tag) match a brute-force scan, including boxes spanning tiles.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkBoxHashOverlapTest, "ProceduralGeometry.DrunkardWalk.BoxHash.Overlap", DefaultTestFlags)
+
+bool FDrunkardWalkBoxHashOverlapTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Rng(4321);
+	auto RandomBox = [&Rng](int32 MaxSize) {
+		const FIntPoint Min(Rng.RandRange(-100, 100), Rng.RandRange(-100, 100));
+		return FDrunkardWalkBox{ Min, Min + FIntPoint(Rng.RandRange(0, MaxSize), Rng.RandRange(0, MaxSize)) };
+	};
+
+	FDrunkardWalkBoxHash	 Hash;
+	TArray<FDrunkardWalkBox> Boxes;
+	TArray<int32>			 Tags;
+	for (int32 i = 0; i < 60; ++i)
+	{
+		Boxes.Add(RandomBox(i % 10 == 0 ? 70 : 8));
+		Tags.Add(i % 4);
+		Hash.Add(Boxes.Last(), Tags.Last());
+	}
+	TestEqual("BoxHash: box count", Hash.Num(), Boxes.Num());
+
+	int32 Mismatches = 0;
+	for (int32 q = 0; q < 500; ++q)
+	{
+		const FDrunkardWalkBox Query = RandomBox(12);
+		const int32			   IgnoreTag = (q % 2 == 0) ? MIN_int32 : q % 4;
+		bool				   bExpected = false;
+		for (int32 i = 0; i < Boxes.Num() && !bExpected; ++i)
+		{
+			bExpected = Tags[i] != IgnoreTag && Boxes[i].Intersects(Query);
+		}
+		Mismatches += (Hash.AnyOverlap(Query, IgnoreTag) != bExpected) ? 1 : 0;
+	}
+	TestEqual("BoxHash: overlap queries match brute force", Mismatches, 0);
+
+	FDrunkardWalkBox Grown = FDrunkardWalkBox::Empty();
+	Grown.Include(FIntPoint(-3, 5));
+	Grown.Include(FIntPoint(2, -1));
+	TestTrue("BoxHash: Include grows from Empty", Grown.Min == FIntPoint(-3, -1) && Grown.Max == FIntPoint(2, 5));
+	TestTrue("BoxHash: ExpandBy touches an adjacent box", Grown.ExpandBy(1).Intersects({ FIntPoint(3, 6), FIntPoint(4, 7) }));
+	return true;
+}
+
+// ============================================================
+// Test 24: Speculative placement — a high-retry config yields the same
+// layout and placement for 1, 3 and 8 concurrent attempts per exit.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkPlacementWorkersTest, "ProceduralGeometry.DrunkardWalk.PlacementWorkers.Deterministic", DefaultTestFlags)
+
+bool FDrunkardWalkPlacementWorkersTest::RunTest(const FString& Parameters)
+{
+	auto GenerateWith = [](int32 Workers) {
+		UDrunkardWalkGenerator2D* Gen = MakeTestDrunkardWalk(TEXT("SpeculativeAttempts"), 12);
+		Gen->SetCorridorWidthRange(1, 3)
+			->SetCorridorTurnProbability(0.3f)
+			->SetCorridorBranchProbability(0.15f)
+			->SetRoomBorderMargin(2)
+			->SetMaxPlacementAttemptsPerExit(24)
+			->SetPlacementWorkers(Workers);
+		return Gen->GenerateWithGridData();
+	};
+
+	const FDrunkardWalkGridData Serial = GenerateWith(1);
+	TestTrue("PlacementWorkers: produced rooms", Serial.PlacedRooms.Num() > 1);
+	for (const int32 Workers : { 3, 8 })
+	{
+		const FDrunkardWalkGridData Parallel = GenerateWith(Workers);
+		TestTrue(FString::Printf(TEXT("PlacementWorkers: grid identical with %d workers"), Workers), Parallel.Grid == Serial.Grid);
+		TestEqual(FString::Printf(TEXT("PlacementWorkers: room count with %d workers"), Workers), Parallel.PlacedRooms.Num(), Serial.PlacedRooms.Num());
+		TestEqual(FString::Printf(TEXT("PlacementWorkers: corridor count with %d workers"), Workers), Parallel.WalkerPaths.Num(), Serial.WalkerPaths.Num());
+	}
+	return true;
+}
+
+// ============================================================
+// Test 25: Tiled raster — cell types, region ids and the center region match
+// the dense grid for the same seed, while storing fewer cells for a long walk.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkTiledRasterTest, "ProceduralGeometry.DrunkardWalk.Tiled.MatchesDense", DefaultTestFlags)
+
+bool FDrunkardWalkTiledRasterTest::RunTest(const FString& Parameters)
+{
+	auto Configure = [](UDrunkardWalkGenerator2D* Gen) {
+		Gen->SetCorridorLengthRange(10, 20)->SetCorridorWidthRange(1, 2)->SetCorridorTurnProbability(0.1f)->SetWallThickness(2);
+	};
+
+	UDrunkardWalkGenerator2D* DenseGen = MakeTestDrunkardWalk(TEXT("TiledRaster"), 20);
+	UDrunkardWalkGenerator2D* TiledGen = MakeTestDrunkardWalk(TEXT("TiledRaster"), 20);
+	Configure(DenseGen);
+	Configure(TiledGen);
+
+	const FDrunkardWalkGridData		 Dense = DenseGen->GenerateWithGridData();
+	const FDrunkardWalkTiledGridData Tiled = TiledGen->GenerateTiled();
+
+	TestEqual("Tiled: grid width", Tiled.GridWidth, Dense.GridWidth);
+	TestEqual("Tiled: grid height", Tiled.GridHeight, Dense.GridHeight);
+	TestEqual("Tiled: placed rooms", Tiled.PlacedRooms.Num(), Dense.PlacedRooms.Num());
+	TestEqual("Tiled: region count", Tiled.RegionSizes.Num(), Dense.Regions.Num());
+	TestEqual("Tiled: center region", Tiled.CenterRegionId, Dense.CenterRegionId);
+
+	int32 TypeMismatches = 0;
+	int32 RegionMismatches = 0;
+	for (int32 Y = 0; Y < Dense.GridHeight; ++Y)
+	{
+		for (int32 X = 0; X < Dense.GridWidth; ++X)
+		{
+			const int32 Index = Y * Dense.GridWidth + X;
+			TypeMismatches += (Tiled.GetCellType(FIntPoint(X, Y)) != Dense.CellType[Index]) ? 1 : 0;
+			RegionMismatches += (Tiled.GetRegionId(FIntPoint(X, Y)) != Dense.RegionIds[Index]) ? 1 : 0;
+		}
+	}
+	TestEqual("Tiled: cell types match dense", TypeMismatches, 0);
+	TestEqual("Tiled: region ids match dense", RegionMismatches, 0);
+
+	for (int32 RegionId = 0; RegionId < FMath::Min(Tiled.RegionSizes.Num(), Dense.Regions.Num()); ++RegionId)
+	{
+		TestEqual(FString::Printf(TEXT("Tiled: region %d size"), RegionId), Tiled.RegionSizes[RegionId], Dense.Regions[RegionId].Num());
+	}
+
+	// Every stored non-empty cell lies inside the dense frame.
+	int32 OutsideCells = 0;
+	for (const FDrunkardWalkTiledGridData::FTile& Tile : Tiled.Tiles)
+	{
+		for (int32 Local = 0; Local < FDrunkardWalkTiledGridData::TileCells; ++Local)
+		{
+			const int32 X = Tile.Coord.X * FDrunkardWalkTiledGridData::TileSize + (Local % FDrunkardWalkTiledGridData::TileSize);
+			const int32 Y = Tile.Coord.Y * FDrunkardWalkTiledGridData::TileSize + (Local / FDrunkardWalkTiledGridData::TileSize);
+			const bool	bInside = X >= 0 && X < Dense.GridWidth && Y >= 0 && Y < Dense.GridHeight;
+			OutsideCells += (!bInside && Tile.CellType[Local] != EDrunkardWalkCellType::Empty) ? 1 : 0;
+		}
+	}
+	TestEqual("Tiled: no cells outside the dense frame", OutsideCells, 0);
+	AddInfo(FString::Printf(TEXT("Tiled: %lld stored cells vs %d dense"), Tiled.NumStoredCells(), Dense.GridWidth * Dense.GridHeight));
+	return true;
+}
+
+// ============================================================
+// Test 26: Compact diagram — GenerateCompact matches Generate cell for cell,
+// views expose the same fields, and FromDiagram/ToDiagram round-trip.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDrunkardWalkCompactDiagramTest, "ProceduralGeometry.DrunkardWalk.CompactDiagram", DefaultTestFlags)
+
+bool FDrunkardWalkCompactDiagramTest::RunTest(const FString& Parameters)
+{
+	const FLayoutDiagram2D		Diagram = MakeTestDrunkardWalk(TEXT("CompactDiagram"), 8)->Generate();
+	const FLayoutDiagramCompact Compact = MakeTestDrunkardWalk(TEXT("CompactDiagram"), 8)->GenerateCompact();
+
+	if (!TestEqual("Compact: cell count", Compact.Num(), Diagram.Cells.Num()))
+	{
+		return false;
+	}
+	TestEqual("Compact: center cell", Compact.CenterCellIndex, Diagram.CenterCellIndex);
+	TestEqual("Compact: seed", Compact.Seed, Diagram.Seed);
+	TestTrue("Compact: bounds", Compact.Bounds == Diagram.Bounds);
+
+	TestTrue("Compact: matches the per-cell diagram", LayoutsEqual(Diagram, Compact));
+	int32 Mismatches = 0;
+	for (const FLayoutCellView Cell : Compact.GetCells())
+	{
+		Mismatches += CellsEqual(Diagram.Cells[Cell.CellIndex], Cell) ? 0 : 1;
+	}
+	TestEqual("Compact: every cell view matches the per-cell diagram", Mismatches, 0);
+
+	TestTrue("Compact: FromDiagram/ToDiagram round-trips", LayoutsEqual(FLayoutDiagramCompact::FromDiagram(Diagram).ToDiagram(), Compact));
+	AddInfo(FString::Printf(TEXT("Compact: %llu bytes for %d cells"), static_cast<uint64>(Compact.GetAllocatedSize()), Compact.Num()));
+	return true;
+}
+
 #endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,167 @@
+#include "Generators/LayoutBinaryFormat.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "../ProceduralGeometryTestFixtures.h"
+#include "../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// ============================================================
+// Test 1: DrunkardWalk grid data round-trips through bytes and through a memory-mapped file.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutBinaryDrunkardWalkRoundTripTest, "ProceduralGeometry.LayoutBinary.DrunkardWalkRoundTrip", DefaultTestFlags)
+
+bool FLayoutBinaryDrunkardWalkRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FDrunkardWalkGridData Data = MakeTestDrunkardWalk(TEXT("Binary"), 6)->GenerateWithGridData();
+	const TArray<uint8>			Bytes = FLayoutBinaryFormat::Write(Data);
+	TestEqual("Binary: file size is a multiple of the payload alignment", Bytes.Num() % PGLayoutBinary::PayloadAlignment, 0);
+
+	const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("LayoutBinary_DW.pglb"));
+	TestTrue("Binary: file written", FLayoutBinaryFormat::SaveToFile(Bytes, Path));
+
+	const TUniquePtr<FLayoutBinaryReader> FromBytes = FLayoutBinaryReader::OpenBytes(Bytes);
+	const TUniquePtr<FLayoutBinaryReader> FromFile = FLayoutBinaryReader::OpenFile(Path);
+	if (!TestTrue("Binary: buffer opens", FromBytes.IsValid()) || !TestTrue("Binary: file opens", FromFile.IsValid()))
+	{
+		return false;
+	}
+
+	for (const FLayoutBinaryReader* Reader : { FromBytes.Get(), FromFile.Get() })
+	{
+		FDrunkardWalkGridData Loaded;
+		if (!TestTrue("Binary: DW data reads back", FLayoutBinaryFormat::Read(*Reader, Loaded)))
+		{
+			return false;
+		}
+		TestTrue("Binary: Grid", Loaded.Grid == Data.Grid);
+		TestTrue("Binary: CellType", Loaded.CellType == Data.CellType);
+		TestTrue("Binary: RegionIds", Loaded.RegionIds == Data.RegionIds);
+		TestTrue("Binary: Regions", Loaded.Regions == Data.Regions);
+		TestTrue("Binary: WalkerPaths", Loaded.WalkerPaths == Data.WalkerPaths);
+		TestTrue("Binary: corridor rooms", Loaded.CorridorSourceRoom == Data.CorridorSourceRoom && Loaded.CorridorTargetRoom == Data.CorridorTargetRoom);
+		TestTrue("Binary: RoomCenters", Loaded.RoomCenters == Data.RoomCenters);
+		TestEqual("Binary: PlacedRooms count", Loaded.PlacedRooms.Num(), Data.PlacedRooms.Num());
+		for (int32 i = 0; i < FMath::Min(Loaded.PlacedRooms.Num(), Data.PlacedRooms.Num()); ++i)
+		{
+			const FDrunkardWalkPlacedRoom& A = Loaded.PlacedRooms[i];
+			const FDrunkardWalkPlacedRoom& B = Data.PlacedRooms[i];
+			TestTrue("Binary: PlacedRoom", A.Min == B.Min && A.Width == B.Width && A.Height == B.Height && A.TypeIndex == B.TypeIndex);
+		}
+		TestEqual("Binary: GridWidth", Loaded.GridWidth, Data.GridWidth);
+		TestEqual("Binary: GridHeight", Loaded.GridHeight, Data.GridHeight);
+		TestEqual("Binary: CellSize", Loaded.CellSize, Data.CellSize);
+		TestEqual("Binary: CenterRegionId", Loaded.CenterRegionId, Data.CenterRegionId);
+		TestEqual("Binary: RequestedRoomCount", Loaded.RequestedRoomCount, Data.RequestedRoomCount);
+		TestEqual("Binary: bDegradedResolution", Loaded.bDegradedResolution, Data.bDegradedResolution);
+		TestTrue("Binary: Diagram", LayoutsEqual(Loaded.Diagram, Data.Diagram));
+	}
+
+	// A DW file is not a CA file.
+	FCellularAutomataGridData WrongKind;
+	TestFalse("Binary: kind mismatch is rejected", FLayoutBinaryFormat::Read(*FromBytes, WrongKind));
+
+	IFileManager::Get().Delete(*Path);
+	return true;
+}
+
+// ============================================================
+// Test 2: CellularAutomata grid data (including the region graph) and a bare diagram round-trip.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutBinaryCellularAutomataRoundTripTest, "ProceduralGeometry.LayoutBinary.CellularAutomataRoundTrip", DefaultTestFlags)
+
+bool FLayoutBinaryCellularAutomataRoundTripTest::RunTest(const FString& Parameters)
+{
+	UCellularAutomataGenerator2D* Gen = NewObject<UCellularAutomataGenerator2D>();
+	Gen->SetSeed(TEXT("Binary"))->SetGridSize(64);
+	const FCellularAutomataGridData Data = Gen->GenerateWithGridData();
+
+	const TArray<uint8>					  Bytes = FLayoutBinaryFormat::Write(Data);
+	const TUniquePtr<FLayoutBinaryReader> Reader = FLayoutBinaryReader::OpenBytes(Bytes);
+	FCellularAutomataGridData			  Loaded;
+	if (!TestTrue("Binary: CA buffer opens", Reader.IsValid()) || !TestTrue("Binary: CA data reads back", FLayoutBinaryFormat::Read(*Reader, Loaded)))
+	{
+		return false;
+	}
+	TestTrue("Binary: Grid", Loaded.Grid == Data.Grid);
+	TestTrue("Binary: RegionIds", Loaded.RegionIds == Data.RegionIds);
+	TestTrue("Binary: Regions", Loaded.Regions == Data.Regions);
+	TestTrue("Binary: SurvivingRegions", Loaded.SurvivingRegions == Data.SurvivingRegions);
+	TestTrue("Binary: RegionGraph offsets/neighbors",
+		Loaded.RegionGraph.Offsets == Data.RegionGraph.Offsets && Loaded.RegionGraph.Neighbors == Data.RegionGraph.Neighbors);
+	TestTrue("Binary: RegionGraph metrics",
+		Loaded.RegionGraph.ContactLength == Data.RegionGraph.ContactLength && Loaded.RegionGraph.WallThickness == Data.RegionGraph.WallThickness);
+	TestEqual("Binary: CenterRegionId", Loaded.CenterRegionId, Data.CenterRegionId);
+	TestEqual("Binary: GridWidth", Loaded.GridWidth, Data.GridWidth);
+	TestEqual("Binary: CellSize", Loaded.CellSize, Data.CellSize);
+	TestTrue("Binary: Diagram", LayoutsEqual(Loaded.Diagram, Data.Diagram));
+
+	// Bare diagram: the in-place views alias the buffer and match the compact form.
+	const FLayoutDiagramCompact			  Compact = FLayoutDiagramCompact::FromDiagram(Data.Diagram);
+	const TArray<uint8>					  DiagramBytes = FLayoutBinaryFormat::Write(Compact);
+	const TUniquePtr<FLayoutBinaryReader> DiagramReader = FLayoutBinaryReader::OpenBytes(DiagramBytes);
+	FLayoutDiagram2D					  LoadedDiagram;
+	if (!TestTrue("Binary: diagram buffer opens", DiagramReader.IsValid()))
+	{
+		return false;
+	}
+	TestTrue("Binary: diagram reads back", FLayoutBinaryFormat::Read(*DiagramReader, LoadedDiagram));
+	TestTrue("Binary: diagram matches", LayoutsEqual(LoadedDiagram, Data.Diagram));
+
+	const TArrayView<const int32> Offsets = DiagramReader->GetArray<int32>(PGLayoutBinary::MakeTag("DVOF"));
+	TestTrue("Binary: offsets view matches", TArray<int32>(Offsets) == Compact.VertexOffsets);
+	TestTrue("Binary: view points into the buffer",
+		reinterpret_cast<const uint8*>(Offsets.GetData()) >= DiagramBytes.GetData()
+			&& reinterpret_cast<const uint8*>(Offsets.GetData()) < DiagramBytes.GetData() + DiagramBytes.Num());
+	TestEqual("Binary: wrong element size gives an empty view", DiagramReader->GetArray<int64>(PGLayoutBinary::MakeTag("DVOF")).Num(), 0);
+	return true;
+}
+
+// ============================================================
+// Test 3: Corrupted, truncated, foreign and future-version buffers are rejected, never read.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutBinaryRejectCorruptTest, "ProceduralGeometry.LayoutBinary.RejectCorrupt", DefaultTestFlags)
+
+bool FLayoutBinaryRejectCorruptTest::RunTest(const FString& Parameters)
+{
+	const TArray<uint8>					  Bytes = FLayoutBinaryFormat::Write(MakeTestDrunkardWalk(TEXT("Binary"), 6)->GenerateWithGridData());
+	const TUniquePtr<FLayoutBinaryReader> Pristine = FLayoutBinaryReader::OpenBytes(Bytes);
+	if (!TestTrue("Binary: pristine buffer opens", Pristine.IsValid()))
+	{
+		return false;
+	}
+	const uint64 GridOffset = Pristine->FindSection(PGLayoutBinary::MakeTag("GRID"))->Offset;
+
+	AddExpectedError(TEXT("[LayoutBinary]"), EAutomationExpectedErrorFlags::Contains, 0);
+
+	// Payload byte flip: caught by the section CRC, and only when checksums are verified.
+	TArray<uint8> Flipped = Bytes;
+	Flipped[GridOffset] ^= 0x5A;
+	FString Error;
+	TestFalse("Binary: flipped payload byte rejected", FLayoutBinaryReader::OpenBytes(Flipped, true, &Error).IsValid());
+	TestTrue("Binary: error names the checksum", Error.Contains(TEXT("checksum")));
+
+	// Section table flip: caught by the table CRC even without payload verification.
+	TArray<uint8> BadTable = Bytes;
+	BadTable[sizeof(PGLayoutBinary::FHeader) + 8] ^= 0x01;
+	TestFalse("Binary: flipped table byte rejected", FLayoutBinaryReader::OpenBytes(BadTable, false).IsValid());
+
+	TArray<uint8> Truncated = Bytes;
+	Truncated.SetNum(Bytes.Num() - PGLayoutBinary::PayloadAlignment);
+	TestFalse("Binary: truncated buffer rejected", FLayoutBinaryReader::OpenBytes(Truncated).IsValid());
+	TestFalse("Binary: header-only buffer rejected", FLayoutBinaryReader::OpenBytes(MakeArrayView(Bytes.GetData(), 8)).IsValid());
+
+	TArray<uint8> BadMagic = Bytes;
+	BadMagic[0] ^= 0xFF;
+	TestFalse("Binary: bad magic rejected", FLayoutBinaryReader::OpenBytes(BadMagic).IsValid());
+
+	TArray<uint8> FutureVersion = Bytes;
+	reinterpret_cast<PGLayoutBinary::FHeader*>(FutureVersion.GetData())->Version = PGLayoutBinary::Version + 1;
+	TestFalse("Binary: newer version rejected", FLayoutBinaryReader::OpenBytes(FutureVersion).IsValid());
+
+	TestFalse("Binary: missing file rejected",
+		FLayoutBinaryReader::OpenFile(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("LayoutBinary_Missing.pglb"))).IsValid());
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
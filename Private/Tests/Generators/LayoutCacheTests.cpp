@@ -0,0 +1,228 @@
+#include "Generators/LayoutCache.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "../ProceduralGeometryTestFixtures.h"
+#include "../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Enables the cache in a private directory for one test and restores the previous state afterwards. */
+	struct FScopedTestCache
+	{
+		IConsoleVariable* CVar;
+		int32			  PreviousValue;
+
+		explicit FScopedTestCache(const TCHAR* Name)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(TEXT("pg.LayoutCache"))), PreviousValue(CVar->GetInt())
+		{
+			CVar->Set(1, ECVF_SetByCode);
+			FLayoutGenerationCache::Get().SetDirectory(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("LayoutCache"), Name));
+			FLayoutGenerationCache::Get().SetMaxBytes(-1);
+			FLayoutGenerationCache::Get().Clear();
+		}
+
+		~FScopedTestCache()
+		{
+			FLayoutGenerationCache::Get().Clear();
+			FLayoutGenerationCache::Get().SetMaxBytes(-1);
+			FLayoutGenerationCache::Get().SetDirectory(FString());
+			CVar->Set(PreviousValue, ECVF_SetByCode);
+		}
+	};
+} // namespace
+
+// ============================================================
+// Test 1: A cached generator returns exactly what an uncached one does, including on
+// repeated Generate calls that continue the same random stream.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCacheMatchesUncachedTest, "ProceduralGeometry.LayoutCache.MatchesUncached", DefaultTestFlags)
+
+bool FLayoutCacheMatchesUncachedTest::RunTest(const FString& Parameters)
+{
+	// Reference, cache off: two calls on one generator give two different layouts.
+	UDrunkardWalkGenerator2D*	Reference = MakeTestDrunkardWalk(TEXT("CacheSeed"), 5);
+	const FDrunkardWalkGridData First = Reference->GenerateWithGridData();
+	const FDrunkardWalkGridData Second = Reference->GenerateWithGridData();
+
+	FScopedTestCache Cache(TEXT("MatchesUncached"));
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		UDrunkardWalkGenerator2D* Gen = MakeTestDrunkardWalk(TEXT("CacheSeed"), 5);
+		TestTrue("Cache: first call matches uncached", LayoutsEqual(Gen->GenerateWithGridData(), First));
+		TestTrue("Cache: second call matches uncached", LayoutsEqual(Gen->GenerateWithGridData(), Second));
+	}
+
+	const FLayoutCacheStats Stats = FLayoutGenerationCache::Get().GetStats();
+	TestEqual("Cache: first pass misses twice", Stats.Misses, 2);
+	TestEqual("Cache: second pass hits twice", Stats.Hits, 2);
+	TestEqual("Cache: one entry per stream state", Stats.Entries, 2);
+
+	// CA diagrams go through the same path.
+	UCellularAutomataGenerator2D* CA = NewObject<UCellularAutomataGenerator2D>();
+	CA->SetSeed(TEXT("CacheSeed"));
+	const FLayoutDiagram2D Generated = CA->Generate();
+	CA->SetSeed(TEXT("CacheSeed"));
+	const FLayoutDiagram2D Loaded = CA->Generate();
+	TestEqual("Cache: CA diagram hit", FLayoutGenerationCache::Get().GetStats().Hits, 3);
+	TestEqual("Cache: CA diagram cell count", Loaded.Cells.Num(), Generated.Cells.Num());
+	TestEqual("Cache: CA diagram seed", Loaded.Seed, Generated.Seed);
+	return true;
+}
+
+// ============================================================
+// Test 2: Every output-affecting parameter is part of the key; PlacementWorkers is not.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCacheKeyTest, "ProceduralGeometry.LayoutCache.Key", DefaultTestFlags)
+
+bool FLayoutCacheKeyTest::RunTest(const FString& Parameters)
+{
+	FScopedTestCache Cache(TEXT("Key"));
+
+	MakeTestDrunkardWalk(TEXT("KeySeed"), 5)->GenerateWithGridData();
+	MakeTestDrunkardWalk(TEXT("KeySeed"), 5)->SetPlacementWorkers(1)->GenerateWithGridData();
+	TestEqual("Cache: PlacementWorkers shares the entry", FLayoutGenerationCache::Get().GetStats().Hits, 1);
+
+	MakeTestDrunkardWalk(TEXT("KeySeed"), 5)->SetWallThickness(2)->GenerateWithGridData();
+	MakeTestDrunkardWalk(TEXT("keyseed"), 5)->GenerateWithGridData();
+	MakeTestDrunkardWalk(TEXT("KeySeed"), 5)->SetGridSize(120)->GenerateWithGridData();
+	MakeTestDrunkardWalk(TEXT("KeySeed"), 5)->Generate();
+	TestEqual("Cache: param, seed case, grid size and output kind all miss", FLayoutGenerationCache::Get().GetStats().Misses, 5);
+	TestEqual("Cache: no further hits", FLayoutGenerationCache::Get().GetStats().Hits, 1);
+	return true;
+}
+
+// ============================================================
+// Test 3: Lowering the size cap evicts the least recently used entry; a corrupted entry
+// is discarded and regenerated.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCacheEvictionTest, "ProceduralGeometry.LayoutCache.Eviction", DefaultTestFlags)
+
+bool FLayoutCacheEvictionTest::RunTest(const FString& Parameters)
+{
+	FScopedTestCache Cache(TEXT("Eviction"));
+
+	MakeTestDrunkardWalk(TEXT("A"), 5)->GenerateWithGridData();
+	MakeTestDrunkardWalk(TEXT("B"), 5)->GenerateWithGridData();
+	MakeTestDrunkardWalk(TEXT("C"), 5)->GenerateWithGridData();
+	MakeTestDrunkardWalk(TEXT("A"), 5)->GenerateWithGridData(); // A is now more recent than B
+	TestEqual("Cache: three entries", FLayoutGenerationCache::Get().GetStats().Entries, 3);
+
+	FLayoutGenerationCache::Get().SetMaxBytes(FLayoutGenerationCache::Get().GetStats().TotalBytes - 1);
+	FLayoutCacheStats Stats = FLayoutGenerationCache::Get().GetStats();
+	TestEqual("Cache: one eviction", Stats.Evictions, 1);
+	TestEqual("Cache: two entries left", Stats.Entries, 2);
+
+	const int32 HitsBefore = Stats.Hits;
+	MakeTestDrunkardWalk(TEXT("A"), 5)->GenerateWithGridData();
+	MakeTestDrunkardWalk(TEXT("C"), 5)->GenerateWithGridData();
+	TestEqual("Cache: A and C survived", FLayoutGenerationCache::Get().GetStats().Hits, HitsBefore + 2);
+
+	// Corrupt every remaining file; lookups must fall back to generating the right layout.
+	FLayoutGenerationCache::Get().SetMaxBytes(-1);
+	const FDrunkardWalkGridData Expected = MakeTestDrunkardWalk(TEXT("A"), 5)->GenerateWithGridData();
+	TArray<FString>				Files;
+	IFileManager::Get().FindFiles(Files, *FPaths::Combine(FLayoutGenerationCache::Get().GetDirectory(), TEXT("*.pglb")), true, false);
+	for (const FString& File : Files)
+	{
+		const FString Path = FPaths::Combine(FLayoutGenerationCache::Get().GetDirectory(), File);
+		TArray<uint8> Bytes;
+		FFileHelper::LoadFileToArray(Bytes, *Path);
+		const uint64 GridOffset = FLayoutBinaryReader::OpenBytes(Bytes)->FindSection(PGLayoutBinary::MakeTag("GRID"))->Offset;
+		Bytes[GridOffset] ^= 0xFF;
+		FFileHelper::SaveArrayToFile(Bytes, *Path);
+	}
+
+	AddExpectedError(TEXT("[LayoutBinary]"), EAutomationExpectedErrorFlags::Contains, 0);
+	const int32 MissesBefore = FLayoutGenerationCache::Get().GetStats().Misses;
+	TestTrue("Cache: corrupted entry regenerates", LayoutsEqual(MakeTestDrunkardWalk(TEXT("A"), 5)->GenerateWithGridData(), Expected));
+	TestEqual("Cache: corrupted entry counts as a miss", FLayoutGenerationCache::Get().GetStats().Misses, MissesBefore + 1);
+	return true;
+}
+
+// ============================================================
+// Test 4: A run that degrades resolution to fit the cell budget leaves the configured grid
+// size alone, so a cache hit and a miss agree on GetGridSize() and on later calls.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCacheDegradedGridSizeTest, "ProceduralGeometry.LayoutCache.DegradedGridSize", DefaultTestFlags)
+
+bool FLayoutCacheDegradedGridSizeTest::RunTest(const FString& Parameters)
+{
+	// 2050x2050 cells at the requested size: just over the 2048x2048 budget.
+	auto MakeDegraded = [] {
+		UCellularAutomataGenerator2D* Gen = NewObject<UCellularAutomataGenerator2D>();
+		Gen->SetBounds(FBox2D(FVector2D(-10250, -10250), FVector2D(10250, 10250)))->SetGridSize(10)->SetSeed(TEXT("DegradedSeed"));
+		return Gen;
+	};
+
+	FScopedTestCache Cache(TEXT("DegradedGridSize"));
+
+	UCellularAutomataGenerator2D*	Miss = MakeDegraded();
+	const FCellularAutomataGridData Generated = Miss->GenerateWithGridData();
+	UCellularAutomataGenerator2D*	Hit = MakeDegraded();
+	const FCellularAutomataGridData Loaded = Hit->GenerateWithGridData();
+
+	TestTrue("Cache: run is degraded", Generated.bDegradedResolution && Generated.CellSize > 10.0f);
+	TestEqual("Cache: second generator hits", FLayoutGenerationCache::Get().GetStats().Hits, 1);
+	TestEqual("Cache: miss keeps the configured grid size", Miss->GetGridSize(), 10);
+	TestEqual("Cache: hit and miss agree on the grid size", Hit->GetGridSize(), Miss->GetGridSize());
+	TestTrue("Cache: hit matches the generated layout", Loaded.Grid == Generated.Grid && Loaded.CellSize == Generated.CellSize);
+
+	// Both generators key their next call on the same inputs, so it is one miss and one hit again.
+	const FCellularAutomataGridData MissNext = Miss->GenerateWithGridData();
+	const FCellularAutomataGridData HitNext = Hit->GenerateWithGridData();
+	TestEqual("Cache: next calls share an entry", FLayoutGenerationCache::Get().GetStats().Hits, 2);
+	TestTrue("Cache: next calls agree", MissNext.bDegradedResolution == HitNext.bDegradedResolution && MissNext.Grid == HitNext.Grid);
+	return true;
+}
+
+
+// ============================================================
+// Test 5: Grid diagrams keep their GridLookup through the cache, so a hit answers FindCellAt
+// from the lookup exactly like the uncached diagram does.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCacheGridLookupTest, "ProceduralGeometry.LayoutCache.GridLookup", DefaultTestFlags)
+
+bool FLayoutCacheGridLookupTest::RunTest(const FString& Parameters)
+{
+	const FLayoutDiagram2D		Uncached = MakeTestDrunkardWalk(TEXT("LookupSeed"), 5)->Generate();
+	const FDrunkardWalkGridData UncachedData = MakeTestDrunkardWalk(TEXT("LookupSeed"), 5)->GenerateWithGridData();
+	const FLayoutGridLookup* UncachedLookup = Uncached.GetGridLookup();
+	if (!TestTrue("Cache: uncached diagram has a lookup", UncachedLookup && UncachedData.Diagram.GetGridLookup()))
+	{
+		return false;
+	}
+
+	FScopedTestCache Cache(TEXT("GridLookup"));
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		const TCHAR*				Label = Pass == 0 ? TEXT("miss") : TEXT("hit");
+		const FLayoutDiagram2D		Diagram = MakeTestDrunkardWalk(TEXT("LookupSeed"), 5)->Generate();
+		const FDrunkardWalkGridData Data = MakeTestDrunkardWalk(TEXT("LookupSeed"), 5)->GenerateWithGridData();
+		for (const FLayoutGridLookup* Lookup : { Diagram.GetGridLookup(), Data.Diagram.GetGridLookup() })
+		{
+			if (!TestNotNull(FString::Printf(TEXT("Cache %s: lookup valid"), Label), Lookup))
+			{
+				return false;
+			}
+			TestTrue(FString::Printf(TEXT("Cache %s: lookup matches uncached"), Label),
+				Lookup->GridToCellIndex == UncachedLookup->GridToCellIndex && Lookup->Origin == UncachedLookup->Origin
+					&& Lookup->CellSize == UncachedLookup->CellSize && Lookup->Width == UncachedLookup->Width);
+		}
+
+		int32 Mismatches = 0;
+		for (const FLayoutCell2D& Cell : Diagram.Cells)
+		{
+			Mismatches += Diagram.FindCellAt(Cell.Center) != Cell.CellIndex;
+		}
+		TestEqual(FString::Printf(TEXT("Cache %s: every center finds its cell"), Label), Mismatches, 0);
+		TestNull(FString::Printf(TEXT("Cache %s: no BVH built over a grid diagram"), Label), Diagram.GetCellBVH());
+	}
+	TestEqual("Cache: second pass hits", FLayoutGenerationCache::Get().GetStats().Hits, 2);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,243 @@
+#include "Generators/LayoutCellLocator.h"
+#include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
+#include "GeometryUtils/GeometryFunctionLibrary.h"
+#include "ProceduralGeometry.h"
+#include "../ProceduralGeometryTestFixtures.h"
+#include "../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FLayoutDiagram2D MakeLocatorDungeon(bool bMergeRectangles)
+	{
+		UDrunkardWalkGenerator2D* Gen = MakeTestDrunkardWalk(TEXT("CellLocator"), 6, 4, 5);
+		return Gen->SetBranchProbability(0.3f)->SetCorridorWidthRange(1, 2)->SetMergeFloorRectangles(bMergeRectangles)->Generate();
+	}
+
+	FLayoutDiagram2D MakeLocatorCave()
+	{
+		UCellularAutomataGenerator2D* Gen = NewObject<UCellularAutomataGenerator2D>();
+		Gen->SetBounds(FBox2D(FVector2D(-2000, -2000), FVector2D(2000, 2000)));
+		Gen->SetSeed(TEXT("CellLocator"));
+		return Gen->Generate();
+	}
+
+	/** Random points over the diagram bounds, widened so some fall outside every cell. */
+	TArray<FVector2D> MakeQueryPoints(const FLayoutDiagram2D& Diagram, int32 Count)
+	{
+		FBox2D Box(ForceInit);
+		for (const FLayoutCell2D& Cell : Diagram.Cells)
+		{
+			for (const FVector2D& Vertex : Cell.Vertices)
+			{
+				Box += Vertex;
+			}
+		}
+		Box = Box.ExpandBy(Box.GetExtent().X * 0.1);
+
+		FRandomStream	  Random(1234);
+		TArray<FVector2D> Points;
+		Points.Reserve(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Points.Add(FVector2D(Random.FRandRange(Box.Min.X, Box.Max.X), Random.FRandRange(Box.Min.Y, Box.Max.Y)));
+		}
+		return Points;
+	}
+
+	/** Lowest-index cell whose polygon contains Point, testing every cell; INDEX_NONE if none does. */
+	int32 ScanForCell(const FLayoutDiagram2D& Diagram, const FVector2D& Point)
+	{
+		for (int32 CellIndex = 0; CellIndex < Diagram.Cells.Num(); ++CellIndex)
+		{
+			if (FGeometryUtils::PointInPolygon(Diagram.Cells[CellIndex].Vertices, Point))
+			{
+				return CellIndex;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Checks FindCellAt and FindCellsAt against a plain polygon scan of the same diagram: a point is found exactly when
+	 * some polygon contains it, and the cell found contains it. (Cave regions can sit inside another region's outline,
+	 * so the scan's lowest index is not always the answer.)
+	 */
+	bool MatchesScan(FAutomationTestBase& Test, const TCHAR* Label, const FLayoutDiagram2D& Diagram, bool bCheckCenters)
+	{
+		for (int32 CellIndex = 0; bCheckCenters && CellIndex < Diagram.Cells.Num(); ++CellIndex)
+		{
+			const FVector2D& Center = Diagram.Cells[CellIndex].Center;
+			if (!Test.TestEqual(FString::Printf(TEXT("%s: center of cell %d"), Label, CellIndex), Diagram.FindCellAt(Center), CellIndex))
+			{
+				return false;
+			}
+		}
+
+		const TArray<FVector2D> Points = MakeQueryPoints(Diagram, 4000);
+		TArray<int32>			Found;
+		int32					Hits = 0;
+		for (const FVector2D& Point : Points)
+		{
+			const int32 Cell = Diagram.FindCellAt(Point);
+			const bool	bInside = ScanForCell(Diagram, Point) != INDEX_NONE;
+			const bool	bValid = bInside ? Cell != INDEX_NONE && FGeometryUtils::PointInPolygon(Diagram.Cells[Cell].Vertices, Point)
+										 : Cell == INDEX_NONE;
+			if (!Test.TestTrue(FString::Printf(TEXT("%s: point (%.2f, %.2f)"), Label, Point.X, Point.Y), bValid))
+			{
+				return false;
+			}
+			Found.Add(Cell);
+			Hits += bInside;
+		}
+		Test.TestTrue(FString::Printf(TEXT("%s: some points hit cells"), Label), Hits > 0);
+		Test.TestTrue(FString::Printf(TEXT("%s: some points miss"), Label), Hits < Points.Num());
+
+		TArray<int32> Batched;
+		TArray<int32> BatchedParallel;
+		Diagram.FindCellsAt(Points, Batched);
+		Diagram.FindCellsAt(Points, BatchedParallel, true);
+		Test.TestTrue(FString::Printf(TEXT("%s: batched"), Label), Batched == Found);
+		Test.TestTrue(FString::Printf(TEXT("%s: batched parallel"), Label), BatchedParallel == Found);
+		return true;
+	}
+} // namespace
+
+// ============================================================
+// Test 1: Grid-derived diagrams (one cell per grid cell, and merged rectangles) keep their
+// grid lookup, and it agrees with polygon tests everywhere.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCellLocatorGridTest, "ProceduralGeometry.CellLocator.Grid", DefaultTestFlags)
+
+bool FLayoutCellLocatorGridTest::RunTest(const FString& Parameters)
+{
+	for (const bool bMerge : { false, true })
+	{
+		const TCHAR*		   Label = bMerge ? TEXT("Rectangles") : TEXT("Grid");
+		const FLayoutDiagram2D Diagram = MakeLocatorDungeon(bMerge);
+		TestTrue(FString::Printf(TEXT("%s: has cells"), Label), Diagram.Cells.Num() > 1);
+		TestNotNull(FString::Printf(TEXT("%s: grid lookup kept"), Label), Diagram.GetGridLookup());
+		MatchesScan(*this, Label, Diagram, true);
+		TestNull(FString::Printf(TEXT("%s: no BVH needed"), Label), Diagram.GetCellBVH());
+
+		const FLayoutDiagram2D Copy = Diagram;
+		TestTrue(FString::Printf(TEXT("%s: copies share the lookup"), Label), Copy.GetGridLookup() == Diagram.GetGridLookup());
+	}
+	return true;
+}
+
+// ============================================================
+// Test 2: Polygon diagrams (cave regions) get a BVH on their first lookup, and lookups
+// through it agree with a scan of every polygon.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCellLocatorPolygonTest, "ProceduralGeometry.CellLocator.Polygons", DefaultTestFlags)
+
+bool FLayoutCellLocatorPolygonTest::RunTest(const FString& Parameters)
+{
+	const FLayoutDiagram2D Diagram = MakeLocatorCave();
+	TestTrue("Polygons: has cells", Diagram.Cells.Num() > 0);
+	TestNull("Polygons: no grid lookup", Diagram.GetGridLookup());
+	TestNull("Polygons: BVH left to the first lookup", Diagram.GetCellBVH());
+	MatchesScan(*this, TEXT("Polygons"), Diagram, false);
+	TestNotNull("Polygons: BVH built by a lookup", Diagram.GetCellBVH());
+
+	// A diagram that lost its BVH (e.g. rebuilt from compact form) builds it again on its first lookup.
+	FLayoutDiagram2D Stripped = Diagram;
+	Stripped.ResetCellBVH();
+	TestEqual("Polygons: rebuilt lazily", Stripped.FindCellAt(Diagram.Cells[0].Center), Diagram.FindCellAt(Diagram.Cells[0].Center));
+	TestTrue("Polygons: rebuilt BVH is its own", Stripped.GetCellBVH() && Stripped.GetCellBVH() != Diagram.GetCellBVH());
+	return true;
+}
+
+// ============================================================
+// Test 3: BVH over plain boxes — every box is found, empty boxes are left out, and points
+// in gaps or outside all boxes miss.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCellLocatorBVHTest, "ProceduralGeometry.CellLocator.BVH", DefaultTestFlags)
+
+bool FLayoutCellLocatorBVHTest::RunTest(const FString& Parameters)
+{
+	TArray<FBox2D> Boxes;
+	for (int32 Y = 0; Y < 10; ++Y)
+	{
+		for (int32 X = 0; X < 13; ++X)
+		{
+			Boxes.Add(FBox2D(FVector2D(X * 10, Y * 10), FVector2D(X * 10 + 8, Y * 10 + 8)));
+		}
+	}
+	Boxes.Add(FBox2D(ForceInit)); // empty cells are skipped
+
+	FLayoutCellBVH BVH;
+	BVH.Build(Boxes);
+	TestEqual("BVH: every valid box indexed", BVH.CellOrder.Num(), Boxes.Num() - 1);
+
+	auto InBox = [&Boxes](const FVector2D& Point) {
+		return [&Boxes, Point](int32 Cell) { return Boxes[Cell].IsInside(Point); };
+	};
+	for (int32 Cell = 0; Cell < Boxes.Num() - 1; ++Cell)
+	{
+		const FVector2D Center = Boxes[Cell].GetCenter();
+		if (!TestEqual(FString::Printf(TEXT("BVH: box %d"), Cell), BVH.FindFirst(Center, InBox(Center)), Cell))
+		{
+			return false;
+		}
+	}
+	TestEqual("BVH: gap between boxes", BVH.FindFirst(FVector2D(9, 9), InBox(FVector2D(9, 9))), static_cast<int32>(INDEX_NONE));
+	TestEqual("BVH: outside", BVH.FindFirst(FVector2D(-50, 40), InBox(FVector2D(-50, 40))), static_cast<int32>(INDEX_NONE));
+
+	BVH.Build(TArray<FBox2D>());
+	TestFalse("BVH: empty build", BVH.IsValid());
+	TestEqual("BVH: empty query", BVH.FindFirst(FVector2D::ZeroVector, InBox(FVector2D::ZeroVector)), static_cast<int32>(INDEX_NONE));
+	return true;
+}
+
+// ============================================================
+// Test 4: Benchmark — point lookups per second through the grid lookup, the BVH, and a
+// plain scan of the same diagram.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutCellLocatorBenchmarkTest, "ProceduralGeometry.CellLocator.Benchmark", PerfTestFlags)
+
+bool FLayoutCellLocatorBenchmarkTest::RunTest(const FString& Parameters)
+{
+	auto Measure = [](const TCHAR* Label, int32 NumCells, const TArray<FVector2D>& Points, TFunctionRef<int32(const FVector2D&)> FindCell) {
+		int32		 Hits = 0;
+		const double Start = FPlatformTime::Seconds();
+		for (const FVector2D& Point : Points)
+		{
+			Hits += FindCell(Point) != INDEX_NONE;
+		}
+		const double Seconds = FMath::Max(FPlatformTime::Seconds() - Start, 1e-9);
+		UE_LOG(LogRoguelikeGeometry,
+			Log,
+			TEXT("[CellLocator] %s: %d cells, %.2f M lookups/s (%d hits)"),
+			Label,
+			NumCells,
+			Points.Num() / Seconds / 1e6,
+			Hits);
+	};
+
+	const FLayoutDiagram2D Grid = MakeLocatorDungeon(false);
+	const FLayoutDiagram2D Cave = MakeLocatorCave();
+	for (const FLayoutDiagram2D* Diagram : { &Grid, &Cave })
+	{
+		const TArray<FVector2D> Points = MakeQueryPoints(*Diagram, 20000);
+		FLayoutDiagram2D		BVH = *Diagram;
+		BVH.ResetGridLookup();
+		BVH.BuildCellBVH();
+
+		const TCHAR* Kind = Diagram == &Grid ? TEXT("dungeon grid") : TEXT("cave polygons");
+		const int32	 NumCells = Diagram->Cells.Num();
+		if (Diagram->GetGridLookup())
+		{
+			auto ThroughLookup = [Diagram](const FVector2D& P) { return Diagram->FindCellAt(P); };
+			Measure(*FString::Printf(TEXT("%s, grid lookup"), Kind), NumCells, Points, ThroughLookup);
+		}
+		Measure(*FString::Printf(TEXT("%s, BVH"), Kind), NumCells, Points, [&BVH](const FVector2D& P) { return BVH.FindCellAt(P); });
+		Measure(*FString::Printf(TEXT("%s, scan"), Kind), NumCells, Points, [Diagram](const FVector2D& P) { return ScanForCell(*Diagram, P); });
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
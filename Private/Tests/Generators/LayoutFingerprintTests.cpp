@@ -0,0 +1,154 @@
+#include "Generators/LayoutFingerprint.h"
+#include "Generators/LayoutBinaryFormat.h"
+#include "ProceduralGeometry.h"
+#include "../ProceduralGeometryTestFixtures.h"
+#include "../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	UCellularAutomataGenerator2D* MakeFingerprintCA(const FString& Seed)
+	{
+		UCellularAutomataGenerator2D* Gen = NewObject<UCellularAutomataGenerator2D>();
+		Gen->SetBounds(FBox2D(FVector2D(-1000, -1000), FVector2D(1000, 1000)));
+		Gen->SetSeed(Seed);
+		return Gen;
+	}
+
+	UVoronoiGenerator2D* MakeFingerprintVoronoi(const FString& Seed)
+	{
+		UVoronoiGenerator2D* Gen = NewObject<UVoronoiGenerator2D>();
+		Gen->SetBounds(FBox2D(FVector2D(-1000, -1000), FVector2D(1000, 1000)));
+		Gen->SetSeed(Seed);
+		return Gen;
+	}
+} // namespace
+
+// ============================================================
+// Test 1: Stream rules — capacity and acceleration data do not matter, floats are quantised,
+// length prefixes keep nested arrays apart, and compact diagrams hash like full ones.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutFingerprintStreamTest, "ProceduralGeometry.Fingerprint.Stream", DefaultTestFlags)
+
+bool FLayoutFingerprintStreamTest::RunTest(const FString& Parameters)
+{
+	UDrunkardWalkGenerator2D* Gen = MakeTestDrunkardWalk(TEXT("FingerprintStream"), 6, 4, 5)->SetBranchProbability(0.3f)->SetCorridorWidthRange(1, 2);
+	const FLayoutDiagram2D	  Diagram = Gen->Generate();
+	const uint64			  Fingerprint = FLayoutFingerprint::Of(Diagram);
+	TestTrue("Stream: has cells", Diagram.Cells.Num() > 1);
+
+	FLayoutDiagram2D Roomy = Diagram;
+	Roomy.Cells.Reserve(Roomy.Cells.Num() * 2);
+	for (FLayoutCell2D& Cell : Roomy.Cells)
+	{
+		Cell.Vertices.Reserve(32);
+		Cell.Neighbors.Reserve(32);
+	}
+	Roomy.ResetGridLookup();
+	Roomy.BuildCellBVH();
+	TestEqual("Stream: capacity and acceleration data ignored", FLayoutFingerprint::Of(Roomy), Fingerprint);
+
+	Gen->SetSeed(TEXT("FingerprintStream"));
+	const FLayoutDiagramCompact Compact = Gen->GenerateCompact();
+	TestEqual("Stream: compact matches full", FLayoutFingerprint::Of(Compact), Fingerprint);
+
+	FLayoutDiagram2D Nudged = Diagram;
+	Nudged.Cells[0].Vertices[0].X += FLayoutFingerprint::DefaultQuantum * 0.01;
+	TestEqual("Stream: sub-quantum noise ignored", FLayoutFingerprint::Of(Nudged), Fingerprint);
+	Nudged.Cells[0].Vertices[0].X += FLayoutFingerprint::DefaultQuantum * 2.0;
+	TestNotEqual("Stream: moves above the quantum seen", FLayoutFingerprint::Of(Nudged), Fingerprint);
+	TestEqual("Stream: coarse quantum absorbs the move", FLayoutFingerprint::Of(Nudged, 1.0), FLayoutFingerprint::Of(Diagram, 1.0));
+
+	FLayoutDiagram2D Edited = Diagram;
+	Edited.Cells[0].bIsExterior = !Edited.Cells[0].bIsExterior;
+	TestNotEqual("Stream: flags seen", FLayoutFingerprint::Of(Edited), Fingerprint);
+	Edited = Diagram;
+	Edited.Seed += TEXT("x");
+	TestNotEqual("Stream: seed seen", FLayoutFingerprint::Of(Edited), Fingerprint);
+
+	const TArray<TArray<int32>> SplitA = { { 1 }, { 2, 3 } };
+	const TArray<TArray<int32>> SplitB = { { 1, 2 }, { 3 } };
+	TestNotEqual("Stream: nested arrays length-prefixed", FLayoutFingerprint::Of(SplitA), FLayoutFingerprint::Of(SplitB));
+
+	TestEqual("Stream: -0 == +0", FLayoutFingerprint::Of(-0.0), FLayoutFingerprint::Of(0.0));
+	TestNotEqual("Stream: NaN has its own code", FLayoutFingerprint::Of(NAN), FLayoutFingerprint::Of(0.0));
+	TestNotEqual("Stream: +inf != -inf", FLayoutFingerprint::Of(INFINITY), FLayoutFingerprint::Of(-INFINITY));
+	TestEqual("Stream: float and double agree", FLayoutFingerprint::Of(1.5f), FLayoutFingerprint::Of(1.5));
+	return true;
+}
+
+// ============================================================
+// Test 2: Determinism — repeated runs, the allocation-reusing overloads, and a binary round
+// trip all produce the same fingerprint; different seeds do not.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutFingerprintDeterminismTest, "ProceduralGeometry.Fingerprint.Determinism", DefaultTestFlags)
+
+bool FLayoutFingerprintDeterminismTest::RunTest(const FString& Parameters)
+{
+	const uint64 CA = FLayoutFingerprint::Of(MakeFingerprintCA(TEXT("Determinism"))->GenerateWithGridData());
+	TestEqual("CA: repeat", FLayoutFingerprint::Of(MakeFingerprintCA(TEXT("Determinism"))->GenerateWithGridData()), CA);
+	TestNotEqual("CA: other seed", FLayoutFingerprint::Of(MakeFingerprintCA(TEXT("Determinism2"))->GenerateWithGridData()), CA);
+
+	FCellularAutomataGridData CAReused;
+	FCellularAutomataScratch  CAScratch;
+	MakeFingerprintCA(TEXT("Other"))->GenerateWithGridData(CAReused, CAScratch);
+	MakeFingerprintCA(TEXT("Determinism"))->GenerateWithGridData(CAReused, CAScratch);
+	TestEqual("CA: reused output and scratch", FLayoutFingerprint::Of(CAReused), CA);
+
+	UDrunkardWalkGenerator2D* DWGen = MakeTestDrunkardWalk(TEXT("Determinism"), 6, 4, 5)->SetBranchProbability(0.3f)->SetCorridorWidthRange(1, 2);
+	const uint64			  DW = FLayoutFingerprint::Of(DWGen->GenerateWithGridData());
+	TestEqual("DW: repeat", FLayoutFingerprint::Of(DWGen->SetSeed(TEXT("Determinism"))->GenerateWithGridData()), DW);
+	TestNotEqual("DW: other seed", FLayoutFingerprint::Of(DWGen->SetSeed(TEXT("Determinism2"))->GenerateWithGridData()), DW);
+
+	const FLayoutDiagram2D DWDiagram = DWGen->SetSeed(TEXT("Determinism"))->Generate();
+	FLayoutDiagram2D	   DWReused;
+	FDrunkardWalkScratch   DWScratch;
+	DWGen->SetSeed(TEXT("Other"))->Generate(DWReused, DWScratch);
+	DWGen->SetSeed(TEXT("Determinism"))->Generate(DWReused, DWScratch);
+	TestEqual("DW: reused output and scratch", FLayoutFingerprint::Of(DWReused), FLayoutFingerprint::Of(DWDiagram));
+
+	const TUniquePtr<FLayoutBinaryReader> Reader = FLayoutBinaryReader::OpenBytes(FLayoutBinaryFormat::Write(DWDiagram));
+	FLayoutDiagram2D					  RoundTrip;
+	TestTrue("DW: binary read", Reader.IsValid() && FLayoutBinaryFormat::Read(*Reader, RoundTrip));
+	TestEqual("DW: binary round trip", FLayoutFingerprint::Of(RoundTrip), FLayoutFingerprint::Of(DWDiagram));
+
+	const uint64 Voronoi = FLayoutFingerprint::Of(MakeFingerprintVoronoi(TEXT("Determinism"))->GenerateRelaxed(64));
+	TestEqual("Voronoi: repeat", FLayoutFingerprint::Of(MakeFingerprintVoronoi(TEXT("Determinism"))->GenerateRelaxed(64)), Voronoi);
+	TestNotEqual("Voronoi: other seed", FLayoutFingerprint::Of(MakeFingerprintVoronoi(TEXT("Determinism2"))->GenerateRelaxed(64)), Voronoi);
+	return true;
+}
+
+// ============================================================
+// Test 3: Benchmark — fingerprint throughput over a large cave's grid data.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutFingerprintBenchmarkTest, "ProceduralGeometry.Fingerprint.Benchmark", PerfTestFlags)
+
+bool FLayoutFingerprintBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UCellularAutomataGenerator2D* Gen = MakeFingerprintCA(TEXT("FingerprintBenchmark"));
+	Gen->SetBounds(FBox2D(FVector2D(-10000, -10000), FVector2D(10000, 10000)));
+	const FCellularAutomataGridData Data = Gen->GenerateWithGridData();
+
+	constexpr int32 Runs = 10;
+	uint64			Fingerprint = 0;
+	const double	Start = FPlatformTime::Seconds();
+	for (int32 Run = 0; Run < Runs; ++Run)
+	{
+		Fingerprint = FLayoutFingerprint::Of(Data);
+	}
+	const double Ms = (FPlatformTime::Seconds() - Start) * 1000.0 / Runs;
+
+	UE_LOG(LogRoguelikeGeometry,
+		Log,
+		TEXT("[Fingerprint] %dx%d grid, %d diagram cells: %.3f ms per fingerprint (%s, binary size %.2f MB)"),
+		Data.GridWidth,
+		Data.GridHeight,
+		Data.Diagram.Cells.Num(),
+		Ms,
+		*FLayoutFingerprint::ToString(Fingerprint),
+		FLayoutBinaryFormat::Write(Data).Num() / (1024.0 * 1024.0));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,312 @@
+#include "Generators/LayoutGridCodec.h"
+#include "Generators/LayoutBinaryFormat.h"
+#include "ProceduralGeometry.h"
+#include "../ProceduralGeometryTestFixtures.h"
+#include "../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** A typical cave: 200 x 200 cells of natural caves. */
+	FCellularAutomataGridData MakeCodecCave(const FString& Seed)
+	{
+		UCellularAutomataGenerator2D* Gen = NewObject<UCellularAutomataGenerator2D>();
+		Gen->SetBounds(FBox2D(FVector2D(-1000, -1000), FVector2D(1000, 1000)))->SetGridSize(10)->SetSeed(Seed);
+		return Gen->GenerateWithGridData();
+	}
+
+	/** A typical dungeon: a dozen 6x6 rooms with turning, branching corridors. */
+	FDrunkardWalkGridData MakeCodecDungeon(const FString& Seed)
+	{
+		return MakeTestDrunkardWalk(Seed, 12, 6, 6)->SetCorridorTurnProbability(0.2f)->SetBranchProbability(0.3f)->GenerateWithGridData();
+	}
+
+	/** In-memory bytes of the per-cell data and region lists, the payload a save or replication would otherwise ship. */
+	int64 GridPayloadBytes(const TArray<bool>& Grid, const TArray<uint8>& CellType, const TArray<int32>& RegionIds, const TArray<TArray<FIntPoint>>& Regions)
+	{
+		int64 Bytes = Grid.Num() * sizeof(bool) + CellType.Num() * sizeof(uint8) + RegionIds.Num() * sizeof(int32);
+		for (const TArray<FIntPoint>& Region : Regions)
+		{
+			Bytes += Region.Num() * sizeof(FIntPoint);
+		}
+		return Bytes;
+	}
+
+	/** Bytes with one section's element count replaced and the table CRC refreshed, so only the count is wrong. */
+	TArray<uint8> WithSectionCount(const TArray<uint8>& Bytes, uint32 Tag, uint32 Count)
+	{
+		TArray<uint8>			 Patched = Bytes;
+		PGLayoutBinary::FHeader& Header = *reinterpret_cast<PGLayoutBinary::FHeader*>(Patched.GetData());
+		PGLayoutBinary::FSection* Table = reinterpret_cast<PGLayoutBinary::FSection*>(Patched.GetData() + sizeof(PGLayoutBinary::FHeader));
+		for (uint32 i = 0; i < Header.NumSections; ++i)
+		{
+			if (Table[i].Tag == Tag)
+			{
+				Table[i].Count = Count;
+			}
+		}
+		Header.TableCrc = FCrc::MemCrc32(Table, Header.NumSections * sizeof(PGLayoutBinary::FSection));
+		return Patched;
+	}
+
+	template <typename ElementType>
+	bool RoundTripsGrid(const TArray<ElementType>& Cells, int32 Width)
+	{
+		TArray<uint8> Bytes;
+		FLayoutGridCodec::EncodeGrid(Cells, Width, Bytes);
+		TArray<ElementType> Decoded;
+		return FLayoutGridCodec::DecodeGrid(Bytes, Cells.Num(), Decoded) && Decoded == Cells;
+	}
+} // namespace
+
+// ============================================================
+// Test 1: Grids and point lists round-trip exactly, including edge shapes and extreme values.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutGridCodecRoundTripTest, "ProceduralGeometry.LayoutGridCodec.RoundTrip", DefaultTestFlags)
+
+bool FLayoutGridCodecRoundTripTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Stream(1234);
+
+	TestTrue("Codec: empty grid", RoundTripsGrid(TArray<bool>(), 0));
+	TestTrue("Codec: single cell", RoundTripsGrid(TArray<uint8>({ 3 }), 1));
+	TestTrue("Codec: one column", RoundTripsGrid(TArray<int32>({ 1, 1, -1, 7, 7, 7 }), 1));
+	TestTrue("Codec: partial last row", RoundTripsGrid(TArray<uint8>({ 0, 1, 2, 3, 0, 1, 2 }), 3));
+	TestTrue("Codec: extreme int32", RoundTripsGrid(TArray<int32>({ MIN_int32, MAX_int32, 0, MIN_int32, -1, MAX_int32 }), 2));
+
+	for (const int32 Width : { 1, 7, 64, 257 })
+	{
+		TArray<bool>  Noise;
+		TArray<uint8> Types;
+		TArray<int32> Ids;
+		for (int32 i = 0; i < Width * 31; ++i)
+		{
+			Noise.Add(Stream.FRand() < 0.45f);
+			Types.Add(static_cast<uint8>(Stream.RandRange(0, 3)));
+			Ids.Add(Stream.FRand() < 0.5f ? INDEX_NONE : Stream.RandRange(0, 40));
+		}
+		TestTrue(FString::Printf(TEXT("Codec: noisy bools, width %d"), Width), RoundTripsGrid(Noise, Width));
+		TestTrue(FString::Printf(TEXT("Codec: noisy types, width %d"), Width), RoundTripsGrid(Types, Width));
+		TestTrue(FString::Printf(TEXT("Codec: noisy ids, width %d"), Width), RoundTripsGrid(Ids, Width));
+	}
+
+	const FCellularAutomataGridData Cave = MakeCodecCave(TEXT("CodecCave"));
+	TestTrue("Codec: cave grid", RoundTripsGrid(Cave.Grid, Cave.GridWidth));
+	TestTrue("Codec: cave region ids", RoundTripsGrid(Cave.RegionIds, Cave.GridWidth));
+
+	TArray<FIntPoint> Points = { FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(-5, 3), FIntPoint(MAX_int32, MIN_int32), FIntPoint(MIN_int32, 7) };
+	for (const TArray<FIntPoint>& Region : Cave.Regions)
+	{
+		Points.Append(Region);
+	}
+	TArray<uint8> PointBytes;
+	FLayoutGridCodec::EncodePoints(Points, PointBytes);
+	TArray<FIntPoint> DecodedPoints;
+	TestTrue("Codec: points decode", FLayoutGridCodec::DecodePoints(PointBytes, Points.Num(), DecodedPoints));
+	TestTrue("Codec: points round-trip", DecodedPoints == Points);
+	return true;
+}
+
+// ============================================================
+// Test 2: Malformed payloads are rejected rather than read or written out of bounds.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutGridCodecMalformedTest, "ProceduralGeometry.LayoutGridCodec.Malformed", DefaultTestFlags)
+
+bool FLayoutGridCodecMalformedTest::RunTest(const FString& Parameters)
+{
+	const TArray<uint8> Types = { 0, 0, 1, 1, 0, 0, 1, 2, 2, 2, 3, 3 };
+	TArray<uint8>		Bytes;
+	FLayoutGridCodec::EncodeGrid(Types, 4, Bytes);
+
+	TArray<uint8> Decoded;
+	TestTrue("Codec: pristine decodes", FLayoutGridCodec::DecodeGrid(Bytes, Types.Num(), Decoded));
+	TestFalse("Codec: truncated", FLayoutGridCodec::DecodeGrid(MakeArrayView(Bytes.GetData(), Bytes.Num() - 1), Types.Num(), Decoded));
+
+	TArray<uint8> Trailing = Bytes;
+	Trailing.Add(0);
+	TestFalse("Codec: trailing bytes", FLayoutGridCodec::DecodeGrid(Trailing, Types.Num(), Decoded));
+	TestFalse("Codec: more cells than encoded", FLayoutGridCodec::DecodeGrid(Bytes, Types.Num() + 4, Decoded));
+
+	// Width 4, then a literal run of 5 cells: longer than the row.
+	TestFalse("Codec: run past row end", FLayoutGridCodec::DecodeGrid(TArray<uint8>({ 4, 4 << 1, 0 }), 4, Decoded));
+	// Width 4, then a copy run in the first row.
+	TestFalse("Codec: copy in first row", FLayoutGridCodec::DecodeGrid(TArray<uint8>({ 4, (3 << 1) | 1 }), 4, Decoded));
+	// Width 2, one literal run of value 2 into a bool grid.
+	TArray<bool> Bools;
+	TestFalse("Codec: out-of-range bool", FLayoutGridCodec::DecodeGrid(TArray<uint8>({ 2, 1 << 1, 4 }), 2, Bools));
+	TestFalse("Codec: zero width", FLayoutGridCodec::DecodeGrid(TArray<uint8>({ 0 }), 4, Decoded));
+	TestFalse("Codec: unterminated varint", FLayoutGridCodec::DecodeGrid(TArray<uint8>({ 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 }), 4, Decoded));
+
+	TArray<FIntPoint> Points;
+	TestFalse("Codec: truncated points", FLayoutGridCodec::DecodePoints(TArray<uint8>({ 2 }), 1, Points));
+	return true;
+}
+
+// ============================================================
+// Test 3: Compressed containers round-trip CA and DW grid data and are smaller than plain ones.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutGridCodecContainerTest, "ProceduralGeometry.LayoutGridCodec.CompressedContainer", DefaultTestFlags)
+
+bool FLayoutGridCodecContainerTest::RunTest(const FString& Parameters)
+{
+	const FDrunkardWalkGridData Dungeon = MakeCodecDungeon(TEXT("CodecDungeon"));
+	const TArray<uint8>			DungeonBytes = FLayoutBinaryFormat::WriteCompressed(Dungeon);
+	TestTrue("Codec: dungeon compresses", DungeonBytes.Num() < FLayoutBinaryFormat::Write(Dungeon).Num());
+
+	const TUniquePtr<FLayoutBinaryReader> DungeonReader = FLayoutBinaryReader::OpenBytes(DungeonBytes);
+	FDrunkardWalkGridData				  LoadedDungeon;
+	if (!TestTrue("Codec: dungeon opens", DungeonReader.IsValid())
+		|| !TestTrue("Codec: dungeon reads", FLayoutBinaryFormat::Read(*DungeonReader, LoadedDungeon)))
+	{
+		return false;
+	}
+	TestTrue("Codec: dungeon Grid", LoadedDungeon.Grid == Dungeon.Grid);
+	TestTrue("Codec: dungeon CellType", LoadedDungeon.CellType == Dungeon.CellType);
+	TestTrue("Codec: dungeon RegionIds", LoadedDungeon.RegionIds == Dungeon.RegionIds);
+	TestTrue("Codec: dungeon Regions", LoadedDungeon.Regions == Dungeon.Regions);
+	TestTrue("Codec: dungeon WalkerPaths", LoadedDungeon.WalkerPaths == Dungeon.WalkerPaths);
+	TestEqual("Codec: dungeon diagram", LoadedDungeon.Diagram.Cells.Num(), Dungeon.Diagram.Cells.Num());
+
+	const FCellularAutomataGridData Cave = MakeCodecCave(TEXT("CodecCave"));
+	const TArray<uint8>				CaveBytes = FLayoutBinaryFormat::WriteCompressed(Cave);
+	TestTrue("Codec: cave compresses", CaveBytes.Num() < FLayoutBinaryFormat::Write(Cave).Num());
+
+	const TUniquePtr<FLayoutBinaryReader> CaveReader = FLayoutBinaryReader::OpenBytes(CaveBytes);
+	FCellularAutomataGridData			  LoadedCave;
+	if (!TestTrue("Codec: cave opens", CaveReader.IsValid()) || !TestTrue("Codec: cave reads", FLayoutBinaryFormat::Read(*CaveReader, LoadedCave)))
+	{
+		return false;
+	}
+	TestTrue("Codec: cave Grid", LoadedCave.Grid == Cave.Grid);
+	TestTrue("Codec: cave RegionIds", LoadedCave.RegionIds == Cave.RegionIds);
+	TestTrue("Codec: cave Regions", LoadedCave.Regions == Cave.Regions);
+	TestTrue("Codec: cave SurvivingRegions", LoadedCave.SurvivingRegions == Cave.SurvivingRegions);
+	TestEqual("Codec: cave diagram", LoadedCave.Diagram.Cells.Num(), Cave.Diagram.Cells.Num());
+	return true;
+}
+
+// ============================================================
+// Test 4: Benchmark — bytes per cell and encode/decode throughput on typical caves and dungeons.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutGridCodecBenchmarkTest, "ProceduralGeometry.LayoutGridCodec.Benchmark", PerfTestFlags)
+
+bool FLayoutGridCodecBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Iterations = 20;
+
+	auto Measure = [this](const TCHAR* Label, const auto& Layout, int64 Cells, int64 PayloadBytes) {
+		const int32 PlainBytes = FLayoutBinaryFormat::Write(Layout).Num();
+
+		TArray<uint8> Compressed;
+		const double  EncodeStart = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			Compressed = FLayoutBinaryFormat::WriteCompressed(Layout);
+		}
+		const double EncodeSeconds = (FPlatformTime::Seconds() - EncodeStart) / Iterations;
+
+		typename TDecay<decltype(Layout)>::Type Decoded;
+		const double							DecodeStart = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			const TUniquePtr<FLayoutBinaryReader> Reader = FLayoutBinaryReader::OpenBytes(Compressed);
+			TestTrue(FString::Printf(TEXT("Benchmark: %s decodes"), Label), Reader.IsValid() && FLayoutBinaryFormat::Read(*Reader, Decoded));
+		}
+		const double DecodeSeconds = (FPlatformTime::Seconds() - DecodeStart) / Iterations;
+
+		const double PayloadMB = static_cast<double>(PayloadBytes) / (1024.0 * 1024.0);
+		UE_LOG(LogRoguelikeGeometry,
+			Log,
+			TEXT("[Codec] %s: %lld cells, in-memory %.2f B/cell, plain file %.2f B/cell, compressed %.3f B/cell (%d bytes); ")
+				TEXT("encode %.1f MB/s, decode %.1f MB/s (of in-memory payload, whole container incl. diagram)"),
+			Label,
+			Cells,
+			static_cast<double>(PayloadBytes) / Cells,
+			static_cast<double>(PlainBytes) / Cells,
+			static_cast<double>(Compressed.Num()) / Cells,
+			Compressed.Num(),
+			PayloadMB / FMath::Max(EncodeSeconds, 1e-9),
+			PayloadMB / FMath::Max(DecodeSeconds, 1e-9));
+		TestTrue(FString::Printf(TEXT("Benchmark: %s compressed is smaller than plain"), Label), Compressed.Num() < PlainBytes);
+	};
+
+	for (const TCHAR* Seed : { TEXT("BenchCave1"), TEXT("BenchCave2") })
+	{
+		const FCellularAutomataGridData Cave = MakeCodecCave(Seed);
+		Measure(Seed, Cave, Cave.Grid.Num(), GridPayloadBytes(Cave.Grid, TArray<uint8>(), Cave.RegionIds, Cave.Regions));
+	}
+	for (const TCHAR* Seed : { TEXT("BenchDungeon1"), TEXT("BenchDungeon2") })
+	{
+		const FDrunkardWalkGridData Dungeon = MakeCodecDungeon(Seed);
+		Measure(Seed, Dungeon, Dungeon.Grid.Num(), GridPayloadBytes(Dungeon.Grid, Dungeon.CellType, Dungeon.RegionIds, Dungeon.Regions));
+	}
+	return true;
+}
+
+
+// ============================================================
+// Test 5: Counts in a section header are checked against the bytes and the grid meta before anything is allocated.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutGridCodecMalformedHeaderTest, "ProceduralGeometry.LayoutGridCodec.MalformedHeader", DefaultTestFlags)
+
+bool FLayoutGridCodecMalformedHeaderTest::RunTest(const FString& Parameters)
+{
+	// A width and a single token cannot hold two billion cells, nor two bytes two billion points.
+	TArray<uint8>	  Decoded;
+	TArray<FIntPoint> Points;
+	TestFalse("Header: grid count beyond the bytes", FLayoutGridCodec::DecodeGrid(TArray<uint8>({ 4, 0, 0 }), MAX_int32, Decoded));
+	TestFalse("Header: point count beyond the bytes", FLayoutGridCodec::DecodePoints(TArray<uint8>({ 0, 0 }), MAX_int32, Points));
+	TestEqual("Header: nothing allocated for the grid", Decoded.Max(), 0);
+	TestEqual("Header: nothing allocated for the points", Points.Max(), 0);
+
+	const FDrunkardWalkGridData			  Dungeon = MakeCodecDungeon(TEXT("CodecHeader"));
+	const TArray<uint8>					  Bytes = FLayoutBinaryFormat::WriteCompressed(Dungeon);
+	const TUniquePtr<FLayoutBinaryReader> Pristine = FLayoutBinaryReader::OpenBytes(Bytes);
+	if (!TestTrue("Header: pristine container opens", Pristine.IsValid()))
+	{
+		return false;
+	}
+	const uint32 NumCells = static_cast<uint32>(Dungeon.Grid.Num());
+	uint32		 NumPoints = 0;
+	for (const TArray<FIntPoint>& Region : Dungeon.Regions)
+	{
+		NumPoints += Region.Num();
+	}
+
+	struct FCase
+	{
+		const TCHAR* Label;
+		uint32		 Tag;
+		uint32		 Count;
+	};
+	const FCase Cases[] = {
+		{ TEXT("grid larger than the meta"), PGLayoutBinary::MakeTag("GRID"), NumCells + 1 },
+		{ TEXT("grid smaller than the meta"), PGLayoutBinary::MakeTag("GRID"), NumCells - 1 },
+		{ TEXT("huge grid"), PGLayoutBinary::MakeTag("GRID"), static_cast<uint32>(MAX_int32) },
+		{ TEXT("negative grid"), PGLayoutBinary::MakeTag("GRID"), MAX_uint32 },
+		{ TEXT("huge region ids"), PGLayoutBinary::MakeTag("RGID"), static_cast<uint32>(MAX_int32) },
+		{ TEXT("huge cell types"), PGLayoutBinary::MakeTag("CTYP"), static_cast<uint32>(MAX_int32) },
+		{ TEXT("huge region cells"), PGLayoutBinary::MakeTag("RGPT"), static_cast<uint32>(MAX_int32) },
+		{ TEXT("region cells off by one"), PGLayoutBinary::MakeTag("RGPT"), NumPoints + 1 },
+	};
+	for (const FCase& Case : Cases)
+	{
+		const PGLayoutBinary::FSection* Section = Pristine->FindSection(Case.Tag);
+		if (!TestTrue(FString::Printf(TEXT("Header: %s section is coded"), Case.Label),
+				Section && Section->Encoding != static_cast<uint16>(PGLayoutBinary::EEncoding::Raw)))
+		{
+			continue;
+		}
+
+		// Coded sections have data-dependent sizes, so the container opens and the count is only caught on read.
+		const TArray<uint8>					  Patched = WithSectionCount(Bytes, Case.Tag, Case.Count);
+		const TUniquePtr<FLayoutBinaryReader> Reader = FLayoutBinaryReader::OpenBytes(Patched);
+		FDrunkardWalkGridData				  Loaded;
+		TestTrue(FString::Printf(TEXT("Header: %s opens"), Case.Label), Reader.IsValid());
+		TestFalse(FString::Printf(TEXT("Header: %s rejected"), Case.Label), Reader.IsValid() && FLayoutBinaryFormat::Read(*Reader, Loaded));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,207 @@
+#include "Generators/LayoutPathFields.h"
+#include "Generators/LayoutDiagramCompact.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
+#include "../ProceduralGeometryTestFixtures.h"
+#include "../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	void AddPathCell(FLayoutDiagram2D& Diagram, const FVector2D& Center, TArray<int32> Neighbors)
+	{
+		FLayoutCell2D& Cell = Diagram.Cells.AddDefaulted_GetRef();
+		Cell.Center = Center;
+		Cell.Neighbors = MoveTemp(Neighbors);
+		Cell.CellIndex = Diagram.Cells.Num() - 1;
+	}
+
+	float PathLength(const FLayoutDiagram2D& Diagram, const TArray<int32>& Path)
+	{
+		float Length = 0.f;
+		for (int32 i = 1; i < Path.Num(); ++i)
+		{
+			Length += static_cast<float>(FVector2D::Distance(Diagram.Cells[Path[i - 1]].Center, Diagram.Cells[Path[i]].Center));
+		}
+		return Length;
+	}
+} // namespace
+
+// ============================================================
+// Test 1: Hand-built graph — fewest hops and shortest distance take different routes,
+// and a disconnected cell is reported unreachable.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutPathFieldsRoutesTest, "ProceduralGeometry.PathFields.Routes", DefaultTestFlags)
+
+bool FLayoutPathFieldsRoutesTest::RunTest(const FString& Parameters)
+{
+	// 0 = source. Two hops through the detour 1, or three short hops through 2 and 3, to the target 4. 5 is isolated.
+	FLayoutDiagram2D Diagram;
+	AddPathCell(Diagram, FVector2D(0, 0), { 1, 2 });
+	AddPathCell(Diagram, FVector2D(0, 1000), { 0, 4 });
+	AddPathCell(Diagram, FVector2D(30, 0), { 0, 3 });
+	AddPathCell(Diagram, FVector2D(60, 0), { 2, 4 });
+	AddPathCell(Diagram, FVector2D(100, 0), { 1, 3 });
+	AddPathCell(Diagram, FVector2D(500, 500), {});
+	Diagram.CenterCellIndex = 0;
+
+	FLayoutPathFields Fields;
+	FLayoutPathFields::Build(Diagram, Fields, 16);
+	TestTrue("Routes: valid", Fields.IsValid());
+	TestTrue("Routes: next-hop table built", Fields.HasNextHopTable());
+	TestEqual("Routes: source", Fields.SourceCellIndex, 0);
+	TestEqual("Routes: target hops", Fields.HopDistance[4], 2);
+	TestEqual("Routes: target distance", Fields.Distance[4], 100.f, 0.01f);
+	TestEqual("Routes: target steps back through the short route", Fields.NextHopToSource[4], 3);
+	TestEqual("Routes: detour is farthest", Fields.FarthestCellIndex, 1);
+	TestEqual("Routes: isolated hops", Fields.HopDistance[5], static_cast<int32>(INDEX_NONE));
+	TestEqual("Routes: isolated distance", Fields.Distance[5], -1.f);
+	TestEqual("Routes: source has no next hop", Fields.NextHopToSource[0], static_cast<int32>(INDEX_NONE));
+
+	TArray<int32> Path;
+	TestTrue("Routes: path to source", Fields.GetPath(Diagram, 4, 0, Path));
+	TestTrue("Routes: path to source cells", Path == TArray<int32>({ 4, 3, 2, 0 }));
+	TestTrue("Routes: path between non-source cells", Fields.GetPath(Diagram, 1, 3, Path));
+	TestTrue("Routes: path between non-source cells takes the shorter side", Path == TArray<int32>({ 1, 4, 3 }));
+	TestFalse("Routes: isolated cell has no path", Fields.GetPath(Diagram, 5, 0, Path));
+	TestEqual("Routes: failed path is empty", Path.Num(), 0);
+
+	FLayoutPathFields Small;
+	FLayoutPathFields::Build(Diagram, Small, 4);
+	TestFalse("Routes: table skipped over the cell limit", Small.HasNextHopTable());
+	TestFalse("Routes: no path between non-source cells without a table", Small.GetPath(Diagram, 1, 3, Path));
+	return true;
+}
+
+// ============================================================
+// Test 2: On a generated dungeon, the fields match an independent BFS, satisfy the
+// shortest-path optimality conditions, and the next-hop table walks shortest paths.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutPathFieldsDungeonTest, "ProceduralGeometry.PathFields.Dungeon", DefaultTestFlags)
+
+bool FLayoutPathFieldsDungeonTest::RunTest(const FString& Parameters)
+{
+	UDrunkardWalkGenerator2D* Gen = MakeTestDrunkardWalk(TEXT("PathFields"), 6, 4, 5);
+	const FLayoutDiagram2D	  Diagram = Gen->SetBranchProbability(0.3f)->SetCorridorWidthRange(1, 2)->SetMergeFloorRectangles(true)->Generate();
+	const int32				  Num = Diagram.Cells.Num();
+	if (!TestTrue("Dungeon: has cells", Num > 1 && Diagram.CenterCellIndex != INDEX_NONE))
+	{
+		return false;
+	}
+
+	FLayoutPathFields Fields;
+	FLayoutPathFields::Build(Diagram, Fields, Num);
+	TestTrue("Dungeon: table built", Fields.HasNextHopTable());
+
+	TArray<int32> Hops;
+	Hops.Init(INDEX_NONE, Num);
+	Hops[Diagram.CenterCellIndex] = 0;
+	TArray<int32> Queue = { Diagram.CenterCellIndex };
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		for (const int32 Neighbor : Diagram.Cells[Queue[Head]].Neighbors)
+		{
+			if (Hops[Neighbor] == INDEX_NONE)
+			{
+				Hops[Neighbor] = Hops[Queue[Head]] + 1;
+				Queue.Add(Neighbor);
+			}
+		}
+	}
+	TestTrue("Dungeon: hops match BFS", Fields.HopDistance == Hops);
+
+	bool bTreeConsistent = true;
+	bool bOptimal = true;
+	for (int32 Cell = 0; Cell < Num; ++Cell)
+	{
+		const float Distance = Fields.Distance[Cell];
+		const int32 Next = Fields.NextHopToSource[Cell];
+		if (Cell != Diagram.CenterCellIndex && Distance >= 0.f)
+		{
+			bTreeConsistent &= Diagram.Cells[Cell].Neighbors.Contains(Next)
+				&& FMath::IsNearlyEqual(Distance, Fields.Distance[Next] + PathLength(Diagram, { Cell, Next }), 0.01f);
+		}
+		for (const int32 Neighbor : Diagram.Cells[Cell].Neighbors)
+		{
+			bOptimal &= Distance <= Fields.Distance[Neighbor] + PathLength(Diagram, { Cell, Neighbor }) + 0.01f;
+		}
+	}
+	TestTrue("Dungeon: every cell steps to a neighbor one edge closer", bTreeConsistent);
+	TestTrue("Dungeon: no edge shortens any distance", bOptimal);
+
+	// Table rows against fields built from that target.
+	TArray<int32> Path;
+	for (int32 Target = 0; Target < Num; Target += FMath::Max(1, Num / 8))
+	{
+		FLayoutPathFields FromTarget;
+		FLayoutPathFields::Build(Diagram, FromTarget, 0, Target);
+		for (int32 Cell = 0; Cell < Num; ++Cell)
+		{
+			const bool bFound = Fields.GetPath(Diagram, Cell, Target, Path);
+			if (!TestTrue(FString::Printf(TEXT("Dungeon: %d -> %d reachable"), Cell, Target), bFound == (FromTarget.Distance[Cell] >= 0.f)))
+			{
+				return false;
+			}
+			const float Expected = FromTarget.Distance[Cell];
+			if (bFound
+				&& !TestEqual(FString::Printf(TEXT("Dungeon: %d -> %d length"), Cell, Target), PathLength(Diagram, Path), Expected,
+					FMath::Max(0.05f, Expected * 1e-4f)))
+			{
+				return false;
+			}
+		}
+	}
+
+	FLayoutPathFields FromCompact;
+	FLayoutPathFields::Build(FLayoutDiagramCompact::FromDiagram(Diagram), FromCompact, Num);
+	TestTrue("Dungeon: compact hops", FromCompact.HopDistance == Fields.HopDistance);
+	TestTrue("Dungeon: compact distances", FromCompact.Distance == Fields.Distance);
+	TestTrue("Dungeon: compact next hops", FromCompact.NextHopToSource == Fields.NextHopToSource);
+	TestTrue("Dungeon: compact table", FromCompact.NextHopSlots == Fields.NextHopSlots);
+	return true;
+}
+
+// ============================================================
+// Test 3: The generator post-pass fills the fields on every diagram it returns when
+// enabled, and leaves them empty otherwise.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutPathFieldsGeneratorTest, "ProceduralGeometry.PathFields.Generator", DefaultTestFlags)
+
+bool FLayoutPathFieldsGeneratorTest::RunTest(const FString& Parameters)
+{
+	UDrunkardWalkGenerator2D* Gen = MakeTestDrunkardWalk(TEXT("PathFields"), 6, 4, 5);
+	Gen->SetBranchProbability(0.3f)->SetCorridorWidthRange(1, 2)->SetMergeFloorRectangles(true);
+	TestNull("Generator: off by default", Gen->Generate().GetPathFields());
+
+	Gen->SetPathFields(true, 100000);
+	Gen->SetSeed(TEXT("PathFields"));
+	const FLayoutDiagram2D Diagram = Gen->Generate();
+	const FLayoutPathFields* Fields = Diagram.GetPathFields();
+	if (!TestTrue("Generator: fields built", Fields && Fields->IsValid()))
+	{
+		return false;
+	}
+	TestTrue("Generator: table built", Fields->HasNextHopTable());
+	TestEqual("Generator: source is the center cell", Fields->SourceCellIndex, Diagram.CenterCellIndex);
+
+	const FLayoutDiagram2D Copy = Diagram;
+	TestTrue("Generator: copies share the fields", Copy.GetPathFields() == Fields);
+
+	Gen->SetSeed(TEXT("PathFields"));
+	const FDrunkardWalkGridData GridData = Gen->GenerateWithGridData();
+	TestTrue("Generator: grid data fields match", GridData.Diagram.GetPathFields() && GridData.Diagram.GetPathFields()->Distance == Fields->Distance);
+
+	FDrunkardWalkScratch Scratch;
+	FLayoutDiagram2D	 Reused;
+	Gen->SetSeed(TEXT("PathFields"));
+	Gen->Generate(Reused, Scratch);
+	TestTrue("Generator: reuse overload fields match", Reused.GetPathFields() && Reused.GetPathFields()->NextHopSlots == Fields->NextHopSlots);
+
+	Gen->SetPathFields(false);
+	Gen->SetSeed(TEXT("PathFields"));
+	Gen->Generate(Reused, Scratch);
+	TestNull("Generator: disabling drops reused fields", Reused.GetPathFields());
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,428 @@
+#include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
+#include "Generators/LayoutDiagramCompact.h"
+#include "Generators/LayoutFrameArena.h"
+#include "HAL/IConsoleManager.h"
+#include "ProceduralGeometry.h"
+#include "../ProceduralGeometryAllocationCounter.h"
+#include "../ProceduralGeometryTestFixtures.h"
+#include "../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Container choice for the corridor stage in Test 5: the global heap, as the generators used before the frame arena. */
+	struct FHeapTemporaries
+	{
+		template <typename ElementType>
+		using TArrayType = TArray<ElementType>;
+		template <typename ElementType>
+		using TSetType = TSet<ElementType>;
+		template <typename KeyType, typename ValueType>
+		using TMapType = TMap<KeyType, ValueType>;
+	};
+
+	/** The same containers on the thread's FMemStack; the caller holds the mark. */
+	struct FFrameTemporaries
+	{
+		template <typename ElementType>
+		using TArrayType = TFrameArray<ElementType>;
+		template <typename ElementType>
+		using TSetType = TFrameSet<ElementType>;
+		template <typename KeyType, typename ValueType>
+		using TMapType = TFrameMap<KeyType, ValueType>;
+	};
+
+	/**
+	 * The temporaries of CarveCorridors' pair selection (surviving ids, region-to-cell map, connected pairs, candidate
+	 * pairs) followed by a flood of every surviving region with a queue and a visited set, as the tile labelling does.
+	 * Returns a checksum of the visit order, so both container choices can be checked to do the same work.
+	 */
+	template <typename TTemporaries>
+	uint64 RunCorridorStage(const FCellularAutomataGridData& GridData)
+	{
+		typename TTemporaries::template TArrayType<int32> SurvivingIds;
+		for (int32 i = 0; i < GridData.SurvivingRegions.Num(); ++i)
+		{
+			if (GridData.SurvivingRegions[i])
+			{
+				SurvivingIds.Add(i);
+			}
+		}
+
+		typename TTemporaries::template TMapType<int32, int32> RegionToDiagramCell;
+		for (int32 CellIdx = 0; CellIdx < FMath::Min(GridData.Diagram.Cells.Num(), SurvivingIds.Num()); ++CellIdx)
+		{
+			RegionToDiagramCell.Add(SurvivingIds[CellIdx], CellIdx);
+		}
+
+		typename TTemporaries::template TSetType<TPair<int32, int32>> ConnectedPairs;
+		for (int32 CellIdx = 0; CellIdx < GridData.Diagram.Cells.Num(); ++CellIdx)
+		{
+			for (const int32 NeighborIdx : GridData.Diagram.Cells[CellIdx].Neighbors)
+			{
+				ConnectedPairs.Add(TPair<int32, int32>(FMath::Min(CellIdx, NeighborIdx), FMath::Max(CellIdx, NeighborIdx)));
+			}
+		}
+
+		uint64 Checksum = 0;
+		typename TTemporaries::template TArrayType<TPair<int32, int32>> Pairs;
+		for (int32 a = 0; a < SurvivingIds.Num(); ++a)
+		{
+			for (int32 b = a + 1; b < SurvivingIds.Num(); ++b)
+			{
+				const int32* CellA = RegionToDiagramCell.Find(SurvivingIds[a]);
+				const int32* CellB = RegionToDiagramCell.Find(SurvivingIds[b]);
+				if (CellA && CellB && !ConnectedPairs.Contains(TPair<int32, int32>(FMath::Min(*CellA, *CellB), FMath::Max(*CellA, *CellB))))
+				{
+					Pairs.Add(TPair<int32, int32>(SurvivingIds[a], SurvivingIds[b]));
+				}
+			}
+		}
+		Checksum += Pairs.Num();
+
+		const int32 Width = GridData.GridWidth;
+		const int32 Height = GridData.GridHeight;
+		for (const int32 RegionId : SurvivingIds)
+		{
+			const TArray<FIntPoint>& RegionCells = GridData.Regions[RegionId];
+			if (RegionCells.Num() == 0)
+			{
+				continue;
+			}
+
+			typename TTemporaries::template TSetType<FIntPoint>	  Visited;
+			typename TTemporaries::template TArrayType<FIntPoint> Queue;
+			Queue.Add(RegionCells[0]);
+			Visited.Add(RegionCells[0]);
+			for (int32 Head = 0; Head < Queue.Num(); ++Head)
+			{
+				const FIntPoint Cell = Queue[Head];
+				Checksum = Checksum * 31 + static_cast<uint64>(Cell.Y * Width + Cell.X);
+				for (const FIntPoint Step : { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) })
+				{
+					const FIntPoint Next = Cell + Step;
+					if (Next.X >= 0 && Next.X < Width && Next.Y >= 0 && Next.Y < Height && GridData.RegionIds[Next.Y * Width + Next.X] == RegionId
+						&& !Visited.Contains(Next))
+					{
+						Visited.Add(Next);
+						Queue.Add(Next);
+					}
+				}
+			}
+		}
+		return Checksum;
+	}
+} // namespace
+
+// ============================================================
+// Test 1: The DrunkardWalk reuse overloads produce exactly the by-value layouts, and
+// once warmed up, regenerating a same-sized layout keeps every output buffer in place.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutScratchReuseDWTest, "ProceduralGeometry.ScratchReuse.DrunkardWalk", DefaultTestFlags)
+
+bool FLayoutScratchReuseDWTest::RunTest(const FString& Parameters)
+{
+	UDrunkardWalkGenerator2D* Gen = MakeTestDrunkardWalk(TEXT("ReuseA"), 6, 4, 5)->SetBranchProbability(0.3f)->SetCorridorWidthRange(1, 2);
+	FDrunkardWalkScratch	  Scratch;
+	FDrunkardWalkGridData	  Reused;
+
+	// Different seeds in a row: leftovers from a larger or smaller previous layout must not leak into the next one.
+	for (const TCHAR* Seed : { TEXT("ReuseA"), TEXT("ReuseB"), TEXT("ReuseA") })
+	{
+		Gen->SetSeed(Seed);
+		const FDrunkardWalkGridData Expected = Gen->GenerateWithGridData();
+		Gen->SetSeed(Seed);
+		Gen->GenerateWithGridData(Reused, Scratch);
+
+		TestTrue(FString::Printf(TEXT("%s: grid"), Seed), Reused.Grid == Expected.Grid);
+		TestTrue(FString::Printf(TEXT("%s: cell types"), Seed), Reused.CellType == Expected.CellType);
+		TestTrue(FString::Printf(TEXT("%s: region ids"), Seed), Reused.RegionIds == Expected.RegionIds);
+		TestTrue(FString::Printf(TEXT("%s: regions"), Seed), Reused.Regions == Expected.Regions);
+		TestTrue(FString::Printf(TEXT("%s: walker paths"), Seed), Reused.WalkerPaths == Expected.WalkerPaths);
+		TestTrue(FString::Printf(TEXT("%s: corridor sources"), Seed), Reused.CorridorSourceRoom == Expected.CorridorSourceRoom);
+		TestTrue(FString::Printf(TEXT("%s: room centers"), Seed), Reused.RoomCenters == Expected.RoomCenters);
+		TestEqual(FString::Printf(TEXT("%s: center region"), Seed), Reused.CenterRegionId, Expected.CenterRegionId);
+		TestEqual(FString::Printf(TEXT("%s: grid width"), Seed), Reused.GridWidth, Expected.GridWidth);
+		TestTrue(FString::Printf(TEXT("%s: diagram"), Seed), LayoutsEqual(Reused.Diagram, Expected.Diagram));
+
+		FLayoutDiagram2D Diagram;
+		Gen->SetSeed(Seed);
+		Gen->Generate(Diagram, Scratch);
+		TestTrue(FString::Printf(TEXT("%s: diagram overload"), Seed), LayoutsEqual(Diagram, Expected.Diagram));
+	}
+
+	// Same seed again: every buffer already has the capacity it needs.
+	const bool*				 GridData = Reused.Grid.GetData();
+	const uint8*			 CellTypeData = Reused.CellType.GetData();
+	const int32*			 RegionIdData = Reused.RegionIds.GetData();
+	const TArray<FIntPoint>* RegionData = Reused.Regions.GetData();
+	const FLayoutCell2D*	 CellData = Reused.Diagram.Cells.GetData();
+	const FVector2D*		 VertexData = Reused.Diagram.Cells[0].Vertices.GetData();
+	const FIntPoint*		 PathData = Reused.WalkerPaths[0].GetData();
+	Gen->SetSeed(TEXT("ReuseA"));
+	Gen->GenerateWithGridData(Reused, Scratch);
+	TestTrue("Reuse: grid kept", Reused.Grid.GetData() == GridData);
+	TestTrue("Reuse: cell types kept", Reused.CellType.GetData() == CellTypeData);
+	TestTrue("Reuse: region ids kept", Reused.RegionIds.GetData() == RegionIdData);
+	TestTrue("Reuse: regions kept", Reused.Regions.GetData() == RegionData);
+	TestTrue("Reuse: diagram cells kept", Reused.Diagram.Cells.GetData() == CellData);
+	TestTrue("Reuse: cell vertices kept", Reused.Diagram.Cells[0].Vertices.GetData() == VertexData);
+	TestTrue("Reuse: walker paths kept", Reused.WalkerPaths[0].GetData() == PathData);
+	return true;
+}
+
+// ============================================================
+// Test 2: The CellularAutomata reuse overloads produce exactly the by-value layouts and
+// keep their output buffers across same-sized regenerations.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutScratchReuseCATest, "ProceduralGeometry.ScratchReuse.CellularAutomata", DefaultTestFlags)
+
+bool FLayoutScratchReuseCATest::RunTest(const FString& Parameters)
+{
+	UCellularAutomataGenerator2D* Gen = NewObject<UCellularAutomataGenerator2D>();
+	Gen->SetBounds(FBox2D(FVector2D(-500, -500), FVector2D(500, 500)));
+	FCellularAutomataScratch  Scratch;
+	FCellularAutomataGridData Reused;
+
+	for (const TCHAR* Seed : { TEXT("ReuseA"), TEXT("ReuseB"), TEXT("ReuseA") })
+	{
+		Gen->SetSeed(Seed);
+		const FCellularAutomataGridData Expected = Gen->GenerateWithGridData();
+		Gen->SetSeed(Seed);
+		Gen->GenerateWithGridData(Reused, Scratch);
+
+		TestTrue(FString::Printf(TEXT("%s: grid"), Seed), Reused.Grid == Expected.Grid);
+		TestTrue(FString::Printf(TEXT("%s: region ids"), Seed), Reused.RegionIds == Expected.RegionIds);
+		TestTrue(FString::Printf(TEXT("%s: regions"), Seed), Reused.Regions == Expected.Regions);
+		TestTrue(FString::Printf(TEXT("%s: surviving regions"), Seed), Reused.SurvivingRegions == Expected.SurvivingRegions);
+		TestEqual(FString::Printf(TEXT("%s: center region"), Seed), Reused.CenterRegionId, Expected.CenterRegionId);
+		TestTrue(FString::Printf(TEXT("%s: diagram"), Seed), LayoutsEqual(Reused.Diagram, Expected.Diagram));
+
+		FLayoutDiagram2D Diagram;
+		Gen->SetSeed(Seed);
+		Gen->Generate(Diagram, Scratch);
+		TestTrue(FString::Printf(TEXT("%s: diagram overload"), Seed), LayoutsEqual(Diagram, Expected.Diagram));
+	}
+
+	const bool*				 GridData = Reused.Grid.GetData();
+	const int32*			 RegionIdData = Reused.RegionIds.GetData();
+	const TArray<FIntPoint>* RegionData = Reused.Regions.GetData();
+	const FLayoutCell2D*	 CellData = Reused.Diagram.Cells.GetData();
+	Gen->SetSeed(TEXT("ReuseA"));
+	Gen->GenerateWithGridData(Reused, Scratch);
+	TestTrue("Reuse: grid kept", Reused.Grid.GetData() == GridData);
+	TestTrue("Reuse: region ids kept", Reused.RegionIds.GetData() == RegionIdData);
+	TestTrue("Reuse: regions kept", Reused.Regions.GetData() == RegionData);
+	TestTrue("Reuse: diagram cells kept", Reused.Diagram.Cells.GetData() == CellData);
+	return true;
+}
+
+// ============================================================
+// Test 3: Benchmark — heap allocations per generation for the by-value calls against the
+// reuse overloads. This measures output and scratch reuse; Test 5 isolates the frame arena.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutScratchReuseAllocationsTest, "ProceduralGeometry.ScratchReuse.Allocations", PerfTestFlags)
+
+bool FLayoutScratchReuseAllocationsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Iterations = 10;
+
+	auto Measure = [this](const TCHAR* Label, auto&& ByValue, auto&& Reusing) {
+		// Warm-up: sizes the scratch and the thread's frame-arena pages.
+		ByValue();
+		Reusing();
+
+		int64 ByValueCount = 0;
+		{
+			FScopedHeapAllocationCounter Counter;
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				ByValue();
+			}
+			ByValueCount = Counter.GetCount();
+		}
+		int64 ReusingCount = 0;
+		{
+			FScopedHeapAllocationCounter Counter;
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Reusing();
+			}
+			ReusingCount = Counter.GetCount();
+		}
+
+		UE_LOG(LogRoguelikeGeometry,
+			Log,
+			TEXT("[Allocations] %s: %.1f heap allocations per generation by value, %.1f with scratch reuse"),
+			Label,
+			static_cast<double>(ByValueCount) / Iterations,
+			static_cast<double>(ReusingCount) / Iterations);
+		TestTrue(FString::Printf(TEXT("Allocations: %s by-value path is counted"), Label), ByValueCount > 0);
+		TestTrue(FString::Printf(TEXT("Allocations: %s reuse allocates less than by value"), Label), ReusingCount < ByValueCount);
+	};
+
+	UDrunkardWalkGenerator2D* DWGen = MakeTestDrunkardWalk(TEXT("ReuseA"), 6, 4, 5)->SetBranchProbability(0.3f)->SetCorridorWidthRange(1, 2);
+	DWGen->SetPlacementWorkers(1);
+	FDrunkardWalkScratch  DWScratch;
+	FDrunkardWalkGridData DWData;
+	Measure(
+		TEXT("DrunkardWalk"),
+		[DWGen]() {
+			DWGen->SetSeed(TEXT("AllocBench"));
+			DWGen->GenerateWithGridData();
+		},
+		[DWGen, &DWScratch, &DWData]() {
+			DWGen->SetSeed(TEXT("AllocBench"));
+			DWGen->GenerateWithGridData(DWData, DWScratch);
+		});
+
+	UCellularAutomataGenerator2D* CAGen = NewObject<UCellularAutomataGenerator2D>();
+	CAGen->SetBounds(FBox2D(FVector2D(-500, -500), FVector2D(500, 500)));
+	FCellularAutomataScratch  CAScratch;
+	FCellularAutomataGridData CAData;
+	Measure(
+		TEXT("CellularAutomata"),
+		[CAGen]() {
+			CAGen->SetSeed(TEXT("AllocBench"));
+			CAGen->GenerateWithGridData();
+		},
+		[CAGen, &CAScratch, &CAData]() {
+			CAGen->SetSeed(TEXT("AllocBench"));
+			CAGen->GenerateWithGridData(CAData, CAScratch);
+		});
+	return true;
+}
+
+
+// ============================================================
+// Test 4: Steady state — once the scratch, the output and the frame-arena pages are warm,
+// regenerating a same-sized layout through the reuse overloads makes no heap allocation at
+// all on the generating thread, in every output mode. Logging is left as configured; the
+// layout cache is turned off, since a cache hit replaces the output with a fresh copy.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutScratchReuseSteadyStateTest, "ProceduralGeometry.ScratchReuse.SteadyState", DefaultTestFlags)
+
+bool FLayoutScratchReuseSteadyStateTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Iterations = 5;
+	const FString	Seed = TEXT("SteadyState");
+
+	IConsoleVariable* CacheCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("pg.LayoutCache"));
+	const int32		  CacheSetting = CacheCVar->GetInt();
+	CacheCVar->Set(0, ECVF_SetByCode);
+
+	auto Measure = [this](const TCHAR* Label, auto&& Reusing) {
+		// Two warm-up calls: the first sizes every buffer, the second proves the sizes are stable.
+		Reusing();
+		Reusing();
+
+		int64 Count = 0;
+		{
+			FScopedHeapAllocationCounter Counter(/*bCurrentThreadOnly=*/true);
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Reusing();
+			}
+			Count = Counter.GetCount();
+		}
+		TestEqual(FString::Printf(TEXT("SteadyState: %s heap allocations"), Label), Count, static_cast<int64>(0));
+	};
+
+	for (const bool bMerge : { false, true })
+	{
+		UDrunkardWalkGenerator2D* DWGen = MakeTestDrunkardWalk(TEXT("ReuseA"), 6, 4, 5)->SetBranchProbability(0.3f)->SetCorridorWidthRange(1, 2);
+		DWGen->SetMergeFloorRectangles(bMerge)->SetPlacementWorkers(1);
+		const TCHAR* Mode = bMerge ? TEXT("rectangles") : TEXT("grid cells");
+
+		FDrunkardWalkScratch  DWScratch;
+		FDrunkardWalkGridData DWData;
+		Measure(*FString::Printf(TEXT("DrunkardWalk grid data, %s"), Mode), [DWGen, &Seed, &DWScratch, &DWData]() {
+			DWGen->SetSeed(Seed);
+			DWGen->GenerateWithGridData(DWData, DWScratch);
+		});
+
+		FLayoutDiagram2D DWDiagram;
+		Measure(*FString::Printf(TEXT("DrunkardWalk diagram, %s"), Mode), [DWGen, &Seed, &DWScratch, &DWDiagram]() {
+			DWGen->SetSeed(Seed);
+			DWGen->Generate(DWDiagram, DWScratch);
+		});
+
+		FLayoutDiagramCompact DWCompact;
+		Measure(*FString::Printf(TEXT("DrunkardWalk compact, %s"), Mode), [DWGen, &Seed, &DWScratch, &DWCompact]() {
+			DWGen->SetSeed(Seed);
+			DWGen->GenerateCompact(DWCompact, DWScratch);
+		});
+	}
+
+	UCellularAutomataGenerator2D* CAGen = NewObject<UCellularAutomataGenerator2D>();
+	CAGen->SetBounds(FBox2D(FVector2D(-500, -500), FVector2D(500, 500)))->SetGridSize(10);
+	FCellularAutomataScratch  CAScratch;
+	FCellularAutomataGridData CAData;
+	Measure(TEXT("CellularAutomata"), [CAGen, &Seed, &CAScratch, &CAData]() {
+		CAGen->SetSeed(Seed);
+		CAGen->GenerateWithGridData(CAData, CAScratch);
+	});
+
+	CacheCVar->Set(CacheSetting, ECVF_SetByCode);
+	return true;
+}
+
+// ============================================================
+// Test 5: Benchmark — what the frame arena removes: the same corridor-selection and region
+// flood temporaries run on heap containers and on frame containers under an FMemMark, over
+// one generated layout. Both must visit the same cells; the frame run must make fewer heap
+// allocations (its only ones are chunks larger than an FMemStack page).
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutFrameArenaAllocationsTest, "ProceduralGeometry.ScratchReuse.FrameArena", PerfTestFlags)
+
+bool FLayoutFrameArenaAllocationsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Iterations = 10;
+
+	UCellularAutomataGenerator2D* Gen = NewObject<UCellularAutomataGenerator2D>();
+	Gen->SetBounds(FBox2D(FVector2D(-500, -500), FVector2D(500, 500)));
+	Gen->SetSeed(TEXT("AllocBench"));
+	const FCellularAutomataGridData GridData = Gen->GenerateWithGridData();
+
+	auto RunOnFrame = [&GridData]() {
+		FMemMark Mark(FMemStack::Get());
+		return RunCorridorStage<FFrameTemporaries>(GridData);
+	};
+
+	// Warm-up: the frame run takes its pages from the page pool once, as a generation does on its first call.
+	const uint64 HeapChecksum = RunCorridorStage<FHeapTemporaries>(GridData);
+	const uint64 FrameChecksum = RunOnFrame();
+	TestTrue("FrameArena: same work on both containers", FrameChecksum == HeapChecksum);
+
+	int64 HeapCount = 0;
+	{
+		FScopedHeapAllocationCounter Counter(/*bCurrentThreadOnly=*/true);
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			RunCorridorStage<FHeapTemporaries>(GridData);
+		}
+		HeapCount = Counter.GetCount();
+	}
+	int64 FrameCount = 0;
+	{
+		FScopedHeapAllocationCounter Counter(/*bCurrentThreadOnly=*/true);
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			RunOnFrame();
+		}
+		FrameCount = Counter.GetCount();
+	}
+
+	UE_LOG(LogRoguelikeGeometry,
+		Log,
+		TEXT("[Allocations] Corridor stage: %.1f heap allocations per run on heap containers, %.1f on the frame arena"),
+		static_cast<double>(HeapCount) / Iterations,
+		static_cast<double>(FrameCount) / Iterations);
+	TestTrue("FrameArena: heap containers are counted", HeapCount > 0);
+	TestTrue("FrameArena: frame containers allocate less", FrameCount < HeapCount);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,154 @@
+#include "Generators/LayoutSeedFarm.h"
+#include "Generators/CellularAutomata2D/CellularAutomataConfig.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkConfig.h"
+#include "../ProceduralGeometryTestFlags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Resolved DW params with a handful of small rooms; fast enough to farm dozens of seeds in a test. */
+	FDrunkardWalkResolvedParams MakeFarmDWParams()
+	{
+		FDrunkardWalkConfig Config;
+		FRoomTypeConfig		RoomType;
+		RoomType.Tag = FName(TEXT("Farm"));
+		RoomType.FootprintWidthCells = 4;
+		RoomType.FootprintHeightCells = 4;
+		RoomType.Weight = 6;
+		Config.RoomTypes.Add(RoomType);
+		Config.CorridorTurnProbability = 0.2f;
+		Config.BranchProbability = 0.3f;
+		return Config.Resolve();
+	}
+
+	/** Accepts layouts whose diagram cell count is even — an arbitrary, seed-dependent split. */
+	bool AcceptEvenCells(const FDrunkardWalkGridData& Data)
+	{
+		return Data.Diagram.Cells.Num() % 2 == 0;
+	}
+} // namespace
+
+// ============================================================
+// Test 1: Accepted seeds are the K lowest-index accepts, identical for 1 and 4 workers
+// and for a serial loop over the same seeds.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutSeedFarmDeterministicTest, "ProceduralGeometry.SeedFarm.DeterministicAcrossWorkers", DefaultTestFlags)
+
+bool FLayoutSeedFarmDeterministicTest::RunTest(const FString& Parameters)
+{
+	const FDrunkardWalkResolvedParams Params = MakeFarmDWParams();
+
+	FLayoutSeedFarmOptions Options;
+	Options.Seeds = FLayoutSeedFarm::MakeSeedRange(TEXT("Farm"), 0, 24);
+	Options.MaxAccepted = 3;
+
+	Options.NumWorkers = 1;
+	const TLayoutSeedFarmResult<FDrunkardWalkGridData> Serial = FLayoutSeedFarm::RunDrunkardWalk(Params, Options, AcceptEvenCells);
+	Options.NumWorkers = 4;
+	const TLayoutSeedFarmResult<FDrunkardWalkGridData> Parallel = FLayoutSeedFarm::RunDrunkardWalk(Params, Options, AcceptEvenCells);
+
+	TestEqual("SeedFarm: stats parallel to seeds", Parallel.Stats.Num(), Options.Seeds.Num());
+	TestTrue("SeedFarm: same accepted seeds for 1 and 4 workers", Serial.AcceptedSeedIndices == Parallel.AcceptedSeedIndices);
+	TestEqual("SeedFarm: layouts parallel to accepted indices", Parallel.AcceptedLayouts.Num(), Parallel.AcceptedSeedIndices.Num());
+
+	// Reference: a plain serial loop, one fresh generator per seed.
+	TArray<int32> Expected;
+	for (int32 i = 0; i < Options.Seeds.Num() && Expected.Num() < Options.MaxAccepted; ++i)
+	{
+		UDrunkardWalkGenerator2D* Gen = NewObject<UDrunkardWalkGenerator2D>();
+		Gen->SetBounds(Options.Bounds)->SetGridSize(Options.GridSize)->SetSeed(Options.Seeds[i])->ApplyResolvedParams(Params);
+		const FDrunkardWalkGridData Data = Gen->GenerateWithGridData();
+		if (AcceptEvenCells(Data))
+		{
+			const int32 Slot = Expected.Add(i);
+			if (Parallel.AcceptedLayouts.IsValidIndex(Slot))
+			{
+				TestTrue(FString::Printf(TEXT("SeedFarm: layout for seed %d matches a fresh generator"), i),
+					Parallel.AcceptedLayouts[Slot].Grid == Data.Grid);
+			}
+		}
+	}
+	TestTrue("SeedFarm: accepted indices equal the serial reference", Parallel.AcceptedSeedIndices == Expected);
+
+	for (const int32 SeedIdx : Parallel.AcceptedSeedIndices)
+	{
+		TestTrue("SeedFarm: accepted seed was evaluated and accepted",
+			Parallel.Stats[SeedIdx].bEvaluated && Parallel.Stats[SeedIdx].bAccepted);
+	}
+	return true;
+}
+
+// ============================================================
+// Test 2: Once K layouts are accepted, later seeds are cancelled; without a cap
+// every seed is evaluated. Also exercises the CA entry point.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutSeedFarmCancelTest, "ProceduralGeometry.SeedFarm.CancelAfterK", DefaultTestFlags)
+
+bool FLayoutSeedFarmCancelTest::RunTest(const FString& Parameters)
+{
+	FLayoutSeedFarmOptions Options;
+	Options.Seeds = FLayoutSeedFarm::MakeSeedRange(TEXT("Cancel"), 0, 40);
+	Options.MaxAccepted = 2;
+	Options.NumWorkers = 1;
+
+	const TLayoutSeedFarmResult<FDrunkardWalkGridData> AcceptAll =
+		FLayoutSeedFarm::RunDrunkardWalk(MakeFarmDWParams(), Options, [](const FDrunkardWalkGridData&) { return true; });
+	TestTrue("SeedFarm: first two seeds accepted", AcceptAll.AcceptedSeedIndices == TArray<int32>({ 0, 1 }));
+	TestFalse("SeedFarm: single worker stops after the K-th accept", AcceptAll.Stats[2].bEvaluated);
+
+	Options.Seeds = FLayoutSeedFarm::MakeSeedRange(TEXT("CaveFarm"), 0, 6);
+	Options.MaxAccepted = 0;
+	Options.NumWorkers = 3;
+	const TLayoutSeedFarmResult<FCellularAutomataGridData> Caves =
+		FLayoutSeedFarm::RunCellularAutomata(FCellularAutomataConfig().Resolve(), Options, [](const FCellularAutomataGridData& Data) {
+			return Data.Diagram.Cells.Num() > 0;
+		});
+
+	int32 Evaluated = 0;
+	for (const FLayoutSeedFarmSeedStats& Stats : Caves.Stats)
+	{
+		Evaluated += Stats.bEvaluated ? 1 : 0;
+	}
+	TestEqual("SeedFarm: uncapped run evaluates every seed", Evaluated, Options.Seeds.Num());
+	TestEqual("SeedFarm: accepted layouts match accepted indices", Caves.AcceptedLayouts.Num(), Caves.AcceptedSeedIndices.Num());
+	return true;
+}
+
+// ============================================================
+// Test 3: Over-budget bounds degrade every CA seed; workers reuse one generator across
+// seeds, and each layout still matches a fresh per-seed generator.
+// ============================================================
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLayoutSeedFarmDegradedTest, "ProceduralGeometry.SeedFarm.DegradedMatchesFreshGenerators", DefaultTestFlags)
+
+bool FLayoutSeedFarmDegradedTest::RunTest(const FString& Parameters)
+{
+	// 2050x2050 cells at the requested size: just over the 2048x2048 budget.
+	FLayoutSeedFarmOptions Options;
+	Options.Seeds = FLayoutSeedFarm::MakeSeedRange(TEXT("DegradedFarm"), 0, 4);
+	Options.Bounds = FBox2D(FVector2D(-10250, -10250), FVector2D(10250, 10250));
+	Options.GridSize = 10;
+	Options.MaxAccepted = 0;
+	Options.NumWorkers = 2;
+
+	const FCellularAutomataResolvedParams				   Params = FCellularAutomataConfig().Resolve();
+	const TLayoutSeedFarmResult<FCellularAutomataGridData> Farm =
+		FLayoutSeedFarm::RunCellularAutomata(Params, Options, [](const FCellularAutomataGridData&) { return true; });
+	TestEqual("SeedFarm: every seed accepted", Farm.AcceptedSeedIndices.Num(), Options.Seeds.Num());
+
+	for (int32 Slot = 0; Slot < Farm.AcceptedSeedIndices.Num(); ++Slot)
+	{
+		const int32					  SeedIdx = Farm.AcceptedSeedIndices[Slot];
+		UCellularAutomataGenerator2D* Gen = NewObject<UCellularAutomataGenerator2D>();
+		Gen->SetBounds(Options.Bounds)->SetGridSize(Options.GridSize)->SetSeed(Options.Seeds[SeedIdx])->ApplyResolvedParams(Params);
+		const FCellularAutomataGridData Fresh = Gen->GenerateWithGridData();
+
+		const FCellularAutomataGridData& Farmed = Farm.AcceptedLayouts[Slot];
+		TestTrue(FString::Printf(TEXT("SeedFarm: seed %d degraded"), SeedIdx), Farmed.bDegradedResolution && Fresh.bDegradedResolution);
+		TestEqual(FString::Printf(TEXT("SeedFarm: seed %d cell size"), SeedIdx), Farmed.CellSize, Fresh.CellSize);
+		TestTrue(FString::Printf(TEXT("SeedFarm: seed %d matches a fresh generator"), SeedIdx), Farmed.Grid == Fresh.Grid);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
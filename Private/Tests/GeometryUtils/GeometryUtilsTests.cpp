@@ -1,5 +1,6 @@
 #include "GeometryUtils/GeometryFunctionLibrary.h"
 #include "../ProceduralGeometryTestFlags.h"
+#include "Algo/Reverse.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -521,4 +522,311 @@ bool FDistanceToBoundaryEdgeTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+// ============================================================
+// SimplifyPolygonDouglasPeucker
+// ============================================================
+
+namespace
+{
+	/** Right triangle (0,0)-(100,0)-(100,100) whose hypotenuse is a 10-unit staircase back to the origin. */
+	TArray<FVector2D> MakeStaircaseTriangle()
+	{
+		TArray<FVector2D> Polygon = { FVector2D(0, 0), FVector2D(100, 0), FVector2D(100, 100) };
+		for (int32 Step = 9; Step >= 0; --Step)
+		{
+			Polygon.Add(FVector2D(Step * 10.0f, (Step + 1) * 10.0f));
+			if (Step > 0)
+			{
+				Polygon.Add(FVector2D(Step * 10.0f, Step * 10.0f));
+			}
+		}
+		return Polygon;
+	}
+} // namespace
+
+// Test 23: Staircase within tolerance collapses to its three true corners
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplifyStaircaseTest, "ProceduralGeometry.GeometryUtils.SimplifyDouglasPeucker.Staircase", DefaultTestFlags)
+
+bool FSimplifyStaircaseTest::RunTest(const FString& Parameters)
+{
+	TArray<FVector2D> Polygon = MakeStaircaseTriangle();
+	FGeometryUtils::SimplifyPolygonDouglasPeucker(Polygon, 8.0f, TArray<bool>());
+
+	TestEqual("Staircase collapses to a triangle", Polygon.Num(), 3);
+	TestTrue("Origin kept", Polygon.Contains(FVector2D(0, 0)));
+	TestTrue("(100,0) kept", Polygon.Contains(FVector2D(100, 0)));
+	TestTrue("(100,100) kept", Polygon.Contains(FVector2D(100, 100)));
+
+	// Tolerance below every non-zero corner deviation on the 10-unit lattice keeps the staircase intact
+	TArray<FVector2D> Tight = MakeStaircaseTriangle();
+	const int32		  OriginalCount = Tight.Num();
+	FGeometryUtils::SimplifyPolygonDouglasPeucker(Tight, 0.5f, TArray<bool>());
+	TestEqual("Tight tolerance keeps every corner", Tight.Num(), OriginalCount);
+
+	return true;
+}
+
+// Test 24: Locked vertices survive, and winding does not change which vertices are kept
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplifyLockedAndWindingTest, "ProceduralGeometry.GeometryUtils.SimplifyDouglasPeucker.LockedAndWinding", DefaultTestFlags)
+
+bool FSimplifyLockedAndWindingTest::RunTest(const FString& Parameters)
+{
+	const FVector2D Pinned(50, 50);
+
+	TArray<FVector2D> Polygon = MakeStaircaseTriangle();
+	TArray<bool>	  Locked;
+	Locked.Init(false, Polygon.Num());
+	Locked[Polygon.IndexOfByKey(Pinned)] = true;
+
+	FGeometryUtils::SimplifyPolygonDouglasPeucker(Polygon, 8.0f, Locked);
+	TestTrue("Locked vertex kept", Polygon.Contains(Pinned));
+	TestEqual("Triangle corners plus the pinned vertex", Polygon.Num(), 4);
+
+	// Reversed input must keep the same vertex set
+	TArray<FVector2D> Forward = MakeStaircaseTriangle();
+	TArray<FVector2D> Reversed = Forward;
+	Algo::Reverse(Reversed);
+	FGeometryUtils::SimplifyPolygonDouglasPeucker(Forward, 3.0f, TArray<bool>());
+	FGeometryUtils::SimplifyPolygonDouglasPeucker(Reversed, 3.0f, TArray<bool>());
+
+	TestEqual("Same vertex count for both windings", Forward.Num(), Reversed.Num());
+	for (const FVector2D& V : Forward)
+	{
+		TestTrue(FString::Printf(TEXT("(%.0f,%.0f) kept in both windings"), V.X, V.Y), Reversed.Contains(V));
+	}
+
+	return true;
+}
+
+// ============================================================
+// DistanceTransformSq
+// ============================================================
+
+// Test 25: Matches a brute-force nearest-feature search on a random grid
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDistanceTransformBruteForceTest, "ProceduralGeometry.GeometryUtils.DistanceTransform.MatchesBruteForce", DefaultTestFlags)
+
+bool FDistanceTransformBruteForceTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Width = 37;
+	constexpr int32 Height = 23;
+
+	FRandomStream Stream(1234);
+	TArray<bool>  Features;
+	Features.SetNumUninitialized(Width * Height);
+	for (int32 i = 0; i < Features.Num(); ++i)
+	{
+		Features[i] = Stream.FRand() < 0.05f;
+	}
+
+	TArray<int32> DistSq;
+	FGeometryUtils::DistanceTransformSq(Features, Width, Height, DistSq);
+	TestEqual("Output sized to grid", DistSq.Num(), Width * Height);
+
+	int32 Mismatches = 0;
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			int32 Best = MAX_int32;
+			for (int32 FY = 0; FY < Height; ++FY)
+			{
+				for (int32 FX = 0; FX < Width; ++FX)
+				{
+					if (Features[FY * Width + FX])
+					{
+						Best = FMath::Min(Best, FMath::Square(FX - X) + FMath::Square(FY - Y));
+					}
+				}
+			}
+			if (DistSq[Y * Width + X] != Best)
+			{
+				++Mismatches;
+			}
+		}
+	}
+	TestEqual("Every cell matches brute force", Mismatches, 0);
+
+	// uint8 overload on the same features
+	TArray<uint8> Types;
+	Types.SetNumUninitialized(Features.Num());
+	for (int32 i = 0; i < Features.Num(); ++i)
+	{
+		Types[i] = Features[i] ? 2 : 0;
+	}
+	TArray<int32> TypeDistSq;
+	FGeometryUtils::DistanceTransformSq(Types, 2, Width, Height, TypeDistSq);
+	TestTrue("uint8 overload matches bool overload", TypeDistSq == DistSq);
+
+	return true;
+}
+
+// Test 26: Parallel passes produce the same field as the serial path; no features => MAX_int32 everywhere;
+// distances too large for int32 saturate at MAX_int32
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDistanceTransformParallelTest, "ProceduralGeometry.GeometryUtils.DistanceTransform.ParallelAndEmpty", DefaultTestFlags)
+
+bool FDistanceTransformParallelTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Width = 300;
+	constexpr int32 Height = 211;
+
+	FRandomStream Stream(99);
+	TArray<bool>  Features;
+	Features.SetNumUninitialized(Width * Height);
+	for (int32 i = 0; i < Features.Num(); ++i)
+	{
+		Features[i] = Stream.FRand() < 0.002f;
+	}
+
+	TArray<int32> Serial;
+	TArray<int32> Parallel;
+	FGeometryUtils::DistanceTransformSq(Features, Width, Height, Serial, false);
+	FGeometryUtils::DistanceTransformSq(Features, Width, Height, Parallel, true);
+	TestTrue("Parallel equals serial", Serial == Parallel);
+
+	TArray<bool> NoFeatures;
+	NoFeatures.Init(false, 8 * 5);
+	TArray<int32> Empty;
+	FGeometryUtils::DistanceTransformSq(NoFeatures, 8, 5, Empty);
+	bool bAllUnreachable = Empty.Num() == 8 * 5;
+	for (const int32 D : Empty)
+	{
+		bAllUnreachable &= (D == MAX_int32);
+	}
+	TestTrue("No features => every cell MAX_int32", bAllUnreachable);
+
+	// Spans past 46340 cells: squared distances saturate at MAX_int32 instead of wrapping negative, along rows and columns.
+	constexpr int32 Span = 50000;
+	TArray<bool>	Line;
+	Line.Init(false, Span);
+	Line[0] = true;
+	for (const bool bColumn : { false, true })
+	{
+		TArray<int32> Long;
+		FGeometryUtils::DistanceTransformSq(Line, bColumn ? 1 : Span, bColumn ? Span : 1, Long);
+		const TCHAR* Axis = bColumn ? TEXT("column") : TEXT("row");
+		TestEqual(FString::Printf(TEXT("Long %s: last exact distance"), Axis), Long[46340], 46340 * 46340);
+		TestEqual(FString::Printf(TEXT("Long %s: saturates"), Axis), Long[46341], MAX_int32);
+		TestEqual(FString::Printf(TEXT("Long %s: far end saturates"), Axis), Long[Span - 1], MAX_int32);
+	}
+
+	return true;
+}
+
+// ============================================================
+// DilateChebyshev
+// ============================================================
+
+// Test 27: Matches a brute-force square-window dilation for several radii, serial and parallel
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDilateChebyshevBruteForceTest, "ProceduralGeometry.GeometryUtils.DilateChebyshev.MatchesBruteForce", DefaultTestFlags)
+
+bool FDilateChebyshevBruteForceTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Width = 61;
+	constexpr int32 Height = 45;
+
+	FRandomStream Stream(7);
+	TArray<bool>  Mask;
+	Mask.SetNumUninitialized(Width * Height);
+	for (int32 i = 0; i < Mask.Num(); ++i)
+	{
+		Mask[i] = Stream.FRand() < 0.01f;
+	}
+
+	for (const int32 Radius : { 0, 1, 3, 8 })
+	{
+		TArray<bool> Serial;
+		TArray<bool> Parallel;
+		FGeometryUtils::DilateChebyshev(Mask, Width, Height, Radius, Serial, false);
+		FGeometryUtils::DilateChebyshev(Mask, Width, Height, Radius, Parallel, true);
+		TestTrue(FString::Printf(TEXT("Radius %d: parallel equals serial"), Radius), Serial == Parallel);
+
+		int32 Mismatches = 0;
+		for (int32 Y = 0; Y < Height; ++Y)
+		{
+			for (int32 X = 0; X < Width; ++X)
+			{
+				bool bExpected = false;
+				for (int32 NY = FMath::Max(0, Y - Radius); NY <= FMath::Min(Height - 1, Y + Radius) && !bExpected; ++NY)
+				{
+					for (int32 NX = FMath::Max(0, X - Radius); NX <= FMath::Min(Width - 1, X + Radius); ++NX)
+					{
+						bExpected |= Mask[NY * Width + NX];
+					}
+				}
+				Mismatches += (Serial[Y * Width + X] != bExpected) ? 1 : 0;
+			}
+		}
+		TestEqual(FString::Printf(TEXT("Radius %d: every cell matches brute force"), Radius), Mismatches, 0);
+	}
+
+	return true;
+}
+
+// ============================================================
+// SimplifyPolygonSetDouglasPeucker
+// ============================================================
+
+// Test 28: A staircase two polygons share simplifies once, to the same diagonal on both sides
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplifySetSharedChainTest, "ProceduralGeometry.GeometryUtils.SimplifyDouglasPeucker.SetSharedChain", DefaultTestFlags)
+
+bool FSimplifySetSharedChainTest::RunTest(const FString& Parameters)
+{
+	// Lower triangle walks the staircase from (100,100) down to the origin; the upper polygon walks it back up.
+	TArray<FVector2D> Lower = MakeStaircaseTriangle();
+	TArray<FVector2D> Upper = { FVector2D(0, 0) };
+	for (int32 i = Lower.Num() - 1; i >= 3; --i)
+	{
+		Upper.Add(Lower[i]);
+	}
+	Upper.Add(FVector2D(100, 100));
+	Upper.Add(FVector2D(0, 100));
+
+	// Both ends of the shared staircase are junctions.
+	TArray<bool> LowerLocked;
+	TArray<bool> UpperLocked;
+	LowerLocked.Init(false, Lower.Num());
+	UpperLocked.Init(false, Upper.Num());
+	LowerLocked[0] = LowerLocked[2] = true;
+	UpperLocked[0] = UpperLocked[Upper.IndexOfByKey(FVector2D(100, 100))] = true;
+
+	TArray<FVector2D>* const Polygons[] = { &Lower, &Upper };
+	const TArray<bool>		 Locked[] = { LowerLocked, UpperLocked };
+	FGeometryUtils::SimplifyPolygonSetDouglasPeucker(Polygons, 8.0f, Locked);
+
+	TestEqual("Lower collapses to a triangle", Lower.Num(), 3);
+	TestEqual("Upper collapses to a triangle", Upper.Num(), 3);
+	TestTrue("Upper is the mirror triangle",
+		Upper.Contains(FVector2D(0, 0)) && Upper.Contains(FVector2D(100, 100)) && Upper.Contains(FVector2D(0, 100)));
+	TestTrue("Lower still meets Upper at both junctions", Lower.Contains(FVector2D(0, 0)) && Lower.Contains(FVector2D(100, 100)));
+
+	return true;
+}
+
+// Test 29: A chain whose simplification would swallow a neighbouring polygon is refined instead
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplifySetKeepsTopologyTest, "ProceduralGeometry.GeometryUtils.SimplifyDouglasPeucker.SetKeepsTopology", DefaultTestFlags)
+
+bool FSimplifySetKeepsTopologyTest::RunTest(const FString& Parameters)
+{
+	// The island sits inside one step of the staircase, on the far side of the diagonal the step collapses to at this tolerance.
+	TArray<FVector2D> Triangle = MakeStaircaseTriangle();
+	TArray<FVector2D> Island = { FVector2D(41, 46), FVector2D(43, 46), FVector2D(43, 48), FVector2D(41, 48) };
+	const FVector2D	  IslandCenter(42, 47);
+	TestTrue("Island starts inside the triangle", FGeometryUtils::PointInPolygon(Triangle, IslandCenter));
+
+	TArray<FVector2D>* const Polygons[] = { &Triangle, &Island };
+	FGeometryUtils::SimplifyPolygonSetDouglasPeucker(Polygons, 8.0f, TArrayView<const TArray<bool>>());
+
+	TestTrue("Island stays inside the triangle", FGeometryUtils::PointInPolygon(Triangle, IslandCenter));
+	TestEqual("Island untouched", Island.Num(), 4);
+	TestTrue("Triangle keeps the step around the island", Triangle.Contains(FVector2D(40, 50)) && Triangle.Contains(FVector2D(40, 40)));
+
+	// Alone, the same outline collapses to its three corners.
+	TArray<FVector2D>		 Alone = MakeStaircaseTriangle();
+	TArray<FVector2D>* const Single[] = { &Alone };
+	FGeometryUtils::SimplifyPolygonSetDouglasPeucker(Single, 8.0f, TArrayView<const TArray<bool>>());
+	TestEqual("Without the island the staircase collapses", Alone.Num(), 3);
+
+	return true;
+}
+
 #endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/AutomationTest.h"
+
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Counts heap allocations (Malloc, and Realloc to a non-zero size) made through GMalloc on any thread while in scope,
+ * for perf tests that report allocations per generation. GMalloc is wrapped in a forwarding proxy for the scope, so
+ * blocks allocated inside and freed outside (or the other way round) still reach the same allocator.
+ *
+ * Other engine threads allocate too; measure several iterations and compare like with like rather than asserting
+ * exact numbers. With bCurrentThreadOnly, only allocations on the thread that opened the scope count, which is exact
+ * for single-threaded work (a zero-allocation steady state, for instance).
+ */
+class FScopedHeapAllocationCounter
+{
+public:
+	explicit FScopedHeapAllocationCounter(bool bCurrentThreadOnly = false)
+	{
+		FCountingMalloc& Proxy = GetProxy();
+		check(GMalloc != &Proxy);
+		Proxy.Inner = GMalloc;
+		Proxy.Count.store(0);
+		Proxy.bCurrentThreadOnly = bCurrentThreadOnly;
+		Proxy.ThreadId = FPlatformTLS::GetCurrentThreadId();
+		GMalloc = &Proxy;
+	}
+
+	~FScopedHeapAllocationCounter() { GMalloc = GetProxy().Inner; }
+
+	int64 GetCount() const { return GetProxy().Count.load(); }
+
+private:
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc*		   Inner = nullptr;
+		std::atomic<int64> Count{ 0 };
+		bool			   bCurrentThreadOnly = false;
+		uint32			   ThreadId = 0;
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountOne();
+			return Inner->Malloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			if (Size > 0)
+			{
+				CountOne();
+			}
+			return Inner->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool   GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void   Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void   SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void   ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool   IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool   ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("ProceduralGeometry allocation counter"); }
+
+		void CountOne()
+		{
+			if (!bCurrentThreadOnly || FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				Count.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	// Never destroyed: another thread may still be inside a call it loaded from GMalloc just before the restore.
+	static FCountingMalloc& GetProxy()
+	{
+		static FCountingMalloc* Proxy = new FCountingMalloc();
+		return *Proxy;
+	}
+};
+
+#endif
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Generators/DrunkardWalk2D/DrunkardWalkConfig.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
+#include "Generators/LayoutDiagramCompact.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Fixtures shared by the ProceduralGeometry tests. Inline so test files in one unity translation unit do not
+// redefine them.
+
+/**
+ * DrunkardWalk generator on 100-unit cells with a single room type of RoomCount rooms, FootprintWidth x FootprintHeight
+ * cells each. Everything else is the generator default; chain setters on the result for corridor or merge options.
+ */
+inline UDrunkardWalkGenerator2D* MakeTestDrunkardWalk(const FString& Seed, int32 RoomCount, int32 FootprintWidth = 4, int32 FootprintHeight = 4)
+{
+	UDrunkardWalkGenerator2D* Gen = NewObject<UDrunkardWalkGenerator2D>();
+	Gen->SetSeed(Seed);
+	Gen->SetGridSize(100);
+
+	FRoomTypeConfig RoomType;
+	RoomType.Tag = FName(TEXT("Test"));
+	RoomType.FootprintWidthCells = FootprintWidth;
+	RoomType.FootprintHeightCells = FootprintHeight;
+	RoomType.Weight = RoomCount;
+	Gen->SetRoomTypes({ RoomType });
+	return Gen;
+}
+
+/** Exact equality of one cell in either form; doubles are compared bit for bit. */
+inline bool CellsEqual(const FLayoutCell2D& A, const FLayoutCellView& B)
+{
+	return A.Vertices == TArray<FVector2D>(B.Vertices) && A.Neighbors == TArray<int32>(B.Neighbors) && A.Center == B.Center
+		&& A.CellIndex == B.CellIndex && A.bIsExterior == B.bIsExterior;
+}
+
+/** Exact, field-by-field equality of two layouts. Diagrams: every cell in order, plus bounds, center and seed. */
+inline bool LayoutsEqual(const FLayoutDiagram2D& A, const FLayoutDiagram2D& B)
+{
+	if (A.Cells.Num() != B.Cells.Num() || A.Seed != B.Seed || A.CenterCellIndex != B.CenterCellIndex || A.CenterPoint != B.CenterPoint
+		|| A.Bounds.Min != B.Bounds.Min || A.Bounds.Max != B.Bounds.Max || A.Bounds.bIsValid != B.Bounds.bIsValid)
+	{
+		return false;
+	}
+	for (int32 i = 0; i < B.Cells.Num(); ++i)
+	{
+		const FLayoutCell2D& CellB = B.Cells[i];
+		if (!CellsEqual(A.Cells[i], FLayoutCellView{ CellB.Vertices, CellB.Neighbors, CellB.Center, CellB.CellIndex, CellB.bIsExterior }))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/** As above, against the compact form of the same diagram. */
+inline bool LayoutsEqual(const FLayoutDiagram2D& A, const FLayoutDiagramCompact& B)
+{
+	if (A.Cells.Num() != B.Num() || A.Seed != B.Seed || A.CenterCellIndex != B.CenterCellIndex || A.CenterPoint != B.CenterPoint
+		|| A.Bounds.Min != B.Bounds.Min || A.Bounds.Max != B.Bounds.Max || A.Bounds.bIsValid != B.Bounds.bIsValid)
+	{
+		return false;
+	}
+	for (int32 i = 0; i < B.Num(); ++i)
+	{
+		if (!CellsEqual(A.Cells[i], B.GetCell(i)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/** DrunkardWalk grid data: the per-cell arrays, rooms and walker paths, and the diagram. */
+inline bool LayoutsEqual(const FDrunkardWalkGridData& A, const FDrunkardWalkGridData& B)
+{
+	return A.Grid == B.Grid && A.CellType == B.CellType && A.RegionIds == B.RegionIds && A.RoomCenters == B.RoomCenters
+		&& A.WalkerPaths == B.WalkerPaths && A.GridWidth == B.GridWidth && LayoutsEqual(A.Diagram, B.Diagram);
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Generators/CellularAutomata2D/CellularAutomataConfig.h"
+#include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
 #include "CellularAutomata2DVisualizer.generated.h"
 
 class UProceduralMeshComponent;
@@ -74,4 +75,9 @@ public:
 
 protected:
 	virtual void OnConstruction(const FTransform& Transform) override;
+
+private:
+	// Regenerated on every OnConstruction; kept so repeated drags reuse the same memory.
+	FCellularAutomataGridData LastGridData;
+	FCellularAutomataScratch  GenerationScratch;
 };
@@ -64,6 +64,7 @@ struct PROCEDURALGEOMETRY_API FCellularAutomataResolvedParams
 	int32		  GridDensityMultiplier = 10;
 	int32		  MinRegionSize = 30;
 	bool		  bKeepCenterRegion = true;
+	float		  BoundarySimplifyTolerance = 0.0f;
 };
 
 /**
@@ -174,6 +175,15 @@ struct PROCEDURALGEOMETRY_API FCellularAutomataConfig
 		meta = (ClampMin = 1, ClampMax = 5, ToolTip = "Width of carved corridors in grid cells."))
 	int32 CorridorWidth = 2;
 
+	// --- Output ---
+
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category = "Cave Generation|Output",
+		meta = (ClampMin = 0.0,
+			ToolTip = "Max deviation in world units when simplifying region outlines (Douglas-Peucker). 0 = exact staircase outline. Corners shared with neighbouring regions are always kept, and no outline is pushed across another."))
+	float BoundarySimplifyTolerance = 0.0f;
+
 	/** Resolves semantic parameters into raw CA parameters for the generator. Pure function, no side effects. */
 	FCellularAutomataResolvedParams Resolve() const;
 };
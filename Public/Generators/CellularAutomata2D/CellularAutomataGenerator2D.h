@@ -1,9 +1,42 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+#include "Generators/CellularAutomata2D/CellularAutomataConfig.h"
 #include "Generators/LayoutGenerator.h"
 #include "CellularAutomataGenerator2D.generated.h"
 
+struct FCellularAutomataHierarchicalDiagram;
+
+/**
+ * Region adjacency graph over diagram cells, in CSR form. The neighbors of cell i are
+ * Neighbors[Offsets[i] .. Offsets[i + 1]) in ascending order; the per-edge arrays run parallel to Neighbors.
+ * Two regions are adjacent when a single wall cell separates them (4-neighbourhood), matching FLayoutCell2D::Neighbors.
+ */
+struct PROCEDURALGEOMETRY_API FCellularAutomataRegionGraph
+{
+	TArray<int32> Offsets;		 // NumCells + 1 entries
+	TArray<int32> Neighbors;	 // Neighbor diagram cell index per edge slot
+	TArray<float> ContactLength; // Bridging wall cells between the pair * CellSize (world units)
+	TArray<float> WallThickness; // CellSize if some wall cell has the pair on opposite sides, 0 if they only meet diagonally
+
+	int32 NumCells() const { return FMath::Max(0, Offsets.Num() - 1); }
+
+	/** Neighbor cell indices of CellIndex (ascending). */
+	TArrayView<const int32> GetNeighbors(int32 CellIndex) const
+	{
+		return TArrayView<const int32>(Neighbors.GetData() + Offsets[CellIndex], Offsets[CellIndex + 1] - Offsets[CellIndex]);
+	}
+
+	/** Edge slot of (CellA -> CellB) for indexing the per-edge arrays, or INDEX_NONE if not adjacent. */
+	int32 FindEdge(int32 CellA, int32 CellB) const
+	{
+		const TArrayView<const int32> Row = GetNeighbors(CellA);
+		const int32					  Local = Algo::LowerBound(Row, CellB);
+		return (Local < Row.Num() && Row[Local] == CellB) ? Offsets[CellA] + Local : INDEX_NONE;
+	}
+};
+
 /**
  * Debug/visualization data from the cellular automata generation pipeline.
  * NOT a stable production API — use Generate() for production callers.
@@ -12,16 +45,53 @@
  */
 struct PROCEDURALGEOMETRY_API FCellularAutomataGridData
 {
-	TArray<bool>			  Grid;				// true = floor, false = wall
-	TArray<int32>			  RegionIds;		// Per-cell region ID (-1 = wall)
-	TArray<TArray<FIntPoint>> Regions;			// List of cell coordinates per region
-	TArray<bool>			  SurvivingRegions; // true = survived culling, false = culled
-	int32					  CenterRegionId;	// Region containing grid center (-1 if none)
-	int32					  GridWidth;
-	int32					  GridHeight;
-	float					  CellSize;
-	bool					  bDegradedResolution = false; // true when cell size was enlarged to fit the cell budget
-	FLayoutDiagram2D		  Diagram;					   // The final merged diagram (existing output)
+	TArray<bool>				 Grid;			   // true = floor, false = wall
+	TArray<int32>				 RegionIds;		   // Per-cell region ID (-1 = wall)
+	TArray<TArray<FIntPoint>>	 Regions;		   // List of cell coordinates per region
+	TArray<bool>				 SurvivingRegions; // true = survived culling, false = culled
+	int32						 CenterRegionId;   // Region containing grid center (-1 if none)
+	int32						 GridWidth;
+	int32						 GridHeight;
+	float						 CellSize;
+	bool						 bDegradedResolution = false; // true when cell size was enlarged to fit the cell budget
+	FLayoutDiagram2D			 Diagram;					  // The final merged diagram (existing output)
+	FCellularAutomataRegionGraph RegionGraph;				  // Adjacency between Diagram cells with contact metrics
+};
+
+/**
+ * Working memory for repeated cellular automata generation, passed to the Generate() and GenerateWithGridData()
+ * overloads that fill an existing output. Every buffer keeps its capacity between calls; contents are meaningless
+ * outside a call. Use one scratch per thread.
+ */
+struct PROCEDURALGEOMETRY_API FCellularAutomataScratch
+{
+	/** Adjacent pair of diagram cells with its bridging wall count, merged from the sorted edge keys. */
+	struct FMergedEdge
+	{
+		int32 A;
+		int32 B;
+		int32 ContactCells;
+		bool  bStraight;
+	};
+
+	TArray<bool>			  NextGrid; // automaton double buffer
+	TArray<int32>			  RegionToCell;
+	TArray<int32>			  SurvivingRegionIds;
+	TArray<uint64>			  EdgeKeys;
+	TArray<uint64>			  SortBuffer;
+	TArray<FMergedEdge>		  Edges;
+	TArray<int32>			  Degree;
+	TArray<int32>			  FillCursor;
+	FCellularAutomataGridData GridData; // Generate(FLayoutDiagram2D&, ...) works in here
+
+	// Boundary tracing
+	TMultiMap<FIntPoint, FIntPoint>	  EdgeMap;
+	TSet<TPair<FIntPoint, FIntPoint>> UsedEdges;
+	TArray<TArray<FIntPoint>>		  Loops;
+	TArray<FIntPoint>				  Outgoing;
+	TArray<FIntPoint>				  Corners;
+	TArray<TArray<bool>>			  OutlineLocks; // per diagram cell, parallel to its outline vertices
+	TArray<TArray<FVector2D>*>		  Outlines;
 };
 
 UCLASS()
@@ -35,8 +105,12 @@ class PROCEDURALGEOMETRY_API UCellularAutomataGenerator2D final : public ULayout
 	TArray<int32> SurvivalRule;
 	int32		  MinRegionSize;
 	bool		  bKeepCenterRegion;
+	float		  BoundarySimplifyTolerance;
 
 public:
+	/** Bump whenever a change alters the output for identical inputs; cached layouts from older versions are then ignored. */
+	static constexpr uint32 CacheAlgorithmVersion = 3;
+
 	UCellularAutomataGenerator2D();
 
 	// Covariant base class overrides
@@ -53,12 +127,33 @@ public:
 	UCellularAutomataGenerator2D* SetMinRegionSize(int32 InSize);
 	UCellularAutomataGenerator2D* SetKeepCenterRegion(bool bKeep);
 
+	/** Max outline deviation in world units for Douglas-Peucker simplification of traced regions. 0 = exact staircase outline.
+	 *  Outlines are simplified together: corners where regions meet stay put, and no outline is pushed across another. */
+	UCellularAutomataGenerator2D* SetBoundarySimplifyTolerance(float InTolerance);
+
+	/** Applies a fully resolved parameter set in one call. */
+	UCellularAutomataGenerator2D* ApplyResolvedParams(const FCellularAutomataResolvedParams& Params);
+
 	// Generation
 	virtual FLayoutDiagram2D Generate() override;
 
 	/** Returns the full intermediate grid data including the final diagram. For visualization and testing only. */
 	FCellularAutomataGridData GenerateWithGridData();
 
+	/**
+	 * Same output as Generate() and GenerateWithGridData(), written into an existing result. The result's arrays and the
+	 * scratch buffers are reused, so once they have grown to a layout's size, regenerating same-sized layouts (editor
+	 * drag ticks, seed farms) allocates no containers. With pg.LayoutCache on, the result is replaced by the cached copy.
+	 */
+	void Generate(FLayoutDiagram2D& OutDiagram, FCellularAutomataScratch& Scratch);
+	void GenerateWithGridData(FCellularAutomataGridData& OutGridData, FCellularAutomataScratch& Scratch);
+
+	/**
+	 * Two-level layout for streaming (see CellularAutomataHierarchy.h): region polygons and the region graph resident,
+	 * per-region tile detail as encoded blocks decoded on demand.
+	 */
+	FCellularAutomataHierarchicalDiagram GenerateHierarchical();
+
 	/**
 	 * Carves corridors between disconnected surviving regions in the grid.
 	 * Modifies Grid and RegionIds in place. Does not recompute Diagram — caller must call RebuildDiagram() afterward.
@@ -79,21 +174,50 @@ public:
 	void RebuildDiagram(FCellularAutomataGridData& GridData);
 
 private:
-	/** Core generation pipeline shared by Generate() and GenerateWithGridData(). */
-	FCellularAutomataGridData GenerateInternal();
+	/**
+	 * Core generation pipeline shared by Generate() and GenerateWithGridData(); fills Result in place.
+	 * Culled regions are tracked only in SurvivingRegions; bMaterializeGrid also clears their cells in Grid.
+	 */
+	void GenerateInternal(bool bMaterializeGrid, FCellularAutomataGridData& Result, FCellularAutomataScratch& Scratch);
+
+	/** Layout cache key of the current configuration for the given output kind. */
+	FString MakeCacheKey(const TCHAR* Output) const;
 
 	static uint16 RuleToBitmask(const TArray<int32>& Rule);
 	int32		  CountWallNeighbors(const TArray<bool>& Grid, int32 X, int32 Y, int32 GridWidth, int32 GridHeight) const;
 
-	// Region merging pipeline
-	FLayoutDiagram2D  BuildDiagramFromRegions(const TArray<bool>& Grid,
-		 const TArray<int32>&									  RegionIds,
-		 const TArray<TArray<FIntPoint>>&						  Regions,
-		 int32													  CenterRegionId,
-		 int32													  GridWidth,
-		 int32													  GridHeight);
-	TArray<FVector2D> TraceBoundaryPolygon(
-		const TArray<FIntPoint>& Region, const TArray<int32>& RegionIds, int32 RegionId, int32 GridWidth, int32 GridHeight, float CellSize) const;
-	static float	  ComputePolygonArea(const TArray<FIntPoint>& Loop);
-	TArray<FVector2D> SimplifyAndConvert(const TArray<FIntPoint>& Loop, float CellSize) const;
+	/** Region ID of the floor cell nearest (CenterX, CenterY), lowest ID on ties; O(distance^2). INDEX_NONE if no floor. */
+	static int32 FindNearestRegionId(const TArray<int32>& RegionIds, int32 GridWidth, int32 GridHeight, int32 CenterX, int32 CenterY);
+
+	// Region merging pipeline (outputs are filled in place)
+	void BuildDiagramFromRegions(const TArray<bool>& SurvivingRegions,
+		const TArray<int32>&						 RegionIds,
+		const TArray<TArray<FIntPoint>>&			 Regions,
+		int32										 CenterRegionId,
+		int32										 GridWidth,
+		int32										 GridHeight,
+		float										 CellSize,
+		FCellularAutomataRegionGraph&				 OutRegionGraph,
+		FLayoutDiagram2D&							 OutDiagram,
+		FCellularAutomataScratch&					 Scratch);
+	void TraceBoundaryPolygon(const TArray<FIntPoint>& Region,
+		const TArray<int32>&						   RegionIds,
+		const TArray<bool>&							   SurvivingRegions,
+		int32										   RegionId,
+		int32										   GridWidth,
+		int32										   GridHeight,
+		float										   CellSize,
+		FCellularAutomataScratch&					   Scratch,
+		TArray<FVector2D>&							   OutVertices,
+		TArray<bool>*								   OutLocked = nullptr) const;
+	static float ComputePolygonArea(const TArray<FIntPoint>& Loop);
+	void SimplifyAndConvert(
+		const TArray<FIntPoint>& Loop, float CellSize, TArray<FVector2D>& OutVertices, TArray<FIntPoint>* OutCorners = nullptr) const;
+	/** True where another surviving region meets this grid corner or RegionId's outline pinches through it; culled regions count as wall. */
+	static bool IsJunctionCorner(const FIntPoint& Corner,
+		const TArray<int32>&					  RegionIds,
+		const TArray<bool>&						  SurvivingRegions,
+		int32									  RegionId,
+		int32									  GridWidth,
+		int32									  GridHeight);
 };
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
+
+/**
+ * Full-resolution detail of one region: one fine cell per floor tile of the region, decoded from its block on demand.
+ * Fine cells follow ConvertGridToDiagram's layout over the region's tile box (row-major numbering, 4-neighbour
+ * Neighbors, GridLookup in world space); bIsExterior marks tiles on the edge of the whole map.
+ */
+struct PROCEDURALGEOMETRY_API FCellularAutomataRegionDetail
+{
+	int32			 CoarseCellIndex = INDEX_NONE; // link back to the region's cell in the coarse level
+	FIntPoint		 TileMin = FIntPoint::ZeroValue; // region tile box in the full map grid
+	int32			 Width = 0;
+	int32			 Height = 0;
+	TArray<bool>	 Floor; // Width * Height, true on the region's own tiles
+	FLayoutDiagram2D Cells;
+
+	/** Full-map tile of a fine cell, or (-1, -1). */
+	FIntPoint GetTile(int32 FineCellIndex) const;
+};
+
+/**
+ * Two-level cave layout for streaming large maps. The coarse level is always resident: region polygons (the regular
+ * CA diagram, one cell per surviving region) and the region adjacency graph with contact metrics. The fine level is
+ * one block per region holding the region's tile mask, run-length coded with FLayoutGridCodec; a block is decoded
+ * into an FCellularAutomataRegionDetail only when loaded, and can be unloaded again, so memory follows the regions a
+ * streaming system has paged in rather than the map size.
+ *
+ * Cross-level links: coarse cell i owns block i (GetBlock, LoadDetail); a detail records its CoarseCellIndex and tile
+ * box; both levels share the map's tile frame (GridOrigin, CellSize), so FindCellAt resolves a world point to its
+ * region and, when that region is loaded, to the fine cell.
+ */
+struct PROCEDURALGEOMETRY_API FCellularAutomataHierarchicalDiagram
+{
+	/** Encoded fine detail of one coarse cell; the mask bytes are BlockBytes[ByteOffset, ByteOffset + ByteCount). */
+	struct FBlock
+	{
+		FIntPoint TileMin = FIntPoint::ZeroValue;
+		int32	  Width = 0;
+		int32	  Height = 0;
+		int32	  NumFineCells = 0;
+		int32	  ByteOffset = 0;
+		int32	  ByteCount = 0;
+	};
+
+	FLayoutDiagram2D			 Regions;	  // coarse level
+	FCellularAutomataRegionGraph RegionGraph; // coarse adjacency, parallel to Regions.Cells
+	FVector2D					 GridOrigin = FVector2D::ZeroVector; // world position of map tile (0, 0)
+	float						 CellSize = 0.f;
+	int32						 GridWidth = 0;
+	int32						 GridHeight = 0;
+	TArray<FBlock>				 Blocks;	 // one per coarse cell
+	TArray<uint8>				 BlockBytes; // all blocks back to back; streamers may keep these on disk instead
+
+	/** Builds both levels from generator output (after CarveCorridors, call RebuildDiagram first). */
+	static FCellularAutomataHierarchicalDiagram Build(const FCellularAutomataGridData& GridData);
+
+	int32 NumRegions() const { return Regions.Cells.Num(); }
+
+	const FBlock& GetBlock(int32 CoarseCellIndex) const { return Blocks[CoarseCellIndex]; }
+
+	TArrayView<const uint8> GetBlockBytes(int32 CoarseCellIndex) const
+	{
+		const FBlock& Block = Blocks[CoarseCellIndex];
+		return TArrayView<const uint8>(BlockBytes.GetData() + Block.ByteOffset, Block.ByteCount);
+	}
+
+	/**
+	 * Decodes one block (its bytes may come from anywhere, e.g. a streamed file) into OutDetail, reusing its arrays.
+	 * Returns false, leaving OutDetail unspecified, when the bytes do not match the block.
+	 */
+	bool DecodeDetail(int32 CoarseCellIndex, TArrayView<const uint8> Bytes, FCellularAutomataRegionDetail& OutDetail) const;
+
+	/** Decodes and keeps the detail of a region; a no-op when already loaded. Returns nullptr if it fails to decode. */
+	const FCellularAutomataRegionDetail* LoadDetail(int32 CoarseCellIndex);
+
+	/** Drops a loaded detail, freeing its memory. */
+	void UnloadDetail(int32 CoarseCellIndex);
+
+	/** The loaded detail of a region, or nullptr. */
+	const FCellularAutomataRegionDetail* FindDetail(int32 CoarseCellIndex) const;
+
+	int32 NumLoadedDetails() const { return LoadedDetails.Num(); }
+
+	/**
+	 * Region cell containing WorldPos into OutCoarseCell (INDEX_NONE if none), and the fine cell into OutFineCell when
+	 * that region's detail is loaded (else INDEX_NONE). When a loaded detail owns the tile under WorldPos, that region
+	 * wins over the polygon hit (regions can nest inside another's outline). Returns true when a fine cell was found.
+	 */
+	bool FindCellAt(const FVector2D& WorldPos, int32& OutCoarseCell, int32& OutFineCell) const;
+
+	/** Heap bytes held: the coarse level, the encoded blocks and the loaded details. */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	TMap<int32, TUniquePtr<FCellularAutomataRegionDetail>> LoadedDetails;
+};
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Generators/DrunkardWalk2D/DrunkardWalkConfig.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
 #include "DrunkardWalk2DVisualizer.generated.h"
 
 class UProceduralMeshComponent;
@@ -77,4 +78,9 @@ public:
 
 protected:
 	virtual void OnConstruction(const FTransform& Transform) override;
+
+private:
+	// Regenerated on every OnConstruction; kept so repeated drags reuse the same memory.
+	FDrunkardWalkGridData LastGridData;
+	FDrunkardWalkScratch  GenerationScratch;
 };
@@ -64,6 +64,7 @@ struct PROCEDURALGEOMETRY_API FDrunkardWalkResolvedParams
 	int32					MaxPlacementAttemptsPerExit = 8;
 	bool					bShuffleRoomOrder = true;
 	float					BranchProbability = 0.0f;
+	bool					bMergeFloorRectangles = false;
 };
 
 /**
@@ -160,6 +161,13 @@ struct PROCEDURALGEOMETRY_API FDrunkardWalkConfig
 				"Probability that the next room grows from a random earlier room instead of the most recent one. 0 = a single winding path, 1 = a highly branching tree."))
 	float BranchProbability = 0.0f;
 
+	UPROPERTY(EditAnywhere,
+		BlueprintReadWrite,
+		Category = "Dungeon Generation|Output",
+		meta = (ToolTip =
+					"Emit the diagram as maximal axis-aligned floor rectangles (rooms and corridor runs kept apart) instead of one cell per floor cell. Same floor coverage, far fewer cells."))
+	bool bMergeFloorRectangles = false;
+
 	/** Validates and clamps semantic parameters into raw DW parameters for the generator. Pure function, no side effects. */
 	FDrunkardWalkResolvedParams Resolve() const;
 
@@ -23,6 +23,48 @@ struct PROCEDURALGEOMETRY_API FDrunkardWalkPlacedRoom
 	int32	  TypeIndex = -1; // index into the resolved RoomTypes array (-1 = unknown)
 };
 
+/** A corridor of the dungeon graph: center rail with the band width at each rail point. */
+struct PROCEDURALGEOMETRY_API FDungeonGraphCorridor
+{
+	TArray<FIntPoint> Path;			  // center rail, grid-array coords
+	TArray<int32>	  Widths;		  // band width in cells per Path point (parallel to Path)
+	int32			  SourceRoom = -1; // Rooms index the corridor starts from
+	int32			  TargetRoom = -1; // Rooms index the corridor leads to
+};
+
+/**
+ * Lightweight room-and-corridor graph of a drunkard walk layout, produced without rasterizing any grid.
+ * Coordinates use the full-resolution grid-array frame of GenerateWithGridData() (identical to it unless that
+ * run reports bDegradedResolution). Room adjacency is CSR: the neighbors of room R are
+ * AdjacentRooms[AdjacencyOffsets[R] .. AdjacencyOffsets[R + 1]), ascending, with the connecting corridor
+ * index in the parallel AdjacentCorridors array.
+ */
+struct PROCEDURALGEOMETRY_API FDungeonGraph2D
+{
+	TArray<FDrunkardWalkPlacedRoom> Rooms;				// Placed rooms in placement order
+	TArray<FDungeonGraphCorridor>	Corridors;			// One per placed corridor segment
+	TArray<int32>					AdjacencyOffsets;	// Rooms.Num() + 1 entries
+	TArray<int32>					AdjacentRooms;		// Neighbor room per adjacency entry
+	TArray<int32>					AdjacentCorridors;	// Corridors index per adjacency entry (parallel to AdjacentRooms)
+	int32							RequestedRoomCount = 0;
+	float							CellSize = 0.0f;
+	FVector2D						WorldOrigin = FVector2D::ZeroVector; // world position of grid-array cell (0,0)'s min corner
+
+	int32 NumRooms() const { return Rooms.Num(); }
+
+	TArrayView<const int32> GetNeighbors(int32 RoomIndex) const
+	{
+		return TArrayView<const int32>(
+			AdjacentRooms.GetData() + AdjacencyOffsets[RoomIndex], AdjacencyOffsets[RoomIndex + 1] - AdjacencyOffsets[RoomIndex]);
+	}
+
+	TArrayView<const int32> GetNeighborCorridors(int32 RoomIndex) const
+	{
+		return TArrayView<const int32>(
+			AdjacentCorridors.GetData() + AdjacencyOffsets[RoomIndex], AdjacencyOffsets[RoomIndex + 1] - AdjacencyOffsets[RoomIndex]);
+	}
+};
+
 /**
  * Debug/visualization data from the drunkard walk generation pipeline.
  * NOT a stable production API — use Generate() for production callers.
@@ -49,6 +91,85 @@ struct PROCEDURALGEOMETRY_API FDrunkardWalkGridData
 	FLayoutDiagram2D				Diagram;					 // Final output (existing)
 };
 
+/**
+ * Sparse raster of a drunkard walk layout: only TileSize x TileSize blocks that hold floor or wall cells are stored,
+ * so memory scales with the dungeon's area rather than its bounding box. Cells use the same grid-array frame as
+ * FDrunkardWalkGridData; for the same seed and config, cell types and region ids match the dense grid cell for cell
+ * (unless the dense grid had to degrade its resolution and this one did not).
+ */
+struct PROCEDURALGEOMETRY_API FDrunkardWalkTiledGridData
+{
+	static constexpr int32 TileShift = 5;
+	static constexpr int32 TileSize = 1 << TileShift;
+	static constexpr int32 TileCells = TileSize * TileSize;
+
+	struct FTile
+	{
+		FIntPoint	  Coord;	 // covers cells [Coord * TileSize, Coord * TileSize + TileSize) on both axes
+		TArray<uint8> CellType;	 // EDrunkardWalkCellType, row-major within the tile
+		TArray<int32> RegionIds; // floor region per cell (-1 = non-floor)
+	};
+
+	TArray<FTile>					Tiles;		// sorted by (Coord.Y, Coord.X)
+	TMap<FIntPoint, int32>			TileLookup; // tile coord -> Tiles index
+	TArray<int32>					RegionSizes;			// floor cells per region; ids follow the dense grid's row-major scan order
+	int32							CenterRegionId = -1;	// region containing the first room's center (-1 if none)
+	TArray<TArray<FIntPoint>>		WalkerPaths;			// one corridor polyline per placed segment (grid-array coords)
+	TArray<int32>					CorridorSourceRoom;		// parallel to WalkerPaths
+	TArray<int32>					CorridorTargetRoom;		// parallel to WalkerPaths
+	TArray<FIntPoint>				RoomCenters;			// grid positions of placed room centers
+	TArray<FDrunkardWalkPlacedRoom> PlacedRooms;			// full placed-room records
+	int32							RequestedRoomCount = 0; // total rooms requested (sum of type counts)
+	int32							GridWidth = 0;			// size of the equivalent dense grid
+	int32							GridHeight = 0;
+	float							CellSize = 0.0f;
+	bool							bDegradedResolution = false;
+	FVector2D						WorldOrigin = FVector2D::ZeroVector; // world position of grid-array cell (0, 0)'s min corner
+
+	/** Tile holding Cell, or nullptr if that block is not stored (all Empty). */
+	const FTile* FindTile(const FIntPoint& Cell) const
+	{
+		const int32* TileIdx = TileLookup.Find(FIntPoint(Cell.X >> TileShift, Cell.Y >> TileShift));
+		return TileIdx ? &Tiles[*TileIdx] : nullptr;
+	}
+
+	/** Row-major index of Cell within its tile. */
+	static int32 LocalIndexOf(const FIntPoint& Cell) { return ((Cell.Y & (TileSize - 1)) << TileShift) | (Cell.X & (TileSize - 1)); }
+
+	uint8 GetCellType(const FIntPoint& Cell) const
+	{
+		const FTile* Tile = FindTile(Cell);
+		return Tile ? Tile->CellType[LocalIndexOf(Cell)] : EDrunkardWalkCellType::Empty;
+	}
+
+	int32 GetRegionId(const FIntPoint& Cell) const
+	{
+		const FTile* Tile = FindTile(Cell);
+		return Tile ? Tile->RegionIds[LocalIndexOf(Cell)] : -1;
+	}
+
+	/** Cells actually held in memory (stored tiles x TileCells). */
+	int64 NumStoredCells() const { return static_cast<int64>(Tiles.Num()) * TileCells; }
+};
+
+/**
+ * Working memory for repeated drunkard walk generation, passed to the Generate() and GenerateWithGridData() overloads
+ * that fill an existing output. The walk's sparse grids, placement scratch and raster buffers keep their capacity
+ * between calls. Use one scratch per thread.
+ */
+class PROCEDURALGEOMETRY_API FDrunkardWalkScratch
+{
+public:
+	FDrunkardWalkScratch();
+	~FDrunkardWalkScratch();
+
+private:
+	friend class UDrunkardWalkGenerator2D;
+
+	struct FImpl; // defined in DrunkardWalkGenerator2D.cpp
+	TUniquePtr<FImpl> Impl;
+};
+
 UCLASS()
 class PROCEDURALGEOMETRY_API UDrunkardWalkGenerator2D final : public ULayoutGenerator
 {
@@ -66,8 +187,13 @@ class PROCEDURALGEOMETRY_API UDrunkardWalkGenerator2D final : public ULayoutGene
 	int32					MaxPlacementAttemptsPerExit;
 	bool					bShuffleRoomOrder;
 	float					BranchProbability;
+	bool					bMergeFloorRectangles;
+	int32					PlacementWorkers; // 0 = one per task-graph worker plus the calling thread
 
 public:
+	/** Bump whenever a change alters the output for identical inputs; cached layouts from older versions are then ignored. */
+	static constexpr uint32 CacheAlgorithmVersion = 2;
+
 	UDrunkardWalkGenerator2D();
 
 	// Covariant base class overrides
@@ -102,23 +228,73 @@ public:
 	/** Sets the probability [0,1] that a room grows from a random earlier room instead of the most recent (branching). */
 	UDrunkardWalkGenerator2D* SetBranchProbability(float InProbability);
 
+	/** When true, the diagram merges floor cells into maximal rectangles (one per room, plus corridor runs). */
+	UDrunkardWalkGenerator2D* SetMergeFloorRectangles(bool bInMerge);
+
+	/**
+	 * Sets how many placement attempts per exit are traced concurrently (0 = one per task-graph worker plus the calling
+	 * thread). Each attempt draws from its own sub-stream and the lowest-index success wins, so the layout is the same
+	 * for any value.
+	 */
+	UDrunkardWalkGenerator2D* SetPlacementWorkers(int32 InWorkers);
+
 	/** Applies a fully resolved parameter set in one call. */
 	UDrunkardWalkGenerator2D* ApplyResolvedParams(const FDrunkardWalkResolvedParams& Params);
 
 	// Generation
 	virtual FLayoutDiagram2D Generate() override;
 
+	/** Same layout as Generate(), converted straight from the grid into compact form (no per-cell diagram). */
+	virtual FLayoutDiagramCompact GenerateCompact() override;
+
 	/** Returns full intermediate grid data including placed rooms and regions. For visualization/testing only. */
 	FDrunkardWalkGridData GenerateWithGridData();
 
+	/**
+	 * Same output as Generate(), GenerateCompact() and GenerateWithGridData(), written into an existing result. The
+	 * result's arrays and the scratch buffers are reused, so once they have grown to a layout's size, regenerating
+	 * same-sized layouts (editor drag ticks, seed farms) allocates no grid, region or diagram containers. With
+	 * pg.LayoutCache on, the result is replaced by the cached copy, which does allocate.
+	 */
+	void Generate(FLayoutDiagram2D& OutDiagram, FDrunkardWalkScratch& Scratch);
+	void GenerateCompact(FLayoutDiagramCompact& OutCompact, FDrunkardWalkScratch& Scratch);
+	void GenerateWithGridData(FDrunkardWalkGridData& OutGridData, FDrunkardWalkScratch& Scratch);
+
+	/**
+	 * Runs only the walk and returns the room/corridor graph. Skips rasterization, wall classification, flood fill and
+	 * diagram conversion entirely; for logic that never needs geometry. Same seed and config => same rooms and corridors
+	 * as GenerateWithGridData().
+	 */
+	FDungeonGraph2D GenerateGraph();
+
+	/**
+	 * Runs the walk and rasterizes it into sparse tiles (wall classification and flood fill per tile) instead of one
+	 * bounding-box grid. No diagram is built. The cell budget applies to the populated area, so long, sprawling walks
+	 * keep full resolution where the dense path would degrade.
+	 */
+	FDrunkardWalkTiledGridData GenerateTiled();
+
 private:
-	/** Core generation pipeline shared by Generate() and GenerateWithGridData(). */
-	FDrunkardWalkGridData GenerateInternal();
+	/**
+	 * Core generation pipeline shared by Generate(), GenerateWithGridData() and GenerateGraph(); fills Result in place.
+	 * When OutGraphOnly is set the pipeline stops after the walk: it fills the graph and leaves an empty grid result.
+	 * When OutTiled is set the walk is rasterized into OutTiled instead, and the grid result is left empty.
+	 * When OutCompact is set the diagram is written there instead of into the result's Diagram (merged rectangles are
+	 * still built in the result's Diagram first, then flattened).
+	 */
+	void GenerateInternal(FDrunkardWalkGridData& Result,
+		FDrunkardWalkScratch&					 Scratch,
+		FDungeonGraph2D*						 OutGraphOnly = nullptr,
+		FDrunkardWalkTiledGridData*				 OutTiled = nullptr,
+		FLayoutDiagramCompact*					 OutCompact = nullptr);
+
+	/** Layout cache key of the current configuration for the given output kind. PlacementWorkers is left out: it never changes the layout. */
+	FString MakeCacheKey(const TCHAR* Output) const;
 
 	/**
 	 * Expands RoomTypes into a flat queue of type indices (one entry per room, count = Weight) and
 	 * optionally shuffles it with Fisher-Yates so the placement order varies per seed.
 	 * Extracted so it can be verified in isolation from the full walk pipeline.
 	 */
-	static TArray<int32> BuildRoomQueue(const TArray<FRoomTypeConfig>& RoomTypes, bool bShuffle, FRandomStream& RandomStream);
+	static void BuildRoomQueue(const TArray<FRoomTypeConfig>& RoomTypes, bool bShuffle, FRandomStream& RandomStream, TArray<int32>& OutQueue);
 };
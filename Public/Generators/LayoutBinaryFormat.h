@@ -0,0 +1,257 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
+#include "Generators/LayoutDiagramCompact.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Versioned little-endian binary container for generated layouts.
+ *
+ *   [Header 32B][Section table: NumSections x 32B][payloads, each 16-byte aligned]
+ *
+ * Every section is a tagged array: raw POD elements, or a bit-packed grid (1 or 2 bits per cell, LSB first).
+ * Nested arrays and adjacency are stored as CSR pairs (offsets + items). Payload offsets are aligned, so a reader
+ * over a memory-mapped file hands out typed views straight into the mapping; nothing is parsed or copied until a
+ * caller asks for a full struct.
+ *
+ * Compressed containers (for save games and replication) additionally code grids as row runs and point lists as
+ * deltas (see FLayoutGridCodec); those sections are decoded on read and have no in-place view.
+ *
+ * Full diagrams (FLayoutDiagram2D, alone or inside grid data) also store their GridLookup when they have one, so a
+ * grid diagram read back answers FindCellAt in O(1) like the one that was written. Compact diagrams have no lookup.
+ */
+namespace PGLayoutBinary
+{
+	constexpr uint32 Magic = 0x424C4750; // "PGLB"
+	constexpr uint16 Version = 3; // 2: RowRuns and PointDeltas encodings; 3: grid lookup sections
+	constexpr uint32 PayloadAlignment = 16;
+
+	constexpr uint32 MakeTag(const char (&Name)[5])
+	{
+		return static_cast<uint32>(Name[0]) | (static_cast<uint32>(Name[1]) << 8) | (static_cast<uint32>(Name[2]) << 16)
+			| (static_cast<uint32>(Name[3]) << 24);
+	}
+
+	enum class EPayloadKind : uint32
+	{
+		Diagram = 1,
+		CellularAutomata = 2,
+		DrunkardWalk = 3,
+	};
+
+	enum class EEncoding : uint16
+	{
+		Raw = 0,		 // Count elements of ElementSize bytes
+		Bits1 = 1,		 // Count cells, 1 bit each
+		Bits2 = 2,		 // Count cells, 2 bits each (values 0..3)
+		RowRuns = 3,	 // Count grid cells of ElementSize bytes, as FLayoutGridCodec grid runs
+		PointDeltas = 4, // Count FIntPoints, as FLayoutGridCodec point deltas
+	};
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint16 HeaderSize;
+		uint32 Kind; // EPayloadKind
+		uint32 NumSections;
+		uint64 FileSize;
+		uint32 TableCrc; // CRC32 of the section table
+		uint32 Reserved;
+	};
+	static_assert(sizeof(FHeader) == 32, "FHeader layout is part of the file format");
+
+	struct FSection
+	{
+		uint32 Tag;
+		uint16 Encoding; // EEncoding
+		uint16 ElementSize;
+		uint32 Count;
+		uint32 Crc; // CRC32 of the payload bytes
+		uint64 Offset;
+		uint64 Size;
+	};
+	static_assert(sizeof(FSection) == 32, "FSection layout is part of the file format");
+} // namespace PGLayoutBinary
+
+/** Builds one container in memory. Sections are written in the order they are added. */
+class PROCEDURALGEOMETRY_API FLayoutBinaryWriter
+{
+public:
+	/** With bInCompressGrids, the AddGrid*() and AddNested() sections use the compressed encodings where smaller. */
+	explicit FLayoutBinaryWriter(PGLayoutBinary::EPayloadKind InKind, bool bInCompressGrids = false)
+		: Kind(InKind), bCompressGrids(bInCompressGrids)
+	{
+	}
+
+	template <typename ElementType>
+	void AddArray(uint32 Tag, TArrayView<const ElementType> Items)
+	{
+		static_assert(TIsTriviallyCopyable<ElementType>::Value, "Raw sections hold trivially copyable elements only");
+		AddRaw(Tag, Items.GetData(), sizeof(ElementType), Items.Num());
+	}
+
+	/** Packs Cells at 1 bit each. */
+	void AddBits(uint32 Tag, const TArray<bool>& Cells);
+
+	/** Packs Values at 2 bits each; every value must be < 4. */
+	void AddBits2(uint32 Tag, const TArray<uint8>& Values);
+
+	/** Row-major grids of the given width: bit-packed (raw for int32) or, when compressing, row runs if smaller. */
+	void AddGridBits(uint32 Tag, const TArray<bool>& Cells, int32 Width);
+	void AddGridBits2(uint32 Tag, const TArray<uint8>& Values, int32 Width);
+	void AddGridInt32(uint32 Tag, const TArray<int32>& Values, int32 Width);
+
+	void AddString(uint32 Tag, const FString& Value);
+
+	/** Nested point lists as CSR: OffsetsTag holds Lists.Num() + 1 offsets into the flat ItemsTag array. */
+	void AddNested(uint32 OffsetsTag, uint32 ItemsTag, const TArray<TArray<FIntPoint>>& Lists);
+
+	PGLayoutBinary::EPayloadKind GetKind() const { return Kind; }
+
+	/** Assembles header, section table and aligned payloads. */
+	TArray<uint8> Finish() const;
+
+private:
+	struct FPendingSection
+	{
+		PGLayoutBinary::FSection Section;
+		TArray<uint8>			 Bytes;
+	};
+
+	void AddRaw(uint32 Tag, const void* Data, int32 ElementSize, int32 Count);
+	void AddEncoded(uint32 Tag, PGLayoutBinary::EEncoding Encoding, int32 ElementSize, int32 Count, TArray<uint8>&& Bytes);
+
+	PGLayoutBinary::EPayloadKind Kind;
+	bool						 bCompressGrids;
+	TArray<FPendingSection>		 Sections;
+};
+
+/**
+ * Validating reader over a container held in memory or memory-mapped from disk. Open*() checks the header, the
+ * section table and every section's bounds, alignment and encoding size, and optionally each payload's CRC; after
+ * that, section access cannot read out of bounds.
+ */
+class PROCEDURALGEOMETRY_API FLayoutBinaryReader
+{
+public:
+	~FLayoutBinaryReader();
+
+	/** Memory-maps Path (falls back to loading it when mapping is unsupported). Returns nullptr if invalid. */
+	static TUniquePtr<FLayoutBinaryReader> OpenFile(const FString& Path, bool bVerifyChecksums = true, FString* OutError = nullptr);
+
+	/** Reads over caller-owned bytes, which must outlive the reader. Returns nullptr if invalid. */
+	static TUniquePtr<FLayoutBinaryReader> OpenBytes(TArrayView<const uint8> Bytes, bool bVerifyChecksums = true, FString* OutError = nullptr);
+
+	PGLayoutBinary::EPayloadKind GetKind() const { return static_cast<PGLayoutBinary::EPayloadKind>(Header().Kind); }
+	bool						 IsMemoryMapped() const { return MappedRegion != nullptr; }
+
+	const PGLayoutBinary::FSection* FindSection(uint32 Tag) const;
+
+	/** In-place view of a raw section, or an empty view if the section is missing or holds other elements. */
+	template <typename ElementType>
+	TArrayView<const ElementType> GetArray(uint32 Tag) const
+	{
+		const PGLayoutBinary::FSection* Section = FindSection(Tag);
+		if (!Section || Section->Encoding != static_cast<uint16>(PGLayoutBinary::EEncoding::Raw) || Section->ElementSize != sizeof(ElementType))
+		{
+			return TArrayView<const ElementType>();
+		}
+		return TArrayView<const ElementType>(reinterpret_cast<const ElementType*>(Data.GetData() + Section->Offset), Section->Count);
+	}
+
+	/** Copies a raw section into Out. False if missing or mismatched. */
+	template <typename ElementType>
+	bool ReadArray(uint32 Tag, TArray<ElementType>& Out) const
+	{
+		const PGLayoutBinary::FSection* Section = FindSection(Tag);
+		const TArrayView<const ElementType> View = GetArray<ElementType>(Tag);
+		if (!Section || View.Num() != static_cast<int32>(Section->Count))
+		{
+			return false;
+		}
+		Out = TArray<ElementType>(View);
+		return true;
+	}
+
+	/**
+	 * Unpacks a 1-bit (to bool) or 2-bit (to uint8) grid section, bit-packed or row runs. ExpectedCount comes from data
+	 * already checked (the grid meta, the cell count); a section holding any other count is rejected before decoding.
+	 */
+	bool ReadBits(uint32 Tag, int32 ExpectedCount, TArray<bool>& Out) const;
+	bool ReadBits2(uint32 Tag, int32 ExpectedCount, TArray<uint8>& Out) const;
+
+	/** Reads an int32 grid section of ExpectedCount cells, raw or row runs. */
+	bool ReadGridInt32(uint32 Tag, int32 ExpectedCount, TArray<int32>& Out) const;
+
+	bool ReadString(uint32 Tag, FString& Out) const;
+	bool ReadNested(uint32 OffsetsTag, uint32 ItemsTag, TArray<TArray<FIntPoint>>& Out) const;
+
+private:
+	FLayoutBinaryReader() = default;
+
+	bool Validate(bool bVerifyChecksums, FString& OutError);
+
+	TArrayView<const uint8> Payload(const PGLayoutBinary::FSection& Section) const
+	{
+		return TArrayView<const uint8>(Data.GetData() + Section.Offset, static_cast<int32>(Section.Size));
+	}
+
+	const PGLayoutBinary::FHeader& Header() const { return *reinterpret_cast<const PGLayoutBinary::FHeader*>(Data.GetData()); }
+
+	TArrayView<const PGLayoutBinary::FSection> Table() const
+	{
+		return TArrayView<const PGLayoutBinary::FSection>(
+			reinterpret_cast<const PGLayoutBinary::FSection*>(Data.GetData() + sizeof(PGLayoutBinary::FHeader)), Header().NumSections);
+	}
+
+	TArrayView<const uint8> Data;
+	TArray<uint8>			OwnedBytes; // file contents when mapping was unavailable
+	IMappedFileHandle*		MappedHandle = nullptr;
+	IMappedFileRegion*		MappedRegion = nullptr;
+};
+
+/** Writes and reads whole layout structs in the binary container. Read*() returns false on a kind or section mismatch. */
+class PROCEDURALGEOMETRY_API FLayoutBinaryFormat
+{
+public:
+	template <typename LayoutType>
+	static TArray<uint8> Write(const LayoutType& Layout)
+	{
+		FLayoutBinaryWriter Writer(GetKind(Layout));
+		AddSections(Writer, Layout);
+		return Writer.Finish();
+	}
+
+	/** Write() with grids and point lists compressed; smaller, but read by decoding rather than in place. */
+	template <typename LayoutType>
+	static TArray<uint8> WriteCompressed(const LayoutType& Layout)
+	{
+		FLayoutBinaryWriter Writer(GetKind(Layout), /*bInCompressGrids=*/true);
+		AddSections(Writer, Layout);
+		return Writer.Finish();
+	}
+
+	/** Payload kind of each struct, for callers that build a container with AddSections() plus sections of their own. */
+	static PGLayoutBinary::EPayloadKind GetKind(const FLayoutDiagramCompact&) { return PGLayoutBinary::EPayloadKind::Diagram; }
+	static PGLayoutBinary::EPayloadKind GetKind(const FLayoutDiagram2D&) { return PGLayoutBinary::EPayloadKind::Diagram; }
+	static PGLayoutBinary::EPayloadKind GetKind(const FCellularAutomataGridData&) { return PGLayoutBinary::EPayloadKind::CellularAutomata; }
+	static PGLayoutBinary::EPayloadKind GetKind(const FDrunkardWalkGridData&) { return PGLayoutBinary::EPayloadKind::DrunkardWalk; }
+
+	/** Adds the struct's sections to a writer created with its GetKind(). Their tags are upper-case; use others for extras. */
+	static void AddSections(FLayoutBinaryWriter& Writer, const FLayoutDiagramCompact& Diagram);
+	static void AddSections(FLayoutBinaryWriter& Writer, const FLayoutDiagram2D& Diagram);
+	static void AddSections(FLayoutBinaryWriter& Writer, const FCellularAutomataGridData& Data);
+	static void AddSections(FLayoutBinaryWriter& Writer, const FDrunkardWalkGridData& Data);
+
+	static bool Read(const FLayoutBinaryReader& Reader, FLayoutDiagramCompact& OutDiagram);
+	static bool Read(const FLayoutBinaryReader& Reader, FLayoutDiagram2D& OutDiagram);
+	static bool Read(const FLayoutBinaryReader& Reader, FCellularAutomataGridData& OutData);
+	static bool Read(const FLayoutBinaryReader& Reader, FDrunkardWalkGridData& OutData);
+
+	static bool SaveToFile(const TArray<uint8>& Bytes, const FString& Path);
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generators/LayoutBinaryFormat.h"
+#include "Misc/SecureHash.h"
+
+/**
+ * Content address of one generation: a SHA-1 over everything that determines the output. Generators feed in their
+ * type, algorithm version and output kind, then every resolved parameter, the bounds, grid size, seed string and the
+ * current random stream state. Values are hashed by their bytes, so keys are stable across runs on one platform.
+ */
+class PROCEDURALGEOMETRY_API FLayoutCacheKey
+{
+public:
+	/** Also folds in the binary format version, so format changes invalidate old entries. */
+	FLayoutCacheKey(const TCHAR* GeneratorType, uint32 AlgorithmVersion, const TCHAR* Output);
+
+	FLayoutCacheKey& Add(int32 Value) { return AddBytes(&Value, sizeof(Value)); }
+	FLayoutCacheKey& Add(uint32 Value) { return AddBytes(&Value, sizeof(Value)); }
+	FLayoutCacheKey& Add(float Value) { return AddBytes(&Value, sizeof(Value)); }
+	FLayoutCacheKey& Add(double Value) { return AddBytes(&Value, sizeof(Value)); }
+	FLayoutCacheKey& Add(bool bValue) { return Add(static_cast<int32>(bValue)); }
+	FLayoutCacheKey& Add(const FVector2D& Value) { return Add(Value.X).Add(Value.Y); }
+	FLayoutCacheKey& Add(const FBox2D& Value) { return Add(Value.Min).Add(Value.Max).Add(static_cast<bool>(Value.bIsValid)); }
+
+	/** Length-prefixed UTF-8, case-sensitive. */
+	FLayoutCacheKey& Add(const FString& Value);
+	FLayoutCacheKey& Add(FName Value) { return Add(Value.ToString()); }
+
+	FLayoutCacheKey& Add(const TArray<int32>& Values)
+	{
+		Add(Values.Num());
+		return AddBytes(Values.GetData(), Values.Num() * sizeof(int32));
+	}
+
+	/** 40 hex digits; the key is complete after this call. */
+	FString ToString();
+
+private:
+	FLayoutCacheKey& AddBytes(const void* Data, int64 Size);
+
+	FSHA1 Hash;
+};
+
+struct PROCEDURALGEOMETRY_API FLayoutCacheStats
+{
+	int32 Hits = 0;
+	int32 Misses = 0;
+	int32 Evictions = 0;
+	int32 Entries = 0;
+	int64 TotalBytes = 0;
+};
+
+/**
+ * Content-addressed on-disk cache of generated layouts. Each entry is one binary layout file named by its key, so
+ * identical generations (an editor OnConstruction refresh, a dedicated server restart) load instead of regenerating.
+ * The directory is capped at pg.LayoutCache.MaxSizeMB; the least recently used entries are evicted first, with file
+ * timestamps carrying recency across sessions.
+ *
+ * Off unless pg.LayoutCache is 1 (e.g. in the [SystemSettings] section of DefaultEngine.ini). Safe to use from
+ * several threads; concurrent processes sharing the directory only ever see complete files.
+ */
+class PROCEDURALGEOMETRY_API FLayoutGenerationCache
+{
+public:
+	static FLayoutGenerationCache& Get();
+
+	/** Value of pg.LayoutCache. */
+	static bool IsEnabled();
+
+	/** Defaults to <ProjectSaved>/LayoutCache. Changing it drops the in-memory index. */
+	void	SetDirectory(const FString& InDirectory);
+	FString GetDirectory() const;
+
+	/** Overrides pg.LayoutCache.MaxSizeMB (negative restores it) and evicts down to the new cap right away. */
+	void SetMaxBytes(int64 InMaxBytes);
+
+	/**
+	 * Returns the cached layout for the key from MakeKey(), or runs Generate() and stores its result. The random stream
+	 * is left in the state Generate() would leave it in, so later draws match an uncached run. Only Generate() is called
+	 * when the cache is disabled.
+	 */
+	template <typename LayoutType, typename KeyFuncType, typename GenerateFuncType>
+	LayoutType FindOrGenerate(FRandomStream& Stream, KeyFuncType&& MakeKey, GenerateFuncType&& Generate)
+	{
+		if (!IsEnabled())
+		{
+			return Generate();
+		}
+
+		const FString Key = MakeKey();
+		LayoutType	  Layout;
+		if (Load(Key, Stream, Layout))
+		{
+			return Layout;
+		}
+		Layout = Generate();
+		Store(Key, Stream, Layout);
+		return Layout;
+	}
+
+	/** Deletes every entry. */
+	void Clear();
+
+	FLayoutCacheStats GetStats() const;
+
+private:
+	template <typename LayoutType>
+	bool Load(const FString& Key, FRandomStream& Stream, LayoutType& OutLayout)
+	{
+		const TUniquePtr<FLayoutBinaryReader> Reader = Open(Key);
+		if (!Reader)
+		{
+			return false;
+		}
+		const TArrayView<const int32> StreamState = Reader->GetArray<int32>(PGLayoutBinary::MakeTag("rngs"));
+		if (StreamState.Num() != 1 || !FLayoutBinaryFormat::Read(*Reader, OutLayout))
+		{
+			Discard(Key);
+			return false;
+		}
+		Stream.Initialize(StreamState[0]);
+		return true;
+	}
+
+	template <typename LayoutType>
+	void Store(const FString& Key, const FRandomStream& Stream, const LayoutType& Layout)
+	{
+		FLayoutBinaryWriter Writer(FLayoutBinaryFormat::GetKind(Layout));
+		FLayoutBinaryFormat::AddSections(Writer, Layout);
+		const int32 StreamState = Stream.GetCurrentSeed();
+		Writer.AddArray<int32>(PGLayoutBinary::MakeTag("rngs"), MakeArrayView(&StreamState, 1));
+		StoreBytes(Key, Writer.Finish());
+	}
+
+	struct FEntry
+	{
+		int64 Size = 0;
+		int64 LastUse = 0; // UTC ticks
+	};
+
+	/** Reader over the entry for Key (and marks it used), or nullptr on a miss. */
+	TUniquePtr<FLayoutBinaryReader> Open(const FString& Key);
+	void							StoreBytes(const FString& Key, const TArray<uint8>& Bytes);
+
+	/** Removes an unreadable entry. */
+	void Discard(const FString& Key);
+
+	FString PathFor(const FString& Key) const;
+
+	int64 GetMaxBytes() const;
+
+	// Callers hold Lock.
+	void  EnsureIndexed();
+	void  EvictToFit(int64 MaxBytes);
+	int64 NextUseTick(); // strictly increasing, so entries used in the same tick still order
+
+	mutable FCriticalSection Lock;
+	FString					 Directory;
+	TMap<FString, FEntry>	 Entries;
+	int64					 TotalBytes = 0;
+	int64					 LastTick = 0;
+	int64					 MaxBytesOverride = -1;
+	bool					 bIndexed = false;
+	FLayoutCacheStats		 Stats;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutCellLocator.generated.h"
+
+/**
+ * World point -> cell index in O(1) for diagrams built from a regular grid: the grid frame (origin, cell size and
+ * dimensions) and, per grid cell, the index of the diagram cell covering it (INDEX_NONE for walls).
+ */
+USTRUCT()
+struct PROCEDURALGEOMETRY_API FLayoutGridLookup
+{
+	GENERATED_BODY()
+
+	/** World position of the grid's (0, 0) corner. */
+	UPROPERTY()
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	UPROPERTY()
+	double CellSize = 0.0;
+
+	UPROPERTY()
+	int32 Width = 0;
+
+	UPROPERTY()
+	int32 Height = 0;
+
+	/** Row-major, Width * Height entries. */
+	UPROPERTY()
+	TArray<int32> GridToCellIndex;
+
+	bool IsValid() const { return CellSize > 0.0 && Width > 0 && Height > 0 && GridToCellIndex.Num() == Width * Height; }
+
+	/** Clears the mapping, keeping its memory. */
+	void Reset();
+
+	/** The diagram cell covering WorldPos, or INDEX_NONE (a wall, or outside the grid). */
+	int32 FindCellAt(const FVector2D& WorldPos) const
+	{
+		const double GX = FMath::FloorToDouble((WorldPos.X - Origin.X) / CellSize);
+		const double GY = FMath::FloorToDouble((WorldPos.Y - Origin.Y) / CellSize);
+		if (GX < 0.0 || GY < 0.0 || GX >= Width || GY >= Height)
+		{
+			return INDEX_NONE;
+		}
+		return GridToCellIndex[static_cast<int32>(GY) * Width + static_cast<int32>(GX)];
+	}
+};
+
+/**
+ * Bounding volume hierarchy over cell bounds, for point queries on polygon diagrams that are not grid-aligned. Nodes
+ * are stored flat: an inner node's children are nodes NodeStart and NodeStart + 1; a leaf holds CellOrder entries
+ * [NodeStart, NodeStart + NodeCount).
+ */
+USTRUCT()
+struct PROCEDURALGEOMETRY_API FLayoutCellBVH
+{
+	GENERATED_BODY()
+
+	static constexpr int32 MaxLeafCells = 4;
+
+	UPROPERTY()
+	TArray<FBox2D> NodeBounds;
+
+	UPROPERTY()
+	TArray<int32> NodeStart;
+
+	/** 0 for inner nodes. */
+	UPROPERTY()
+	TArray<int32> NodeCount;
+
+	UPROPERTY()
+	TArray<int32> CellOrder;
+
+	bool IsValid() const { return NodeBounds.Num() > 0; }
+
+	/** Clears the hierarchy, keeping its memory. */
+	void Reset();
+
+	/** Builds over CellBounds (invalid boxes are left out), splitting at the median center on the longer axis. */
+	void Build(TArrayView<const FBox2D> CellBounds);
+
+	/** First cell, in tree order, whose bounds contain Point and for which Contains(CellIndex) holds; else INDEX_NONE. */
+	template <typename PredicateType>
+	int32 FindFirst(const FVector2D& Point, PredicateType&& Contains) const
+	{
+		if (!IsValid())
+		{
+			return INDEX_NONE;
+		}
+
+		// Median splits keep the depth near log2(cells / MaxLeafCells), so the stack never gets close to this.
+		constexpr int32 MaxStack = 64;
+		int32			Stack[MaxStack];
+		int32			StackSize = 0;
+		Stack[StackSize++] = 0;
+		while (StackSize > 0)
+		{
+			const int32	  Node = Stack[--StackSize];
+			const FBox2D& Box = NodeBounds[Node];
+			if (Point.X < Box.Min.X || Point.X > Box.Max.X || Point.Y < Box.Min.Y || Point.Y > Box.Max.Y)
+			{
+				continue;
+			}
+			if (NodeCount[Node] == 0)
+			{
+				check(StackSize + 2 <= MaxStack);
+				Stack[StackSize++] = NodeStart[Node] + 1;
+				Stack[StackSize++] = NodeStart[Node];
+				continue;
+			}
+			for (int32 i = NodeStart[Node]; i < NodeStart[Node] + NodeCount[Node]; ++i)
+			{
+				if (Contains(CellOrder[i]))
+				{
+					return CellOrder[i];
+				}
+			}
+		}
+		return INDEX_NONE;
+	}
+};
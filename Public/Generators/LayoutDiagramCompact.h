@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generators/LayoutGenerator.h"
+
+struct FLayoutDiagramCompact;
+
+/**
+ * Read-only view of one cell of an FLayoutDiagramCompact. Field names mirror FLayoutCell2D, so read-only code written
+ * against FLayoutCell2D (Cell.Vertices, Cell.Neighbors, Cell.Center, ...) compiles unchanged against a view.
+ * Holds spans into the compact arrays; copying a view never allocates.
+ */
+struct FLayoutCellView
+{
+	TArrayView<const FVector2D> Vertices;
+	TArrayView<const int32>		Neighbors;
+	FVector2D					Center = FVector2D::ZeroVector;
+	int32						CellIndex = INDEX_NONE;
+	bool						bIsExterior = false;
+};
+
+/**
+ * Flat (SoA/CSR) form of FLayoutDiagram2D for diagrams with many cells. Cell i owns
+ * Vertices[VertexOffsets[i], VertexOffsets[i + 1]) and Neighbors[NeighborOffsets[i], NeighborOffsets[i + 1]);
+ * centers are packed and the exterior flags are a bitset. Compared to one FLayoutCell2D per cell this drops two
+ * heap allocations and the reflected struct per cell.
+ */
+struct PROCEDURALGEOMETRY_API FLayoutDiagramCompact
+{
+	TArray<FVector2D> Vertices;
+	TArray<int32>	  VertexOffsets;   // NumCells + 1 entries
+	TArray<int32>	  Neighbors;
+	TArray<int32>	  NeighborOffsets; // NumCells + 1 entries
+	TArray<FVector2D> Centers;		   // one per cell
+	TBitArray<>		  ExteriorBits;	   // one bit per cell
+	FBox2D			  Bounds = FBox2D(ForceInit);
+	FVector2D		  CenterPoint = FVector2D::ZeroVector;
+	int32			  CenterCellIndex = INDEX_NONE;
+	FString			  Seed;
+
+	FLayoutDiagramCompact() { Reset(); }
+
+	int32 Num() const { return Centers.Num(); }
+
+	/** Clears all cells, leaving the offset arrays holding their leading 0. */
+	void Reset();
+
+	/** Reserves capacity for NumCells cells with NumVertices vertices and NumNeighbors neighbor entries in total. */
+	void Reserve(int32 NumCells, int32 NumVertices, int32 NumNeighbors);
+
+	/**
+	 * Appends a cell with its vertices and returns its index. Neighbor lists are CSR, so they are appended separately,
+	 * in cell order: call AddNeighbor() for cell i, then FinishNeighbors() once, before starting cell i + 1.
+	 */
+	int32 AddCell(TArrayView<const FVector2D> CellVertices, const FVector2D& Center, bool bIsExterior);
+	void  AddNeighbor(int32 NeighborIndex) { Neighbors.Add(NeighborIndex); }
+	void  FinishNeighbors() { NeighborOffsets.Add(Neighbors.Num()); }
+
+	TArrayView<const FVector2D> GetVertices(int32 CellIndex) const
+	{
+		return TArrayView<const FVector2D>(Vertices.GetData() + VertexOffsets[CellIndex], VertexOffsets[CellIndex + 1] - VertexOffsets[CellIndex]);
+	}
+
+	TArrayView<const int32> GetNeighbors(int32 CellIndex) const
+	{
+		return TArrayView<const int32>(
+			Neighbors.GetData() + NeighborOffsets[CellIndex], NeighborOffsets[CellIndex + 1] - NeighborOffsets[CellIndex]);
+	}
+
+	bool IsExterior(int32 CellIndex) const { return ExteriorBits[CellIndex]; }
+
+	FLayoutCellView GetCell(int32 CellIndex) const
+	{
+		FLayoutCellView View;
+		View.Vertices = GetVertices(CellIndex);
+		View.Neighbors = GetNeighbors(CellIndex);
+		View.Center = Centers[CellIndex];
+		View.CellIndex = CellIndex;
+		View.bIsExterior = IsExterior(CellIndex);
+		return View;
+	}
+
+	/** Range over all cells as views: for (const FLayoutCellView Cell : Compact.GetCells()). */
+	struct FCellIterator
+	{
+		const FLayoutDiagramCompact* Diagram;
+		int32						 CellIndex;
+
+		FLayoutCellView operator*() const { return Diagram->GetCell(CellIndex); }
+		FCellIterator&	operator++()
+		{
+			++CellIndex;
+			return *this;
+		}
+		bool operator!=(const FCellIterator& Other) const { return CellIndex != Other.CellIndex; }
+	};
+
+	struct FCellRange
+	{
+		const FLayoutDiagramCompact* Diagram;
+
+		FCellIterator begin() const { return { Diagram, 0 }; }
+		FCellIterator end() const { return { Diagram, Diagram->Num() }; }
+	};
+
+	FCellRange GetCells() const { return { this }; }
+
+	/** Flattens a per-cell diagram (cell order and indices preserved). */
+	static FLayoutDiagramCompact FromDiagram(const FLayoutDiagram2D& Diagram);
+
+	/** FromDiagram into an existing compact diagram, reusing its arrays. */
+	static void FromDiagram(const FLayoutDiagram2D& Diagram, FLayoutDiagramCompact& OutCompact);
+
+	/** Expands back into per-cell form, for consumers that need FLayoutDiagram2D. */
+	FLayoutDiagram2D ToDiagram() const;
+
+	/** Heap bytes held by the arrays. */
+	SIZE_T GetAllocatedSize() const;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
+#include "Generators/LayoutDiagramCompact.h"
+#include "Generators/Voronoi2D/VoronoiGenerator2D.h"
+#include "Hash/xxhash.h"
+
+/**
+ * 64-bit fingerprint of generated output (XXH3 over a canonical stream), for determinism checks — serial against
+ * parallel, before against after a refactor — and for keying caches of derived data. Arrays are hashed by length and
+ * elements, never by capacity, padding or allocation. Floats are quantised first: rounded to a multiple of Quantum
+ * world units, so float noise well below the step (a reordered sum, FMA contraction) does not change the result.
+ *
+ * Only the output itself is hashed: derived acceleration data (GridLookup, CellBVH, PathFields, TileLookup) is left
+ * out. FLayoutDiagram2D and FLayoutDiagramCompact feed the same stream, so a compact diagram fingerprints like the
+ * full diagram it was flattened from.
+ */
+class PROCEDURALGEOMETRY_API FLayoutFingerprint
+{
+public:
+	/** 1/1024 world units: far below any cell size, far above float noise at layout coordinates. */
+	static constexpr double DefaultQuantum = 1.0 / 1024.0;
+
+	explicit FLayoutFingerprint(double InQuantum = DefaultQuantum);
+
+	template <typename LayoutType>
+	static uint64 Of(const LayoutType& Layout, double Quantum = DefaultQuantum)
+	{
+		return FLayoutFingerprint(Quantum).Add(Layout).Get();
+	}
+
+	/** 16 hex digits. */
+	static FString ToString(uint64 Fingerprint) { return FString::Printf(TEXT("%016llx"), Fingerprint); }
+
+	FLayoutFingerprint& Add(uint8 Value) { return AddBytes(&Value, sizeof(Value)); }
+	FLayoutFingerprint& Add(int32 Value) { return AddBytes(&Value, sizeof(Value)); }
+	FLayoutFingerprint& Add(uint32 Value) { return AddBytes(&Value, sizeof(Value)); }
+	FLayoutFingerprint& Add(int64 Value) { return AddBytes(&Value, sizeof(Value)); }
+	FLayoutFingerprint& Add(bool bValue) { return Add(static_cast<uint8>(bValue)); }
+
+	/** Quantised to the nearest multiple of Quantum (halves away from zero); NaN and infinities hash as fixed codes. */
+	FLayoutFingerprint& Add(double Value);
+	FLayoutFingerprint& Add(float Value) { return Add(static_cast<double>(Value)); }
+
+	FLayoutFingerprint& Add(const FVector2D& Value) { return Add(Value.X).Add(Value.Y); }
+	FLayoutFingerprint& Add(const FIntPoint& Value) { return Add(Value.X).Add(Value.Y); }
+	FLayoutFingerprint& Add(const FBox2D& Value) { return Add(Value.Min).Add(Value.Max).Add(static_cast<bool>(Value.bIsValid)); }
+
+	/** Length-prefixed UTF-8, case-sensitive. */
+	FLayoutFingerprint& Add(const FString& Value);
+
+	/** Length, then each element; integer elements go in as one block. */
+	template <typename ElementType, typename AllocatorType>
+	FLayoutFingerprint& Add(const TArray<ElementType, AllocatorType>& Values)
+	{
+		return Add(TArrayView<const ElementType>(Values));
+	}
+
+	template <typename ElementType>
+	FLayoutFingerprint& Add(TArrayView<const ElementType> Values)
+	{
+		Add(Values.Num());
+		if constexpr (TIsIntegral<ElementType>::Value)
+		{
+			return AddBytes(Values.GetData(), Values.Num() * sizeof(ElementType));
+		}
+		else
+		{
+			for (const ElementType& Value : Values)
+			{
+				Add(Value);
+			}
+			return *this;
+		}
+	}
+
+	FLayoutFingerprint& Add(const FLayoutCell2D& Cell);
+	FLayoutFingerprint& Add(const FLayoutDiagram2D& Diagram);
+	FLayoutFingerprint& Add(const FLayoutDiagramCompact& Diagram);
+	FLayoutFingerprint& Add(const FVoronoiCell2D& Cell);
+	FLayoutFingerprint& Add(const FVoronoiDiagram2D& Diagram);
+	FLayoutFingerprint& Add(const FCellularAutomataRegionGraph& Graph);
+	FLayoutFingerprint& Add(const FCellularAutomataGridData& Data);
+	FLayoutFingerprint& Add(const FDrunkardWalkPlacedRoom& Room);
+	FLayoutFingerprint& Add(const FDungeonGraphCorridor& Corridor);
+	FLayoutFingerprint& Add(const FDungeonGraph2D& Graph);
+	FLayoutFingerprint& Add(const FDrunkardWalkGridData& Data);
+	FLayoutFingerprint& Add(const FDrunkardWalkTiledGridData::FTile& Tile);
+	FLayoutFingerprint& Add(const FDrunkardWalkTiledGridData& Data);
+
+	/** Fingerprint of everything added so far; more can be added afterwards. */
+	uint64 Get() const { return Hash.Finalize().Hash; }
+
+private:
+	FLayoutFingerprint& AddBytes(const void* Data, int64 Size);
+
+	/** One cell in the stream shared by the full and compact diagram forms. */
+	FLayoutFingerprint& AddCell(
+		TArrayView<const FVector2D> Vertices, TArrayView<const int32> Neighbors, const FVector2D& Center, int32 CellIndex, bool bIsExterior);
+
+	FXxHash64Builder Hash;
+	double			 InvQuantum;
+};
@@ -1,8 +1,13 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "Generators/LayoutCellLocator.h"
+#include "Generators/LayoutPathFields.h"
 #include "LayoutGenerator.generated.h"
 
+struct FLayoutDiagramCompact;
+class FLayoutCacheKey;
+
 USTRUCT()
 struct PROCEDURALGEOMETRY_API FLayoutCell2D
 {
@@ -45,6 +50,58 @@ struct PROCEDURALGEOMETRY_API FLayoutDiagram2D
 
 	UPROPERTY()
 	FString Seed;
+
+	/** Index of the cell containing WorldPos, or INDEX_NONE: through the grid lookup when there is one, else
+	 *  point-in-polygon tests on the cell BVH candidates. The first such query builds the BVH; call BuildCellBVH up front
+	 *  before querying one diagram from several threads. */
+	int32 FindCellAt(const FVector2D& WorldPos) const;
+
+	/** FindCellAt for each of WorldPositions into OutCells (resized to match). */
+	void FindCellsAt(TArrayView<const FVector2D> WorldPositions, TArray<int32>& OutCells, bool bParallel = false) const;
+
+	/** Set for diagrams built from a grid (one cell per grid cell, or merged rectangles), else null; FindCellAt is O(1)
+	 *  then. */
+	const FLayoutGridLookup* GetGridLookup() const { return GridLookup.IsValid() && GridLookup->IsValid() ? GridLookup.Get() : nullptr; }
+
+	/** The lookup for a grid builder to fill, cleared: the diagram's own one keeps its memory, one shared with a copy
+	 *  is left to the copy. */
+	FLayoutGridLookup& WriteGridLookup();
+
+	void ResetGridLookup() { GridLookup.Reset(); }
+
+	/** Hierarchy over cell bounds for polygon diagrams, or null until the first point query (or BuildCellBVH). */
+	const FLayoutCellBVH* GetCellBVH() const { return CellBVH.Get(); }
+
+	/** (Re)builds the cell BVH over the cells' vertex bounds. Call after editing cells. */
+	void BuildCellBVH();
+
+	void ResetCellBVH() { CellBVH.Reset(); }
+
+	/** Distance and path fields over the Neighbors graph, or null until requested: by the generators' post-pass
+	 *  (ULayoutGenerator::SetPathFields) or BuildPathFields. */
+	const FLayoutPathFields* GetPathFields() const { return PathFields.Get(); }
+
+	/** Computes the fields on demand (see FLayoutPathFields::Build), reusing the arrays of fields no copy shares. */
+	const FLayoutPathFields& BuildPathFields(int32 MaxNextHopTableCells = 0, int32 SourceCell = INDEX_NONE);
+
+	/** Drops the fields. */
+	void ResetPathFields() { PathFields.Reset(); }
+
+private:
+	/** The cell BVH, built first if missing. */
+	const FLayoutCellBVH& FindOrBuildCellBVH() const;
+
+	// Acceleration data derived from the cells. Not UPROPERTYs, so never serialized; copies of the diagram share it
+	// instead of duplicating it.
+
+	/** Written by the grid builders, which number the grid cells anyway; the binary format stores it alongside. */
+	TSharedPtr<FLayoutGridLookup> GridLookup;
+
+	/** Built lazily, on the first point query that needs it. */
+	mutable TSharedPtr<FLayoutCellBVH> CellBVH;
+
+	/** Not part of the binary format or the layout cache either: the next-hop table is O(N^2). */
+	TSharedPtr<FLayoutPathFields> PathFields;
 };
 
 UCLASS(Abstract)
@@ -67,6 +124,12 @@ protected:
 
 	FRandomStream RandomStream;
 
+	UPROPERTY()
+	bool bBuildPathFields = false;
+
+	UPROPERTY()
+	int32 MaxNextHopTableCells = 0;
+
 private:
 	bool bCenterSet = false;
 
@@ -78,15 +141,70 @@ public:
 	virtual ULayoutGenerator* SetSeed(const FString& InSeed);
 	virtual ULayoutGenerator* SetGridSize(int32 InSize);
 
+	/** The configured grid size; a run that degrades resolution to fit a cell budget reports its cell size in its output. */
+	int32 GetGridSize() const { return GridSize; }
+
+	/** Enables the path-field post-pass: every FLayoutDiagram2D the generator returns carries path fields from its
+	 *  center cell, with the all-pairs next-hop table when it has at most InMaxNextHopTableCells cells. */
+	virtual ULayoutGenerator* SetPathFields(bool bInBuild, int32 InMaxNextHopTableCells = 0);
+
 	virtual FLayoutDiagram2D Generate() PURE_VIRTUAL(ULayoutGenerator::Generate, return FLayoutDiagram2D(););
 
+	/** Generates straight into the flat CSR/SoA form (include LayoutDiagramCompact.h). The default flattens Generate();
+	 *  grid-based generators override it to skip the per-cell diagram entirely. */
+	virtual FLayoutDiagramCompact GenerateCompact();
+
+	/**
+	 * The grid-to-diagram conversion behind ConvertGridToDiagram for an explicit frame: grid cell (X, Y) spans
+	 * Origin + [X, X + 1) * CellSize. Fills the cells, GridLookup and the center cell (the one nearest
+	 * Diagram.CenterPoint); Bounds, Seed and CenterPoint are the caller's. Reuses the diagram's arrays.
+	 */
+	static void BuildGridDiagram(
+		const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight, const FVector2D& Origin, float CellSize, FLayoutDiagram2D& Diagram);
+
 protected:
+	/** Adds the inputs every generator shares (bounds, center, grid size, seed and random stream state) to a cache key. */
+	void AddCacheKeyInputs(FLayoutCacheKey& Key) const;
+
+	/** Post-pass run on every diagram handed out: the path fields when enabled (else they are dropped). */
+	void ApplyDiagramPostPasses(FLayoutDiagram2D& Diagram) const;
+
 	void			 InitializeRandomStream();
 	FVector2D		 ClampToBounds(const FVector2D& Point) const;
 	FLayoutDiagram2D ConvertGridToDiagram(const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight) const;
 
+	/** ConvertGridToDiagram into an existing diagram, reusing its cells' arrays and its GridLookup. */
+	void ConvertGridToDiagram(const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight, FLayoutDiagram2D& OutDiagram) const;
+
+	/** ConvertGridToDiagram written directly into compact form: same cells, order, neighbors and center cell. */
+	FLayoutDiagramCompact ConvertGridToCompact(const TArray<bool>& Grid, int32 GridWidth, int32 GridHeight) const;
+
+	/** ConvertGridToCompact into an existing compact diagram, reusing its arrays; GridToCellIndex is the caller's buffer
+	 *  for the grid cell numbering. */
+	void ConvertGridToCompact(const TArray<bool>& Grid,
+		int32									 GridWidth,
+		int32									 GridHeight,
+		FLayoutDiagramCompact&					 OutCompact,
+		TArray<int32>&							 GridToCellIndex) const;
+
+	/** Like ConvertGridToDiagram, but covers the floor with greedy maximal axis-aligned rectangles (one diagram cell each).
+	 *  Only cells with equal GroupIds merge, so callers can keep rooms and corridors apart. Neighbors are rectangles that
+	 *  share an edge segment. The center cell is the rectangle covering (CenterX, CenterY), else the one nearest CenterPoint. */
+	FLayoutDiagram2D ConvertGridToRectDiagram(
+		const TArray<bool>& Grid, const TArray<int32>& GroupIds, int32 GridWidth, int32 GridHeight, int32 CenterX, int32 CenterY) const;
+
+	/** ConvertGridToRectDiagram into an existing diagram, reusing its cells' arrays and its GridLookup. */
+	void ConvertGridToRectDiagram(const TArray<bool>& Grid,
+		const TArray<int32>&						  GroupIds,
+		int32										  GridWidth,
+		int32										  GridHeight,
+		int32										  CenterX,
+		int32										  CenterY,
+		FLayoutDiagram2D&							  OutDiagram) const;
+
 	/** BFS flood-fill over a boolean grid. Populates OutRegionIds and OutRegions, and identifies which
 	 *  region contains the cell (CenterX, CenterY) via OutCenterRegionId (-1 if that cell is a wall).
+	 *  The output arrays, including the per-region ones, keep their memory across calls.
 	 * Used by CA and DrunkardWalk generators. */
 	static void FloodFillRegions(const TArray<bool>& Grid,
 		int32										 GridWidth,
@@ -96,4 +214,17 @@ protected:
 		TArray<int32>&								 OutRegionIds,
 		TArray<TArray<FIntPoint>>&					 OutRegions,
 		int32&										 OutCenterRegionId);
+
+	/** Array.Init(Value, Num) that keeps the current allocation whenever it is large enough; Init() reallocates whenever
+	 *  the element count changes. */
+	template <typename ElementType>
+	static void InitReusing(TArray<ElementType>& Array, const ElementType& Value, int32 Num)
+	{
+		Array.Reset(Num);
+		Array.AddUninitialized(Num);
+		for (ElementType& Element : Array)
+		{
+			Element = Value;
+		}
+	}
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Compact encodings for per-cell grids and point lists, used by the binary layout format when writing compressed.
+ *
+ * Grids (floor masks, cell types, region ids) are coded row by row as runs. A run either copies N cells from the row
+ * above, which covers the long vertical edges of caves and rooms, or repeats one literal value N times. Tokens are
+ * LEB128 varints:
+ *   ((N - 1) << 1) | 1                           copy N cells from the row above (never in the first row)
+ *   ((N - 1) << 1) | 0, zigzag(Value - Previous)  N cells of Value; Previous is the last literal value (initially 0)
+ * Runs never cross a row boundary. The payload starts with the row width as a varint.
+ *
+ * Point lists (region cells, walker paths) are zigzag varint deltas from the previous point, starting at (0, 0);
+ * BFS orders and walks move one cell at a time, so most points cost two bytes.
+ *
+ * Decoders take the expected element count and reject malformed input without reading or writing out of bounds; a
+ * count the bytes cannot possibly hold is rejected before anything is allocated. A short stream can still describe a
+ * large grid (one run per row), so callers pass a count they have checked, not one read from the same untrusted bytes.
+ */
+struct PROCEDURALGEOMETRY_API FLayoutGridCodec
+{
+	static void EncodeGrid(TArrayView<const bool> Cells, int32 Width, TArray<uint8>& Out);
+	static void EncodeGrid(TArrayView<const uint8> Cells, int32 Width, TArray<uint8>& Out);
+	static void EncodeGrid(TArrayView<const int32> Cells, int32 Width, TArray<uint8>& Out);
+
+	static bool DecodeGrid(TArrayView<const uint8> Bytes, int32 Count, TArray<bool>& Out);
+	static bool DecodeGrid(TArrayView<const uint8> Bytes, int32 Count, TArray<uint8>& Out);
+	static bool DecodeGrid(TArrayView<const uint8> Bytes, int32 Count, TArray<int32>& Out);
+
+	static void EncodePoints(TArrayView<const FIntPoint> Points, TArray<uint8>& Out);
+	static bool DecodePoints(TArrayView<const uint8> Bytes, int32 Count, TArray<FIntPoint>& Out);
+};
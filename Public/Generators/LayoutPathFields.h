@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutPathFields.generated.h"
+
+struct FLayoutDiagram2D;
+struct FLayoutDiagramCompact;
+
+/**
+ * Precomputed distance and path fields over a layout diagram's Neighbors graph, so gameplay queries (distance from the
+ * center, critical path, spawn spacing, "which way to X") are array lookups instead of a BFS or Dijkstra per query.
+ *
+ * From the source cell (the diagram's center cell): hop counts, weighted distances (edge weight = distance between the
+ * two cell centers) and the next cell on a shortest weighted path back to the source. Optionally, for diagrams of at
+ * most MaxNextHopTableCells cells, an all-pairs next-hop table of one byte per (target, cell) pair holding the index
+ * into the cell's Neighbors of its next step toward the target.
+ */
+USTRUCT()
+struct PROCEDURALGEOMETRY_API FLayoutPathFields
+{
+	GENERATED_BODY()
+
+	/** Slot value for "no next step" (the cell is the target, or cannot reach it). */
+	static constexpr uint8 NoSlot = MAX_uint8;
+
+	UPROPERTY()
+	int32 SourceCellIndex = INDEX_NONE;
+
+	/** Cell reached last from the source by weighted distance: one end of the layout's critical path. */
+	UPROPERTY()
+	int32 FarthestCellIndex = INDEX_NONE;
+
+	/** Neighbor steps from the source per cell; INDEX_NONE where unreachable. */
+	UPROPERTY()
+	TArray<int32> HopDistance;
+
+	/** Shortest center-to-center path length from the source per cell; -1 where unreachable. */
+	UPROPERTY()
+	TArray<float> Distance;
+
+	/** Next cell on a shortest weighted path to the source per cell; INDEX_NONE at the source and where unreachable. */
+	UPROPERTY()
+	TArray<int32> NextHopToSource;
+
+	/** All-pairs next-hop slots, row per target: NextHopSlots[Target * NumCells + Cell]. Empty unless requested. */
+	UPROPERTY()
+	TArray<uint8> NextHopSlots;
+
+	UPROPERTY()
+	int32 NumCells = 0;
+
+	bool IsValid() const { return SourceCellIndex != INDEX_NONE && HopDistance.Num() == NumCells; }
+	bool HasNextHopTable() const { return NumCells > 0 && NextHopSlots.Num() == NumCells * NumCells; }
+
+	/** Clears all fields, keeping the arrays' memory. */
+	void Reset();
+
+	/** Index into Cell's Neighbors of its next step toward Target, or INDEX_NONE. Requires the next-hop table. */
+	int32 GetNextHopSlot(int32 Cell, int32 Target) const
+	{
+		check(HasNextHopTable());
+		const uint8 Slot = NextHopSlots[Target * NumCells + Cell];
+		return Slot == NoSlot ? INDEX_NONE : Slot;
+	}
+
+	/** Next cell from Cell toward Target: the source tree when Target is the source, else the next-hop table. */
+	int32 GetNextHop(const FLayoutDiagram2D& Diagram, int32 Cell, int32 Target) const;
+
+	/**
+	 * Cells from From to Target inclusive along a shortest weighted path, into OutPath (reset first). Returns false when
+	 * Target is unreachable, or is not the source and there is no next-hop table.
+	 */
+	bool GetPath(const FLayoutDiagram2D& Diagram, int32 From, int32 Target, TArray<int32>& OutPath) const;
+
+	/**
+	 * Computes the fields from SourceCell (INDEX_NONE: the diagram's CenterCellIndex) into OutFields, reusing its arrays.
+	 * The next-hop table is built, one Dijkstra per target in parallel, when the diagram has at most
+	 * MaxNextHopTableCells cells and no cell has more than 254 neighbors. Neighbor lists are assumed symmetric.
+	 */
+	static void Build(
+		const FLayoutDiagram2D& Diagram, FLayoutPathFields& OutFields, int32 MaxNextHopTableCells = 0, int32 SourceCell = INDEX_NONE);
+	static void Build(
+		const FLayoutDiagramCompact& Diagram, FLayoutPathFields& OutFields, int32 MaxNextHopTableCells = 0, int32 SourceCell = INDEX_NONE);
+};
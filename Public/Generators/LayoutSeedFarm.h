@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Generators/CellularAutomata2D/CellularAutomataGenerator2D.h"
+#include "Generators/DrunkardWalk2D/DrunkardWalkGenerator2D.h"
+
+/** Outcome of one seed in a seed farm run. */
+struct PROCEDURALGEOMETRY_API FLayoutSeedFarmSeedStats
+{
+	FString Seed;
+	bool	bEvaluated = false; // false if the run was cancelled before this seed was generated
+	bool	bAccepted = false;	// predicate result (only meaningful when bEvaluated)
+	double	ElapsedMs = 0.0;	// generation + predicate time
+	int32	DiagramCells = 0;
+	int32	Regions = 0;
+};
+
+/** Seeds and generator frame shared by every layout in a farm run. */
+struct PROCEDURALGEOMETRY_API FLayoutSeedFarmOptions
+{
+	TArray<FString> Seeds;
+	FBox2D			Bounds = FBox2D(FVector2D(-500, -500), FVector2D(500, 500));
+	int32			GridSize = 100;
+	int32			MaxAccepted = 1; // stop once this many seeds are accepted (K); <= 0 evaluates every seed
+	int32			NumWorkers = 0;	 // parallel generator cores; 0 = one per task-graph worker plus the calling thread
+};
+
+/**
+ * Result of a farm run. The accepted layouts are always the K lowest-index accepted seeds, whatever the worker
+ * count or timing. Seeds after the K-th accepted one may or may not have been evaluated (see bEvaluated).
+ */
+template <typename GridDataType>
+struct TLayoutSeedFarmResult
+{
+	TArray<FLayoutSeedFarmSeedStats> Stats;				  // parallel to FLayoutSeedFarmOptions::Seeds
+	TArray<int32>					 AcceptedSeedIndices; // ascending, at most MaxAccepted
+	TArray<GridDataType>			 AcceptedLayouts;	  // parallel to AcceptedSeedIndices
+};
+
+/**
+ * Generates one layout per seed across worker threads and keeps those an acceptance predicate approves, cancelling
+ * outstanding seeds once enough are accepted. Each worker owns its own generator, configured from the same resolved
+ * params; a generator carries no state from one seed to the next (a degraded run does not touch GridSize), so layouts
+ * are identical to a serial loop over the same seeds.
+ *
+ * Call from the game thread (generators are created there). The predicate runs on worker threads and must be
+ * thread-safe; it sees the full grid data of each layout.
+ */
+class PROCEDURALGEOMETRY_API FLayoutSeedFarm
+{
+public:
+	/** Seeds "<Prefix><First>" .. "<Prefix><First + Count - 1>". */
+	static TArray<FString> MakeSeedRange(const FString& Prefix, int32 First, int32 Count);
+
+	static TLayoutSeedFarmResult<FDrunkardWalkGridData> RunDrunkardWalk(const FDrunkardWalkResolvedParams& Params,
+		const FLayoutSeedFarmOptions&																	   Options,
+		TFunction<bool(const FDrunkardWalkGridData&)>													   Accept);
+
+	static TLayoutSeedFarmResult<FCellularAutomataGridData> RunCellularAutomata(const FCellularAutomataResolvedParams& Params,
+		const FLayoutSeedFarmOptions&																			   Options,
+		TFunction<bool(const FCellularAutomataGridData&)>														   Accept);
+};
@@ -40,6 +40,44 @@ public:
 	/** Offset a polyline into a closed ribbon polygon of the given width (per-vertex normals). Empty if <2 points. */
 	static void OffsetPolylineToRibbon(const TArray<FVector2D>& Polyline, float Width, TArray<FVector2D>& OutRibbon);
 
+	/** Douglas-Peucker simplification of a closed polygon in place; Tolerance is the max deviation in world units.
+	 *  Vertices flagged in Locked (parallel to Vertices, or empty) are always kept. Single-polygon form of
+	 *  SimplifyPolygonSetDouglasPeucker.
+	 */
+	static void SimplifyPolygonDouglasPeucker(TArray<FVector2D>& Vertices, float Tolerance, const TArray<bool>& Locked);
+
+	/** Douglas-Peucker simplification of a set of closed polygons in place, preserving their topology.
+	 *  Each outline splits into chains at its Locked vertices (Locked is parallel to Polygons, or empty); a chain that
+	 *  several outlines walk, in either direction, is simplified once and reused by all of them. Chains whose result
+	 *  crosses another segment, flips or collapses an outline, or moves another polygon across it are re-simplified at
+	 *  half the tolerance, down to the exact input if need be. Touching without crossing is allowed.
+	 */
+	static void SimplifyPolygonSetDouglasPeucker(
+		TArrayView<TArray<FVector2D>* const> Polygons, float Tolerance, TArrayView<const TArray<bool>> Locked);
+
+	/** Exact squared Euclidean distance transform of a row-major grid (Felzenszwalb-Huttenlocher), O(Width*Height).
+	 *  OutDistSq[i] = squared distance in cells from cell i to the nearest cell where Features is true, or MAX_int32
+	 *  if the grid has no feature cell. Distances saturate at MAX_int32: a cell more than 46340 cells from every feature
+	 *  (possible on long, thin grids) reads as MAX_int32, the same as no feature. bParallel runs the column and row
+	 *  passes across worker threads.
+	 */
+	static void DistanceTransformSq(const TArray<bool>& Features, int32 Width, int32 Height, TArray<int32>& OutDistSq, bool bParallel = false);
+
+	/** uint8 overload for cell-type grids: feature cells are those equal to FeatureValue. */
+	static void DistanceTransformSq(
+		const TArray<uint8>& Grid, uint8 FeatureValue, int32 Width, int32 Height, TArray<int32>& OutDistSq, bool bParallel = false);
+
+	/** Chebyshev (square-window) dilation of a row-major mask: OutDilated[i] is true if any Mask cell within Radius
+	 *  cells on both axes is true. Separable row/column sweeps, O(Width*Height) regardless of Radius; bParallel runs
+	 *  the row and column passes across worker threads.
+	 */
+	static void DilateChebyshev(
+		const TArray<bool>& Mask, int32 Width, int32 Height, int32 Radius, TArray<bool>& OutDilated, bool bParallel = false);
+
+	/** View overload for callers that keep the mask in their own storage; OutDilated must already hold Width*Height cells. */
+	static void DilateChebyshev(
+		TArrayView<const bool> Mask, int32 Width, int32 Height, int32 Radius, TArrayView<bool> OutDilated, bool bParallel = false);
+
 private:
 	// Helper functions for polygon operations
 	static float DistanceToLineSegment(const FVector2D& Point, const FVector2D& LineStart, const FVector2D& LineEnd);